@@ -0,0 +1,425 @@
+/******************************************************************************
+ *
+ * Module: ADC
+ *
+ * File Name: ADC.c
+ *
+ * Description: Source file for the TM4C123GH6PM ADC sample sequencer driver with
+ *              hardware averaging and uDMA ping-pong streaming of the FIFO results
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "ADC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* Bus address of a buffer, unsigned long has the pointer width on target and host */
+#define ADC_ADDRESS(Ptr)              ((uint32)(unsigned long)(Ptr))
+
+/* uDMA channel of a sequencer and its CHMAP encoding: ADC0 SSn on 14+n, ADC1 SSn on 24+n */
+#define ADC_DMA_CHANNEL(Module, Seq)  (((Module) == ADC_MODULE0) ? (14 + (Seq)) : (24 + (Seq)))
+#define ADC_DMA_ENCODING(Module)      ((uint32)(Module))
+
+/* Channel control word: 16-bit items from the fixed FIFO address into the buffer */
+#define ADC_DMA_CHCTL_16BIT           0x5D000000
+#define ADC_DMA_CHCTL_ARBSIZE_POS     14
+#define ADC_DMA_CHCTL_XFERSIZE_POS    4
+#define ADC_DMA_CHCTL_PING_PONG       0x3
+#define ADC_DMA_CHCTL_MODE_MASK       0x7
+
+/* Word offsets in the control table, the alternate entries follow the 32 primary ones */
+#define ADC_DMA_PRIMARY(Channel)      ((Channel) * 4)
+#define ADC_DMA_ALTERNATE(Channel)    (128 + ((Channel) * 4))
+#define ADC_DMA_SRCENDP               0
+#define ADC_DMA_DSTENDP               1
+#define ADC_DMA_CHCTL                 2
+
+#define ADC_UDMA_CFG_MASTEN           0x1
+#define ADC_SAMPLE_MASK               0xFFF
+
+typedef struct
+{
+    uint32 *table;
+    uint16 *buffers[2];                 /* ping in the primary, pong in the alternate entry */
+    uint16 count;
+    uint32 chctl;
+    uint8 next;                         /* entry that completes next                     */
+    uint32 overruns;
+    ADC_BufferCallBackType callBack;
+}ADC_StreamType;
+
+static const uint32 g_AdcBase[ADC_NUMBER_OF_MODULES] = { ADC0_BASE, ADC1_BASE };
+static const uint8 g_AdcDepth[ADC_NUMBER_OF_SEQUENCERS] = { 8, 4, 4, 1 };
+
+static ADC_StreamType g_AdcStreams[ADC_NUMBER_OF_MODULES][ADC_NUMBER_OF_SEQUENCERS];
+static void (*g_AdcCallBacks[ADC_NUMBER_OF_MODULES][ADC_NUMBER_OF_SEQUENCERS])(void);
+
+/* Load a ping-pong entry to fill the buffer again */
+static void ADC_ArmEntry(ADC_StreamType *Stream, uint32 Base, ADC_SequencerType Sequencer, uint32 Entry, uint8 Half){
+
+    Stream->table[Entry + ADC_DMA_SRCENDP] = ADC_SSFIFO_ADDRESS(Base, Sequencer);
+    Stream->table[Entry + ADC_DMA_DSTENDP] = ADC_ADDRESS(&Stream->buffers[Half][Stream->count - 1]);
+    Stream->table[Entry + ADC_DMA_CHCTL]   = Stream->chctl;
+}
+
+/*********************************************************************
+* Service Name: ADC_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - ADC module / Rate - Conversion rate /
+*                  Averaging - Hardware oversampling of every sample
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clock the module and set its rate and averaging. The
+*              averaging divides the sample rate, 1 Msps at 64X gives 15.6 ksps.
+**********************************************************************/
+void ADC_Init(ADC_ModuleType Module, ADC_RateType Rate, ADC_AveragingType Averaging){
+
+    uint32 base = g_AdcBase[Module];
+
+    SYSCTL_RCGCADC_REG |= (1u << Module);
+    SYSCTL_SCGCADC_REG |= (1u << Module);
+    SYSCTL_DCGCADC_REG |= (1u << Module);
+    while(!(SYSCTL_PRADC_REG & (1u << Module))){}
+
+    ADC_ACTSS_REG(base) = 0;
+    ADC_PC_REG(base)    = (uint32)Rate;
+    ADC_SAC_REG(base)   = (uint32)Averaging;
+}
+
+/*********************************************************************
+* Service Name: ADC_EncodeSequence
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Config - Sequence
+* Parameters (inout): None
+* Parameters (out): Regs - Register values
+* Return value: boolean - FALSE for a wrong step count, input or priority
+* Description: Function to compute the sequencer registers of a configuration, with
+*              END and IE on the last step.
+**********************************************************************/
+boolean ADC_EncodeSequence(const ADC_SequenceConfigType *Config, ADC_SequenceRegsType *Regs){
+
+    uint32 shift = 4 * (uint32)Config->sequencer;
+    uint8 step;
+
+    if((Config->steps == 0) || (Config->steps > g_AdcDepth[Config->sequencer]) || (Config->priority > 3)){
+        return FALSE;
+    }
+
+    Regs->ssmux = 0;
+    Regs->ssctl = 0;
+
+    for(step = 0; step < Config->steps; step++){
+
+        uint8 input = Config->inputs[step];
+
+        if(input == ADC_INPUT_TEMP){
+            Regs->ssctl |= (uint32)ADC_SSCTL_TS << (4 * step);
+        }
+        else if(input < ADC_NUMBER_OF_INPUTS){
+            Regs->ssmux |= (uint32)input << (4 * step);
+        }
+        else{
+            return FALSE;
+        }
+    }
+
+    /* The last step ends the sequence and raises the interrupt / uDMA request */
+    Regs->ssctl |= (uint32)(ADC_SSCTL_END | ADC_SSCTL_IE) << (4 * (Config->steps - 1));
+
+    Regs->emuxMask   = 0xFu << shift;
+    Regs->emux       = (uint32)Config->trigger << shift;
+    Regs->ssprioMask = 0x3u << shift;
+    Regs->sspri      = (uint32)Config->priority << shift;
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: ADC_ConfigureSequence
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Sequence
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when ADC_EncodeSequence rejects the configuration
+* Description: Function to program a sample sequencer of an initialized module and
+*              enable it. The NVIC line of the sequencer is enabled by the application.
+**********************************************************************/
+boolean ADC_ConfigureSequence(const ADC_SequenceConfigType *Config){
+
+    uint32 base = g_AdcBase[Config->module];
+    ADC_SequencerType seq = Config->sequencer;
+    ADC_SequenceRegsType regs;
+
+    if(!ADC_EncodeSequence(Config, &regs)){
+        return FALSE;
+    }
+
+    /* The sequencer is programmed while disabled */
+    ADC_ACTSS_REG(base) &= ~(ADC_ACTSS_ASEN(seq) | ADC_ACTSS_ADEN(seq));
+
+    ADC_EMUX_REG(base)       = (ADC_EMUX_REG(base) & ~regs.emuxMask) | regs.emux;
+    ADC_SSPRI_REG(base)      = (ADC_SSPRI_REG(base) & ~regs.ssprioMask) | regs.sspri;
+    ADC_SSMUX_REG(base, seq) = regs.ssmux;
+    ADC_SSCTL_REG(base, seq) = regs.ssctl;
+
+    ADC_ISC_REG(base) = ADC_INT_SS(seq) | ADC_INT_DMA(seq);
+    if(Config->interrupt){
+        ADC_IM_REG(base) |= ADC_INT_SS(seq);
+    }
+    else{
+        ADC_IM_REG(base) &= ~ADC_INT_SS(seq);
+    }
+
+    ADC_ACTSS_REG(base) |= ADC_ACTSS_ASEN(seq);
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: ADC_Trigger
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start a sequence with the processor trigger.
+**********************************************************************/
+void ADC_Trigger(ADC_ModuleType Module, ADC_SequencerType Sequencer){
+
+    ADC_PSSI_REG(g_AdcBase[Module]) = (1u << Sequencer);
+}
+
+/*********************************************************************
+* Service Name: ADC_ReadFifo
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer / MaxCount - Size of Samples
+* Parameters (inout): None
+* Parameters (out): Samples - 12-bit results
+* Return value: uint8 - Number of samples read
+* Description: Function to empty the FIFO of a sequencer without uDMA and clear its
+*              sequence complete flag.
+**********************************************************************/
+uint8 ADC_ReadFifo(ADC_ModuleType Module, ADC_SequencerType Sequencer, uint16 *Samples, uint8 MaxCount){
+
+    uint32 base = g_AdcBase[Module];
+    uint8 count = 0;
+
+    while((count < MaxCount) && !(ADC_SSFSTAT_REG(base, Sequencer) & ADC_SSFSTAT_EMPTY)){
+        Samples[count++] = (uint16)(ADC_SSFIFO_REG(base, Sequencer) & ADC_SAMPLE_MASK);
+    }
+
+    ADC_ISC_REG(base) = ADC_INT_SS(Sequencer);
+
+    return count;
+}
+
+/*********************************************************************
+* Service Name: ADC_StartStream
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Sequencer, uDMA table and buffers
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for a wrong buffer size
+* Description: Function to stream the sequencer FIFO into two buffers with the uDMA
+*              in ping-pong mode. The handler calls the call back once per full buffer
+*              and re-arms it, no interrupt is taken per sample.
+**********************************************************************/
+boolean ADC_StartStream(const ADC_StreamConfigType *Config){
+
+    uint32 base    = g_AdcBase[Config->module];
+    uint32 seq     = Config->sequencer;
+    uint32 channel = ADC_DMA_CHANNEL(Config->module, seq);
+    uint32 steps;
+    uint32 arb     = 0;
+    ADC_StreamType *stream = &g_AdcStreams[Config->module][seq];
+
+    /* Steps of the configured sequence, from the position of its END bit */
+    for(steps = 1; steps < 8; steps++){
+        if(ADC_SSCTL_REG(base, seq) & ((uint32)ADC_SSCTL_END << (4 * (steps - 1)))){
+            break;
+        }
+    }
+
+    if((Config->count == 0) || (Config->count > ADC_DMA_MAX_SAMPLES) || ((Config->count % steps) != 0)){
+        return FALSE;
+    }
+
+    /* One request moves up to a whole sequence, the arbitration size is a power of two */
+    while((2u << arb) <= steps){
+        arb++;
+    }
+
+    stream->table      = Config->dmaTable;
+    stream->buffers[0] = Config->ping;
+    stream->buffers[1] = Config->pong;
+    stream->count      = Config->count;
+    stream->next       = 0;
+    stream->callBack   = Config->callBack;
+    stream->chctl      = ADC_DMA_CHCTL_16BIT | (arb << ADC_DMA_CHCTL_ARBSIZE_POS) |
+                         ((uint32)(Config->count - 1) << ADC_DMA_CHCTL_XFERSIZE_POS) | ADC_DMA_CHCTL_PING_PONG;
+
+    SYSCTL_RCGCDMA_REG |= 0x1;
+    SYSCTL_SCGCDMA_REG |= 0x1;
+    SYSCTL_DCGCDMA_REG |= 0x1;
+    while(!(SYSCTL_PRDMA_REG & 0x1)){}
+
+    UDMA_CFG_REG     = ADC_UDMA_CFG_MASTEN;
+    UDMA_CTLBASE_REG = ADC_ADDRESS(Config->dmaTable);
+
+    UDMA_ENACLR_REG = (1u << channel);
+    UDMA_CHMAP_REG(channel) = (UDMA_CHMAP_REG(channel) & ~(0xFu << (4 * (channel % 8)))) |
+                              (ADC_DMA_ENCODING(Config->module) << (4 * (channel % 8)));
+
+    ADC_ArmEntry(stream, base, Config->sequencer, ADC_DMA_PRIMARY(channel), 0);
+    ADC_ArmEntry(stream, base, Config->sequencer, ADC_DMA_ALTERNATE(channel), 1);
+
+    /* Single and burst requests, default priority, start on the primary entry */
+    UDMA_USEBURSTCLR_REG = (1u << channel);
+    UDMA_PRIOCLR_REG     = (1u << channel);
+    UDMA_ALTCLR_REG      = (1u << channel);
+    UDMA_REQMASKCLR_REG  = (1u << channel);
+    UDMA_ENASET_REG      = (1u << channel);
+
+    ADC_ISC_REG(base)    = ADC_INT_DMA(seq);
+    ADC_IM_REG(base)    |= ADC_INT_DMA(seq);
+    ADC_ACTSS_REG(base) |= ADC_ACTSS_ADEN(seq);
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: ADC_StopStream
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop the uDMA channel of the sequencer, the sequencer
+*              keeps running and its FIFO overflows.
+**********************************************************************/
+void ADC_StopStream(ADC_ModuleType Module, ADC_SequencerType Sequencer){
+
+    uint32 base = g_AdcBase[Module];
+
+    ADC_ACTSS_REG(base) &= ~ADC_ACTSS_ADEN(Sequencer);
+    ADC_IM_REG(base)    &= ~ADC_INT_DMA(Sequencer);
+    UDMA_ENACLR_REG      = (1u << ADC_DMA_CHANNEL(Module, Sequencer));
+    ADC_ISC_REG(base)    = ADC_INT_DMA(Sequencer);
+
+    g_AdcStreams[Module][Sequencer].callBack = NULL_PTR;
+}
+
+/*********************************************************************
+* Service Name: ADC_GetOverruns
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Streams restarted because both buffers were full
+* Description: Function to check that the call back keeps up with the sample rate.
+**********************************************************************/
+uint32 ADC_GetOverruns(ADC_ModuleType Module, ADC_SequencerType Sequencer){
+
+    return g_AdcStreams[Module][Sequencer].overruns;
+}
+
+/*********************************************************************
+* Service Name: ADC_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer /
+*                  Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called on the sequence complete
+*              interrupt, read the results with ADC_ReadFifo.
+**********************************************************************/
+void ADC_SetCallBack(ADC_ModuleType Module, ADC_SequencerType Sequencer, void (*Ptr2Func)(void)){
+
+    g_AdcCallBacks[Module][Sequencer] = Ptr2Func;
+}
+
+/*********************************************************************
+* Service Name: ADC_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the uDMA done and sequence complete interrupts of a
+*              sequencer. The vector table entries ADC_Adc0Seq0_Handler ...
+*              ADC_Adc1Seq3_Handler call it.
+**********************************************************************/
+void ADC_Handler(ADC_ModuleType Module, ADC_SequencerType Sequencer){
+
+    uint32 base   = g_AdcBase[Module];
+    uint32 status = ADC_RIS_REG(base) & ADC_IM_REG(base) & (ADC_INT_SS(Sequencer) | ADC_INT_DMA(Sequencer));
+
+    ADC_ISC_REG(base) = status;
+
+    if(status & ADC_INT_DMA(Sequencer)){
+
+        ADC_StreamType *stream = &g_AdcStreams[Module][Sequencer];
+        uint32 channel = ADC_DMA_CHANNEL(Module, Sequencer);
+        uint8 done = 0;
+
+        /* A finished entry has its mode back to stop, both are finished after an overrun */
+        while(done < 2){
+
+            uint32 entry = (stream->next == 0) ? ADC_DMA_PRIMARY(channel) : ADC_DMA_ALTERNATE(channel);
+            uint8 half = stream->next;
+
+            if((stream->table[entry + ADC_DMA_CHCTL] & ADC_DMA_CHCTL_MODE_MASK) != 0){
+                break;
+            }
+
+            ADC_ArmEntry(stream, base, Sequencer, entry, half);
+            stream->next ^= 1;
+            done++;
+
+            if(stream->callBack != NULL_PTR){
+                stream->callBack(stream->buffers[half], stream->count);
+            }
+        }
+
+        /* The channel stopped on a finished entry, resume on the one that completes next */
+        if(!(UDMA_ENASET_REG & (1u << channel))){
+
+            if(stream->next == 0){
+                UDMA_ALTCLR_REG = (1u << channel);
+            }
+            else{
+                UDMA_ALTSET_REG = (1u << channel);
+            }
+            UDMA_ENASET_REG = (1u << channel);
+            stream->overruns++;
+        }
+    }
+
+    if((status & ADC_INT_SS(Sequencer)) && (g_AdcCallBacks[Module][Sequencer] != NULL_PTR)){
+        g_AdcCallBacks[Module][Sequencer]();
+    }
+}
+
+/* Vector table entries */
+#define ADC_DEFINE_HANDLER(Name, Module, Seq)       void ADC_##Name##_Handler(void){ ADC_Handler(Module, Seq); }
+
+ADC_DEFINE_HANDLER(Adc0Seq0, ADC_MODULE0, ADC_SEQUENCER0)
+ADC_DEFINE_HANDLER(Adc0Seq1, ADC_MODULE0, ADC_SEQUENCER1)
+ADC_DEFINE_HANDLER(Adc0Seq2, ADC_MODULE0, ADC_SEQUENCER2)
+ADC_DEFINE_HANDLER(Adc0Seq3, ADC_MODULE0, ADC_SEQUENCER3)
+ADC_DEFINE_HANDLER(Adc1Seq0, ADC_MODULE1, ADC_SEQUENCER0)
+ADC_DEFINE_HANDLER(Adc1Seq1, ADC_MODULE1, ADC_SEQUENCER1)
+ADC_DEFINE_HANDLER(Adc1Seq2, ADC_MODULE1, ADC_SEQUENCER2)
+ADC_DEFINE_HANDLER(Adc1Seq3, ADC_MODULE1, ADC_SEQUENCER3)
@@ -0,0 +1,301 @@
+/******************************************************************************
+ *
+ * Module: ADC
+ *
+ * File Name: ADC.h
+ *
+ * Description: Header file for the TM4C123GH6PM ADC sample sequencer driver with
+ *              hardware averaging and uDMA ping-pong streaming of the FIFO results
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef ADC_H_
+#define ADC_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define ADC_NUMBER_OF_MODULES                2
+#define ADC_NUMBER_OF_SEQUENCERS             4
+#define ADC_NUMBER_OF_INPUTS                 12      /* AIN0 ... AIN11              */
+
+/* Input of a step, AINn or the internal temperature sensor */
+#define ADC_INPUT_TEMP                       0x80
+
+/* ADCSSCTLn step fields, 4 bits per step */
+#define ADC_SSCTL_D                          0x1     /* differential pair           */
+#define ADC_SSCTL_END                        0x2     /* last step                   */
+#define ADC_SSCTL_IE                         0x4     /* interrupt / uDMA request    */
+#define ADC_SSCTL_TS                         0x8     /* temperature sensor          */
+
+/* ADCACTSS, ADCIM, ADCRIS, ADCISC bits of sequencer n */
+#define ADC_ACTSS_ASEN(Seq)                  (0x001u << (Seq))
+#define ADC_ACTSS_ADEN(Seq)                  (0x100u << (Seq))   /* uDMA enable  */
+#define ADC_INT_SS(Seq)                      (0x001u << (Seq))
+#define ADC_INT_DMA(Seq)                     (0x100u << (Seq))
+
+/* ADCSSFSTATn FIFO empty */
+#define ADC_SSFSTAT_EMPTY                    0x100
+
+/* Most samples moved by one uDMA transfer, the XFERSIZE field */
+#define ADC_DMA_MAX_SAMPLES                  1024
+
+/*
+ * uDMA channel control table, 32 primary then 32 alternate entries of 4 words. One
+ * table serves every uDMA user, it is defined by the application aligned to 1024 bytes:
+ *     #pragma DATA_ALIGN(g_DmaTable, 1024)
+ *     uint32 g_DmaTable[ADC_DMA_TABLE_WORDS];
+ */
+#define ADC_DMA_TABLE_WORDS                  256
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    ADC_MODULE0, ADC_MODULE1
+}ADC_ModuleType;
+
+/* FIFO depth and number of steps: 8, 4, 4, 1 */
+typedef enum
+{
+    ADC_SEQUENCER0, ADC_SEQUENCER1, ADC_SEQUENCER2, ADC_SEQUENCER3
+}ADC_SequencerType;
+
+/* ADCEMUX trigger source */
+typedef enum
+{
+    ADC_TRIGGER_PROCESSOR  = 0x0,      /* ADC_Trigger                                  */
+    ADC_TRIGGER_COMPARATOR0 = 0x1,
+    ADC_TRIGGER_COMPARATOR1 = 0x2,
+    ADC_TRIGGER_EXTERNAL   = 0x4,      /* GPIO pin, GPIOADCCTL                         */
+    ADC_TRIGGER_TIMER      = 0x5,      /* GPTM_SetAdcTrigger                           */
+    ADC_TRIGGER_PWM0       = 0x6,      /* PWM generator 0 ... 3, PWMnINTEN TRCMPxx     */
+    ADC_TRIGGER_PWM1       = 0x7,
+    ADC_TRIGGER_PWM2       = 0x8,
+    ADC_TRIGGER_PWM3       = 0x9,
+    ADC_TRIGGER_ALWAYS     = 0xF       /* continuous sampling                          */
+}ADC_TriggerType;
+
+/* ADCPC conversion rate */
+typedef enum
+{
+    ADC_RATE_125KSPS = 0x1,
+    ADC_RATE_250KSPS = 0x3,
+    ADC_RATE_500KSPS = 0x5,
+    ADC_RATE_1MSPS   = 0x7
+}ADC_RateType;
+
+/* ADCSAC hardware oversampling, every sample is the mean of 2^n conversions */
+typedef enum
+{
+    ADC_AVERAGE_NONE, ADC_AVERAGE_2X, ADC_AVERAGE_4X, ADC_AVERAGE_8X,
+    ADC_AVERAGE_16X, ADC_AVERAGE_32X, ADC_AVERAGE_64X
+}ADC_AveragingType;
+
+typedef struct
+{
+    ADC_ModuleType module;
+    ADC_SequencerType sequencer;
+    ADC_TriggerType trigger;
+    uint8 priority;                     /* 0 highest ... 3, unique in the module         */
+    uint8 steps;                        /* samples per trigger, 1 ... FIFO depth         */
+    uint8 inputs[8];                    /* AINn or ADC_INPUT_TEMP per step               */
+    boolean interrupt;                  /* sequence complete interrupt, not for streams  */
+}ADC_SequenceConfigType;
+
+/* Register values of a sequence, computed without any register access */
+typedef struct
+{
+    uint32 ssmux;                       /* ADCSSMUXn                                     */
+    uint32 ssctl;                       /* ADCSSCTLn                                     */
+    uint32 emuxMask;                    /* ADCEMUX field of the sequencer                */
+    uint32 emux;
+    uint32 ssprioMask;                  /* ADCSSPRI field of the sequencer               */
+    uint32 sspri;
+}ADC_SequenceRegsType;
+
+/* Called from the handler with a full buffer, while the uDMA fills the other one */
+typedef void (*ADC_BufferCallBackType)(const uint16 *Buffer, uint16 Count);
+
+typedef struct
+{
+    ADC_ModuleType module;
+    ADC_SequencerType sequencer;        /* configured by ADC_ConfigureSequence first     */
+    uint32 *dmaTable;                   /* ADC_DMA_TABLE_WORDS, 1024 byte aligned        */
+    uint16 *ping;
+    uint16 *pong;
+    uint16 count;                       /* samples per buffer, multiple of the steps     */
+    ADC_BufferCallBackType callBack;
+}ADC_StreamConfigType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: ADC_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - ADC module / Rate - Conversion rate /
+*                  Averaging - Hardware oversampling of every sample
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clock the module and set its rate and averaging. The
+*              averaging divides the sample rate, 1 Msps at 64X gives 15.6 ksps.
+**********************************************************************/
+
+void ADC_Init(ADC_ModuleType Module, ADC_RateType Rate, ADC_AveragingType Averaging);
+
+/*********************************************************************
+* Service Name: ADC_EncodeSequence
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Config - Sequence
+* Parameters (inout): None
+* Parameters (out): Regs - Register values
+* Return value: boolean - FALSE for a wrong step count, input or priority
+* Description: Function to compute the sequencer registers of a configuration, with
+*              END and IE on the last step.
+**********************************************************************/
+
+boolean ADC_EncodeSequence(const ADC_SequenceConfigType *Config, ADC_SequenceRegsType *Regs);
+
+/*********************************************************************
+* Service Name: ADC_ConfigureSequence
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Sequence
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when ADC_EncodeSequence rejects the configuration
+* Description: Function to program a sample sequencer of an initialized module and
+*              enable it. The NVIC line of the sequencer is enabled by the application.
+**********************************************************************/
+
+boolean ADC_ConfigureSequence(const ADC_SequenceConfigType *Config);
+
+/*********************************************************************
+* Service Name: ADC_Trigger
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start a sequence with the processor trigger.
+**********************************************************************/
+
+void ADC_Trigger(ADC_ModuleType Module, ADC_SequencerType Sequencer);
+
+/*********************************************************************
+* Service Name: ADC_ReadFifo
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer / MaxCount - Size of Samples
+* Parameters (inout): None
+* Parameters (out): Samples - 12-bit results
+* Return value: uint8 - Number of samples read
+* Description: Function to empty the FIFO of a sequencer without uDMA and clear its
+*              sequence complete flag.
+**********************************************************************/
+
+uint8 ADC_ReadFifo(ADC_ModuleType Module, ADC_SequencerType Sequencer, uint16 *Samples, uint8 MaxCount);
+
+/*********************************************************************
+* Service Name: ADC_StartStream
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Sequencer, uDMA table and buffers
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for a wrong buffer size
+* Description: Function to stream the sequencer FIFO into two buffers with the uDMA
+*              in ping-pong mode. The handler calls the call back once per full buffer
+*              and re-arms it, no interrupt is taken per sample.
+**********************************************************************/
+
+boolean ADC_StartStream(const ADC_StreamConfigType *Config);
+
+/*********************************************************************
+* Service Name: ADC_StopStream
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop the uDMA channel of the sequencer, the sequencer
+*              keeps running and its FIFO overflows.
+**********************************************************************/
+
+void ADC_StopStream(ADC_ModuleType Module, ADC_SequencerType Sequencer);
+
+/*********************************************************************
+* Service Name: ADC_GetOverruns
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Streams restarted because both buffers were full
+* Description: Function to check that the call back keeps up with the sample rate.
+**********************************************************************/
+
+uint32 ADC_GetOverruns(ADC_ModuleType Module, ADC_SequencerType Sequencer);
+
+/*********************************************************************
+* Service Name: ADC_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer /
+*                  Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called on the sequence complete
+*              interrupt, read the results with ADC_ReadFifo.
+**********************************************************************/
+
+void ADC_SetCallBack(ADC_ModuleType Module, ADC_SequencerType Sequencer, void (*Ptr2Func)(void));
+
+/*********************************************************************
+* Service Name: ADC_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - ADC module / Sequencer - Sequencer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the uDMA done and sequence complete interrupts of a
+*              sequencer. The vector table entries ADC_Adc0Seq0_Handler ...
+*              ADC_Adc1Seq3_Handler call it.
+**********************************************************************/
+
+void ADC_Handler(ADC_ModuleType Module, ADC_SequencerType Sequencer);
+
+/* Vector table entries, one per NVIC_ADCn_SEQUENCEm_IRQ */
+void ADC_Adc0Seq0_Handler(void);
+void ADC_Adc0Seq1_Handler(void);
+void ADC_Adc0Seq2_Handler(void);
+void ADC_Adc0Seq3_Handler(void);
+void ADC_Adc1Seq0_Handler(void);
+void ADC_Adc1Seq1_Handler(void);
+void ADC_Adc1Seq2_Handler(void);
+void ADC_Adc1Seq3_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* ADC_H_ */
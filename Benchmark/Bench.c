@@ -0,0 +1,257 @@
+/******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: Bench.c
+ *
+ * Description: Source file for the driver micro-benchmark harness. Runs on target
+ *              with the DWT cycle counter or natively on the host simulation
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Bench.h"
+#include "tm4c123gh6pm_registers.h"
+
+#if defined(HOST_SIMULATION) && defined(BENCH_HOST_NANOSECONDS)
+#include <time.h>
+#define BENCH_START()              Bench_HostNanoseconds()
+#define BENCH_STOP()               Bench_HostNanoseconds()
+#elif defined(HOST_SIMULATION) && defined(BENCH_HOST_INSTRUCTIONS)
+#ifndef __x86_64__
+#error "BENCH_HOST_INSTRUCTIONS single-steps with the x86-64 trap flag"
+#endif
+#include <signal.h>
+#define BENCH_START()              Bench_HostStepStart()
+#define BENCH_STOP()               Bench_HostStepStop()
+#elif defined(HOST_SIMULATION)
+#define BENCH_START()              Bench_HostBusAccesses()
+#define BENCH_STOP()               Bench_HostBusAccesses()
+#else
+#define BENCH_START()              DWT_CYCCNT_REG
+#define BENCH_STOP()               DWT_CYCCNT_REG
+#endif
+
+/* Cost of an empty case, removed from every measurement */
+static uint32 g_BenchOverhead = 0;
+
+static void Bench_Empty(void){
+}
+
+#if defined(HOST_SIMULATION) && defined(BENCH_HOST_NANOSECONDS)
+static uint32 Bench_HostNanoseconds(void){
+
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32)((uint64)now.tv_sec * 1000000000ULL + (uint64)now.tv_nsec);
+}
+#elif defined(HOST_SIMULATION) && defined(BENCH_HOST_INSTRUCTIONS)
+static volatile uint32 g_BenchSteps = 0;
+
+/* SIGTRAP after every instruction while the trap flag is set, the handler runs with it clear */
+static void Bench_HostStep(int Signal){
+
+    (void)Signal;
+    g_BenchSteps++;
+}
+
+static uint32 Bench_HostStepStart(void){
+
+    __builtin_ia32_writeeflags_u64(__builtin_ia32_readeflags_u64() | BENCH_HOST_TRAP_FLAG);
+
+    return g_BenchSteps;
+}
+
+static uint32 Bench_HostStepStop(void){
+
+    __builtin_ia32_writeeflags_u64(__builtin_ia32_readeflags_u64() & ~(uint64)BENCH_HOST_TRAP_FLAG);
+
+    return g_BenchSteps;
+}
+#elif defined(HOST_SIMULATION)
+/* Reads and writes of the register file so far, weighted by their bus cost */
+static uint32 Bench_HostBusAccesses(void){
+
+    return (HostReg_GetReadCount() * BENCH_HOST_READ_COST) + (HostReg_GetWriteCount() * BENCH_HOST_WRITE_COST);
+}
+#endif
+
+/* Format Value in decimal into Buffer (at least 11 characters) */
+static void Bench_FormatDec(uint32 Value, char *Buffer){
+
+    char digits[10];
+    uint8 count = 0;
+
+    do{
+        digits[count++] = (char)('0' + (Value % 10));
+        Value /= 10;
+    }while(Value != 0);
+
+    while(count > 0){
+        *Buffer++ = digits[--count];
+    }
+    *Buffer = '\0';
+}
+
+static void Bench_PrintField(Bench_PrintFuncType PrintFunc, const char *Name, uint32 Value){
+
+    char dec[11];
+
+    Bench_FormatDec(Value, dec);
+    PrintFunc(Name);
+    PrintFunc(dec);
+}
+
+/* Time the case, without removing the overhead */
+static void Bench_Time(const Bench_CaseType *Case, Bench_ResultType *Result){
+
+    uint32 total = 0;
+    uint32 i;
+
+    Result->min = BENCH_NO_BUDGET;
+    Result->max = 0;
+
+    for(i = 0; i < BENCH_ITERATIONS; i++){
+
+        uint32 start;
+        uint32 cost;
+
+        if(Case->setup != NULL_PTR){
+            Case->setup();
+        }
+
+        start = BENCH_START();
+        Case->run();
+        cost = BENCH_STOP() - start;
+
+        if(Case->teardown != NULL_PTR){
+            Case->teardown();
+        }
+
+        total += cost;
+        if(cost < Result->min){
+            Result->min = cost;
+        }
+        if(cost > Result->max){
+            Result->max = cost;
+        }
+    }
+
+    Result->mean = total / BENCH_ITERATIONS;
+}
+
+/*********************************************************************
+* Service Name: Bench_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start the DWT cycle counter on target, or reset the
+*              simulated register file (and catch the single-step trap) on the host.
+**********************************************************************/
+void Bench_Init(void){
+
+    const Bench_CaseType empty = { "empty", NULL_PTR, Bench_Empty, NULL_PTR, 0, 0, 0 };
+    Bench_ResultType result;
+
+#ifdef HOST_SIMULATION
+    HostReg_Init();
+#ifdef BENCH_HOST_INSTRUCTIONS
+    signal(SIGTRAP, Bench_HostStep);
+#endif
+#else
+    DEBUG_DEMCR_REG |= BENCH_DEMCR_TRCENA;
+    DWT_CYCCNT_REG   = 0;
+    DWT_CTRL_REG    |= BENCH_DWT_CYCCNTENA;
+#endif
+
+    g_BenchOverhead = 0;
+    Bench_Time(&empty, &result);
+    g_BenchOverhead = result.min;
+}
+
+/*********************************************************************
+* Service Name: Bench_Measure
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Case - Benchmark case
+* Parameters (inout): None
+* Parameters (out): Result - min/max/mean cost per call, overhead removed
+* Return value: boolean - FALSE when the minimum is over the budget of the build
+* Description: Function to time BENCH_ITERATIONS calls of a case.
+**********************************************************************/
+boolean Bench_Measure(const Bench_CaseType *Case, Bench_ResultType *Result){
+
+    Bench_Time(Case, Result);
+
+    Result->min  = (Result->min  > g_BenchOverhead) ? (Result->min  - g_BenchOverhead) : 0;
+    Result->max  = (Result->max  > g_BenchOverhead) ? (Result->max  - g_BenchOverhead) : 0;
+    Result->mean = (Result->mean > g_BenchOverhead) ? (Result->mean - g_BenchOverhead) : 0;
+
+#if defined(HOST_SIMULATION) && defined(BENCH_HOST_NANOSECONDS)
+    Result->budget = BENCH_NO_BUDGET;   /*wall clock, informative only*/
+#elif defined(HOST_SIMULATION) && defined(BENCH_HOST_INSTRUCTIONS)
+    Result->budget = Case->instructionBudget;
+#elif defined(HOST_SIMULATION)
+    Result->budget = Case->hostBudget;
+#else
+    Result->budget = Case->targetBudget;
+#endif
+
+    return (Result->budget == BENCH_NO_BUDGET) || (Result->min <= Result->budget);
+}
+
+/*********************************************************************
+* Service Name: Bench_Run
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Cases - Case table / Count - Number of cases / PrintFunc - Output function
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Number of cases over budget
+* Description: Function to measure every case and print the results as one JSON object,
+*              to be compared between commits with tools/bench_compare.py.
+**********************************************************************/
+uint32 Bench_Run(const Bench_CaseType *Cases, uint32 Count, Bench_PrintFuncType PrintFunc){
+
+    uint32 failures = 0;
+    uint32 i;
+
+    PrintFunc("{\n  \"target\": \"" BENCH_TARGET_NAME "\",\n  \"unit\": \"" BENCH_UNIT_NAME "\",\n");
+    Bench_PrintField(PrintFunc, "  \"iterations\": ", BENCH_ITERATIONS);
+    Bench_PrintField(PrintFunc, ",\n  \"overhead\": ", g_BenchOverhead);
+    PrintFunc(",\n  \"results\": [\n");
+
+    for(i = 0; i < Count; i++){
+
+        Bench_ResultType result;
+        boolean pass = Bench_Measure(&Cases[i], &result);
+
+        if(!pass){
+            failures++;
+        }
+
+        PrintFunc("    { \"name\": \"");
+        PrintFunc(Cases[i].name);
+        Bench_PrintField(PrintFunc, "\", \"min\": ", result.min);
+        Bench_PrintField(PrintFunc, ", \"max\": ", result.max);
+        Bench_PrintField(PrintFunc, ", \"mean\": ", result.mean);
+        if(result.budget == BENCH_NO_BUDGET){
+            PrintFunc(", \"budget\": null");
+        }
+        else{
+            Bench_PrintField(PrintFunc, ", \"budget\": ", result.budget);
+        }
+        PrintFunc(pass ? ", \"status\": \"pass\" }" : ", \"status\": \"over_budget\" }");
+        PrintFunc((i + 1 < Count) ? ",\n" : "\n");
+    }
+
+    Bench_PrintField(PrintFunc, "  ],\n  \"failures\": ", failures);
+    PrintFunc("\n}\n");
+
+    return failures;
+}
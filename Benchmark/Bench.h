@@ -0,0 +1,163 @@
+/******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: Bench.h
+ *
+ * Description: Header file for the driver micro-benchmark harness. Runs on target
+ *              with the DWT cycle counter or natively on the host simulation
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Timed calls per case, the minimum is compared with the budget */
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS                     32
+#endif
+
+/*
+ * Cost unit of the build:
+ *  - target: core cycles read from DWT CYCCNT
+ *  - host:   register bus accesses counted by HostRegisters.c, deterministic. A
+ *            read costs 1 and a write 2: the register file can not tell a store
+ *            from a read-modify-write, every write is charged as one, the target
+ *            cycles tell them apart
+ *  - host with BENCH_HOST_INSTRUCTIONS: x86-64 instructions single-stepped with
+ *            the trap flag, deterministic, for the work of code that touches no
+ *            register (MemPool, DSP, the RAM shadows)
+ *  - host with BENCH_HOST_NANOSECONDS: wall clock nanoseconds, to compare code
+ *            that touches no register (MemPool against malloc), no budgets
+ */
+#if defined(HOST_SIMULATION) && defined(BENCH_HOST_NANOSECONDS)
+#define BENCH_TARGET_NAME                    "host"
+#define BENCH_UNIT_NAME                      "ns"
+#elif defined(HOST_SIMULATION) && defined(BENCH_HOST_INSTRUCTIONS)
+#define BENCH_TARGET_NAME                    "host"
+#define BENCH_UNIT_NAME                      "instructions"
+#elif defined(HOST_SIMULATION)
+#define BENCH_TARGET_NAME                    "host"
+#define BENCH_UNIT_NAME                      "bus_accesses"
+#else
+#define BENCH_TARGET_NAME                    "tm4c123gh6pm"
+#define BENCH_UNIT_NAME                      "cycles"
+#endif
+
+/* Host cost of a register read and of a register write, a read-modify-write pays both */
+#define BENCH_HOST_READ_COST                 1
+#define BENCH_HOST_WRITE_COST                2
+
+/* x86-64 EFLAGS trap flag, a debug exception after every instruction */
+#define BENCH_HOST_TRAP_FLAG                 0x00000100
+
+/* DWT cycle counter enable */
+#define BENCH_DEMCR_TRCENA                   0x01000000
+#define BENCH_DWT_CYCCNTENA                  0x00000001
+
+/* Budget value that disables the check of a case */
+#define BENCH_NO_BUDGET                      0xFFFFFFFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef void (*Bench_FuncType)(void);
+
+/* Output function, writes one null terminated string */
+typedef void (*Bench_PrintFuncType)(const char *String);
+
+/* One benchmarked call, setup and teardown run around it untimed (may be NULL_PTR) */
+typedef struct
+{
+    const char *name;
+    Bench_FuncType setup;
+    Bench_FuncType run;
+    Bench_FuncType teardown;
+    uint32 hostBudget;          /* bus accesses per call       */
+    uint32 instructionBudget;   /* host instructions per call  */
+    uint32 targetBudget;        /* cycles per call             */
+} Bench_CaseType;
+
+typedef struct
+{
+    uint32 min;
+    uint32 max;
+    uint32 mean;
+    uint32 budget;
+} Bench_ResultType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Bench_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start the DWT cycle counter on target, or reset the
+*              simulated register file (and catch the single-step trap) on the host.
+**********************************************************************/
+
+void Bench_Init(void);
+
+/*********************************************************************
+* Service Name: Bench_Measure
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Case - Benchmark case
+* Parameters (inout): None
+* Parameters (out): Result - min/max/mean cost per call, overhead removed
+* Return value: boolean - FALSE when the minimum is over the budget of the build
+* Description: Function to time BENCH_ITERATIONS calls of a case.
+**********************************************************************/
+
+boolean Bench_Measure(const Bench_CaseType *Case, Bench_ResultType *Result);
+
+/*********************************************************************
+* Service Name: Bench_Run
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Cases - Case table / Count - Number of cases / PrintFunc - Output function
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Number of cases over budget
+* Description: Function to measure every case and print the results as one JSON object,
+*              to be compared between commits with tools/bench_compare.py.
+**********************************************************************/
+
+uint32 Bench_Run(const Bench_CaseType *Cases, uint32 Count, Bench_PrintFuncType PrintFunc);
+
+/*********************************************************************
+* Service Name: Bench_GetCases
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): Count - Number of cases
+* Return value: Pointer to the driver case table (Bench_Cases.c)
+* Description: Function to get the cases of every driver API.
+**********************************************************************/
+
+const Bench_CaseType *Bench_GetCases(uint32 *Count);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,573 @@
+/******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: Bench_Cases.c
+ *
+ * Description: Benchmark cases of every public driver API with their cost budgets.
+ *              A new driver adds its wrappers and a block of table entries here
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Bench.h"
+#include "NVIC.h"
+#include "SysTick.h"
+#include "GPTM.h"
+#include "ADC.h"
+#include "PWM.h"
+#include "SSI.h"
+#include "I2C.h"
+#include "CAN.h"
+#include "QEI.h"
+#include "Watchdog.h"
+#include "EEPROM.h"
+#include "Hibernate.h"
+#include "Clock.h"
+#include "MemPool.h"
+#include "Caps.h"
+#include "DSP.h"
+
+#ifdef HOST_SIMULATION
+#include <stdlib.h>
+#endif
+
+/*
+ * Budgets are the minimum cost per call:
+ *  - host:   register bus accesses, a read costs 1 and a write 2, so a read-modify-write
+ *            (3) is over the budget of a single store (2). Exact, any extra register
+ *            read or write fails the run. 0 for the calls that must stay off the bus (handlers, RAM
+ *            shadows, snapshots, MemPool, DSP)
+ *  - instr:  host instructions, the gcc -O2 count plus 25 %, so the work of the
+ *            calls that touch no register is held as well
+ *  - target: core cycles, upper bounds estimated from the instruction sequence,
+ *            tighten them from the JSON of a board run
+ */
+
+/*******************************************************************************
+ *                                    NVIC                                     *
+ *******************************************************************************/
+static void Bench_NVIC_EnableIRQ(void){
+    NVIC_EnableIRQ(NVIC_UART0_IRQ);
+}
+
+static void Bench_NVIC_DisableIRQ(void){
+    NVIC_DisableIRQ(NVIC_UART0_IRQ);
+}
+
+/* One IRQ of every ENn/DISn register, a read-modify-write in any branch costs a read more */
+static void Bench_NVIC_EnableIRQBanks(void){
+    NVIC_EnableIRQ(NVIC_UART0_IRQ);
+    NVIC_EnableIRQ(NVIC_UART2_IRQ);
+    NVIC_EnableIRQ(NVIC_I2C2_IRQ);
+    NVIC_EnableIRQ(NVIC_32_64_TIMER_1A_IRQ);
+    NVIC_EnableIRQ(NVIC_PWM1_GENERATOR0_IRQ);
+}
+
+static void Bench_NVIC_DisableIRQBanks(void){
+    NVIC_DisableIRQ(NVIC_UART0_IRQ);
+    NVIC_DisableIRQ(NVIC_UART2_IRQ);
+    NVIC_DisableIRQ(NVIC_I2C2_IRQ);
+    NVIC_DisableIRQ(NVIC_32_64_TIMER_1A_IRQ);
+    NVIC_DisableIRQ(NVIC_PWM1_GENERATOR0_IRQ);
+}
+
+static void Bench_NVIC_SetPriorityIRQ(void){
+    NVIC_SetPriorityIRQ(NVIC_UART0_IRQ, 3);
+}
+
+static void Bench_NVIC_EnableException(void){
+    NVIC_EnableException(EXCEPTION_BUS_FAULT_TYPE);
+}
+
+static void Bench_NVIC_DisableException(void){
+    NVIC_DisableException(EXCEPTION_BUS_FAULT_TYPE);
+}
+
+static void Bench_NVIC_SetPriorityException(void){
+    NVIC_SetPriorityException(EXCEPTION_SYSTICK_TYPE, 3);
+}
+
+/*******************************************************************************
+ *                                   SysTick                                   *
+ *******************************************************************************/
+static void Bench_SysTick_CallBack(void){
+}
+
+static void Bench_SysTick_Init(void){
+    SysTick_Init(1);
+}
+
+static void Bench_SysTick_Handler(void){
+    SysTick_Handler();
+}
+
+static void Bench_SysTick_SetCallBack(void){
+    SysTick_SetCallBack(Bench_SysTick_CallBack);
+}
+
+static void Bench_SysTick_ClearCallBack(void){
+    SysTick_SetCallBack(NULL_PTR);
+}
+
+static void Bench_SysTick_Stop(void){
+    SysTick_Stop();
+}
+
+static void Bench_SysTick_Start(void){
+    SysTick_Start();
+}
+
+static void Bench_SysTick_DeInit(void){
+    SysTick_DeInit();
+}
+
+/*******************************************************************************
+ *                                    GPTM                                     *
+ *******************************************************************************/
+static void Bench_GPTM_Init(void){
+    const GPTM_ConfigType config = { GPTM_TIMER0, GPTM_HALF_A, GPTM_MODE_PERIODIC, GPTM_EDGE_RISING, 16000, TRUE };
+    (void)GPTM_Init(&config);
+}
+
+static void Bench_GPTM_Init64(void){
+    const GPTM_ConfigType config = { GPTM_WTIMER0, GPTM_HALF_A, GPTM_MODE_CONCATENATED_PERIODIC, GPTM_EDGE_RISING, 0x100000000ULL, FALSE };
+    (void)GPTM_Init(&config);
+}
+
+static void Bench_GPTM_Start(void){
+    GPTM_Start(GPTM_TIMER0, GPTM_HALF_A);
+}
+
+static void Bench_GPTM_Stop(void){
+    GPTM_Stop(GPTM_TIMER0, GPTM_HALF_A);
+}
+
+static void Bench_GPTM_GetValue64(void){
+    (void)GPTM_GetValue64(GPTM_WTIMER0);
+}
+
+static void Bench_GPTM_GetCapture(void){
+    (void)GPTM_GetCapture(GPTM_TIMER0, GPTM_HALF_A);
+}
+
+static void Bench_GPTM_Handler(void){
+    GPTM_Handler(GPTM_TIMER0, GPTM_HALF_A);
+}
+
+/*******************************************************************************
+ *                                     ADC                                     *
+ *******************************************************************************/
+static const ADC_SequenceConfigType g_BenchAdcSequence =
+{
+    ADC_MODULE0, ADC_SEQUENCER0, ADC_TRIGGER_TIMER, 0, 4, { 0, 1, 2, ADC_INPUT_TEMP }, FALSE
+};
+
+static void Bench_ADC_Init(void){
+    ADC_Init(ADC_MODULE0, ADC_RATE_1MSPS, ADC_AVERAGE_4X);
+}
+
+static void Bench_ADC_EncodeSequence(void){
+    ADC_SequenceRegsType regs;
+    (void)ADC_EncodeSequence(&g_BenchAdcSequence, &regs);
+}
+
+static void Bench_ADC_ConfigureSequence(void){
+    (void)ADC_ConfigureSequence(&g_BenchAdcSequence);
+}
+
+static void Bench_ADC_Trigger(void){
+    ADC_Trigger(ADC_MODULE0, ADC_SEQUENCER0);
+}
+
+/*******************************************************************************
+ *                                     PWM                                     *
+ *******************************************************************************/
+static const PWM_GeneratorConfigType g_BenchPwmPhase =
+{
+    PWM_MODULE0, PWM_GENERATOR0, PWM_COUNT_UP_DOWN, 2000, TRUE, 40, 40,
+    PWM_FAULT_INPUT(0), PWM_FAULT_INPUT(0), TRUE, 0x0, TRUE, PWM_ADC_TRIGGER_ZERO
+};
+
+static void Bench_PWM_Init(void){
+    PWM_Init(PWM_MODULE0, PWM_DIV_2);
+}
+
+static void Bench_PWM_ConfigureGenerator(void){
+    (void)PWM_ConfigureGenerator(&g_BenchPwmPhase);
+}
+
+static void Bench_PWM_SetDuty(void){
+    PWM_SetDuty(PWM_MODULE0, PWM_OUTPUT_A(PWM_GENERATOR0), 700);
+}
+
+/* Three half bridges on generators 0 ... 2, applied together at the next zero */
+static void Bench_PWM_ThreePhase(void){
+    PWM_SetDuty(PWM_MODULE0, PWM_OUTPUT_A(PWM_GENERATOR0), 700);
+    PWM_SetDuty(PWM_MODULE0, PWM_OUTPUT_A(PWM_GENERATOR1), 1000);
+    PWM_SetDuty(PWM_MODULE0, PWM_OUTPUT_A(PWM_GENERATOR2), 1300);
+    PWM_Commit(PWM_MODULE0, PWM_GEN_MASK(0) | PWM_GEN_MASK(1) | PWM_GEN_MASK(2));
+}
+
+static void Bench_PWM_Handler(void){
+    PWM_Handler(PWM_MODULE0, PWM_GENERATOR0);
+}
+
+/*******************************************************************************
+ *                                     SSI                                     *
+ *******************************************************************************/
+static const SSI_DeviceType g_BenchSsiFlash = { 0x40004000, 0x08, SSI_MODE0, 2, 0 };     /* PA3 */
+static const uint8 g_BenchSsiCommand[4] = { 0x03, 0x00, 0x10, 0x00 };
+static SSI_TransactionType g_BenchSsiTransaction =
+{
+    &g_BenchSsiFlash, g_BenchSsiCommand, NULL_PTR, 4, FALSE, NULL_PTR, SSI_TRANSACTION_IDLE, NULL_PTR
+};
+
+static void Bench_SSI_Init(void){
+    SSI_Init(SSI_MODULE0, NULL_PTR);
+    g_BenchSsiTransaction.state = SSI_TRANSACTION_IDLE;
+}
+
+static void Bench_SSI_Submit(void){
+    (void)SSI_Submit(SSI_MODULE0, &g_BenchSsiTransaction);
+}
+
+/*******************************************************************************
+ *                                     I2C                                     *
+ *******************************************************************************/
+static const uint8 g_BenchI2cRegister[1] = { 0x00 };
+static uint8 g_BenchI2cTemperature[2];
+static const I2C_TransferType g_BenchI2cTransfer[1] =
+{
+    { 0x48, g_BenchI2cRegister, 1, g_BenchI2cTemperature, 2 }
+};
+static I2C_JobType g_BenchI2cJob =
+{
+    g_BenchI2cTransfer, 1, NULL_PTR, I2C_JOB_IDLE, I2C_OK, 0, NULL_PTR
+};
+
+static void Bench_I2C_Init(void){
+    I2C_Init(I2C_MODULE0, 16000000, I2C_SPEED_FAST);
+    g_BenchI2cJob.state = I2C_JOB_IDLE;
+}
+
+static void Bench_I2C_Submit(void){
+    (void)I2C_Submit(I2C_MODULE0, &g_BenchI2cJob);
+}
+
+/*******************************************************************************
+ *                                     CAN                                     *
+ *******************************************************************************/
+static const CAN_FrameType g_BenchCanFrame = { 0x123, 0, 8, 0, { 1, 2, 3, 4, 5, 6, 7, 8 } };
+
+static void Bench_CAN_Init(void){
+    (void)CAN_Init(CAN_MODULE0, 16000000, 500000);
+}
+
+static void Bench_CAN_Send(void){
+    (void)CAN_Send(CAN_MODULE0, &g_BenchCanFrame);
+}
+
+static void Bench_CAN_Handler(void){
+    CAN_Handler(CAN_MODULE0);
+}
+
+/*******************************************************************************
+ *                                     QEI                                     *
+ *******************************************************************************/
+static const QEI_ConfigType g_BenchQeiConfig =
+{
+    QEI_MODULE0, 16000000, QEI_COUNTS_PER_REV(1000) - 1, QEI_INDEX_RESET, FALSE, 16000, QEI_VELOCITY_DIV_1
+};
+
+static void Bench_QEI_Init(void){
+    (void)QEI_Init(&g_BenchQeiConfig);
+}
+
+static void Bench_QEI_GetSnapshot(void){
+
+    QEI_SnapshotType snapshot;
+
+    QEI_GetSnapshot(QEI_MODULE0, &snapshot);
+}
+
+static void Bench_QEI_GetPosition(void){
+    (void)QEI_GetPosition(QEI_MODULE0);
+}
+
+/*******************************************************************************
+ *                                  Watchdog                                   *
+ *******************************************************************************/
+static const Watchdog_ConfigType g_BenchWatchdogConfig = { WATCHDOG_MODULE0, 16000000, 1, FALSE };
+
+static uint32 g_BenchWatchdogTask;
+
+/* One tick per window, the task alive: every Watchdog_Tick kicks */
+static void Bench_Watchdog_Init(void){
+    (void)Watchdog_Init(&g_BenchWatchdogConfig);
+    g_BenchWatchdogTask = Watchdog_Register();
+    Watchdog_Tick();
+    Watchdog_CheckIn(g_BenchWatchdogTask);
+}
+
+static void Bench_Watchdog_CheckIn(void){
+    Watchdog_CheckIn(g_BenchWatchdogTask);
+}
+
+static void Bench_Watchdog_Tick(void){
+    Watchdog_Tick();
+}
+
+/*******************************************************************************
+ *                                   EEPROM                                    *
+ *******************************************************************************/
+static const uint32 g_BenchEepromValue[4] = { 1, 2, 3, 4 };
+
+/* Boot load of the whole store into the shadow */
+static void Bench_EEPROM_Init(void){
+    (void)EEPROM_Init();
+}
+
+static void Bench_EEPROM_Record(void){
+    (void)EEPROM_Init();
+    (void)EEPROM_Set(0x10, g_BenchEepromValue, 4);
+}
+
+static void Bench_EEPROM_Get(void){
+
+    uint32 value[4];
+
+    (void)EEPROM_Get(0x10, value, 4);
+}
+
+static void Bench_EEPROM_Set(void){
+    (void)EEPROM_Set(0x10, g_BenchEepromValue, 4);
+}
+
+/*******************************************************************************
+ *                                  Hibernate                                  *
+ *******************************************************************************/
+static const Hibernate_ConfigType g_BenchHibernateConfig = { FALSE, FALSE };
+static const uint32 g_BenchHibernateState[4] = { 1, 2, 3, 4 };
+
+static void Bench_Hibernate_Save(void){
+    Hibernate_Init(&g_BenchHibernateConfig);
+    (void)Hibernate_Enter(5, g_BenchHibernateState, 4);
+}
+
+/* The start of main after a wake, reads only */
+static void Bench_Hibernate_Resume(void){
+
+    uint32 state[4];
+
+    (void)Hibernate_Resume(state, 4);
+}
+
+/* Nothing changed since the last save: no HIBDATA write, two WRC waits on the target */
+static void Bench_Hibernate_Enter(void){
+    (void)Hibernate_Enter(5, g_BenchHibernateState, 4);
+}
+
+/*******************************************************************************
+ *                                    Clock                                    *
+ *******************************************************************************/
+static void Bench_Clock_Init(void){
+    Clock_Init();
+}
+
+static void Bench_Clock_Request(void){
+    (void)Clock_Request(CLOCK_GPIOF);
+}
+
+static void Bench_Clock_Release(void){
+    (void)Clock_Release(CLOCK_GPIOF);
+}
+
+static void Bench_Clock_GetClocked(void){
+    Clock_PeripheralType list[8];
+    (void)Clock_GetClocked(list, 8);
+}
+
+/*******************************************************************************
+ *                                   MemPool                                   *
+ *******************************************************************************/
+MEMPOOL_DEFINE(g_BenchPool32, 32, 8);
+MEMPOOL_DEFINE(g_BenchPool64, 64, 8);
+MEMPOOL_DEFINE(g_BenchPool128, 128, 8);
+
+static MemPool_PoolType *const g_BenchPools[] = { &g_BenchPool32, &g_BenchPool64, &g_BenchPool128 };
+
+static void Bench_MemPool_Init(void){
+    (void)MemPool_Init(g_BenchPools, 3);
+}
+
+static void Bench_MemPool_AllocFromFreeTo(void){
+    MemPool_FreeTo(&g_BenchPool64, MemPool_AllocFrom(&g_BenchPool64));
+}
+
+/* 100 bytes, two classes are skipped before the 128 byte pool */
+static void Bench_MemPool_AllocFree(void){
+    (void)MemPool_Free(MemPool_Alloc(100));
+}
+
+#ifdef HOST_SIMULATION
+/* C library heap for comparison, there is no heap on target (HEAP_SIZE=0) */
+static void Bench_MallocFree(void){
+    void *volatile block = malloc(100);
+    free(block);
+}
+#endif
+
+/*******************************************************************************
+ *                                    Caps                                     *
+ *******************************************************************************/
+static void Bench_Caps_Read(void){
+    Caps_DumpType dump;
+    Caps_Read(&dump);
+}
+
+static void Bench_Caps_Discover(void){
+    (void)Caps_Discover();
+}
+
+static void Bench_Caps_IsPresent(void){
+    (void)Caps_IsPresent(CAPS_INDEX_UART, 3);
+}
+
+/*******************************************************************************
+ *                                     DSP                                     *
+ *******************************************************************************/
+#define BENCH_DSP_BLOCK            64
+#define BENCH_DSP_TAPS             32
+
+static sint16 g_BenchDspIn[BENCH_DSP_BLOCK];
+static sint16 g_BenchDspOut[BENCH_DSP_BLOCK];
+static sint16 g_BenchFirCoeffs[BENCH_DSP_TAPS];
+static sint16 g_BenchFirState[DSP_FIR_STATE_SIZE(BENCH_DSP_TAPS, BENCH_DSP_BLOCK)];
+static sint16 g_BenchBiquadState[DSP_BIQUAD_STATE_SIZE(2)];
+static DSP_FirType g_BenchFir;
+static DSP_BiquadType g_BenchBiquad;
+
+/* Two stage 4th order low pass at fs / 10 */
+static const sint16 g_BenchBiquadCoeffs[2 * DSP_BIQUAD_COEFFS] =
+{
+    1086, 2172, 1086, 24175, -11753,
+    1086, 2172, 1086, 24175, -11753
+};
+
+static void Bench_DSP_Init(void){
+
+    uint16 i;
+
+    for(i = 0; i < BENCH_DSP_BLOCK; i++){
+        g_BenchDspIn[i] = (sint16)((i * 2731) - 16384);
+    }
+    for(i = 0; i < BENCH_DSP_TAPS; i++){
+        g_BenchFirCoeffs[i] = (sint16)(32768 / BENCH_DSP_TAPS);
+    }
+
+    DSP_FirInit(&g_BenchFir, g_BenchFirCoeffs, BENCH_DSP_TAPS, g_BenchFirState, BENCH_DSP_BLOCK);
+    DSP_BiquadInit(&g_BenchBiquad, g_BenchBiquadCoeffs, 2, g_BenchBiquadState, 0);
+}
+
+static void Bench_DSP_Fir(void){
+    DSP_Fir(&g_BenchFir, g_BenchDspIn, g_BenchDspOut, BENCH_DSP_BLOCK);
+}
+
+static void Bench_DSP_FirDecimate(void){
+    DSP_FirDecimate(&g_BenchFir, g_BenchDspIn, g_BenchDspOut, BENCH_DSP_BLOCK, 4);
+}
+
+static void Bench_DSP_Biquad(void){
+    DSP_Biquad(&g_BenchBiquad, g_BenchDspIn, g_BenchDspOut, BENCH_DSP_BLOCK);
+}
+
+static void Bench_DSP_Stats(void){
+    DSP_StatsType stats;
+    DSP_Stats(g_BenchDspIn, BENCH_DSP_BLOCK, &stats);
+}
+
+static void Bench_DSP_AddSat(void){
+    DSP_AddSat(g_BenchDspIn, g_BenchDspIn, g_BenchDspOut, BENCH_DSP_BLOCK);
+}
+
+/* SysTick_StartBusyWait is left out, it blocks for a whole SysTick period */
+static const Bench_CaseType g_BenchCases[] =
+{
+    /* name                            setup                        run                               teardown                     host   instr  target */
+    { "NVIC_EnableIRQ",                NULL_PTR,                    Bench_NVIC_EnableIRQ,             Bench_NVIC_DisableIRQ,          2,    115,     16 },
+    { "NVIC_DisableIRQ",               Bench_NVIC_EnableIRQ,        Bench_NVIC_DisableIRQ,            NULL_PTR,                       2,    155,     16 },
+    { "NVIC_EnableIRQ every bank",     NULL_PTR,                    Bench_NVIC_EnableIRQBanks,        Bench_NVIC_DisableIRQBanks,    10,    610,     80 },
+    { "NVIC_DisableIRQ every bank",    Bench_NVIC_EnableIRQBanks,   Bench_NVIC_DisableIRQBanks,       NULL_PTR,                      10,    980,     80 },
+    { "NVIC_SetPriorityIRQ",           NULL_PTR,                    Bench_NVIC_SetPriorityIRQ,        NULL_PTR,                       3,    165,     24 },
+    { "NVIC_EnableException",          NULL_PTR,                    Bench_NVIC_EnableException,       Bench_NVIC_DisableException,    3,     90,     24 },
+    { "NVIC_DisableException",         NULL_PTR,                    Bench_NVIC_DisableException,      NULL_PTR,                       3,     90,     24 },
+    { "NVIC_SetPriorityException",     NULL_PTR,                    Bench_NVIC_SetPriorityException,  NULL_PTR,                       3,    165,     24 },
+    { "SysTick_Init",                  NULL_PTR,                    Bench_SysTick_Init,               Bench_SysTick_DeInit,           9,    350,     40 },
+    { "SysTick_Handler",               Bench_SysTick_ClearCallBack, Bench_SysTick_Handler,            NULL_PTR,                       0,      5,     12 },
+    { "SysTick_Handler+callback",      Bench_SysTick_SetCallBack,   Bench_SysTick_Handler,            Bench_SysTick_ClearCallBack,    0,      7,     20 },
+    { "SysTick_SetCallBack",           NULL_PTR,                    Bench_SysTick_SetCallBack,        Bench_SysTick_ClearCallBack,    0,      4,     12 },
+    { "SysTick_Stop",                  NULL_PTR,                    Bench_SysTick_Stop,               NULL_PTR,                       3,    110,     16 },
+    { "SysTick_Start",                 NULL_PTR,                    Bench_SysTick_Start,              Bench_SysTick_DeInit,           3,    110,     16 },
+    { "SysTick_DeInit",                NULL_PTR,                    Bench_SysTick_DeInit,             NULL_PTR,                       2,    105,     12 },
+    { "GPTM_Init",                     NULL_PTR,                    Bench_GPTM_Init,                  NULL_PTR,                      31,   1400,    120 },
+    { "GPTM_Init+concatenated64",      NULL_PTR,                    Bench_GPTM_Init64,                NULL_PTR,                      31,   1400,    120 },
+    { "GPTM_Start",                    Bench_GPTM_Init,             Bench_GPTM_Start,                 Bench_GPTM_Stop,                3,     90,     16 },
+    { "GPTM_Stop",                     NULL_PTR,                    Bench_GPTM_Stop,                  NULL_PTR,                       3,     90,     16 },
+    { "GPTM_GetValue64",               Bench_GPTM_Init64,           Bench_GPTM_GetValue64,            NULL_PTR,                       3,    300,     20 },
+    { "GPTM_GetCapture",               NULL_PTR,                    Bench_GPTM_GetCapture,            NULL_PTR,                       1,     90,     16 },
+    { "GPTM_Handler",                  NULL_PTR,                    Bench_GPTM_Handler,               NULL_PTR,                       2,    100,     24 },
+    { "ADC_EncodeSequence",            NULL_PTR,                    Bench_ADC_EncodeSequence,         NULL_PTR,                       0,    120,     80 },
+    { "ADC_ConfigureSequence",         Bench_ADC_Init,              Bench_ADC_ConfigureSequence,      NULL_PTR,                      21,    940,    180 },
+    { "ADC_Trigger",                   NULL_PTR,                    Bench_ADC_Trigger,                NULL_PTR,                       2,     85,     16 },
+    { "PWM_ConfigureGenerator",        Bench_PWM_Init,              Bench_PWM_ConfigureGenerator,     NULL_PTR,                      49,   2000,    300 },
+    { "PWM_SetDuty",                   NULL_PTR,                    Bench_PWM_SetDuty,                NULL_PTR,                       2,    105,     20 },
+    { "PWM_SetDuty*3+Commit",          NULL_PTR,                    Bench_PWM_ThreePhase,             NULL_PTR,                       8,    400,     70 },
+    { "PWM_Handler",                   NULL_PTR,                    Bench_PWM_Handler,                NULL_PTR,                       3,    165,     30 },
+    { "SSI_Submit/4+start",            Bench_SSI_Init,              Bench_SSI_Submit,                 NULL_PTR,                      15,    990,    160 },
+    { "I2C_Submit+start",              Bench_I2C_Init,              Bench_I2C_Submit,                 NULL_PTR,                       6,    320,     90 },
+    { "CAN_Send",                      Bench_CAN_Init,              Bench_CAN_Send,                   NULL_PTR,                      21,    910,    150 },
+    { "CAN_Handler/idle",              NULL_PTR,                    Bench_CAN_Handler,                NULL_PTR,                       1,    110,     20 },
+    { "QEI_GetSnapshot",               Bench_QEI_Init,              Bench_QEI_GetSnapshot,            NULL_PTR,                       0,     50,     40 },
+    { "QEI_GetPosition",               NULL_PTR,                    Bench_QEI_GetPosition,            NULL_PTR,                       1,     80,     12 },
+    { "Watchdog_CheckIn",              Bench_Watchdog_Init,         Bench_Watchdog_CheckIn,           NULL_PTR,                       0,      7,     20 },
+    { "Watchdog_Tick+kick",            Bench_Watchdog_Init,         Bench_Watchdog_Tick,              NULL_PTR,                       2,    105,     40 },
+    { "EEPROM_Init/boot",              NULL_PTR,                    Bench_EEPROM_Init,                NULL_PTR,                     318,  22600,   4000 },
+    { "EEPROM_Get",                    Bench_EEPROM_Record,         Bench_EEPROM_Get,                 NULL_PTR,                       0,     70,     60 },
+    { "EEPROM_Set+commit",             Bench_EEPROM_Init,           Bench_EEPROM_Set,                 NULL_PTR,                       6,    990,    250 },
+    { "Hibernate_Resume",              Bench_Hibernate_Save,        Bench_Hibernate_Resume,           NULL_PTR,                      17,   1400,     60 },
+    { "Hibernate_Enter/unchanged",     Bench_Hibernate_Save,        Bench_Hibernate_Enter,            NULL_PTR,                      14,    980,   3200 },
+    { "Clock_Request",                 Bench_Clock_Init,            Bench_Clock_Request,              Bench_Clock_Release,            7,    360,     60 },
+    { "Clock_Request+shared",          Bench_Clock_Request,         Bench_Clock_Request,              Bench_Clock_Init,               1,    110,     30 },
+    { "Clock_Release",                 Bench_Clock_Request,         Bench_Clock_Release,              NULL_PTR,                       9,    350,     50 },
+    { "Clock_GetClocked",              NULL_PTR,                    Bench_Clock_GetClocked,           NULL_PTR,                      16,   2100,    400 },
+    { "MemPool_AllocFrom+FreeTo",      Bench_MemPool_Init,          Bench_MemPool_AllocFromFreeTo,    NULL_PTR,                       0,     85,     90 },
+    { "MemPool_Alloc+Free",            Bench_MemPool_Init,          Bench_MemPool_AllocFree,          NULL_PTR,                       0,    180,    150 },
+    { "Caps_Read",                     NULL_PTR,                    Bench_Caps_Read,                  NULL_PTR,                      22,   1900,    200 },
+    { "Caps_IsPresent",                Bench_Caps_Discover,         Bench_Caps_IsPresent,             NULL_PTR,                       0,     35,     20 },
+    { "DSP_Fir/32taps/64",             Bench_DSP_Init,              Bench_DSP_Fir,                    NULL_PTR,                       0,  27700,   5000 },
+    { "DSP_FirDecimate/32taps/64:4",   Bench_DSP_Init,              Bench_DSP_FirDecimate,            NULL_PTR,                       0,   7000,   1400 },
+    { "DSP_Biquad/2stages/64",         Bench_DSP_Init,              Bench_DSP_Biquad,                 NULL_PTR,                       0,   6400,   2600 },
+    { "DSP_Stats/64",                  Bench_DSP_Init,              Bench_DSP_Stats,                  NULL_PTR,                       0,   1500,    700 },
+    { "DSP_AddSat/64",                 Bench_DSP_Init,              Bench_DSP_AddSat,                 NULL_PTR,                       0,   1400,    300 },
+#ifdef HOST_SIMULATION
+    { "malloc+free",                   NULL_PTR,                    Bench_MallocFree,                 NULL_PTR,                       0, BENCH_NO_BUDGET, BENCH_NO_BUDGET },
+#endif
+};
+
+/*********************************************************************
+* Service Name: Bench_GetCases
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): Count - Number of cases
+* Return value: Pointer to the driver case table (Bench_Cases.c)
+* Description: Function to get the cases of every driver API.
+**********************************************************************/
+const Bench_CaseType *Bench_GetCases(uint32 *Count){
+
+    *Count = sizeof(g_BenchCases) / sizeof(g_BenchCases[0]);
+
+    return g_BenchCases;
+}
@@ -0,0 +1,60 @@
+/******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: Bench_Main.c
+ *
+ * Description: Entry point of the driver micro-benchmark. The host build prints the
+ *              JSON report on stdout and exits with 1 when a case is over budget,
+ *              the target build leaves it in g_BenchOutput for the debugger
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Bench.h"
+
+#ifdef HOST_SIMULATION
+
+#include <stdio.h>
+
+static void Bench_Print(const char *String){
+
+    fputs(String, stdout);
+}
+
+#else
+
+#define BENCH_OUTPUT_SIZE          4096
+
+/* JSON report, read it with the debugger memory browser or a UART print function */
+char g_BenchOutput[BENCH_OUTPUT_SIZE];
+static uint32 g_BenchOutputLength = 0;
+volatile uint32 g_BenchFailures = 0;
+
+static void Bench_Print(const char *String){
+
+    while((*String != '\0') && (g_BenchOutputLength < (BENCH_OUTPUT_SIZE - 1))){
+        g_BenchOutput[g_BenchOutputLength++] = *String++;
+    }
+    g_BenchOutput[g_BenchOutputLength] = '\0';
+}
+
+#endif
+
+int main(void){
+
+    uint32 count;
+    const Bench_CaseType *cases = Bench_GetCases(&count);
+    uint32 failures;
+
+    Bench_Init();
+    failures = Bench_Run(cases, count, Bench_Print);
+
+#ifdef HOST_SIMULATION
+    return (failures == 0) ? 0 : 1;
+#else
+    g_BenchFailures = failures;
+    while(1){
+    }
+#endif
+}
@@ -0,0 +1,509 @@
+/******************************************************************************
+ *
+ * Module: CAN
+ *
+ * File Name: CAN.c
+ *
+ * Description: Source file for the TM4C123GH6PM CAN controller driver. Receive IDs
+ *              are filtered by the message objects in hardware, high rate IDs get a
+ *              FIFO of chained objects and accepted frames land in a frame ring read
+ *              in place by the application
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "CAN.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef __TI_ARM__
+#define CAN_ENTER_CRITICAL()       uint32 savedPrimask = _disable_IRQ()
+#define CAN_EXIT_CRITICAL()        _restore_interrupts(savedPrimask)
+#else
+#define CAN_ENTER_CRITICAL()
+#define CAN_EXIT_CRITICAL()
+#endif
+
+#if (CAN_RX_RING_SIZE & (CAN_RX_RING_SIZE - 1)) != 0
+#error "CAN_RX_RING_SIZE must be a power of two"
+#endif
+
+/* Interface register sets: IF1 for the thread side, IF2 for the handler */
+#define CAN_IF_THREAD                 0
+#define CAN_IF_HANDLER                1
+
+/* CANCTL */
+#define CAN_CTL_INIT                  0x01
+#define CAN_CTL_IE                    0x02
+#define CAN_CTL_EIE                   0x08
+#define CAN_CTL_CCE                   0x40
+
+#define CAN_STS_ERROR_STATE           (CAN_STATUS_ERROR_PASSIVE | CAN_STATUS_ERROR_WARNING | CAN_STATUS_BUS_OFF)
+
+/* CANINT, otherwise the number of the pending message object */
+#define CAN_INT_STATUS                0x8000
+#define CAN_INT_ID_MASK               0xFFFF
+
+/* Bit time of 16 quanta: sync 1, TSEG1 12, TSEG2 3, SJW 3 */
+#define CAN_TQ_PER_BIT                16u
+#define CAN_BIT_TSEG1                 12u
+#define CAN_BIT_TSEG2                 3u
+#define CAN_BIT_SJW                   3u
+#define CAN_BRP_MAX                   1024u
+
+/* CANIFnCRQ */
+#define CAN_IFCRQ_BUSY                0x8000
+
+/* CANIFnCMSK, NEWDAT is TXRQST on a write */
+#define CAN_IFCMSK_WRNRD              0x80
+#define CAN_IFCMSK_MASK               0x40
+#define CAN_IFCMSK_ARB                0x20
+#define CAN_IFCMSK_CONTROL            0x10
+#define CAN_IFCMSK_CLRINTPND          0x08
+#define CAN_IFCMSK_NEWDAT             0x04
+#define CAN_IFCMSK_TXRQST             0x04
+#define CAN_IFCMSK_DATAA              0x02
+#define CAN_IFCMSK_DATAB              0x01
+
+/* CANIFnMSK2 match the ID type and the direction, data frames only */
+#define CAN_IFMSK2_MXTD               0x8000
+#define CAN_IFMSK2_MDIR               0x4000
+
+/* CANIFnARB2, a standard ID is in bits 12:2, an extended one in 12:0 and ARB1 */
+#define CAN_IFARB2_MSGVAL             0x8000
+#define CAN_IFARB2_XTD                0x4000
+#define CAN_IFARB2_DIR                0x2000
+#define CAN_IFARB2_STD_POS            2
+
+/* CANIFnMCTL */
+#define CAN_IFMCTL_NEWDAT             0x8000
+#define CAN_IFMCTL_MSGLST             0x4000
+#define CAN_IFMCTL_INTPND             0x2000
+#define CAN_IFMCTL_UMASK              0x1000
+#define CAN_IFMCTL_RXIE               0x0400
+#define CAN_IFMCTL_EOB                0x0080
+#define CAN_IFMCTL_DLC                0x000F
+
+#define CAN_DATA_LENGTH_MAX           8
+
+typedef struct
+{
+    CAN_FrameType ring[CAN_RX_RING_SIZE];
+    volatile uint16 head;               /* next frame written by the handler            */
+    volatile uint16 tail;               /* oldest frame, moved by CAN_Release            */
+    uint32 dropped;
+    uint8 status;
+    uint8 objectFilter[CAN_RX_OBJECTS]; /* filter index of each receive object          */
+    void (*callBack)(void);
+}CAN_BusType;
+
+static const uint32 g_CanBase[CAN_NUMBER_OF_MODULES] = { CAN0_BASE, CAN1_BASE };
+
+static CAN_BusType g_CanBus[CAN_NUMBER_OF_MODULES];
+
+/* Move the interface registers to or from a message object */
+static void CAN_Transfer(uint32 Base, uint8 If, uint32 Object){
+
+    CAN_IFCRQ_REG(Base, If) = Object;
+    while(CAN_IFCRQ_REG(Base, If) & CAN_IFCRQ_BUSY){}
+}
+
+static void CAN_SetArbitration(uint32 Base, uint8 If, uint32 Id, boolean Extended, uint32 Flags){
+
+    if(Extended){
+        CAN_IFARB1_REG(Base, If) = Id & 0xFFFF;
+        CAN_IFARB2_REG(Base, If) = Flags | CAN_IFARB2_XTD | ((Id >> 16) & 0x1FFF);
+    }
+    else{
+        CAN_IFARB1_REG(Base, If) = 0;
+        CAN_IFARB2_REG(Base, If) = Flags | ((Id & 0x7FF) << CAN_IFARB2_STD_POS);
+    }
+}
+
+/* Clear the valid bit of a message object, dropping its pending frame */
+static void CAN_Invalidate(uint32 Base, uint32 Object){
+
+    CAN_IFCMSK_REG(Base, CAN_IF_THREAD) = CAN_IFCMSK_WRNRD | CAN_IFCMSK_ARB | CAN_IFCMSK_CONTROL;
+    CAN_IFARB1_REG(Base, CAN_IF_THREAD) = 0;
+    CAN_IFARB2_REG(Base, CAN_IF_THREAD) = 0;
+    CAN_IFMCTL_REG(Base, CAN_IF_THREAD) = 0;
+    CAN_Transfer(Base, CAN_IF_THREAD, Object);
+}
+
+/* Copy the new frame of a receive object into the ring, FALSE when it had none */
+static boolean CAN_ReadObject(CAN_BusType *Bus, uint32 Base, uint32 Object){
+
+    uint32 mctl;
+    uint16 next;
+
+    /* Reading NEWDAT and INTPND back clears them in the object */
+    CAN_IFCMSK_REG(Base, CAN_IF_HANDLER) = CAN_IFCMSK_ARB | CAN_IFCMSK_CONTROL | CAN_IFCMSK_CLRINTPND |
+                                           CAN_IFCMSK_NEWDAT | CAN_IFCMSK_DATAA | CAN_IFCMSK_DATAB;
+    CAN_Transfer(Base, CAN_IF_HANDLER, Object);
+
+    mctl = CAN_IFMCTL_REG(Base, CAN_IF_HANDLER);
+    if((Object > CAN_RX_OBJECTS) || !(mctl & CAN_IFMCTL_NEWDAT)){
+        return FALSE;
+    }
+
+    next = (uint16)((Bus->head + 1u) & (CAN_RX_RING_SIZE - 1u));
+    if(next == Bus->tail){
+        Bus->dropped++;
+    }
+    else{
+
+        CAN_FrameType *frame = &Bus->ring[Bus->head];
+        uint32 arb2 = CAN_IFARB2_REG(Base, CAN_IF_HANDLER);
+        uint32 data;
+
+        if(arb2 & CAN_IFARB2_XTD){
+            frame->id    = ((arb2 & 0x1FFF) << 16) | (CAN_IFARB1_REG(Base, CAN_IF_HANDLER) & 0xFFFF);
+            frame->flags = CAN_FRAME_EXTENDED;
+        }
+        else{
+            frame->id    = (arb2 >> CAN_IFARB2_STD_POS) & 0x7FF;
+            frame->flags = 0;
+        }
+        if(mctl & CAN_IFMCTL_MSGLST){
+            frame->flags |= CAN_FRAME_OVERRUN;
+        }
+
+        frame->length = (uint8)(mctl & CAN_IFMCTL_DLC);
+        if(frame->length > CAN_DATA_LENGTH_MAX){
+            frame->length = CAN_DATA_LENGTH_MAX;
+        }
+        frame->filter = Bus->objectFilter[Object - 1];
+
+        data = CAN_IFDA1_REG(Base, CAN_IF_HANDLER);
+        frame->data[0] = (uint8)data;
+        frame->data[1] = (uint8)(data >> 8);
+        data = CAN_IFDA2_REG(Base, CAN_IF_HANDLER);
+        frame->data[2] = (uint8)data;
+        frame->data[3] = (uint8)(data >> 8);
+        data = CAN_IFDB1_REG(Base, CAN_IF_HANDLER);
+        frame->data[4] = (uint8)data;
+        frame->data[5] = (uint8)(data >> 8);
+        data = CAN_IFDB2_REG(Base, CAN_IF_HANDLER);
+        frame->data[6] = (uint8)data;
+        frame->data[7] = (uint8)(data >> 8);
+
+        Bus->head = next;
+    }
+
+    /* The lost flag is only cleared by a write, a frame arriving in between is lost too */
+    if(mctl & CAN_IFMCTL_MSGLST){
+        CAN_IFCMSK_REG(Base, CAN_IF_HANDLER) = CAN_IFCMSK_WRNRD | CAN_IFCMSK_CONTROL;
+        CAN_IFMCTL_REG(Base, CAN_IF_HANDLER) = mctl & ~(CAN_IFMCTL_NEWDAT | CAN_IFMCTL_MSGLST | CAN_IFMCTL_INTPND);
+        CAN_Transfer(Base, CAN_IF_HANDLER, Object);
+    }
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: CAN_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module / Clock - System clock in Hz / BitRate - Bits
+*                  per second
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when Clock is not a multiple of 16 bit times in range
+* Description: Function to clock the module, set 16 time quanta per bit with the
+*              sample point at 81%, invalidate every message object, empty the ring
+*              and join the bus. No frame is received before CAN_SetFilters. The CAN
+*              pins and the NVIC line are configured by the application.
+**********************************************************************/
+boolean CAN_Init(CAN_ModuleType Module, uint32 Clock, uint32 BitRate){
+
+    CAN_BusType *bus = &g_CanBus[Module];
+    uint32 base = g_CanBase[Module];
+    uint32 brp;
+    uint32 object;
+
+    if(BitRate == 0){
+        return FALSE;
+    }
+    brp = Clock / (BitRate * CAN_TQ_PER_BIT);
+    if((brp == 0) || (brp > CAN_BRP_MAX) || ((brp * BitRate * CAN_TQ_PER_BIT) != Clock)){
+        return FALSE;
+    }
+
+    SYSCTL_RCGCCAN_REG |= (1u << Module);
+    SYSCTL_SCGCCAN_REG |= (1u << Module);
+    SYSCTL_DCGCCAN_REG |= (1u << Module);
+    while(!(SYSCTL_PRCAN_REG & (1u << Module))){}
+
+    /* Bit timing is written with the module off the bus */
+    CAN_CTL_REG(base)  = CAN_CTL_INIT | CAN_CTL_CCE;
+    CAN_BIT_REG(base)  = ((CAN_BIT_TSEG2 - 1u) << 12) | ((CAN_BIT_TSEG1 - 1u) << 8) |
+                         ((CAN_BIT_SJW - 1u) << 6) | ((brp - 1u) & 0x3F);
+    CAN_BRPE_REG(base) = (brp - 1u) >> 6;
+
+    for(object = 1; object <= CAN_NUMBER_OF_OBJECTS; object++){
+        CAN_Invalidate(base, object);
+    }
+
+    bus->head     = 0;
+    bus->tail     = 0;
+    bus->dropped  = 0;
+    bus->status   = 0;
+    bus->callBack = NULL_PTR;
+
+    /* Message object and error state interrupts, no status interrupt per frame */
+    CAN_CTL_REG(base) = CAN_CTL_IE | CAN_CTL_EIE;
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: CAN_SetFilters
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module / Filters - Filters in priority order /
+*                  Count - Number of filters
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the filters need more than CAN_RX_OBJECTS objects
+* Description: Function to program the receive message objects from the first one
+*              on, the objects left over are disabled. Frames matching no filter are
+*              dropped by the controller without an interrupt.
+**********************************************************************/
+boolean CAN_SetFilters(CAN_ModuleType Module, const CAN_FilterType *Filters, uint8 Count){
+
+    CAN_BusType *bus = &g_CanBus[Module];
+    uint32 base = g_CanBase[Module];
+    uint32 objects = 0;
+    uint32 object = 1;
+    uint8 i;
+    uint8 k;
+
+    for(i = 0; i < Count; i++){
+        if(Filters[i].depth == 0){
+            return FALSE;
+        }
+        objects += Filters[i].depth;
+    }
+    if(objects > CAN_RX_OBJECTS){
+        return FALSE;
+    }
+
+    for(i = 0; i < Count; i++){
+
+        const CAN_FilterType *filter = &Filters[i];
+
+        /* A chain fills its objects in order, the last one ends it */
+        for(k = 0; k < filter->depth; k++){
+
+            CAN_ENTER_CRITICAL();
+
+            CAN_IFCMSK_REG(base, CAN_IF_THREAD) = CAN_IFCMSK_WRNRD | CAN_IFCMSK_MASK | CAN_IFCMSK_ARB | CAN_IFCMSK_CONTROL;
+            if(filter->extended){
+                CAN_IFMSK1_REG(base, CAN_IF_THREAD) = filter->mask & 0xFFFF;
+                CAN_IFMSK2_REG(base, CAN_IF_THREAD) = CAN_IFMSK2_MXTD | CAN_IFMSK2_MDIR | ((filter->mask >> 16) & 0x1FFF);
+            }
+            else{
+                CAN_IFMSK1_REG(base, CAN_IF_THREAD) = 0;
+                CAN_IFMSK2_REG(base, CAN_IF_THREAD) = CAN_IFMSK2_MXTD | CAN_IFMSK2_MDIR |
+                                                      ((filter->mask & 0x7FF) << CAN_IFARB2_STD_POS);
+            }
+            CAN_SetArbitration(base, CAN_IF_THREAD, filter->id, filter->extended, CAN_IFARB2_MSGVAL);
+            CAN_IFMCTL_REG(base, CAN_IF_THREAD) = CAN_IFMCTL_UMASK | CAN_IFMCTL_RXIE |
+                                                  (((k + 1u) == filter->depth) ? CAN_IFMCTL_EOB : 0);
+            CAN_Transfer(base, CAN_IF_THREAD, object);
+
+            CAN_EXIT_CRITICAL();
+
+            bus->objectFilter[object - 1] = i;
+            object++;
+        }
+    }
+
+    for(; object <= CAN_RX_OBJECTS; object++){
+
+        CAN_ENTER_CRITICAL();
+        CAN_Invalidate(base, object);
+        CAN_EXIT_CRITICAL();
+    }
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: CAN_Send
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - CAN module / Frame - Frame to send
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE while every transmit object is still pending
+* Description: Function to hand a frame to a free transmit object, the controller
+*              sends it on its own.
+**********************************************************************/
+boolean CAN_Send(CAN_ModuleType Module, const CAN_FrameType *Frame){
+
+    uint32 base = g_CanBase[Module];
+    uint32 pending;
+    uint32 object;
+    boolean sent = FALSE;
+
+    if(Frame->length > CAN_DATA_LENGTH_MAX){
+        return FALSE;
+    }
+
+    {
+        CAN_ENTER_CRITICAL();
+
+        pending = CAN_TXRQ1_REG(base) | (CAN_TXRQ2_REG(base) << 16);
+        for(object = CAN_RX_OBJECTS + 1; object <= CAN_NUMBER_OF_OBJECTS; object++){
+            if(!(pending & (1u << (object - 1)))){
+                break;
+            }
+        }
+
+        if(object <= CAN_NUMBER_OF_OBJECTS){
+
+            CAN_IFCMSK_REG(base, CAN_IF_THREAD) = CAN_IFCMSK_WRNRD | CAN_IFCMSK_ARB | CAN_IFCMSK_CONTROL |
+                                                  CAN_IFCMSK_TXRQST | CAN_IFCMSK_DATAA | CAN_IFCMSK_DATAB;
+            CAN_SetArbitration(base, CAN_IF_THREAD, Frame->id, (Frame->flags & CAN_FRAME_EXTENDED) ? TRUE : FALSE,
+                               CAN_IFARB2_MSGVAL | CAN_IFARB2_DIR);
+            CAN_IFMCTL_REG(base, CAN_IF_THREAD) = CAN_IFMCTL_EOB | Frame->length;
+            CAN_IFDA1_REG(base, CAN_IF_THREAD)  = Frame->data[0] | ((uint32)Frame->data[1] << 8);
+            CAN_IFDA2_REG(base, CAN_IF_THREAD)  = Frame->data[2] | ((uint32)Frame->data[3] << 8);
+            CAN_IFDB1_REG(base, CAN_IF_THREAD)  = Frame->data[4] | ((uint32)Frame->data[5] << 8);
+            CAN_IFDB2_REG(base, CAN_IF_THREAD)  = Frame->data[6] | ((uint32)Frame->data[7] << 8);
+            CAN_Transfer(base, CAN_IF_THREAD, object);
+            sent = TRUE;
+        }
+
+        CAN_EXIT_CRITICAL();
+    }
+
+    return sent;
+}
+
+/*********************************************************************
+* Service Name: CAN_Receive
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: const CAN_FrameType* - Oldest received frame, NULL_PTR when the ring is empty
+* Description: Function to read the oldest frame in place in the ring, it stays valid
+*              until CAN_Release.
+**********************************************************************/
+const CAN_FrameType *CAN_Receive(CAN_ModuleType Module){
+
+    CAN_BusType *bus = &g_CanBus[Module];
+
+    return (bus->tail == bus->head) ? NULL_PTR : &bus->ring[bus->tail];
+}
+
+/*********************************************************************
+* Service Name: CAN_Release
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to give the frame of the last CAN_Receive back to the ring.
+**********************************************************************/
+void CAN_Release(CAN_ModuleType Module){
+
+    CAN_BusType *bus = &g_CanBus[Module];
+
+    if(bus->tail != bus->head){
+        bus->tail = (uint16)((bus->tail + 1u) & (CAN_RX_RING_SIZE - 1u));
+    }
+}
+
+/*********************************************************************
+* Service Name: CAN_GetDropped
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Accepted frames dropped on a full ring since CAN_Init
+* Description: Function to read the ring overflow count.
+**********************************************************************/
+uint32 CAN_GetDropped(CAN_ModuleType Module){
+
+    return g_CanBus[Module].dropped;
+}
+
+/*********************************************************************
+* Service Name: CAN_GetStatus
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint8 - CAN_STATUS_xxx bits of the last error state change
+* Description: Function to read the error state of the module. After a bus off the
+*              module stays off the bus until CAN_Init.
+**********************************************************************/
+uint8 CAN_GetStatus(CAN_ModuleType Module){
+
+    return g_CanBus[Module].status;
+}
+
+/*********************************************************************
+* Service Name: CAN_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - CAN module / Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called by the handler once new frames
+*              are in the ring.
+**********************************************************************/
+void CAN_SetCallBack(CAN_ModuleType Module, void (*Ptr2Func)(void)){
+
+    g_CanBus[Module].callBack = Ptr2Func;
+}
+
+/*********************************************************************
+* Service Name: CAN_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to move the new frames of every pending receive object into
+*              the ring and track the error state. The vector table entries
+*              CAN_Can0_Handler and CAN_Can1_Handler call it.
+**********************************************************************/
+void CAN_Handler(CAN_ModuleType Module){
+
+    CAN_BusType *bus = &g_CanBus[Module];
+    uint32 base = g_CanBase[Module];
+    boolean received = FALSE;
+    uint32 pending;
+
+    /* The controller reports the lowest pending object first, a FIFO drains in order */
+    while((pending = (CAN_INT_REG(base) & CAN_INT_ID_MASK)) != 0){
+
+        if(pending == CAN_INT_STATUS){
+
+            /* Reading CANSTS acknowledges the status interrupt */
+            bus->status = (uint8)(CAN_STS_REG(base) & CAN_STS_ERROR_STATE);
+        }
+        else if(CAN_ReadObject(bus, base, pending)){
+            received = TRUE;
+        }
+    }
+
+    if(received && (bus->callBack != NULL_PTR)){
+        bus->callBack();
+    }
+}
+
+/* Vector table entries */
+#define CAN_DEFINE_HANDLER(Name, Module)            void CAN_##Name##_Handler(void){ CAN_Handler(Module); }
+
+CAN_DEFINE_HANDLER(Can0, CAN_MODULE0)
+CAN_DEFINE_HANDLER(Can1, CAN_MODULE1)
@@ -0,0 +1,228 @@
+/******************************************************************************
+ *
+ * Module: CAN
+ *
+ * File Name: CAN.h
+ *
+ * Description: Header file for the TM4C123GH6PM CAN controller driver. Receive IDs
+ *              are filtered by the message objects in hardware, high rate IDs get a
+ *              FIFO of chained objects and accepted frames land in a frame ring read
+ *              in place by the application
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef CAN_H_
+#define CAN_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define CAN_NUMBER_OF_MODULES                2
+#define CAN_NUMBER_OF_OBJECTS                32
+
+/* Message objects kept for transmission, the last ones so receive wins the priority */
+#ifndef CAN_TX_OBJECTS
+#define CAN_TX_OBJECTS                       4
+#endif
+
+#define CAN_RX_OBJECTS                       (CAN_NUMBER_OF_OBJECTS - CAN_TX_OBJECTS)
+
+/* Frames of the receive ring of a module, a power of two */
+#ifndef CAN_RX_RING_SIZE
+#define CAN_RX_RING_SIZE                     32
+#endif
+
+/* Frame flags */
+#define CAN_FRAME_EXTENDED                   0x01    /* 29-bit ID                          */
+#define CAN_FRAME_OVERRUN                    0x02    /* an older frame of the object was lost */
+
+/* Filter masks, 1 bits of the ID must match */
+#define CAN_MASK_STANDARD_EXACT              0x7FFu
+#define CAN_MASK_EXTENDED_EXACT              0x1FFFFFFFu
+
+/* Error state bits of CAN_GetStatus, those of CANSTS */
+#define CAN_STATUS_ERROR_PASSIVE             0x20
+#define CAN_STATUS_ERROR_WARNING             0x40
+#define CAN_STATUS_BUS_OFF                   0x80
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    CAN_MODULE0, CAN_MODULE1
+}CAN_ModuleType;
+
+typedef struct
+{
+    uint32 id;
+    uint8 flags;                        /* CAN_FRAME_EXTENDED, CAN_FRAME_OVERRUN        */
+    uint8 length;                       /* 0 ... 8                                      */
+    uint8 filter;                       /* index of the accepting filter, received only */
+    uint8 data[8];
+}CAN_FrameType;
+
+/*
+ * IDs accepted by one or a chain of message objects. A depth above 1 chains that many
+ * objects as a FIFO so a burst of the IDs is kept while the handler is late.
+ */
+typedef struct
+{
+    uint32 id;
+    uint32 mask;                        /* 1 bits must match, CAN_MASK_xxx_EXACT for one ID */
+    boolean extended;
+    uint8 depth;                        /* message objects, 1 ... CAN_RX_OBJECTS        */
+}CAN_FilterType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: CAN_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module / Clock - System clock in Hz / BitRate - Bits
+*                  per second
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when Clock is not a multiple of 16 bit times in range
+* Description: Function to clock the module, set 16 time quanta per bit with the
+*              sample point at 81%, invalidate every message object, empty the ring
+*              and join the bus. No frame is received before CAN_SetFilters. The CAN
+*              pins and the NVIC line are configured by the application.
+**********************************************************************/
+
+boolean CAN_Init(CAN_ModuleType Module, uint32 Clock, uint32 BitRate);
+
+/*********************************************************************
+* Service Name: CAN_SetFilters
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module / Filters - Filters in priority order /
+*                  Count - Number of filters
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the filters need more than CAN_RX_OBJECTS objects
+* Description: Function to program the receive message objects from the first one
+*              on, the objects left over are disabled. Frames matching no filter are
+*              dropped by the controller without an interrupt.
+**********************************************************************/
+
+boolean CAN_SetFilters(CAN_ModuleType Module, const CAN_FilterType *Filters, uint8 Count);
+
+/*********************************************************************
+* Service Name: CAN_Send
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - CAN module / Frame - Frame to send
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE while every transmit object is still pending
+* Description: Function to hand a frame to a free transmit object, the controller
+*              sends it on its own.
+**********************************************************************/
+
+boolean CAN_Send(CAN_ModuleType Module, const CAN_FrameType *Frame);
+
+/*********************************************************************
+* Service Name: CAN_Receive
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: const CAN_FrameType* - Oldest received frame, NULL_PTR when the ring is empty
+* Description: Function to read the oldest frame in place in the ring, it stays valid
+*              until CAN_Release.
+**********************************************************************/
+
+const CAN_FrameType *CAN_Receive(CAN_ModuleType Module);
+
+/*********************************************************************
+* Service Name: CAN_Release
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to give the frame of the last CAN_Receive back to the ring.
+**********************************************************************/
+
+void CAN_Release(CAN_ModuleType Module);
+
+/*********************************************************************
+* Service Name: CAN_GetDropped
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Accepted frames dropped on a full ring since CAN_Init
+* Description: Function to read the ring overflow count.
+**********************************************************************/
+
+uint32 CAN_GetDropped(CAN_ModuleType Module);
+
+/*********************************************************************
+* Service Name: CAN_GetStatus
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint8 - CAN_STATUS_xxx bits of the last error state change
+* Description: Function to read the error state of the module. After a bus off the
+*              module stays off the bus until CAN_Init.
+**********************************************************************/
+
+uint8 CAN_GetStatus(CAN_ModuleType Module);
+
+/*********************************************************************
+* Service Name: CAN_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - CAN module / Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called by the handler once new frames
+*              are in the ring.
+**********************************************************************/
+
+void CAN_SetCallBack(CAN_ModuleType Module, void (*Ptr2Func)(void));
+
+/*********************************************************************
+* Service Name: CAN_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - CAN module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to move the new frames of every pending receive object into
+*              the ring and track the error state. The vector table entries
+*              CAN_Can0_Handler and CAN_Can1_Handler call it.
+**********************************************************************/
+
+void CAN_Handler(CAN_ModuleType Module);
+
+/* Vector table entries, one per NVIC_CANn_IRQ */
+void CAN_Can0_Handler(void);
+void CAN_Can1_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* CAN_H_ */
@@ -0,0 +1,166 @@
+/******************************************************************************
+ *
+ * Module: Caps
+ *
+ * File Name: Caps.c
+ *
+ * Description: Source file for the peripheral capability discovery. Reads the device
+ *              identification (DID0/DID1), device capabilities (DCn) and peripheral
+ *              present (PPxxx) registers once into a cached capability bitmap, so the
+ *              drivers validate instance and channel numbers at init only
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Caps.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* DID1 PINCNT to pins */
+static const uint8 g_CapsPinCount[8] = { 0, 0, 100, 64, 144, 157, 168, 0 };
+
+static Caps_Type g_Caps;
+static boolean g_CapsDiscovered = FALSE;
+
+/*********************************************************************
+* Service Name: Caps_Read
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): Dump - Register values
+* Return value: None
+* Description: Function to read the identification, capability and peripheral present
+*              registers of the part. The reserved PPxxx indexes are not accessed.
+**********************************************************************/
+void Caps_Read(Caps_DumpType *Dump){
+
+    uint8 index;
+
+    Dump->did0 = SYSCTL_DID0_REG;
+    Dump->did1 = SYSCTL_DID1_REG;
+    Dump->dc0  = SYSCTL_DC0_REG;
+    Dump->dc7  = SYSCTL_DC7_REG;
+    Dump->dc8  = SYSCTL_DC8_REG;
+    Dump->dc9  = SYSCTL_DC9_REG;
+
+    for(index = 0; index < CAPS_NUMBER_OF_INDEXES; index++){
+        Dump->pp[index] = (CAPS_PP_INDEXES & (1u << index)) ? SYSCTL_PP_REG(index) : 0;
+    }
+}
+
+/*********************************************************************
+* Service Name: Caps_Decode
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Dump - Register values, from Caps_Read or a recorded dump
+* Parameters (inout): None
+* Parameters (out): Caps - Capabilities
+* Return value: None
+* Description: Function to decode the registers, without any register access.
+**********************************************************************/
+void Caps_Decode(const Caps_DumpType *Dump, Caps_Type *Caps){
+
+    uint8 index;
+
+    Caps->deviceClass = CAPS_DID0_CLASS(Dump->did0);
+    Caps->major       = CAPS_DID0_MAJOR(Dump->did0);
+    Caps->minor       = CAPS_DID0_MINOR(Dump->did0);
+    Caps->partNumber  = CAPS_DID1_PARTNO(Dump->did1);
+    Caps->pinCount    = g_CapsPinCount[CAPS_DID1_PINCNT(Dump->did1)];
+    Caps->flashKB     = (uint16)CAPS_DC0_FLASH_KB(Dump->dc0);
+    Caps->sramKB      = (uint16)CAPS_DC0_SRAM_KB(Dump->dc0);
+
+    /* An instance has at most 8 bits (UART0..7), the upper PPxxx bits are reserved */
+    for(index = 0; index < CAPS_NUMBER_OF_INDEXES; index++){
+        Caps->present[index] = (CAPS_PP_INDEXES & (1u << index)) ? (uint8)Dump->pp[index] : 0;
+    }
+
+    /* Channels of a missing module are dropped even if DCn lists them */
+    Caps->adcChannels[0]    = (Dump->pp[CAPS_INDEX_ADC] & 0x1) ? (uint16)Dump->dc8 : 0;
+    Caps->adcChannels[1]    = (Dump->pp[CAPS_INDEX_ADC] & 0x2) ? (uint16)(Dump->dc8 >> 16) : 0;
+    Caps->adcComparators[0] = (Dump->pp[CAPS_INDEX_ADC] & 0x1) ? (uint8)Dump->dc9 : 0;
+    Caps->adcComparators[1] = (Dump->pp[CAPS_INDEX_ADC] & 0x2) ? (uint8)(Dump->dc9 >> 16) : 0;
+    Caps->dmaChannels       = (Dump->pp[CAPS_INDEX_DMA] & 0x1) ? Dump->dc7 : 0;
+}
+
+/*********************************************************************
+* Service Name: Caps_Discover
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the cached capabilities
+* Description: Function to read and decode the registers of the part once, the later
+*              calls return the cache.
+**********************************************************************/
+const Caps_Type *Caps_Discover(void){
+
+    if(!g_CapsDiscovered){
+
+        Caps_DumpType dump;
+
+        Caps_Read(&dump);
+        Caps_Decode(&dump, &g_Caps);
+        g_CapsDiscovered = TRUE;
+    }
+
+    return &g_Caps;
+}
+
+/*********************************************************************
+* Service Name: Caps_IsPresent
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Index - CAPS_INDEX_xxx / Instance - Peripheral number (UART3 = 3)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the part has the peripheral
+* Description: Function to validate a peripheral instance, discovers on the first call.
+**********************************************************************/
+boolean Caps_IsPresent(uint8 Index, uint8 Instance){
+
+    if((Index >= CAPS_NUMBER_OF_INDEXES) || (Instance >= 8)){
+        return FALSE;
+    }
+
+    return CAPS_PRESENT(Caps_Discover(), Index, Instance) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+* Service Name: Caps_IsAdcChannel
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Adc - ADC module, 0 or 1 / Channel - Analog input AINn
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the module has the input
+* Description: Function to validate an ADC input, discovers on the first call.
+**********************************************************************/
+boolean Caps_IsAdcChannel(uint8 Adc, uint8 Channel){
+
+    if((Adc >= 2) || (Channel >= 16)){
+        return FALSE;
+    }
+
+    return ((Caps_Discover()->adcChannels[Adc] >> Channel) & 1) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+* Service Name: Caps_IsDmaChannel
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Channel - uDMA channel
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the uDMA has the channel
+* Description: Function to validate a uDMA channel, discovers on the first call.
+**********************************************************************/
+boolean Caps_IsDmaChannel(uint8 Channel){
+
+    if(Channel >= 32){
+        return FALSE;
+    }
+
+    return ((Caps_Discover()->dmaChannels >> Channel) & 1) ? TRUE : FALSE;
+}
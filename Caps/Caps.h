@@ -0,0 +1,187 @@
+/******************************************************************************
+ *
+ * Module: Caps
+ *
+ * File Name: Caps.h
+ *
+ * Description: Header file for the peripheral capability discovery. Reads the device
+ *              identification (DID0/DID1), device capabilities (DCn) and peripheral
+ *              present (PPxxx) registers once into a cached capability bitmap, so the
+ *              drivers validate instance and channel numbers at init only
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef CAPS_H_
+#define CAPS_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* PPxxx register index, offset from PPWD / 4, same indexes as RCGCxxx */
+#define CAPS_INDEX_WD                        0
+#define CAPS_INDEX_TIMER                     1
+#define CAPS_INDEX_GPIO                      2
+#define CAPS_INDEX_DMA                       3
+#define CAPS_INDEX_HIB                       5
+#define CAPS_INDEX_UART                      6
+#define CAPS_INDEX_SSI                       7
+#define CAPS_INDEX_I2C                       8
+#define CAPS_INDEX_USB                       10
+#define CAPS_INDEX_CAN                       13
+#define CAPS_INDEX_ADC                       14
+#define CAPS_INDEX_ACMP                      15
+#define CAPS_INDEX_PWM                       16
+#define CAPS_INDEX_QEI                       17
+#define CAPS_INDEX_EEPROM                    22
+#define CAPS_INDEX_WTIMER                    23
+#define CAPS_NUMBER_OF_INDEXES               24
+
+/* Indexes with a PPxxx register, the others are reserved */
+#define CAPS_PP_INDEXES                      0x00C3E5EF
+
+/* DID0 fields */
+#define CAPS_DID0_MINOR(Did0)                ((uint8)(Did0))
+#define CAPS_DID0_MAJOR(Did0)                ((uint8)((Did0) >> 8))
+#define CAPS_DID0_CLASS(Did0)                ((uint8)((Did0) >> 16))
+#define CAPS_DID0_CLASS_TM4C123              0x05
+
+/* DID1 fields */
+#define CAPS_DID1_PARTNO(Did1)               ((uint8)((Did1) >> 16))
+#define CAPS_DID1_PINCNT(Did1)               (((Did1) >> 13) & 0x7)
+#define CAPS_DID1_PARTNO_TM4C123GH6PM        0xA1
+
+/* DC0 fields, flash in 2 KB and SRAM in 256 byte units minus one */
+#define CAPS_DC0_FLASH_KB(Dc0)               ((((Dc0) & 0xFFFF) + 1) * 2)
+#define CAPS_DC0_SRAM_KB(Dc0)                (((((Dc0) >> 16) & 0xFFFF) + 1) / 4)
+
+/* Cached check, for the init functions of the drivers */
+#define CAPS_PRESENT(Caps, Index, Instance)  (((Caps)->present[(Index)] >> (Instance)) & 1)
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Raw registers, read from the part by Caps_Read or taken from a recorded dump */
+typedef struct
+{
+    uint32 did0;
+    uint32 did1;
+    uint32 dc0;                         /* memory sizes                         */
+    uint32 dc7;                         /* uDMA channels                        */
+    uint32 dc8;                         /* ADC0/ADC1 input channels             */
+    uint32 dc9;                         /* ADC0/ADC1 digital comparators        */
+    uint32 pp[CAPS_NUMBER_OF_INDEXES];  /* PPxxx, 0 for the reserved indexes    */
+}Caps_DumpType;
+
+typedef struct
+{
+    uint8 deviceClass;                  /* DID0 CLASS                           */
+    uint8 major;                        /* DID0 revision                        */
+    uint8 minor;
+    uint8 partNumber;                   /* DID1 PARTNO                          */
+    uint8 pinCount;                     /* 64, 100, 144 ... 0 when unknown      */
+    uint16 flashKB;
+    uint16 sramKB;
+    uint8 present[CAPS_NUMBER_OF_INDEXES];  /* one bit per instance              */
+    uint16 adcChannels[2];              /* one bit per AINn of ADC0/ADC1        */
+    uint8 adcComparators[2];            /* one bit per digital comparator       */
+    uint32 dmaChannels;                 /* one bit per uDMA channel             */
+}Caps_Type;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Caps_Read
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): Dump - Register values
+* Return value: None
+* Description: Function to read the identification, capability and peripheral present
+*              registers of the part. The reserved PPxxx indexes are not accessed.
+**********************************************************************/
+
+void Caps_Read(Caps_DumpType *Dump);
+
+/*********************************************************************
+* Service Name: Caps_Decode
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Dump - Register values, from Caps_Read or a recorded dump
+* Parameters (inout): None
+* Parameters (out): Caps - Capabilities
+* Return value: None
+* Description: Function to decode the registers, without any register access.
+**********************************************************************/
+
+void Caps_Decode(const Caps_DumpType *Dump, Caps_Type *Caps);
+
+/*********************************************************************
+* Service Name: Caps_Discover
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the cached capabilities
+* Description: Function to read and decode the registers of the part once, the later
+*              calls return the cache.
+**********************************************************************/
+
+const Caps_Type *Caps_Discover(void);
+
+/*********************************************************************
+* Service Name: Caps_IsPresent
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Index - CAPS_INDEX_xxx / Instance - Peripheral number (UART3 = 3)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the part has the peripheral
+* Description: Function to validate a peripheral instance, discovers on the first call.
+**********************************************************************/
+
+boolean Caps_IsPresent(uint8 Index, uint8 Instance);
+
+/*********************************************************************
+* Service Name: Caps_IsAdcChannel
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Adc - ADC module, 0 or 1 / Channel - Analog input AINn
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the module has the input
+* Description: Function to validate an ADC input, discovers on the first call.
+**********************************************************************/
+
+boolean Caps_IsAdcChannel(uint8 Adc, uint8 Channel);
+
+/*********************************************************************
+* Service Name: Caps_IsDmaChannel
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Channel - uDMA channel
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the uDMA has the channel
+* Description: Function to validate a uDMA channel, discovers on the first call.
+**********************************************************************/
+
+boolean Caps_IsDmaChannel(uint8 Channel);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* CAPS_H_ */
@@ -0,0 +1,277 @@
+/******************************************************************************
+ *
+ * Module: Clock
+ *
+ * File Name: Clock.c
+ *
+ * Description: Source file for the peripheral clock gating manager. Reference counts
+ *              the run mode clock of every peripheral and sets its sleep and deep-sleep
+ *              clock gating
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Clock.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef __TI_ARM__
+/* Requests may come from interrupt handlers, the count and the gate change together */
+#define CLOCK_ENTER_CRITICAL()     uint32 savedPrimask = _disable_IRQ()
+#define CLOCK_EXIT_CRITICAL()      _restore_interrupts(savedPrimask)
+#else
+#define CLOCK_ENTER_CRITICAL()
+#define CLOCK_EXIT_CRITICAL()
+#endif
+
+/* Implemented peripherals of every register index */
+static const uint8 g_ClockValid[CLOCK_NUMBER_OF_INDEXES] =
+{
+    0x03, 0x3F, 0x3F, 0x01, 0x00, 0x01, 0xFF, 0x0F,     /* WD TIMER GPIO DMA - HIB UART SSI */
+    0x0F, 0x00, 0x01, 0x00, 0x00, 0x03, 0x03, 0x01,     /* I2C - USB - - CAN ADC ACMP       */
+    0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 0x3F      /* PWM QEI - - - - EEPROM WTIMER    */
+};
+
+/* Peripherals clocked by their own driver, see Clock.h */
+static const uint8 g_ClockDriverOwned[CLOCK_NUMBER_OF_INDEXES] =
+{
+    0x03, 0x3F, 0x00, 0x01, 0x00, 0x01, 0x00, 0x0F,     /* WD TIMER GPIO DMA - HIB UART SSI */
+    0x0F, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x00,     /* I2C - USB - - CAN ADC ACMP       */
+    0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x01, 0x3F      /* PWM QEI - - - - EEPROM WTIMER    */
+};
+
+static uint8 g_ClockRefCount[CLOCK_NUMBER_OF_INDEXES][8];
+static uint8 g_ClockSleepMask[CLOCK_NUMBER_OF_INDEXES];
+static uint8 g_ClockDeepSleepMask[CLOCK_NUMBER_OF_INDEXES];
+
+/*********************************************************************
+* Service Name: Clock_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the reference counts and turn on auto clock gating.
+*              Peripherals clocked before the call keep running in sleep and stop
+*              in deep-sleep, they are not counted and Clock_Release ignores them.
+*              The sleep and deep-sleep gates of driver owned peripherals are left
+*              to their driver.
+**********************************************************************/
+void Clock_Init(void){
+
+    uint8 index;
+    uint8 bit;
+
+    for(index = 0; index < CLOCK_NUMBER_OF_INDEXES; index++){
+
+        for(bit = 0; bit < 8; bit++){
+            g_ClockRefCount[index][bit] = 0;
+        }
+        g_ClockSleepMask[index]     = 0xFF;
+        g_ClockDeepSleepMask[index] = 0x00;
+
+        if(g_ClockValid[index] != 0){
+
+            uint32 managed = g_ClockValid[index] & ~g_ClockDriverOwned[index];
+
+            if(managed != 0){
+                SYSCTL_SCGC_REG(index) = (SYSCTL_SCGC_REG(index) & ~managed) | (SYSCTL_RCGC_REG(index) & managed);
+                SYSCTL_DCGC_REG(index) &= ~managed;
+            }
+        }
+    }
+
+    /* Without ACG the run mode gates are used in sleep and deep-sleep as well */
+    SYSCTL_RCC_REG |= CLOCK_RCC_ACG;
+}
+
+/*********************************************************************
+* Service Name: Clock_Request
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the count is saturated (255 users) or when the
+*                         driver of the peripheral owns its clock
+* Description: Function to take a reference on the peripheral clock. The first one
+*              enables it and waits until the peripheral registers are ready.
+**********************************************************************/
+boolean Clock_Request(Clock_PeripheralType Peripheral){
+
+    uint32 index = CLOCK_ID_INDEX(Peripheral);
+    uint32 bit   = CLOCK_ID_BIT(Peripheral);
+    uint32 mask  = 1u << bit;
+    boolean first;
+
+    if(g_ClockDriverOwned[index] & mask){
+        return FALSE;
+    }
+
+    CLOCK_ENTER_CRITICAL();
+
+    if(g_ClockRefCount[index][bit] == 0xFF){
+        CLOCK_EXIT_CRITICAL();
+        return FALSE;
+    }
+
+    first = (g_ClockRefCount[index][bit]++ == 0);
+    if(first){
+
+        if(g_ClockSleepMask[index] & mask){
+            SYSCTL_SCGC_REG(index) |= mask;
+        }
+        if(g_ClockDeepSleepMask[index] & mask){
+            SYSCTL_DCGC_REG(index) |= mask;
+        }
+        SYSCTL_RCGC_REG(index) |= mask;
+    }
+
+    CLOCK_EXIT_CRITICAL();
+
+    /* A few system clocks pass before the peripheral registers can be accessed */
+    while(!(SYSCTL_PR_REG(index) & mask)){}
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: Clock_Release
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the peripheral holds no reference
+* Description: Function to drop a reference, the last one gates the peripheral clock
+*              off in run, sleep and deep-sleep mode.
+**********************************************************************/
+boolean Clock_Release(Clock_PeripheralType Peripheral){
+
+    uint32 index = CLOCK_ID_INDEX(Peripheral);
+    uint32 bit   = CLOCK_ID_BIT(Peripheral);
+    uint32 mask  = 1u << bit;
+
+    CLOCK_ENTER_CRITICAL();
+
+    if(g_ClockRefCount[index][bit] == 0){
+        CLOCK_EXIT_CRITICAL();
+        return FALSE;
+    }
+
+    if(--g_ClockRefCount[index][bit] == 0){
+
+        SYSCTL_RCGC_REG(index) &= ~mask;
+        SYSCTL_SCGC_REG(index) &= ~mask;
+        SYSCTL_DCGC_REG(index) &= ~mask;
+    }
+
+    CLOCK_EXIT_CRITICAL();
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: Clock_SetSleepGating
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral / InSleep - Keep clocked in sleep /
+*                  InDeepSleep - Keep clocked in deep-sleep
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to choose which low power modes keep the peripheral clocked,
+*              applied while it is requested. The default is sleep only.
+**********************************************************************/
+void Clock_SetSleepGating(Clock_PeripheralType Peripheral, boolean InSleep, boolean InDeepSleep){
+
+    uint32 index = CLOCK_ID_INDEX(Peripheral);
+    uint32 bit   = CLOCK_ID_BIT(Peripheral);
+    uint8 mask   = (uint8)(1u << bit);
+    boolean requested;
+
+    CLOCK_ENTER_CRITICAL();
+
+    g_ClockSleepMask[index]     = InSleep     ? (g_ClockSleepMask[index] | mask)     : (g_ClockSleepMask[index] & ~mask);
+    g_ClockDeepSleepMask[index] = InDeepSleep ? (g_ClockDeepSleepMask[index] | mask) : (g_ClockDeepSleepMask[index] & ~mask);
+
+    requested = (g_ClockRefCount[index][bit] != 0);
+    if(requested){
+
+        SYSCTL_SCGC_REG(index) = InSleep     ? (SYSCTL_SCGC_REG(index) | mask) : (SYSCTL_SCGC_REG(index) & ~(uint32)mask);
+        SYSCTL_DCGC_REG(index) = InDeepSleep ? (SYSCTL_DCGC_REG(index) | mask) : (SYSCTL_DCGC_REG(index) & ~(uint32)mask);
+    }
+
+    CLOCK_EXIT_CRITICAL();
+}
+
+/*********************************************************************
+* Service Name: Clock_GetRefCount
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint8 - Number of users
+* Description: Function to get the reference count of a peripheral clock.
+**********************************************************************/
+uint8 Clock_GetRefCount(Clock_PeripheralType Peripheral){
+
+    return g_ClockRefCount[CLOCK_ID_INDEX(Peripheral)][CLOCK_ID_BIT(Peripheral)];
+}
+
+/*********************************************************************
+* Service Name: Clock_IsClocked
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the run mode clock is on
+* Description: Function to read the run mode clock gate from RCGCxxx.
+**********************************************************************/
+boolean Clock_IsClocked(Clock_PeripheralType Peripheral){
+
+    return (SYSCTL_RCGC_REG(CLOCK_ID_INDEX(Peripheral)) & (1u << CLOCK_ID_BIT(Peripheral))) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+* Service Name: Clock_GetClocked
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): MaxCount - Size of List
+* Parameters (inout): None
+* Parameters (out): List - Clocked peripherals
+* Return value: uint8 - Number of clocked peripherals, may be more than MaxCount
+* Description: Function to list the peripherals whose run mode clock is on, including
+*              the ones enabled without this module.
+**********************************************************************/
+uint8 Clock_GetClocked(Clock_PeripheralType *List, uint8 MaxCount){
+
+    uint8 count = 0;
+    uint8 index;
+    uint8 bit;
+
+    for(index = 0; index < CLOCK_NUMBER_OF_INDEXES; index++){
+
+        uint32 clocked;
+
+        if(g_ClockValid[index] == 0){
+            continue;
+        }
+
+        clocked = SYSCTL_RCGC_REG(index) & g_ClockValid[index];
+        for(bit = 0; clocked != 0; bit++, clocked >>= 1){
+
+            if(clocked & 1){
+
+                if(count < MaxCount){
+                    List[count] = (Clock_PeripheralType)CLOCK_ID(index, bit);
+                }
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
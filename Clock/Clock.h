@@ -0,0 +1,197 @@
+/******************************************************************************
+ *
+ * Module: Clock
+ *
+ * File Name: Clock.h
+ *
+ * Description: Header file for the peripheral clock gating manager. Reference counts
+ *              the run mode clock of every peripheral and sets its sleep and deep-sleep
+ *              clock gating
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* RCGCxxx/SCGCxxx/DCGCxxx/PRxxx register index, offset from RCGCWD / 4 */
+#define CLOCK_INDEX_WD                       0
+#define CLOCK_INDEX_TIMER                    1
+#define CLOCK_INDEX_GPIO                     2
+#define CLOCK_INDEX_DMA                      3
+#define CLOCK_INDEX_HIB                      5
+#define CLOCK_INDEX_UART                     6
+#define CLOCK_INDEX_SSI                      7
+#define CLOCK_INDEX_I2C                      8
+#define CLOCK_INDEX_USB                      10
+#define CLOCK_INDEX_CAN                      13
+#define CLOCK_INDEX_ADC                      14
+#define CLOCK_INDEX_ACMP                     15
+#define CLOCK_INDEX_PWM                      16
+#define CLOCK_INDEX_QEI                      17
+#define CLOCK_INDEX_EEPROM                   22
+#define CLOCK_INDEX_WTIMER                   23
+#define CLOCK_NUMBER_OF_INDEXES              24
+
+/* Peripheral id, register index and bit of the peripheral in it */
+#define CLOCK_ID(Index, Bit)                 (((Index) << 3) | (Bit))
+#define CLOCK_ID_INDEX(Id)                   ((uint32)(Id) >> 3)
+#define CLOCK_ID_BIT(Id)                     ((uint32)(Id) & 0x7)
+
+/* RCC auto clock gating, the SCGC/DCGC registers are used in sleep/deep-sleep */
+#define CLOCK_RCC_ACG                        0x08000000
+
+/*
+ * One owner per peripheral clock, its driver or this module, never both. The
+ * GPTM, ADC, PWM, SSI, I2C, CAN, QEI, watchdog, EEPROM and hibernation drivers
+ * (and uDMA, enabled by the ADC and SSI streams) set their RCGCxxx, SCGCxxx and
+ * DCGCxxx bits in their init and never clear them, so they keep running in sleep
+ * and deep-sleep as without auto clock gating. The last Clock_Release of such a
+ * peripheral would stop a driver that still runs, so Clock_Request refuses them
+ * and Clock_Init leaves their gates alone.
+ */
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    CLOCK_WD0 = CLOCK_ID(CLOCK_INDEX_WD, 0), CLOCK_WD1,
+    CLOCK_TIMER0 = CLOCK_ID(CLOCK_INDEX_TIMER, 0), CLOCK_TIMER1, CLOCK_TIMER2, CLOCK_TIMER3, CLOCK_TIMER4, CLOCK_TIMER5,
+    CLOCK_GPIOA = CLOCK_ID(CLOCK_INDEX_GPIO, 0), CLOCK_GPIOB, CLOCK_GPIOC, CLOCK_GPIOD, CLOCK_GPIOE, CLOCK_GPIOF,
+    CLOCK_UDMA = CLOCK_ID(CLOCK_INDEX_DMA, 0),
+    CLOCK_HIB = CLOCK_ID(CLOCK_INDEX_HIB, 0),
+    CLOCK_UART0 = CLOCK_ID(CLOCK_INDEX_UART, 0), CLOCK_UART1, CLOCK_UART2, CLOCK_UART3, CLOCK_UART4, CLOCK_UART5, CLOCK_UART6, CLOCK_UART7,
+    CLOCK_SSI0 = CLOCK_ID(CLOCK_INDEX_SSI, 0), CLOCK_SSI1, CLOCK_SSI2, CLOCK_SSI3,
+    CLOCK_I2C0 = CLOCK_ID(CLOCK_INDEX_I2C, 0), CLOCK_I2C1, CLOCK_I2C2, CLOCK_I2C3,
+    CLOCK_USB = CLOCK_ID(CLOCK_INDEX_USB, 0),
+    CLOCK_CAN0 = CLOCK_ID(CLOCK_INDEX_CAN, 0), CLOCK_CAN1,
+    CLOCK_ADC0 = CLOCK_ID(CLOCK_INDEX_ADC, 0), CLOCK_ADC1,
+    CLOCK_ACMP = CLOCK_ID(CLOCK_INDEX_ACMP, 0),
+    CLOCK_PWM0 = CLOCK_ID(CLOCK_INDEX_PWM, 0), CLOCK_PWM1,
+    CLOCK_QEI0 = CLOCK_ID(CLOCK_INDEX_QEI, 0), CLOCK_QEI1,
+    CLOCK_EEPROM = CLOCK_ID(CLOCK_INDEX_EEPROM, 0),
+    CLOCK_WTIMER0 = CLOCK_ID(CLOCK_INDEX_WTIMER, 0), CLOCK_WTIMER1, CLOCK_WTIMER2, CLOCK_WTIMER3, CLOCK_WTIMER4, CLOCK_WTIMER5
+}Clock_PeripheralType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Clock_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the reference counts and turn on auto clock gating.
+*              Peripherals clocked before the call keep running in sleep and stop
+*              in deep-sleep, they are not counted and Clock_Release ignores them.
+*              The sleep and deep-sleep gates of driver owned peripherals are left
+*              to their driver.
+**********************************************************************/
+
+void Clock_Init(void);
+
+/*********************************************************************
+* Service Name: Clock_Request
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the count is saturated (255 users) or when the
+*                         driver of the peripheral owns its clock
+* Description: Function to take a reference on the peripheral clock. The first one
+*              enables it and waits until the peripheral registers are ready.
+**********************************************************************/
+
+boolean Clock_Request(Clock_PeripheralType Peripheral);
+
+/*********************************************************************
+* Service Name: Clock_Release
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the peripheral holds no reference
+* Description: Function to drop a reference, the last one gates the peripheral clock
+*              off in run, sleep and deep-sleep mode.
+**********************************************************************/
+
+boolean Clock_Release(Clock_PeripheralType Peripheral);
+
+/*********************************************************************
+* Service Name: Clock_SetSleepGating
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral / InSleep - Keep clocked in sleep /
+*                  InDeepSleep - Keep clocked in deep-sleep
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to choose which low power modes keep the peripheral clocked,
+*              applied while it is requested. The default is sleep only.
+**********************************************************************/
+
+void Clock_SetSleepGating(Clock_PeripheralType Peripheral, boolean InSleep, boolean InDeepSleep);
+
+/*********************************************************************
+* Service Name: Clock_GetRefCount
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint8 - Number of users
+* Description: Function to get the reference count of a peripheral clock.
+**********************************************************************/
+
+uint8 Clock_GetRefCount(Clock_PeripheralType Peripheral);
+
+/*********************************************************************
+* Service Name: Clock_IsClocked
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Peripheral - Peripheral
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the run mode clock is on
+* Description: Function to read the run mode clock gate from RCGCxxx.
+**********************************************************************/
+
+boolean Clock_IsClocked(Clock_PeripheralType Peripheral);
+
+/*********************************************************************
+* Service Name: Clock_GetClocked
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): MaxCount - Size of List
+* Parameters (inout): None
+* Parameters (out): List - Clocked peripherals
+* Return value: uint8 - Number of clocked peripherals, may be more than MaxCount
+* Description: Function to list the peripherals whose run mode clock is on, including
+*              the ones enabled without this module.
+**********************************************************************/
+
+uint8 Clock_GetClocked(Clock_PeripheralType *List, uint8 MaxCount);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,392 @@
+/******************************************************************************
+ *
+ * Module: DSP
+ *
+ * File Name: DSP.c
+ *
+ * Description: Source file for the block based q15 DSP kernels (FIR, biquad IIR,
+ *              decimation, moving average, statistics) for the ADC streams. The
+ *              target build uses the Cortex-M4 SIMD instructions (SMLALD, SMLAD,
+ *              QADD16) on two samples at a time, the host build C models of them
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <string.h>
+#include "DSP.h"
+
+/*
+ * Two q15 samples packed in a word, the lower address in the low half. The kernels
+ * only use these macros, the C models give the same results bit for bit.
+ */
+#ifdef __TI_ARM__
+
+#define DSP_SMLAD(X, Y, Acc)          ((sint32)_smlad((int)(X), (int)(Y), (int)(Acc)))
+#define DSP_SMLALD(X, Y, Acc)         ((sint64)_smlald((long long)(Acc), (int)(X), (int)(Y)))
+#define DSP_QADD16(X, Y)              ((uint32)_qadd16((int)(X), (int)(Y)))
+#define DSP_SAT16(X)                  ((sint16)_ssat((int)(X), 16))
+
+#else
+
+static inline sint32 DSP_SAT16_MODEL(sint32 X){
+
+    return (X > DSP_Q15_MAX) ? DSP_Q15_MAX : ((X < DSP_Q15_MIN) ? DSP_Q15_MIN : X);
+}
+
+/* acc + lo * lo + hi * hi, wraps like the instruction */
+static inline sint32 DSP_SMLAD_MODEL(uint32 X, uint32 Y, sint32 Acc){
+
+    return (sint32)((uint32)Acc + (uint32)((sint32)(sint16)X * (sint16)Y) +
+                    (uint32)((sint32)(sint16)(X >> 16) * (sint16)(Y >> 16)));
+}
+
+static inline sint64 DSP_SMLALD_MODEL(uint32 X, uint32 Y, sint64 Acc){
+
+    return Acc + ((sint32)(sint16)X * (sint16)Y) + ((sint32)(sint16)(X >> 16) * (sint16)(Y >> 16));
+}
+
+static inline uint32 DSP_QADD16_MODEL(uint32 X, uint32 Y){
+
+    uint32 lo = (uint16)DSP_SAT16_MODEL((sint32)(sint16)X + (sint16)Y);
+    uint32 hi = (uint16)DSP_SAT16_MODEL((sint32)(sint16)(X >> 16) + (sint16)(Y >> 16));
+
+    return lo | (hi << 16);
+}
+
+#define DSP_SMLAD(X, Y, Acc)          DSP_SMLAD_MODEL((X), (Y), (Acc))
+#define DSP_SMLALD(X, Y, Acc)         DSP_SMLALD_MODEL((X), (Y), (Acc))
+#define DSP_QADD16(X, Y)              DSP_QADD16_MODEL((X), (Y))
+#define DSP_SAT16(X)                  ((sint16)DSP_SAT16_MODEL(X))
+
+#endif
+
+/* Both sample pairs as 1 and 1, SMLAD with it adds the two halves */
+#define DSP_PAIR_OF_ONES              0x00010001
+
+/* Unaligned word access, a single LDR/STR on the Cortex-M4 */
+static inline uint32 DSP_Read2(const sint16 *Ptr){
+
+    uint32 pair;
+    memcpy(&pair, Ptr, sizeof(pair));
+    return pair;
+}
+
+static inline void DSP_Write2(sint16 *Ptr, uint32 Pair){
+
+    memcpy(Ptr, &Pair, sizeof(Pair));
+}
+
+/* Saturate a q30 / q(30 - shift) accumulator back to q15 */
+static inline sint16 DSP_Saturate64(sint64 Acc, uint8 Shift){
+
+    sint64 value = Acc >> Shift;
+
+    if(value > DSP_Q15_MAX){
+        return DSP_Q15_MAX;
+    }
+    if(value < DSP_Q15_MIN){
+        return DSP_Q15_MIN;
+    }
+    return (sint16)value;
+}
+
+/* One FIR output from Taps samples, oldest first, against the reversed taps */
+static inline sint16 DSP_FirOutput(const sint16 *Coeffs, const sint16 *Samples, uint16 Taps){
+
+    sint64 acc = 0;
+    uint16 k;
+
+    for(k = 0; (k + 1) < Taps; k += 2){
+        acc = DSP_SMLALD(DSP_Read2(&Coeffs[k]), DSP_Read2(&Samples[k]), acc);
+    }
+    if(k < Taps){
+        acc += (sint32)Coeffs[k] * Samples[k];
+    }
+
+    return DSP_Saturate64(acc, 15);
+}
+
+static uint32 DSP_Sqrt(uint32 Value){
+
+    uint32 root = 0;
+    uint32 bit = 1u << 30;
+
+    while(bit > Value){
+        bit >>= 2;
+    }
+    while(bit != 0){
+
+        if(Value >= root + bit){
+            Value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else{
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+/*********************************************************************
+* Service Name: DSP_FirInit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Coeffs - Time reversed taps / Taps - Number of taps /
+*                  State - DSP_FIR_STATE_SIZE(Taps, MaxBlock) words / MaxBlock - Block size
+* Parameters (inout): None
+* Parameters (out): Fir - Filter
+* Return value: None
+* Description: Function to set up a FIR filter with a cleared history.
+**********************************************************************/
+void DSP_FirInit(DSP_FirType *Fir, const sint16 *Coeffs, uint16 Taps, sint16 *State, uint16 MaxBlock){
+
+    Fir->coeffs   = Coeffs;
+    Fir->state    = State;
+    Fir->taps     = Taps;
+    Fir->maxBlock = MaxBlock;
+
+    memset(State, 0, DSP_FIR_STATE_SIZE(Taps, MaxBlock) * sizeof(sint16));
+}
+
+/*********************************************************************
+* Service Name: DSP_Fir
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Input samples / Count - Samples, up to maxBlock
+* Parameters (inout): Fir - Filter
+* Parameters (out): Out - Filtered samples, may be In
+* Return value: None
+* Description: Function to filter a block, two taps per SMLALD with a 64-bit
+*              accumulator, the result is rounded down and saturated to q15.
+**********************************************************************/
+void DSP_Fir(DSP_FirType *Fir, const sint16 *In, sint16 *Out, uint16 Count){
+
+    DSP_FirDecimate(Fir, In, Out, Count, 1);
+}
+
+/*********************************************************************
+* Service Name: DSP_FirDecimate
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Input samples / Count - Samples, up to maxBlock, multiple of
+*                  Factor / Factor - Decimation factor
+* Parameters (inout): Fir - Anti-aliasing filter
+* Parameters (out): Out - Count / Factor filtered samples, may be In
+* Return value: None
+* Description: Function to low pass filter and keep every Factor-th sample, only the
+*              kept outputs are computed.
+**********************************************************************/
+void DSP_FirDecimate(DSP_FirType *Fir, const sint16 *In, sint16 *Out, uint16 Count, uint8 Factor){
+
+    uint16 history = Fir->taps - 1;
+    uint16 n;
+
+    /* The block follows the last taps - 1 samples of the previous one */
+    memcpy(&Fir->state[history], In, Count * sizeof(sint16));
+
+    for(n = Factor - 1; n < Count; n += Factor){
+        *Out++ = DSP_FirOutput(Fir->coeffs, &Fir->state[n], Fir->taps);
+    }
+
+    memmove(Fir->state, &Fir->state[Count], history * sizeof(sint16));
+}
+
+/*********************************************************************
+* Service Name: DSP_BiquadInit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Coeffs - DSP_BIQUAD_COEFFS per stage / Stages - Number of stages /
+*                  State - DSP_BIQUAD_STATE_SIZE(Stages) words / PostShift - Coefficient scale
+* Parameters (inout): None
+* Parameters (out): Biquad - Filter
+* Return value: None
+* Description: Function to set up a biquad cascade with a cleared history.
+**********************************************************************/
+void DSP_BiquadInit(DSP_BiquadType *Biquad, const sint16 *Coeffs, uint8 Stages, sint16 *State, uint8 PostShift){
+
+    Biquad->coeffs    = Coeffs;
+    Biquad->state     = State;
+    Biquad->stages    = Stages;
+    Biquad->postShift = PostShift;
+
+    memset(State, 0, DSP_BIQUAD_STATE_SIZE(Stages) * sizeof(sint16));
+}
+
+/*********************************************************************
+* Service Name: DSP_Biquad
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Input samples / Count - Samples
+* Parameters (inout): Biquad - Filter
+* Parameters (out): Out - Filtered samples, may be In
+* Return value: None
+* Description: Function to filter a block through every stage, the x and y history
+*              pairs each take one SMLALD.
+**********************************************************************/
+void DSP_Biquad(DSP_BiquadType *Biquad, const sint16 *In, sint16 *Out, uint16 Count){
+
+    uint8 shift = 15 - Biquad->postShift;
+    uint8 stage;
+
+    for(stage = 0; stage < Biquad->stages; stage++){
+
+        const sint16 *coeffs = &Biquad->coeffs[stage * DSP_BIQUAD_COEFFS];
+        sint16 *state = &Biquad->state[stage * 4];
+        sint32 b0   = coeffs[0];
+        uint32 b1b2 = DSP_Read2(&coeffs[1]);
+        uint32 a1a2 = DSP_Read2(&coeffs[3]);
+        uint32 x1x2 = DSP_Read2(&state[0]);       /* x[n-1] low, x[n-2] high */
+        uint32 y1y2 = DSP_Read2(&state[2]);
+        uint16 n;
+
+        for(n = 0; n < Count; n++){
+
+            sint16 x0 = In[n];
+            sint64 acc = (sint64)(b0 * x0);
+            sint16 y0;
+
+            acc = DSP_SMLALD(b1b2, x1x2, acc);
+            acc = DSP_SMLALD(a1a2, y1y2, acc);
+            y0  = DSP_Saturate64(acc, shift);
+
+            /* Shift the histories by one sample, PKHBT on target */
+            x1x2 = (x1x2 << 16) | (uint16)x0;
+            y1y2 = (y1y2 << 16) | (uint16)y0;
+
+            Out[n] = y0;
+        }
+
+        DSP_Write2(&state[0], x1x2);
+        DSP_Write2(&state[2], y1y2);
+
+        /* The next stage filters the output of this one */
+        In = Out;
+    }
+}
+
+/*********************************************************************
+* Service Name: DSP_MovingAverageInit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Window - 1 << Log2Length samples / Log2Length - Window size, up to 15
+* Parameters (inout): None
+* Parameters (out): Average - Filter
+* Return value: None
+* Description: Function to set up a moving average with a zero history.
+**********************************************************************/
+void DSP_MovingAverageInit(DSP_MovingAverageType *Average, sint16 *Window, uint8 Log2Length){
+
+    Average->window     = Window;
+    Average->log2Length = Log2Length;
+    Average->index      = 0;
+    Average->sum        = 0;
+
+    memset(Window, 0, (1u << Log2Length) * sizeof(sint16));
+}
+
+/*********************************************************************
+* Service Name: DSP_MovingAverage
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Input samples / Count - Samples
+* Parameters (inout): Average - Filter
+* Parameters (out): Out - Averaged samples, may be In
+* Return value: None
+* Description: Function to average the last window samples, one add and one subtract
+*              per sample on a running sum.
+**********************************************************************/
+void DSP_MovingAverage(DSP_MovingAverageType *Average, const sint16 *In, sint16 *Out, uint16 Count){
+
+    uint16 mask  = (uint16)((1u << Average->log2Length) - 1);
+    uint16 index = Average->index;
+    sint32 sum   = Average->sum;
+    uint16 n;
+
+    for(n = 0; n < Count; n++){
+
+        sint16 x = In[n];
+
+        sum += x - Average->window[index];
+        Average->window[index] = x;
+        index = (index + 1) & mask;
+
+        Out[n] = (sint16)(sum >> Average->log2Length);
+    }
+
+    Average->index = index;
+    Average->sum   = sum;
+}
+
+/*********************************************************************
+* Service Name: DSP_Stats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Samples / Count - Samples, at least 1
+* Parameters (inout): None
+* Parameters (out): Stats - Minimum, maximum, RMS and mean
+* Return value: None
+* Description: Function to get the statistics of a block, the sums of two samples and
+*              two squares are taken per instruction.
+**********************************************************************/
+void DSP_Stats(const sint16 *In, uint16 Count, DSP_StatsType *Stats){
+
+    sint16 min = DSP_Q15_MAX;
+    sint16 max = DSP_Q15_MIN;
+    sint32 sum = 0;             /* 65535 * 32768 still fits */
+    sint64 squares = 0;
+    uint32 rms;
+    uint16 n;
+
+    for(n = 0; (n + 1) < Count; n += 2){
+
+        uint32 pair = DSP_Read2(&In[n]);
+
+        sum     = DSP_SMLAD(pair, DSP_PAIR_OF_ONES, sum);
+        squares = DSP_SMLALD(pair, pair, squares);
+
+        if(In[n] < min)     { min = In[n]; }
+        if(In[n] > max)     { max = In[n]; }
+        if(In[n + 1] < min) { min = In[n + 1]; }
+        if(In[n + 1] > max) { max = In[n + 1]; }
+    }
+    if(n < Count){
+
+        sum     += In[n];
+        squares += (sint32)In[n] * In[n];
+
+        if(In[n] < min) { min = In[n]; }
+        if(In[n] > max) { max = In[n]; }
+    }
+
+    /* The mean square is at most 2^30, its root 32768 for a block of -1.0 */
+    rms = DSP_Sqrt((uint32)(squares / Count));
+
+    Stats->min  = min;
+    Stats->max  = max;
+    Stats->mean = (sint16)(sum / (sint32)Count);
+    Stats->rms  = (sint16)((rms > DSP_Q15_MAX) ? DSP_Q15_MAX : rms);
+}
+
+/*********************************************************************
+* Service Name: DSP_AddSat
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): A - First block / B - Second block / Count - Samples
+* Parameters (inout): None
+* Parameters (out): Out - Saturated sums, may be A or B
+* Return value: None
+* Description: Function to add two blocks with q15 saturation, two samples per QADD16.
+**********************************************************************/
+void DSP_AddSat(const sint16 *A, const sint16 *B, sint16 *Out, uint16 Count){
+
+    uint16 n;
+
+    for(n = 0; (n + 1) < Count; n += 2){
+        DSP_Write2(&Out[n], DSP_QADD16(DSP_Read2(&A[n]), DSP_Read2(&B[n])));
+    }
+    if(n < Count){
+        Out[n] = DSP_SAT16((sint32)A[n] + B[n]);
+    }
+}
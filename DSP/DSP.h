@@ -0,0 +1,221 @@
+/******************************************************************************
+ *
+ * Module: DSP
+ *
+ * File Name: DSP.h
+ *
+ * Description: Header file for the block based q15 DSP kernels (FIR, biquad IIR,
+ *              decimation, moving average, statistics) for the ADC streams. The
+ *              target build uses the Cortex-M4 SIMD instructions (SMLALD, SMLAD,
+ *              QADD16) on two samples at a time, the host build C models of them
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef DSP_H_
+#define DSP_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* q15: -1.0 ... 1.0 - 2^-15 in a sint16 */
+#define DSP_Q15(Value)                       ((sint16)((Value) * 32768.0))
+#define DSP_Q15_MAX                          32767
+#define DSP_Q15_MIN                          (-32768)
+
+/* Words of filter state */
+#define DSP_FIR_STATE_SIZE(Taps, MaxBlock)   ((Taps) + (MaxBlock) - 1)
+#define DSP_BIQUAD_STATE_SIZE(Stages)        (4 * (Stages))
+
+/* Biquad coefficients per stage: b0, b1, b2, a1, a2 */
+#define DSP_BIQUAD_COEFFS                    5
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/*
+ * FIR filter, y[n] = sum(h[k] * x[n - k]). The coefficients are given in time
+ * reversed order, h[Taps - 1] first, so the samples and coefficients are read in
+ * the same direction two at a time.
+ */
+typedef struct
+{
+    const sint16 *coeffs;
+    sint16 *state;                      /* DSP_FIR_STATE_SIZE(taps, maxBlock) */
+    uint16 taps;
+    uint16 maxBlock;                    /* most input samples per call        */
+}DSP_FirType;
+
+/*
+ * Cascade of direct form I biquads, per stage
+ *     y[n] = (b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2]) << postShift
+ * with the feedback coefficients a1, a2 negated from the usual form. Coefficients
+ * above 1.0 are scaled down by 2^postShift.
+ */
+typedef struct
+{
+    const sint16 *coeffs;               /* DSP_BIQUAD_COEFFS per stage          */
+    sint16 *state;                      /* DSP_BIQUAD_STATE_SIZE(stages)        */
+    uint8 stages;
+    uint8 postShift;
+}DSP_BiquadType;
+
+/* Moving average over a power of two window */
+typedef struct
+{
+    sint16 *window;                     /* 1 << log2Length samples              */
+    uint8 log2Length;
+    uint16 index;
+    sint32 sum;
+}DSP_MovingAverageType;
+
+typedef struct
+{
+    sint16 min;
+    sint16 max;
+    sint16 rms;
+    sint16 mean;
+}DSP_StatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: DSP_FirInit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Coeffs - Time reversed taps / Taps - Number of taps /
+*                  State - DSP_FIR_STATE_SIZE(Taps, MaxBlock) words / MaxBlock - Block size
+* Parameters (inout): None
+* Parameters (out): Fir - Filter
+* Return value: None
+* Description: Function to set up a FIR filter with a cleared history.
+**********************************************************************/
+
+void DSP_FirInit(DSP_FirType *Fir, const sint16 *Coeffs, uint16 Taps, sint16 *State, uint16 MaxBlock);
+
+/*********************************************************************
+* Service Name: DSP_Fir
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Input samples / Count - Samples, up to maxBlock
+* Parameters (inout): Fir - Filter
+* Parameters (out): Out - Filtered samples, may be In
+* Return value: None
+* Description: Function to filter a block, two taps per SMLALD with a 64-bit
+*              accumulator, the result is rounded down and saturated to q15.
+**********************************************************************/
+
+void DSP_Fir(DSP_FirType *Fir, const sint16 *In, sint16 *Out, uint16 Count);
+
+/*********************************************************************
+* Service Name: DSP_FirDecimate
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Input samples / Count - Samples, up to maxBlock, multiple of
+*                  Factor / Factor - Decimation factor
+* Parameters (inout): Fir - Anti-aliasing filter
+* Parameters (out): Out - Count / Factor filtered samples, may be In
+* Return value: None
+* Description: Function to low pass filter and keep every Factor-th sample, only the
+*              kept outputs are computed.
+**********************************************************************/
+
+void DSP_FirDecimate(DSP_FirType *Fir, const sint16 *In, sint16 *Out, uint16 Count, uint8 Factor);
+
+/*********************************************************************
+* Service Name: DSP_BiquadInit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Coeffs - DSP_BIQUAD_COEFFS per stage / Stages - Number of stages /
+*                  State - DSP_BIQUAD_STATE_SIZE(Stages) words / PostShift - Coefficient scale
+* Parameters (inout): None
+* Parameters (out): Biquad - Filter
+* Return value: None
+* Description: Function to set up a biquad cascade with a cleared history.
+**********************************************************************/
+
+void DSP_BiquadInit(DSP_BiquadType *Biquad, const sint16 *Coeffs, uint8 Stages, sint16 *State, uint8 PostShift);
+
+/*********************************************************************
+* Service Name: DSP_Biquad
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Input samples / Count - Samples
+* Parameters (inout): Biquad - Filter
+* Parameters (out): Out - Filtered samples, may be In
+* Return value: None
+* Description: Function to filter a block through every stage, the x and y history
+*              pairs each take one SMLALD.
+**********************************************************************/
+
+void DSP_Biquad(DSP_BiquadType *Biquad, const sint16 *In, sint16 *Out, uint16 Count);
+
+/*********************************************************************
+* Service Name: DSP_MovingAverageInit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Window - 1 << Log2Length samples / Log2Length - Window size, up to 15
+* Parameters (inout): None
+* Parameters (out): Average - Filter
+* Return value: None
+* Description: Function to set up a moving average with a zero history.
+**********************************************************************/
+
+void DSP_MovingAverageInit(DSP_MovingAverageType *Average, sint16 *Window, uint8 Log2Length);
+
+/*********************************************************************
+* Service Name: DSP_MovingAverage
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Input samples / Count - Samples
+* Parameters (inout): Average - Filter
+* Parameters (out): Out - Averaged samples, may be In
+* Return value: None
+* Description: Function to average the last window samples, one add and one subtract
+*              per sample on a running sum.
+**********************************************************************/
+
+void DSP_MovingAverage(DSP_MovingAverageType *Average, const sint16 *In, sint16 *Out, uint16 Count);
+
+/*********************************************************************
+* Service Name: DSP_Stats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): In - Samples / Count - Samples, at least 1
+* Parameters (inout): None
+* Parameters (out): Stats - Minimum, maximum, RMS and mean
+* Return value: None
+* Description: Function to get the statistics of a block, the sums of two samples and
+*              two squares are taken per instruction.
+**********************************************************************/
+
+void DSP_Stats(const sint16 *In, uint16 Count, DSP_StatsType *Stats);
+
+/*********************************************************************
+* Service Name: DSP_AddSat
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): A - First block / B - Second block / Count - Samples
+* Parameters (inout): None
+* Parameters (out): Out - Saturated sums, may be A or B
+* Return value: None
+* Description: Function to add two blocks with q15 saturation, two samples per QADD16.
+**********************************************************************/
+
+void DSP_AddSat(const sint16 *A, const sint16 *B, sint16 *Out, uint16 Count);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* DSP_H_ */
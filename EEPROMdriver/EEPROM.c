@@ -0,0 +1,364 @@
+/******************************************************************************
+ *
+ * Module: EEPROM
+ *
+ * File Name: EEPROM.c
+ *
+ * Description: Source file for the key-value configuration store on the
+ *              TM4C123GH6PM EEPROM. The store is read once at boot into a RAM
+ *              shadow, so a read is a table lookup; writes update the shadow and
+ *              the changed words are committed in the background by the EEPROM
+ *              done interrupt, repeated writes before a commit cost one
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "EEPROM.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef __TI_ARM__
+#define EEPROM_ENTER_CRITICAL()    uint32 savedPrimask = _disable_IRQ()
+#define EEPROM_EXIT_CRITICAL()     _restore_interrupts(savedPrimask)
+#else
+#define EEPROM_ENTER_CRITICAL()
+#define EEPROM_EXIT_CRITICAL()
+#endif
+
+#define EEPROM_BLOCK_WORDS            16
+#define EEPROM_ERASED                 0xFFFFFFFF
+
+/* EEDONE and EESUPP */
+#define EEPROM_DONE_WORKING           0x00000001
+#define EEPROM_DONE_WRBUSY            0x00000020
+#define EEPROM_SUPP_ERETRY            0x00000004
+#define EEPROM_SUPP_PRETRY            0x00000008
+
+#define EEPROM_INT_ENABLE             0x00000001
+
+/* FCRIS, FCIM and FCMISC EEPROM bit */
+#define EEPROM_FLASH_INT              0x00000004
+
+/* Record header: key in bits 0-15, value words in bits 16-23, check in bits 24-31 */
+#define EEPROM_HEADER_KEY(Header)     ((uint16)((Header) & 0xFFFF))
+#define EEPROM_HEADER_WORDS(Header)   ((uint8)(((Header) >> 16) & 0xFF))
+
+#define EEPROM_DIRTY_WORDS            (EEPROM_STORE_WORDS / 32)
+
+typedef struct
+{
+    uint16 key;
+    uint16 offset;                      /* of the header word                           */
+    uint8 words;
+    boolean valid;                      /* check passed or value set since boot         */
+}EEPROM_EntryType;
+
+static uint32 g_EepromShadow[EEPROM_STORE_WORDS];
+static EEPROM_EntryType g_EepromEntry[EEPROM_MAX_KEYS];
+static uint8 g_EepromEntries = 0;
+static uint16 g_EepromEnd = 0;          /* first word after the last record             */
+
+/* Words that differ from the EEPROM, one bit per word */
+static uint32 g_EepromDirty[EEPROM_DIRTY_WORDS];
+static volatile boolean g_EepromWriting = FALSE;
+static uint16 g_EepromWord;             /* word written now                             */
+static uint32 g_EepromBlock;             /* EEBLOCK, to skip writing it again            */
+
+static uint32 EEPROM_Header(uint16 Key, const uint32 *Value, uint8 Words){
+
+    uint32 check = Key + ((uint32)Words << 16);
+    uint8 i;
+
+    for(i = 0; i < Words; i++){
+        check = ((check << 1) | (check >> 31)) ^ Value[i];
+    }
+    check ^= check >> 16;
+    check ^= check >> 8;
+
+    return (uint32)Key | ((uint32)Words << 16) | ((check & 0xFF) << 24);
+}
+
+static EEPROM_EntryType *EEPROM_Find(uint16 Key){
+
+    uint8 i;
+
+    for(i = 0; i < g_EepromEntries; i++){
+        if(g_EepromEntry[i].key == Key){
+            return &g_EepromEntry[i];
+        }
+    }
+    return NULL_PTR;
+}
+
+static void EEPROM_Update(uint16 Word, uint32 Value){
+
+    if(g_EepromShadow[Word] != Value){
+        g_EepromShadow[Word] = Value;
+        g_EepromDirty[Word / 32] |= 1u << (Word % 32);
+    }
+}
+
+/* Starts the write of the highest queued word, with interrupts masked */
+static void EEPROM_CommitNext(void){
+
+    sint8 i;
+    uint8 bit;
+    uint32 block;
+
+    for(i = EEPROM_DIRTY_WORDS - 1; (i >= 0) && (g_EepromDirty[i] == 0); i--){}
+
+    if(i < 0){
+        g_EepromWriting = FALSE;
+        return;
+    }
+
+    for(bit = 31; !(g_EepromDirty[i] & (1u << bit)); bit--){}
+    g_EepromDirty[i] &= ~(1u << bit);
+
+    g_EepromWriting = TRUE;
+    g_EepromWord = (uint16)((i * 32) + bit);
+
+    block = g_EepromWord / EEPROM_BLOCK_WORDS;
+    if(block != g_EepromBlock){
+        EEPROM_EEBLOCK_REG = block;
+        g_EepromBlock = block;
+    }
+    EEPROM_EEOFFSET_REG = g_EepromWord % EEPROM_BLOCK_WORDS;
+    EEPROM_EERDWR_REG   = g_EepromShadow[g_EepromWord];
+}
+
+/* Done after power on or a reset, and no retry left pending */
+static boolean EEPROM_Recovered(void){
+
+    while(EEPROM_EEDONE_REG & EEPROM_DONE_WORKING){}
+
+    return (EEPROM_EESUPP_REG & (EEPROM_SUPP_ERETRY | EEPROM_SUPP_PRETRY)) ? FALSE : TRUE;
+}
+
+/*********************************************************************
+* Service Name: EEPROM_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the EEPROM failed its power-on recovery
+* Description: Function to clock and recover the EEPROM, load the store into the
+*              shadow and index its records. Enables the done interrupt, the NVIC
+*              line of NVIC_FLASH_MEMORY_CONTROL_AND_EEPROM_CONTROL_IRQ is enabled by
+*              the application.
+**********************************************************************/
+boolean EEPROM_Init(void){
+
+    uint16 offset = 0;
+    uint32 block;
+    uint8 i;
+
+    g_EepromEntries = 0;
+    g_EepromWriting = FALSE;
+    for(i = 0; i < EEPROM_DIRTY_WORDS; i++){
+        g_EepromDirty[i] = 0;
+    }
+
+    SYSCTL_RCGCEEPROM_REG |= 0x1;
+    SYSCTL_SCGCEEPROM_REG |= 0x1;
+    SYSCTL_DCGCEEPROM_REG |= 0x1;
+    while(!(SYSCTL_PREEPROM_REG & 0x1)){}
+
+    /* Power-on sequence of the data sheet: recover, reset, recover again */
+    if(!EEPROM_Recovered()){
+        return FALSE;
+    }
+    SYSCTL_SREEPROM_REG |= 0x1;
+    SYSCTL_SREEPROM_REG &= ~0x1;
+    while(!(SYSCTL_PREEPROM_REG & 0x1)){}
+    if(!EEPROM_Recovered()){
+        return FALSE;
+    }
+
+    /* EERDWRINC wraps within the block, back to offset 0 for the next one */
+    EEPROM_EEOFFSET_REG = 0;
+    for(block = 0; block < (EEPROM_STORE_WORDS / EEPROM_BLOCK_WORDS); block++){
+
+        uint32 *words = &g_EepromShadow[block * EEPROM_BLOCK_WORDS];
+
+        EEPROM_EEBLOCK_REG = block;
+        for(i = 0; i < EEPROM_BLOCK_WORDS; i++){
+            words[i] = EEPROM_EERDWRINC_REG;
+        }
+    }
+    g_EepromBlock = block - 1;
+
+    /* Records up to the erased header or to the first that can not be one */
+    while(offset < EEPROM_STORE_WORDS){
+
+        uint32 header = g_EepromShadow[offset];
+        uint16 key    = EEPROM_HEADER_KEY(header);
+        uint8 words   = EEPROM_HEADER_WORDS(header);
+
+        if((key == EEPROM_NO_KEY) || (words == 0) || (words > EEPROM_MAX_VALUE_WORDS) ||
+           ((offset + 1u + words) > EEPROM_STORE_WORDS) || (g_EepromEntries == EEPROM_MAX_KEYS)){
+            break;
+        }
+
+        g_EepromEntry[g_EepromEntries].key    = key;
+        g_EepromEntry[g_EepromEntries].offset = offset;
+        g_EepromEntry[g_EepromEntries].words  = words;
+        g_EepromEntry[g_EepromEntries].valid  = (header == EEPROM_Header(key, &g_EepromShadow[offset + 1], words));
+        g_EepromEntries++;
+
+        offset += 1u + words;
+    }
+    g_EepromEnd = offset;
+
+    EEPROM_EEINT_REG = EEPROM_INT_ENABLE;
+    FLASH_FCMISC_REG = EEPROM_FLASH_INT;
+    FLASH_FCIM_REG  |= EEPROM_FLASH_INT;
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: EEPROM_Get
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Key - Record / Words - Length of the value
+* Parameters (inout): None
+* Parameters (out): Value - Value of the record
+* Return value: boolean - FALSE for a missing record or a record of another length
+* Description: Function to read a record from the shadow, with the last value set
+*              even when it is not committed yet.
+**********************************************************************/
+boolean EEPROM_Get(uint16 Key, uint32 *Value, uint8 Words){
+
+    EEPROM_EntryType *entry = EEPROM_Find(Key);
+    const uint32 *value;
+    uint8 i;
+
+    if((entry == NULL_PTR) || !entry->valid || (entry->words != Words)){
+        return FALSE;
+    }
+    value = &g_EepromShadow[entry->offset + 1];
+
+    {
+        EEPROM_ENTER_CRITICAL();
+
+        for(i = 0; i < Words; i++){
+            Value[i] = value[i];
+        }
+
+        EEPROM_EXIT_CRITICAL();
+    }
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: EEPROM_Set
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Key - Record / Value - New value / Words - Length of the value
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for EEPROM_NO_KEY, a length of 0 or above
+*                         EEPROM_MAX_VALUE_WORDS, a record of another length or a
+*                         full store
+* Description: Function to write a record, added at the end of the store the first
+*              time. Only the words that change are queued and the commit starts
+*              when the EEPROM is idle.
+**********************************************************************/
+boolean EEPROM_Set(uint16 Key, const uint32 *Value, uint8 Words){
+
+    EEPROM_EntryType *entry;
+    boolean result = FALSE;
+    uint8 i;
+
+    if((Key == EEPROM_NO_KEY) || (Words == 0) || (Words > EEPROM_MAX_VALUE_WORDS)){
+        return FALSE;
+    }
+
+    {
+        EEPROM_ENTER_CRITICAL();
+
+        entry = EEPROM_Find(Key);
+
+        if((entry == NULL_PTR) && (g_EepromEntries < EEPROM_MAX_KEYS) &&
+           ((g_EepromEnd + 1u + Words) <= EEPROM_STORE_WORDS)){
+
+            entry = &g_EepromEntry[g_EepromEntries++];
+            entry->key    = Key;
+            entry->offset = g_EepromEnd;
+            entry->words  = Words;
+            g_EepromEnd  += 1u + Words;
+
+            /* Ends the store at the new record, whatever an older layout left there */
+            if(g_EepromEnd < EEPROM_STORE_WORDS){
+                EEPROM_Update(g_EepromEnd, EEPROM_ERASED);
+            }
+        }
+
+        if((entry != NULL_PTR) && (entry->words == Words)){
+
+            for(i = 0; i < Words; i++){
+                EEPROM_Update(entry->offset + 1u + i, Value[i]);
+            }
+            EEPROM_Update(entry->offset, EEPROM_Header(Key, Value, Words));
+            entry->valid = TRUE;
+
+            if(!g_EepromWriting){
+                EEPROM_CommitNext();
+            }
+            result = TRUE;
+        }
+
+        EEPROM_EXIT_CRITICAL();
+    }
+
+    return result;
+}
+
+/*********************************************************************
+* Service Name: EEPROM_IsCommitted
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the EEPROM holds every value set
+* Description: Function to check that the store survives a power down.
+**********************************************************************/
+boolean EEPROM_IsCommitted(void){
+
+    return g_EepromWriting ? FALSE : TRUE;
+}
+
+/*********************************************************************
+* Service Name: EEPROM_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the EEPROM done interrupt and write the next queued
+*              word. Called from the vector of
+*              NVIC_FLASH_MEMORY_CONTROL_AND_EEPROM_CONTROL_IRQ.
+**********************************************************************/
+void EEPROM_Handler(void){
+
+    if(!(FLASH_FCRIS_REG & EEPROM_FLASH_INT)){
+        return;
+    }
+    FLASH_FCMISC_REG = EEPROM_FLASH_INT;
+
+    {
+        EEPROM_ENTER_CRITICAL();
+
+        /* Not taken while the EEPROM was busy, queued again */
+        if(EEPROM_EEDONE_REG & EEPROM_DONE_WRBUSY){
+            g_EepromDirty[g_EepromWord / 32] |= 1u << (g_EepromWord % 32);
+        }
+        EEPROM_CommitNext();
+
+        EEPROM_EXIT_CRITICAL();
+    }
+}
@@ -0,0 +1,125 @@
+/******************************************************************************
+ *
+ * Module: EEPROM
+ *
+ * File Name: EEPROM.h
+ *
+ * Description: Header file for the key-value configuration store on the
+ *              TM4C123GH6PM EEPROM. The store is read once at boot into a RAM
+ *              shadow, so a read is a table lookup; writes update the shadow and
+ *              the changed words are committed in the background by the EEPROM
+ *              done interrupt, repeated writes before a commit cost one
+ *
+ *              A record is a header word { key, length, check } followed by its
+ *              value words. Words are committed from the highest address down, so
+ *              the header of a record is written last and a record cut by a power
+ *              loss fails its check and reads as missing.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* EEPROM words used by the store from word 0, a multiple of the 16 word block */
+#define EEPROM_STORE_WORDS                   256
+#define EEPROM_MAX_KEYS                      32
+#define EEPROM_MAX_VALUE_WORDS               16
+
+/* Key reserved for the end of the store */
+#define EEPROM_NO_KEY                        0xFFFF
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: EEPROM_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the EEPROM failed its power-on recovery
+* Description: Function to clock and recover the EEPROM, load the store into the
+*              shadow and index its records. Enables the done interrupt, the NVIC
+*              line of NVIC_FLASH_MEMORY_CONTROL_AND_EEPROM_CONTROL_IRQ is enabled by
+*              the application.
+**********************************************************************/
+
+boolean EEPROM_Init(void);
+
+/*********************************************************************
+* Service Name: EEPROM_Get
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Key - Record / Words - Length of the value
+* Parameters (inout): None
+* Parameters (out): Value - Value of the record
+* Return value: boolean - FALSE for a missing record or a record of another length
+* Description: Function to read a record from the shadow, with the last value set
+*              even when it is not committed yet.
+**********************************************************************/
+
+boolean EEPROM_Get(uint16 Key, uint32 *Value, uint8 Words);
+
+/*********************************************************************
+* Service Name: EEPROM_Set
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Key - Record / Value - New value / Words - Length of the value
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for EEPROM_NO_KEY, a length of 0 or above
+*                         EEPROM_MAX_VALUE_WORDS, a record of another length or a
+*                         full store
+* Description: Function to write a record, added at the end of the store the first
+*              time. Only the words that change are queued and the commit starts
+*              when the EEPROM is idle.
+**********************************************************************/
+
+boolean EEPROM_Set(uint16 Key, const uint32 *Value, uint8 Words);
+
+/*********************************************************************
+* Service Name: EEPROM_IsCommitted
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when the EEPROM holds every value set
+* Description: Function to check that the store survives a power down.
+**********************************************************************/
+
+boolean EEPROM_IsCommitted(void);
+
+/*********************************************************************
+* Service Name: EEPROM_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the EEPROM done interrupt and write the next queued
+*              word. Called from the vector of
+*              NVIC_FLASH_MEMORY_CONTROL_AND_EEPROM_CONTROL_IRQ.
+**********************************************************************/
+
+void EEPROM_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* EEPROM_H_ */
@@ -0,0 +1,349 @@
+/******************************************************************************
+ *
+ * Module: GPTM
+ *
+ * File Name: GPTM.c
+ *
+ * Description: Source file for the TM4C123GH6PM General-Purpose Timer Module driver,
+ *              one-shot, periodic, concatenated 32/64-bit and edge-time capture modes
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "GPTM.h"
+#include "tm4c123gh6pm_registers.h"
+
+#define GPTM_IS_WIDE(Timer)           ((Timer) >= GPTM_WTIMER0)
+#define GPTM_CLOCK_BIT(Timer)         (1u << (GPTM_IS_WIDE(Timer) ? ((Timer) - GPTM_WTIMER0) : (Timer)))
+
+static const uint32 g_GptmBase[GPTM_NUMBER_OF_TIMERS] =
+{
+    TIMER0_BASE, TIMER1_BASE, TIMER2_BASE, TIMER3_BASE, TIMER4_BASE, TIMER5_BASE,
+    WTIMER0_BASE, WTIMER1_BASE, WTIMER2_BASE, WTIMER3_BASE, WTIMER4_BASE, WTIMER5_BASE
+};
+
+static void (*g_GptmCallBacks[GPTM_NUMBER_OF_TIMERS][2])(void);
+
+/* Enable the clock of the timer in run, sleep and deep-sleep mode (a deadline wakes the core
+   from deep-sleep under auto clock gating) and wait until its registers can be accessed */
+static void GPTM_EnableClock(GPTM_TimerType Timer){
+
+    if(GPTM_IS_WIDE(Timer)){
+
+        SYSCTL_RCGCWTIMER_REG |= GPTM_CLOCK_BIT(Timer);
+        SYSCTL_SCGCWTIMER_REG |= GPTM_CLOCK_BIT(Timer);
+        SYSCTL_DCGCWTIMER_REG |= GPTM_CLOCK_BIT(Timer);
+        while(!(SYSCTL_PRWTIMER_REG & GPTM_CLOCK_BIT(Timer))){}
+    }
+    else{
+
+        SYSCTL_RCGCTIMER_REG |= GPTM_CLOCK_BIT(Timer);
+        SYSCTL_SCGCTIMER_REG |= GPTM_CLOCK_BIT(Timer);
+        SYSCTL_DCGCTIMER_REG |= GPTM_CLOCK_BIT(Timer);
+        while(!(SYSCTL_PRTIMER_REG & GPTM_CLOCK_BIT(Timer))){}
+    }
+}
+
+/*********************************************************************
+* Service Name: GPTM_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Timer, half, mode and period
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the period does not fit the counter, or when the
+*                         other half runs and the split/concatenated setting differs
+* Description: Function to clock the timer and configure it, stopped. A split half
+*              keeps the other half running. GPTMCFG, shared by both halves, is only
+*              written when it changes. Start it with GPTM_Start, the NVIC line of the
+*              half is enabled by the application.
+**********************************************************************/
+boolean GPTM_Init(const GPTM_ConfigType *Config){
+
+    uint32 base   = g_GptmBase[Config->timer];
+    boolean wide  = GPTM_IS_WIDE(Config->timer);
+    boolean concatenated = (Config->mode == GPTM_MODE_CONCATENATED_ONE_SHOT) ||
+                           (Config->mode == GPTM_MODE_CONCATENATED_PERIODIC);
+    uint32 shift  = (!concatenated && (Config->half == GPTM_HALF_B)) ? GPTM_CTL_B_SHIFT : 0;
+    uint32 cfg    = concatenated ? GPTM_CFG_CONCATENATED : GPTM_CFG_SPLIT;
+    uint32 other  = (uint32)GPTM_CTL_EN << (GPTM_CTL_B_SHIFT - shift);
+    boolean cfgChanged;
+    uint32 mode;
+    uint32 load;
+    uint32 prescale = 0;
+    uint32 interrupt;
+
+    if(Config->mode == GPTM_MODE_EDGE_TIME){
+
+        /*free running down counter, 24 bits with the prescaler as extension on the 16/32-bit timers*/
+        load      = wide ? 0xFFFFFFFF : 0xFFFF;
+        prescale  = wide ? 0 : 0xFF;
+        mode      = GPTM_TMR_CAPTURE | GPTM_TMR_CMR;
+        interrupt = GPTM_INT_CAPTURE_EVENT;
+    }
+    else{
+
+        if((Config->load == 0) ||
+           (concatenated && !wide && (Config->load > 0x100000000ULL)) ||
+           (!concatenated && wide && (Config->load > 0x100000000ULL)) ||
+           (!concatenated && !wide && (Config->load > 0x1000000))){
+            return FALSE;
+        }
+
+        if(!concatenated && !wide && (Config->load > 0x10000)){
+
+            /*the prescaler divides the clock in one-shot/periodic, period rounded down to a multiple*/
+            prescale = (uint32)((Config->load - 1) >> 16);
+            load     = (uint32)(Config->load / (prescale + 1)) - 1;
+        }
+        else{
+            load = (uint32)(Config->load - 1);
+        }
+        mode      = ((Config->mode == GPTM_MODE_ONE_SHOT) || (Config->mode == GPTM_MODE_CONCATENATED_ONE_SHOT)) ?
+                    GPTM_TMR_ONE_SHOT : GPTM_TMR_PERIODIC;
+        interrupt = GPTM_INT_TIMEOUT;
+    }
+
+    GPTM_EnableClock(Config->timer);
+
+    /* CFG may only change with both halves stopped, a running other half keeps it */
+    cfgChanged = (TIMER_CFG_REG(base) != cfg);
+    if(cfgChanged && (TIMER_CTL_REG(base) & other)){
+        return FALSE;
+    }
+
+    TIMER_CTL_REG(base) &= ~((uint32)(GPTM_CTL_EN | GPTM_CTL_STALL | (3u << GPTM_CTL_EVENT_BITS_POS)) << shift);
+    TIMER_IMR_REG(base) &= ~((uint32)GPTM_INT_HALF_MASK << shift);
+
+    if(cfgChanged){
+        TIMER_CFG_REG(base) = cfg;
+    }
+
+    if(concatenated){
+
+        TIMER_CTL_REG(base) &= ~((uint32)GPTM_CTL_EN << GPTM_CTL_B_SHIFT);
+        TIMER_TAMR_REG(base)  = mode;
+        TIMER_TAILR_REG(base) = load;
+        if(wide){
+            TIMER_TBILR_REG(base) = (uint32)((Config->load - 1) >> 32);   /*upper 32 bits of the 64-bit period*/
+        }
+    }
+    else{
+
+        if(Config->half == GPTM_HALF_A){
+            TIMER_TAMR_REG(base)  = mode;
+            TIMER_TAPR_REG(base)  = prescale;
+            TIMER_TAILR_REG(base) = load;
+        }
+        else{
+            TIMER_TBMR_REG(base)  = mode;
+            TIMER_TBPR_REG(base)  = prescale;
+            TIMER_TBILR_REG(base) = load;
+        }
+    }
+
+    /* Counters stop while the debugger halts the core, edge selection for capture */
+    TIMER_CTL_REG(base) |= ((uint32)GPTM_CTL_STALL |
+                            ((Config->mode == GPTM_MODE_EDGE_TIME) ? ((uint32)Config->edge << GPTM_CTL_EVENT_BITS_POS) : 0))
+                           << shift;
+
+    TIMER_ICR_REG(base) = (uint32)GPTM_INT_HALF_MASK << shift;
+    if(Config->interrupt){
+        TIMER_IMR_REG(base) |= interrupt << shift;
+    }
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: GPTM_Start
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half, GPTM_HALF_A when concatenated
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start counting (or capturing) from the load value.
+**********************************************************************/
+void GPTM_Start(GPTM_TimerType Timer, GPTM_HalfType Half){
+
+    TIMER_CTL_REG(g_GptmBase[Timer]) |= (uint32)GPTM_CTL_EN << ((Half == GPTM_HALF_B) ? GPTM_CTL_B_SHIFT : 0);
+}
+
+/*********************************************************************
+* Service Name: GPTM_Stop
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half, GPTM_HALF_A when concatenated
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop the half, the counter keeps its value.
+**********************************************************************/
+void GPTM_Stop(GPTM_TimerType Timer, GPTM_HalfType Half){
+
+    TIMER_CTL_REG(g_GptmBase[Timer]) &= ~((uint32)GPTM_CTL_EN << ((Half == GPTM_HALF_B) ? GPTM_CTL_B_SHIFT : 0));
+}
+
+/*********************************************************************
+* Service Name: GPTM_SetAdcTrigger
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half, GPTM_HALF_A when concatenated /
+*                  Enable - Trigger the ADC on every time-out
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start the ADC sequencers with the timer trigger on the
+*              time-out of the half, a periodic timer sets the sample rate.
+**********************************************************************/
+void GPTM_SetAdcTrigger(GPTM_TimerType Timer, GPTM_HalfType Half, boolean Enable){
+
+    uint32 bit = (uint32)GPTM_CTL_OTE << ((Half == GPTM_HALF_B) ? GPTM_CTL_B_SHIFT : 0);
+
+    if(Enable){
+        TIMER_CTL_REG(g_GptmBase[Timer]) |= bit;
+    }
+    else{
+        TIMER_CTL_REG(g_GptmBase[Timer]) &= ~bit;
+    }
+}
+
+/*********************************************************************
+* Service Name: GPTM_GetValue
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Free running counter (GPTMTnV)
+* Description: Function to read the counter of a half or of a 32-bit concatenated timer.
+**********************************************************************/
+uint32 GPTM_GetValue(GPTM_TimerType Timer, GPTM_HalfType Half){
+
+    uint32 base = g_GptmBase[Timer];
+
+    return (Half == GPTM_HALF_B) ? TIMER_TBV_REG(base) : TIMER_TAV_REG(base);
+}
+
+/*********************************************************************
+* Service Name: GPTM_GetValue64
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Concatenated 32/64-bit timer (WTIMERn)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint64 - Counter value
+* Description: Function to read both halves of a 64-bit counter without a tear: the
+*              upper half is read again when the lower half wrapped in between.
+**********************************************************************/
+uint64 GPTM_GetValue64(GPTM_TimerType Timer){
+
+    uint32 base = g_GptmBase[Timer];
+    uint32 high;
+    uint32 low;
+
+    do{
+        high = TIMER_TBV_REG(base);
+        low  = TIMER_TAV_REG(base);
+    }while(high != TIMER_TBV_REG(base));
+
+    return ((uint64)high << 32) | low;
+}
+
+/*********************************************************************
+* Service Name: GPTM_GetCapture
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half in edge-time mode
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Counter value latched on the last edge (GPTMTnR)
+* Description: Function to read the capture of the last edge, call it from the callback.
+**********************************************************************/
+uint32 GPTM_GetCapture(GPTM_TimerType Timer, GPTM_HalfType Half){
+
+    uint32 base = g_GptmBase[Timer];
+    uint32 capture = (Half == GPTM_HALF_B) ? TIMER_TBR_REG(base) : TIMER_TAR_REG(base);
+
+    return capture & (GPTM_IS_WIDE(Timer) ? GPTM_32_64_SPLIT_MASK : GPTM_16_32_SPLIT_MASK);
+}
+
+/*********************************************************************
+* Service Name: GPTM_CaptureTicks
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Earlier - First capture / Later - Second capture
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Ticks between the captures, one counter wrap at most
+* Description: Function to get a pulse width or period from two down-counting captures,
+*              divide by GPTM_TICKS_PER_US for microseconds.
+**********************************************************************/
+uint32 GPTM_CaptureTicks(GPTM_TimerType Timer, uint32 Earlier, uint32 Later){
+
+    return (Earlier - Later) & (GPTM_IS_WIDE(Timer) ? GPTM_32_64_SPLIT_MASK : GPTM_16_32_SPLIT_MASK);
+}
+
+/*********************************************************************
+* Service Name: GPTM_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half / Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called on the time-out or capture event.
+**********************************************************************/
+void GPTM_SetCallBack(GPTM_TimerType Timer, GPTM_HalfType Half, void (*Ptr2Func)(void)){
+
+    g_GptmCallBacks[Timer][Half] = Ptr2Func;
+}
+
+/*********************************************************************
+* Service Name: GPTM_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Timer - Timer / Half - Half
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the interrupt of a half and call its call back. The
+*              vector table entries GPTM_Timer0A_Handler ... GPTM_WTimer5B_Handler call it.
+**********************************************************************/
+void GPTM_Handler(GPTM_TimerType Timer, GPTM_HalfType Half){
+
+    TIMER_ICR_REG(g_GptmBase[Timer]) = (uint32)GPTM_INT_HALF_MASK << ((Half == GPTM_HALF_B) ? GPTM_INT_B_SHIFT : 0);
+
+    if(g_GptmCallBacks[Timer][Half] != NULL_PTR){
+        g_GptmCallBacks[Timer][Half]();
+    }
+}
+
+/* Vector table entries */
+#define GPTM_DEFINE_HANDLER(Name, Timer, Half)      void GPTM_##Name##_Handler(void){ GPTM_Handler(Timer, Half); }
+
+GPTM_DEFINE_HANDLER(Timer0A, GPTM_TIMER0, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(Timer0B, GPTM_TIMER0, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(Timer1A, GPTM_TIMER1, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(Timer1B, GPTM_TIMER1, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(Timer2A, GPTM_TIMER2, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(Timer2B, GPTM_TIMER2, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(Timer3A, GPTM_TIMER3, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(Timer3B, GPTM_TIMER3, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(Timer4A, GPTM_TIMER4, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(Timer4B, GPTM_TIMER4, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(Timer5A, GPTM_TIMER5, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(Timer5B, GPTM_TIMER5, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(WTimer0A, GPTM_WTIMER0, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(WTimer0B, GPTM_WTIMER0, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(WTimer1A, GPTM_WTIMER1, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(WTimer1B, GPTM_WTIMER1, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(WTimer2A, GPTM_WTIMER2, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(WTimer2B, GPTM_WTIMER2, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(WTimer3A, GPTM_WTIMER3, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(WTimer3B, GPTM_WTIMER3, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(WTimer4A, GPTM_WTIMER4, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(WTimer4B, GPTM_WTIMER4, GPTM_HALF_B)
+GPTM_DEFINE_HANDLER(WTimer5A, GPTM_WTIMER5, GPTM_HALF_A)
+GPTM_DEFINE_HANDLER(WTimer5B, GPTM_WTIMER5, GPTM_HALF_B)
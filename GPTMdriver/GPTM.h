@@ -0,0 +1,280 @@
+/******************************************************************************
+ *
+ * Module: GPTM
+ *
+ * File Name: GPTM.h
+ *
+ * Description: Header file for the TM4C123GH6PM General-Purpose Timer Module driver,
+ *              one-shot, periodic, concatenated 32/64-bit and edge-time capture modes
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef GPTM_H_
+#define GPTM_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Timer clock, the system clock like SysTick */
+#define GPTM_CLOCK_HZ                        16000000
+#define GPTM_TICKS_PER_US                    (GPTM_CLOCK_HZ / 1000000)
+
+#define GPTM_NUMBER_OF_TIMERS                12
+
+/* GPTMCFG values */
+#define GPTM_CFG_CONCATENATED                0x0
+#define GPTM_CFG_SPLIT                       0x4
+
+/* GPTMTnMR fields */
+#define GPTM_TMR_ONE_SHOT                    0x1
+#define GPTM_TMR_PERIODIC                    0x2
+#define GPTM_TMR_CAPTURE                     0x3
+#define GPTM_TMR_CMR                         0x4   /* edge-time capture     */
+#define GPTM_TMR_CDIR                        0x10  /* count up              */
+
+/* GPTMCTL fields, the B half is 8 bits above the A half */
+#define GPTM_CTL_EN                          0x1
+#define GPTM_CTL_STALL                       0x2   /* freeze in debug halt  */
+#define GPTM_CTL_EVENT_BITS_POS              2
+#define GPTM_CTL_OTE                         0x20  /* ADC trigger on time-out */
+#define GPTM_CTL_B_SHIFT                     8
+
+/* GPTMIMR/RIS/MIS/ICR fields, the B half is 8 bits above the A half */
+#define GPTM_INT_TIMEOUT                     0x1
+#define GPTM_INT_CAPTURE_MATCH               0x2
+#define GPTM_INT_CAPTURE_EVENT               0x4
+#define GPTM_INT_HALF_MASK                   0x1F
+#define GPTM_INT_B_SHIFT                     8
+
+/* Counter widths of one half */
+#define GPTM_16_32_SPLIT_MASK                0x00FFFFFF   /* 16 bits + 8 bit prescaler  */
+#define GPTM_32_64_SPLIT_MASK                0xFFFFFFFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    GPTM_TIMER0, GPTM_TIMER1, GPTM_TIMER2, GPTM_TIMER3, GPTM_TIMER4, GPTM_TIMER5,
+    GPTM_WTIMER0, GPTM_WTIMER1, GPTM_WTIMER2, GPTM_WTIMER3, GPTM_WTIMER4, GPTM_WTIMER5
+}GPTM_TimerType;
+
+typedef enum
+{
+    GPTM_HALF_A, GPTM_HALF_B
+}GPTM_HalfType;
+
+typedef enum
+{
+    GPTM_MODE_ONE_SHOT,
+    GPTM_MODE_PERIODIC,
+    GPTM_MODE_CONCATENATED_ONE_SHOT,   /* both halves as one 32-bit (TIMERn) or 64-bit (WTIMERn) counter */
+    GPTM_MODE_CONCATENATED_PERIODIC,
+    GPTM_MODE_EDGE_TIME                /* counter value latched on every selected edge of the CCP pin */
+}GPTM_ModeType;
+
+typedef enum
+{
+    GPTM_EDGE_RISING  = 0,
+    GPTM_EDGE_FALLING = 1,
+    GPTM_EDGE_BOTH    = 3
+}GPTM_EdgeType;
+
+/*
+ * Configuration of one timer half, or of the whole timer in the concatenated modes
+ * (Half is then ignored and the interrupt comes from the A half). The CCP pin of the
+ * edge-time mode is muxed by the application (GPIOAFSEL/GPIOPCTL).
+ */
+typedef struct
+{
+    GPTM_TimerType timer;
+    GPTM_HalfType half;
+    GPTM_ModeType mode;
+    GPTM_EdgeType edge;                 /* edge-time mode only                       */
+    uint64 load;                        /* ticks per period, ignored in edge-time    */
+    boolean interrupt;                  /* time-out / capture event interrupt        */
+}GPTM_ConfigType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: GPTM_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Timer, half, mode and period
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the period does not fit the counter, or when the
+*                         other half runs and the split/concatenated setting differs
+* Description: Function to clock the timer and configure it, stopped. A split half
+*              keeps the other half running. GPTMCFG, shared by both halves, is only
+*              written when it changes. Start it with GPTM_Start, the NVIC line of the
+*              half is enabled by the application.
+**********************************************************************/
+
+boolean GPTM_Init(const GPTM_ConfigType *Config);
+
+/*********************************************************************
+* Service Name: GPTM_Start
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half, GPTM_HALF_A when concatenated
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start counting (or capturing) from the load value.
+**********************************************************************/
+
+void GPTM_Start(GPTM_TimerType Timer, GPTM_HalfType Half);
+
+/*********************************************************************
+* Service Name: GPTM_Stop
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half, GPTM_HALF_A when concatenated
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop the half, the counter keeps its value.
+**********************************************************************/
+
+void GPTM_Stop(GPTM_TimerType Timer, GPTM_HalfType Half);
+
+/*********************************************************************
+* Service Name: GPTM_SetAdcTrigger
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half, GPTM_HALF_A when concatenated /
+*                  Enable - Trigger the ADC on every time-out
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start the ADC sequencers with the timer trigger on the
+*              time-out of the half, a periodic timer sets the sample rate.
+**********************************************************************/
+
+void GPTM_SetAdcTrigger(GPTM_TimerType Timer, GPTM_HalfType Half, boolean Enable);
+
+/*********************************************************************
+* Service Name: GPTM_GetValue
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Free running counter (GPTMTnV)
+* Description: Function to read the counter of a half or of a 32-bit concatenated timer.
+**********************************************************************/
+
+uint32 GPTM_GetValue(GPTM_TimerType Timer, GPTM_HalfType Half);
+
+/*********************************************************************
+* Service Name: GPTM_GetValue64
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Concatenated 32/64-bit timer (WTIMERn)
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint64 - Counter value
+* Description: Function to read both halves of a 64-bit counter without a tear: the
+*              upper half is read again when the lower half wrapped in between.
+**********************************************************************/
+
+uint64 GPTM_GetValue64(GPTM_TimerType Timer);
+
+/*********************************************************************
+* Service Name: GPTM_GetCapture
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half in edge-time mode
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Counter value latched on the last edge (GPTMTnR)
+* Description: Function to read the capture of the last edge, call it from the callback.
+**********************************************************************/
+
+uint32 GPTM_GetCapture(GPTM_TimerType Timer, GPTM_HalfType Half);
+
+/*********************************************************************
+* Service Name: GPTM_CaptureTicks
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Earlier - First capture / Later - Second capture
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Ticks between the captures, one counter wrap at most
+* Description: Function to get a pulse width or period from two down-counting captures,
+*              divide by GPTM_TICKS_PER_US for microseconds.
+**********************************************************************/
+
+uint32 GPTM_CaptureTicks(GPTM_TimerType Timer, uint32 Earlier, uint32 Later);
+
+/*********************************************************************
+* Service Name: GPTM_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Timer - Timer / Half - Half / Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called on the time-out or capture event.
+**********************************************************************/
+
+void GPTM_SetCallBack(GPTM_TimerType Timer, GPTM_HalfType Half, void (*Ptr2Func)(void));
+
+/*********************************************************************
+* Service Name: GPTM_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Timer - Timer / Half - Half
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the interrupt of a half and call its call back. The
+*              vector table entries GPTM_Timer0A_Handler ... GPTM_WTimer5B_Handler call it.
+**********************************************************************/
+
+void GPTM_Handler(GPTM_TimerType Timer, GPTM_HalfType Half);
+
+/* Vector table entries, one per NVIC_16_32_TIMER_nx_IRQ / NVIC_32_64_TIMER_nx_IRQ */
+void GPTM_Timer0A_Handler(void);
+void GPTM_Timer0B_Handler(void);
+void GPTM_Timer1A_Handler(void);
+void GPTM_Timer1B_Handler(void);
+void GPTM_Timer2A_Handler(void);
+void GPTM_Timer2B_Handler(void);
+void GPTM_Timer3A_Handler(void);
+void GPTM_Timer3B_Handler(void);
+void GPTM_Timer4A_Handler(void);
+void GPTM_Timer4B_Handler(void);
+void GPTM_Timer5A_Handler(void);
+void GPTM_Timer5B_Handler(void);
+void GPTM_WTimer0A_Handler(void);
+void GPTM_WTimer0B_Handler(void);
+void GPTM_WTimer1A_Handler(void);
+void GPTM_WTimer1B_Handler(void);
+void GPTM_WTimer2A_Handler(void);
+void GPTM_WTimer2B_Handler(void);
+void GPTM_WTimer3A_Handler(void);
+void GPTM_WTimer3B_Handler(void);
+void GPTM_WTimer4A_Handler(void);
+void GPTM_WTimer4B_Handler(void);
+void GPTM_WTimer5A_Handler(void);
+void GPTM_WTimer5B_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* GPTM_H_ */
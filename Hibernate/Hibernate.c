@@ -0,0 +1,191 @@
+/******************************************************************************
+ *
+ * Module: Hibernate
+ *
+ * File Name: Hibernate.c
+ *
+ * Description: Source file for the hibernation module driver. Powers the device
+ *              down until an RTC match (or the WAKE pin) and keeps a small
+ *              application state in the battery-backed HIBDATA words across it
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Hibernate.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* HIBCTL */
+#define HIBERNATE_CTL_RTCEN           0x00000001
+#define HIBERNATE_CTL_HIBREQ          0x00000002
+#define HIBERNATE_CTL_RTCWEN          0x00000008
+#define HIBERNATE_CTL_PINWEN          0x00000010
+#define HIBERNATE_CTL_CLK32EN         0x00000040
+#define HIBERNATE_CTL_VABORT          0x00000080
+#define HIBERNATE_CTL_WRC             0x80000000
+
+/* HIBRIS and HIBIC wake causes */
+#define HIBERNATE_INT_RTCALT0         0x00000001
+#define HIBERNATE_INT_EXTW            0x00000008
+
+/* HIBDATA word 0: magic in bits 24-31, state words in bits 16-23, check in bits 0-15 */
+#define HIBERNATE_MAGIC               0xA5000000
+
+static uint32 Hibernate_Header(const uint32 *State, uint8 Words){
+
+    uint32 check = Words;
+    uint8 i;
+
+    for(i = 0; i < Words; i++){
+        check = ((check << 1) | (check >> 31)) ^ State[i];
+    }
+    check ^= check >> 16;
+
+    return HIBERNATE_MAGIC | ((uint32)Words << 16) | (check & 0xFFFF);
+}
+
+/* The module runs on the 32 kHz clock, a write waits for the previous one to land */
+static void Hibernate_WaitWrite(void){
+
+    while(!(HIB_CTL_REG & HIBERNATE_CTL_WRC)){}
+}
+
+/*********************************************************************
+* Service Name: Hibernate_Resume
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Words - Length of the state
+* Parameters (inout): None
+* Parameters (out): State - State saved by Hibernate_Enter
+* Return value: Hibernate_WakeType - Cause, HIBERNATE_WAKE_NONE when State is not
+*                                    restored
+* Description: Function to call first after every reset. Restores the state when the
+*              module kept running and the saved one has Words words, and clears the
+*              wake cause so a later reset reads HIBERNATE_WAKE_RESET. Reads only,
+*              apart from that one write.
+**********************************************************************/
+Hibernate_WakeType Hibernate_Resume(uint32 *State, uint8 Words){
+
+    uint32 saved[HIBERNATE_STATE_WORDS];
+    Hibernate_WakeType cause = HIBERNATE_WAKE_RESET;
+    uint32 wake;
+    uint8 i;
+
+    SYSCTL_RCGCHIB_REG |= 0x1;
+    SYSCTL_SCGCHIB_REG |= 0x1;
+    SYSCTL_DCGCHIB_REG |= 0x1;
+    while(!(SYSCTL_PRHIB_REG & 0x1)){}
+
+    /* Oscillator off: first power up or the battery was removed */
+    if((Words > HIBERNATE_STATE_WORDS) || !(HIB_CTL_REG & HIBERNATE_CTL_CLK32EN)){
+        return HIBERNATE_WAKE_NONE;
+    }
+
+    for(i = 0; i < Words; i++){
+        saved[i] = HIB_DATA_REG(i + 1);
+    }
+    if(HIB_DATA_REG(0) != Hibernate_Header(saved, Words)){
+        return HIBERNATE_WAKE_NONE;
+    }
+
+    wake = HIB_RIS_REG & (HIBERNATE_INT_RTCALT0 | HIBERNATE_INT_EXTW);
+    if(wake & HIBERNATE_INT_RTCALT0){
+        cause = HIBERNATE_WAKE_RTC;
+    }
+    else if(wake & HIBERNATE_INT_EXTW){
+        cause = HIBERNATE_WAKE_PIN;
+    }
+
+    /* Nothing was written since the wake, WRC is already set */
+    if(wake != 0){
+        Hibernate_WaitWrite();
+        HIB_IC_REG = wake;
+    }
+
+    for(i = 0; i < Words; i++){
+        State[i] = saved[i];
+    }
+
+    return cause;
+}
+
+/*********************************************************************
+* Service Name: Hibernate_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Wake sources
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start the 32 kHz oscillator and the RTC on a cold start.
+*              Not needed after a wake, the module keeps running on the battery.
+**********************************************************************/
+void Hibernate_Init(const Hibernate_ConfigType *Config){
+
+    /* The wake sources live in HIBCTL, so Hibernate_Enter needs no RAM state */
+    uint32 ctl = HIBERNATE_CTL_CLK32EN | HIBERNATE_CTL_RTCEN | HIBERNATE_CTL_RTCWEN |
+                 (Config->pinWake ? HIBERNATE_CTL_PINWEN : 0) |
+                 (Config->lowBatteryAbort ? HIBERNATE_CTL_VABORT : 0);
+
+    SYSCTL_RCGCHIB_REG |= 0x1;
+    SYSCTL_SCGCHIB_REG |= 0x1;
+    SYSCTL_DCGCHIB_REG |= 0x1;
+    while(!(SYSCTL_PRHIB_REG & 0x1)){}
+
+    Hibernate_WaitWrite();
+    HIB_CTL_REG = HIBERNATE_CTL_CLK32EN;
+    Hibernate_WaitWrite();
+    HIB_CTL_REG = ctl;
+    Hibernate_WaitWrite();
+}
+
+/*********************************************************************
+* Service Name: Hibernate_Enter
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Seconds - Time to the RTC wake / State - State to keep /
+*                  Words - Length of the state
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for 0 seconds or more than HIBERNATE_STATE_WORDS
+* Description: Function to save the state and request the hibernation. Only the
+*              HIBDATA words that changed are written. The power goes off a few
+*              cycles later, the caller waits for it in a loop; still running then
+*              means the request was refused on a low battery.
+**********************************************************************/
+boolean Hibernate_Enter(uint32 Seconds, const uint32 *State, uint8 Words){
+
+    uint32 header;
+    uint32 wake;
+    uint8 i;
+
+    if((Seconds == 0) || (Words > HIBERNATE_STATE_WORDS)){
+        return FALSE;
+    }
+
+    /* A read is a bus access, a write waits for WRC: skip the words that hold already */
+    for(i = 0; i < Words; i++){
+        if(HIB_DATA_REG(i + 1) != State[i]){
+            Hibernate_WaitWrite();
+            HIB_DATA_REG(i + 1) = State[i];
+        }
+    }
+    header = Hibernate_Header(State, Words);
+    if(HIB_DATA_REG(0) != header){
+        Hibernate_WaitWrite();
+        HIB_DATA_REG(0) = header;
+    }
+
+    /* A cause left from this run would read as the next wake */
+    wake = HIB_RIS_REG & (HIBERNATE_INT_RTCALT0 | HIBERNATE_INT_EXTW);
+    if(wake != 0){
+        Hibernate_WaitWrite();
+        HIB_IC_REG = wake;
+    }
+
+    Hibernate_WaitWrite();
+    HIB_RTCM0_REG = HIB_RTCC_REG + Seconds;
+    Hibernate_WaitWrite();
+    HIB_CTL_REG |= HIBERNATE_CTL_HIBREQ;
+
+    return TRUE;
+}
@@ -0,0 +1,112 @@
+/******************************************************************************
+ *
+ * Module: Hibernate
+ *
+ * File Name: Hibernate.h
+ *
+ * Description: Header file for the hibernation module driver. Powers the device
+ *              down until an RTC match (or the WAKE pin) and keeps a small
+ *              application state in the battery-backed HIBDATA words across it
+ *
+ *              A wake is a reset through ResetISR, so the saving is in what main
+ *              skips: Hibernate_Resume only reads the module, while the cold path
+ *              starts the 32 kHz oscillator and every HIB write waits for WRC
+ *              (about 92 us). Start of main:
+ *                  if(Hibernate_Resume(state, n) == HIBERNATE_WAKE_NONE){
+ *                      full init, Hibernate_Init(&config);
+ *                  }
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef HIBERNATE_H_
+#define HIBERNATE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* HIBDATA words for the application, the first one checks them */
+#define HIBERNATE_STATE_WORDS                15
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    HIBERNATE_WAKE_NONE,                /* cold start or no valid state, nothing restored */
+    HIBERNATE_WAKE_RTC,                 /* RTC match, state restored                      */
+    HIBERNATE_WAKE_PIN,                 /* WAKE pin, state restored                       */
+    HIBERNATE_WAKE_RESET                /* reset with the module running, state restored  */
+}Hibernate_WakeType;
+
+typedef struct
+{
+    boolean pinWake;                    /* WAKE pin low also ends the hibernation         */
+    boolean lowBatteryAbort;            /* refuse to hibernate on a low battery           */
+}Hibernate_ConfigType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Hibernate_Resume
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Words - Length of the state
+* Parameters (inout): None
+* Parameters (out): State - State saved by Hibernate_Enter
+* Return value: Hibernate_WakeType - Cause, HIBERNATE_WAKE_NONE when State is not
+*                                    restored
+* Description: Function to call first after every reset. Restores the state when the
+*              module kept running and the saved one has Words words, and clears the
+*              wake cause so a later reset reads HIBERNATE_WAKE_RESET. Reads only,
+*              apart from that one write.
+**********************************************************************/
+
+Hibernate_WakeType Hibernate_Resume(uint32 *State, uint8 Words);
+
+/*********************************************************************
+* Service Name: Hibernate_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Wake sources
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to start the 32 kHz oscillator and the RTC on a cold start.
+*              Not needed after a wake, the module keeps running on the battery.
+**********************************************************************/
+
+void Hibernate_Init(const Hibernate_ConfigType *Config);
+
+/*********************************************************************
+* Service Name: Hibernate_Enter
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Seconds - Time to the RTC wake / State - State to keep /
+*                  Words - Length of the state
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for 0 seconds or more than HIBERNATE_STATE_WORDS
+* Description: Function to save the state and request the hibernation. Only the
+*              HIBDATA words that changed are written. The power goes off a few
+*              cycles later, the caller waits for it in a loop; still running then
+*              means the request was refused on a low battery.
+**********************************************************************/
+
+boolean Hibernate_Enter(uint32 Seconds, const uint32 *State, uint8 Words);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* HIBERNATE_H_ */
@@ -0,0 +1,122 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: AdcSequence.c
+ *
+ * Description: Host check of the sample sequencer encoding. ADC_EncodeSequence touches
+ *              no register, so every configuration is encoded directly and the
+ *              register values are compared with the ones worked out from the datasheet
+ *
+ *              adc_sequence
+ *
+ *              The activity is a list of tokens:
+ *                  mux=m         ADCSSMUXn
+ *                  ctl=c         ADCSSCTLn
+ *                  emux=v/f      ADCEMUX value and field of the sequencer
+ *                  pri=v/f       ADCSSPRI value and field of the sequencer
+ *                  rejected      ADC_EncodeSequence returned FALSE
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "ADC.h"
+
+#define ADC_SEQUENCE_LOG_SIZE      1024
+
+static char g_Log[ADC_SEQUENCE_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void AdcSequence_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < ADC_SEQUENCE_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+static void AdcSequence_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+/* Encodes the sequence, Inputs holds Steps entries */
+static void AdcSequence_Encode(ADC_SequencerType Sequencer, ADC_TriggerType Trigger, uint8 Priority,
+                               uint8 Steps, const uint8 *Inputs){
+
+    ADC_SequenceConfigType config;
+    ADC_SequenceRegsType regs;
+    char token[32];
+
+    memset(&config, 0, sizeof(config));
+    config.module    = ADC_MODULE0;
+    config.sequencer = Sequencer;
+    config.trigger   = Trigger;
+    config.priority  = Priority;
+    config.steps     = Steps;
+    memcpy(config.inputs, Inputs, (Steps < 8) ? Steps : 8);
+
+    if(!ADC_EncodeSequence(&config, &regs)){
+        AdcSequence_Log("rejected");
+        return;
+    }
+
+    sprintf(token, "mux=%08X", (unsigned)regs.ssmux);
+    AdcSequence_Log(token);
+    sprintf(token, "ctl=%08X", (unsigned)regs.ssctl);
+    AdcSequence_Log(token);
+    sprintf(token, "emux=%04X/%04X", (unsigned)regs.emux, (unsigned)regs.emuxMask);
+    AdcSequence_Log(token);
+    sprintf(token, "pri=%04X/%04X", (unsigned)regs.sspri, (unsigned)regs.ssprioMask);
+    AdcSequence_Log(token);
+}
+
+int main(void){
+
+    static const uint8 ramp[8]     = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    static const uint8 mixed[3]    = { 11, ADC_INPUT_TEMP, 2 };
+    static const uint8 temp[1]     = { ADC_INPUT_TEMP };
+    static const uint8 inner[4]    = { 4, ADC_INPUT_TEMP, ADC_INPUT_TEMP, 9 };
+    static const uint8 wrong[2]    = { 3, ADC_NUMBER_OF_INPUTS };
+
+    /* Eight steps, END and IE on step 7 only */
+    AdcSequence_Encode(ADC_SEQUENCER0, ADC_TRIGGER_PROCESSOR, 3, 8, ramp);
+    AdcSequence_Check("ss0 processor 8 steps", "mux=76543210 ctl=60000000 emux=0000/000F pri=0003/0003");
+
+    /* A temperature step leaves its MUX nibble at 0 and sets TS */
+    AdcSequence_Encode(ADC_SEQUENCER1, ADC_TRIGGER_TIMER, 1, 3, mixed);
+    AdcSequence_Check("ss1 timer temperature", "mux=0000020B ctl=00000680 emux=0050/00F0 pri=0010/0030");
+
+    AdcSequence_Encode(ADC_SEQUENCER2, ADC_TRIGGER_PWM2, 2, 4, inner);
+    AdcSequence_Check("ss2 pwm2 4 steps", "mux=00009004 ctl=00006880 emux=0800/0F00 pri=0200/0300");
+
+    /* The single step is the last one too */
+    AdcSequence_Encode(ADC_SEQUENCER3, ADC_TRIGGER_ALWAYS, 0, 1, temp);
+    AdcSequence_Check("ss3 always temperature", "mux=00000000 ctl=0000000E emux=F000/F000 pri=0000/3000");
+
+    /* More steps than the FIFO depth, none, an unknown input or priority */
+    AdcSequence_Encode(ADC_SEQUENCER0, ADC_TRIGGER_PROCESSOR, 0, 9, ramp);
+    AdcSequence_Encode(ADC_SEQUENCER1, ADC_TRIGGER_PROCESSOR, 0, 5, ramp);
+    AdcSequence_Encode(ADC_SEQUENCER2, ADC_TRIGGER_PROCESSOR, 0, 5, ramp);
+    AdcSequence_Encode(ADC_SEQUENCER3, ADC_TRIGGER_PROCESSOR, 0, 2, ramp);
+    AdcSequence_Check("too many steps", "rejected rejected rejected rejected");
+
+    AdcSequence_Encode(ADC_SEQUENCER0, ADC_TRIGGER_PROCESSOR, 0, 0, ramp);
+    AdcSequence_Encode(ADC_SEQUENCER1, ADC_TRIGGER_PROCESSOR, 0, 2, wrong);
+    AdcSequence_Encode(ADC_SEQUENCER1, ADC_TRIGGER_PROCESSOR, 4, 2, ramp);
+    AdcSequence_Check("bad configuration", "rejected rejected rejected");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,434 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: CanFilter.c
+ *
+ * Description: Host model of the CAN0 message objects. Keeps the message RAM behind
+ *              the IF1/IF2 interface registers, matches frames put on the bus against
+ *              the receive objects the way the controller does, FIFO chains included,
+ *              and checks what CAN.c delivers to the ring
+ *
+ *              can_filter
+ *
+ *              The activity is a list of tokens:
+ *                  iii/f         frame iii taken from the ring, accepted by filter f
+ *                  iii:dd        frame iii with first data byte dd
+ *                  !             appended when an older frame of the object was lost
+ *                  txiii:dd      frame sent by a transmit object
+ *                  irqn          handler runs
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "HostRegisters.h"
+#include "tm4c123gh6pm_registers.h"
+#include "CAN.h"
+
+#define CAN_FILTER_LOG_SIZE        4096
+
+/* Registers the check plays the hardware side of */
+#define CAN_FILTER_INT             (CAN0_BASE + 0x010)
+#define CAN_FILTER_IF1CRQ          (CAN0_BASE + 0x020)
+#define CAN_FILTER_IF2CRQ          (CAN0_BASE + 0x080)
+#define CAN_FILTER_TXRQ1           (CAN0_BASE + 0x100)
+#define CAN_FILTER_TXRQ2           (CAN0_BASE + 0x104)
+
+/* Interface registers from CANIFnCRQ */
+#define CAN_FILTER_CMSK            0x04
+#define CAN_FILTER_MSK1            0x08
+#define CAN_FILTER_MSK2            0x0C
+#define CAN_FILTER_ARB1            0x10
+#define CAN_FILTER_ARB2            0x14
+#define CAN_FILTER_MCTL            0x18
+#define CAN_FILTER_DA1             0x1C
+#define CAN_FILTER_DA2             0x20
+#define CAN_FILTER_DB1             0x24
+#define CAN_FILTER_DB2             0x28
+
+#define CAN_FILTER_CMSK_WRNRD      0x80
+#define CAN_FILTER_CMSK_MASK       0x40
+#define CAN_FILTER_CMSK_ARB        0x20
+#define CAN_FILTER_CMSK_CONTROL    0x10
+#define CAN_FILTER_CMSK_CLRINTPND  0x08
+#define CAN_FILTER_CMSK_NEWDAT     0x04
+#define CAN_FILTER_CMSK_DATAA      0x02
+#define CAN_FILTER_CMSK_DATAB      0x01
+
+#define CAN_FILTER_MXTD            0x8000
+#define CAN_FILTER_MSGVAL          0x8000
+#define CAN_FILTER_XTD             0x4000
+#define CAN_FILTER_DIR             0x2000
+
+#define CAN_FILTER_NEWDAT          0x8000
+#define CAN_FILTER_MSGLST          0x4000
+#define CAN_FILTER_INTPND          0x2000
+#define CAN_FILTER_UMASK           0x1000
+#define CAN_FILTER_RXIE            0x0400
+#define CAN_FILTER_TXRQST          0x0100
+#define CAN_FILTER_EOB             0x0080
+
+/* Written values differ from every value the slot holds, so each write is seen */
+#define CAN_FILTER_WRITTEN         0x10000
+
+typedef struct
+{
+    uint32 msk1;
+    uint32 msk2;
+    uint32 arb1;
+    uint32 arb2;
+    uint32 mctl;
+    uint32 data[4];
+}CanFilter_ObjectType;
+
+static CanFilter_ObjectType g_Objects[CAN_NUMBER_OF_OBJECTS + 1];
+static boolean g_BusBusy = FALSE;
+
+static char g_Log[CAN_FILTER_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void CanFilter_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < CAN_FILTER_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+static uint32 CanFilter_Id(const CanFilter_ObjectType *Object){
+
+    if(Object->arb2 & CAN_FILTER_XTD){
+        return ((Object->arb2 & 0x1FFF) << 16) | (Object->arb1 & 0xFFFF);
+    }
+    return (Object->arb2 >> 2) & 0x7FF;
+}
+
+/* Send the requested transmit objects on a free bus, then raise CANINT and CANTXRQn */
+static void CanFilter_Update(void){
+
+    uint32 txrq = 0;
+    uint32 pending = 0;
+    uint32 object;
+
+    for(object = 1; object <= CAN_NUMBER_OF_OBJECTS; object++){
+
+        CanFilter_ObjectType *o = &g_Objects[object];
+
+        if((o->mctl & CAN_FILTER_TXRQST) && !g_BusBusy){
+
+            char token[24];
+
+            sprintf(token, "tx%03x:%02x", (unsigned)CanFilter_Id(o), (unsigned)(o->data[0] & 0xFF));
+            CanFilter_Log(token);
+            o->mctl &= ~CAN_FILTER_TXRQST;
+        }
+        if(o->mctl & CAN_FILTER_TXRQST){
+            txrq |= 1u << (object - 1);
+        }
+        if((o->mctl & CAN_FILTER_INTPND) && (pending == 0)){
+            pending = object;
+        }
+    }
+
+    HostReg_Poke(CAN_FILTER_TXRQ1, txrq & 0xFFFF);
+    HostReg_Poke(CAN_FILTER_TXRQ2, txrq >> 16);
+    HostReg_Poke(CAN_FILTER_INT, pending);
+}
+
+/* A write of CANIFnCRQ moves the interface registers to or from the message RAM */
+static uint32 CanFilter_Transfer(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    uint32 object = NewValue & 0x3F;
+    uint32 cmsk = HostReg_Peek(Address + CAN_FILTER_CMSK);
+    CanFilter_ObjectType *o;
+
+    (void)OldValue;
+    if((object == 0) || (object > CAN_NUMBER_OF_OBJECTS)){
+        return CAN_FILTER_WRITTEN | NewValue;
+    }
+    o = &g_Objects[object];
+
+    if(cmsk & CAN_FILTER_CMSK_WRNRD){
+
+        if(cmsk & CAN_FILTER_CMSK_MASK){
+            o->msk1 = HostReg_Peek(Address + CAN_FILTER_MSK1);
+            o->msk2 = HostReg_Peek(Address + CAN_FILTER_MSK2);
+        }
+        if(cmsk & CAN_FILTER_CMSK_ARB){
+            o->arb1 = HostReg_Peek(Address + CAN_FILTER_ARB1);
+            o->arb2 = HostReg_Peek(Address + CAN_FILTER_ARB2);
+        }
+        if(cmsk & CAN_FILTER_CMSK_CONTROL){
+            o->mctl = HostReg_Peek(Address + CAN_FILTER_MCTL);
+        }
+        if(cmsk & CAN_FILTER_CMSK_DATAA){
+            o->data[0] = HostReg_Peek(Address + CAN_FILTER_DA1);
+            o->data[1] = HostReg_Peek(Address + CAN_FILTER_DA2);
+        }
+        if(cmsk & CAN_FILTER_CMSK_DATAB){
+            o->data[2] = HostReg_Peek(Address + CAN_FILTER_DB1);
+            o->data[3] = HostReg_Peek(Address + CAN_FILTER_DB2);
+        }
+        if(cmsk & CAN_FILTER_CMSK_NEWDAT){
+            o->mctl |= CAN_FILTER_TXRQST;
+        }
+    }
+    else{
+
+        if(cmsk & CAN_FILTER_CMSK_MASK){
+            HostReg_Poke(Address + CAN_FILTER_MSK1, o->msk1);
+            HostReg_Poke(Address + CAN_FILTER_MSK2, o->msk2);
+        }
+        if(cmsk & CAN_FILTER_CMSK_ARB){
+            HostReg_Poke(Address + CAN_FILTER_ARB1, o->arb1);
+            HostReg_Poke(Address + CAN_FILTER_ARB2, o->arb2);
+        }
+        if(cmsk & CAN_FILTER_CMSK_CONTROL){
+            HostReg_Poke(Address + CAN_FILTER_MCTL, o->mctl);
+        }
+        if(cmsk & CAN_FILTER_CMSK_DATAA){
+            HostReg_Poke(Address + CAN_FILTER_DA1, o->data[0]);
+            HostReg_Poke(Address + CAN_FILTER_DA2, o->data[1]);
+        }
+        if(cmsk & CAN_FILTER_CMSK_DATAB){
+            HostReg_Poke(Address + CAN_FILTER_DB1, o->data[2]);
+            HostReg_Poke(Address + CAN_FILTER_DB2, o->data[3]);
+        }
+        if(cmsk & CAN_FILTER_CMSK_CLRINTPND){
+            o->mctl &= ~CAN_FILTER_INTPND;
+        }
+        if(cmsk & CAN_FILTER_CMSK_NEWDAT){
+            o->mctl &= ~CAN_FILTER_NEWDAT;
+        }
+    }
+
+    CanFilter_Update();
+
+    return CAN_FILTER_WRITTEN | NewValue;
+}
+
+/*
+ * A data frame on the bus. The first valid receive object whose masked ID matches
+ * takes it, an object of a FIFO still holding a frame passes it on to the next one
+ * and the object ending the FIFO is overwritten. Returns the object, 0 when no
+ * object accepts the frame.
+ */
+static uint32 CanFilter_Deliver(uint32 Id, boolean Extended, uint8 Data0){
+
+    uint32 arb1 = Extended ? (Id & 0xFFFF) : 0;
+    uint32 arb2 = Extended ? (CAN_FILTER_XTD | ((Id >> 16) & 0x1FFF)) : ((Id & 0x7FF) << 2);
+    uint32 object;
+
+    for(object = 1; object <= CAN_NUMBER_OF_OBJECTS; object++){
+
+        CanFilter_ObjectType *o = &g_Objects[object];
+        uint32 msk1 = 0xFFFF;
+        uint32 msk2 = CAN_FILTER_MXTD | 0x1FFF;
+
+        if(!(o->arb2 & CAN_FILTER_MSGVAL) || (o->arb2 & CAN_FILTER_DIR)){
+            continue;
+        }
+        if(o->mctl & CAN_FILTER_UMASK){
+            msk1 = o->msk1;
+            msk2 = o->msk2;
+        }
+        if((msk2 & CAN_FILTER_MXTD) && ((o->arb2 ^ arb2) & CAN_FILTER_XTD)){
+            continue;
+        }
+        if(((o->arb2 ^ arb2) & msk2 & 0x1FFF) || (Extended && ((o->arb1 ^ arb1) & msk1 & 0xFFFF))){
+            continue;
+        }
+        if((o->mctl & CAN_FILTER_NEWDAT) && !(o->mctl & CAN_FILTER_EOB)){
+            continue;
+        }
+
+        if(o->mctl & CAN_FILTER_NEWDAT){
+            o->mctl |= CAN_FILTER_MSGLST;
+        }
+        o->arb1 = arb1;
+        o->arb2 = (o->arb2 & (CAN_FILTER_MSGVAL | CAN_FILTER_DIR)) | arb2;
+        o->data[0] = Data0;
+        o->data[1] = 0;
+        o->data[2] = 0;
+        o->data[3] = 0;
+        o->mctl = (o->mctl & ~0xF) | CAN_FILTER_NEWDAT | 1;
+        if(o->mctl & CAN_FILTER_RXIE){
+            o->mctl |= CAN_FILTER_INTPND;
+        }
+        CanFilter_Update();
+
+        return object;
+    }
+
+    return 0;
+}
+
+static uint32 g_Interrupts = 0;
+
+/* The NVIC: the handler runs while CANINT is not 0 */
+static void CanFilter_Interrupt(void){
+
+    HostReg_Sync();
+    if(HostReg_Peek(CAN_FILTER_INT) != 0){
+        g_Interrupts++;
+        CAN_Handler(CAN_MODULE0);
+    }
+}
+
+/* Take the ring empty, logging iii/f or iii:dd tokens */
+static void CanFilter_Drain(boolean WithData){
+
+    const CAN_FrameType *frame;
+    char token[32];
+
+    while((frame = CAN_Receive(CAN_MODULE0)) != NULL_PTR){
+
+        if(WithData){
+            sprintf(token, "%03x:%02x%s", (unsigned)frame->id, (unsigned)frame->data[0],
+                    (frame->flags & CAN_FRAME_OVERRUN) ? "!" : "");
+        }
+        else{
+            sprintf(token, "%03x%s/%u", (unsigned)frame->id, (frame->flags & CAN_FRAME_EXTENDED) ? "x" : "",
+                    (unsigned)frame->filter);
+        }
+        CanFilter_Log(token);
+        CAN_Release(CAN_MODULE0);
+    }
+}
+
+static void CanFilter_LogInterrupts(void){
+
+    char token[16];
+
+    sprintf(token, "irq%u", (unsigned)g_Interrupts);
+    CanFilter_Log(token);
+    g_Interrupts = 0;
+}
+
+static void CanFilter_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+int main(void){
+
+    static const CAN_FilterType wanted[3] =
+    {
+        { 0x100,      CAN_MASK_STANDARD_EXACT, FALSE, 1 },
+        { 0x200,      0x7F0,                   FALSE, 1 },
+        { 0x18FF0010, CAN_MASK_EXTENDED_EXACT, TRUE,  1 }
+    };
+    static const CAN_FilterType burst[2] =
+    {
+        { 0x300, CAN_MASK_STANDARD_EXACT, FALSE, 4 },
+        { 0x100, CAN_MASK_STANDARD_EXACT, FALSE, 1 }
+    };
+    static const CAN_FilterType tooDeep[2] =
+    {
+        { 0x300, CAN_MASK_STANDARD_EXACT, FALSE, CAN_RX_OBJECTS },
+        { 0x100, CAN_MASK_STANDARD_EXACT, FALSE, 1 }
+    };
+    CAN_FrameType frame = { 0x123, 0, 1, 0, { 0 } };
+    uint32 bus = 0;
+    uint32 kept = 0;
+    uint32 i;
+    char token[32];
+
+    HostReg_Init();
+    HostReg_Poke(CAN_FILTER_IF1CRQ, CAN_FILTER_WRITTEN);
+    HostReg_Poke(CAN_FILTER_IF2CRQ, CAN_FILTER_WRITTEN);
+    HostReg_AddCallback(CAN_FILTER_IF1CRQ, CanFilter_Transfer);
+    HostReg_AddCallback(CAN_FILTER_IF2CRQ, CanFilter_Transfer);
+
+    if(CAN_Init(CAN_MODULE0, 16000000, 300000) || !CAN_Init(CAN_MODULE0, 16000000, 500000)){
+        CanFilter_Log("bad-bit-rate");
+    }
+
+    /* Only the wanted IDs raise an interrupt, standard and extended IDs kept apart */
+    (void)CAN_SetFilters(CAN_MODULE0, wanted, 3);
+    {
+        static const uint32 ids[] = { 0x100, 0x123, 0x205, 0x300, 0x18FF0010, 0x010, 0x100, 0x210 };
+        static const boolean extended[] = { FALSE, FALSE, FALSE, FALSE, TRUE, FALSE, TRUE, FALSE };
+
+        for(i = 0; i < (sizeof(ids) / sizeof(ids[0])); i++){
+            (void)CanFilter_Deliver(ids[i], extended[i], (uint8)i);
+            CanFilter_Interrupt();
+        }
+    }
+    CanFilter_Drain(FALSE);
+    CanFilter_LogInterrupts();
+    CanFilter_Check("hardware filtering", "100/0 205/1 18ff0010x/2 irq3");
+
+    /* A late handler drains a burst of a high rate ID from its FIFO in one run */
+    (void)CAN_SetFilters(CAN_MODULE0, burst, 2);
+    for(i = 0; i < 5; i++){
+        (void)CanFilter_Deliver(0x300, FALSE, (uint8)i);
+    }
+    (void)CanFilter_Deliver(0x100, FALSE, 0x10);
+    CanFilter_Interrupt();
+    CanFilter_Drain(TRUE);
+    CanFilter_LogInterrupts();
+    CanFilter_Check("fifo burst", "300:00 300:01 300:02 300:04! 100:10 irq1");
+
+    /* A loaded bus with 1 frame in 10 wanted, one interrupt per wanted frame only */
+    for(i = 0; i < 1000; i++){
+        (void)CanFilter_Deliver(((i % 10) == 0) ? 0x100 : (0x400 + (i % 10)), FALSE, (uint8)i);
+        CanFilter_Interrupt();
+        CanFilter_Drain(TRUE);
+        bus++;
+    }
+    g_Log[0] = '\0';
+    sprintf(token, "frames%u", (unsigned)bus);
+    CanFilter_Log(token);
+    CanFilter_LogInterrupts();
+    CanFilter_Check("busy bus", "frames1000 irq100");
+
+    /* Full ring, the newest frames are dropped and counted */
+    for(i = 0; i < 40; i++){
+        (void)CanFilter_Deliver(0x100, FALSE, (uint8)i);
+        CanFilter_Interrupt();
+    }
+    sprintf(token, "dropped%u", (unsigned)CAN_GetDropped(CAN_MODULE0));
+    CanFilter_Log(token);
+    while(CAN_Receive(CAN_MODULE0) != NULL_PTR){
+        kept++;
+        CAN_Release(CAN_MODULE0);
+    }
+    sprintf(token, "kept%u", (unsigned)kept);
+    CanFilter_Log(token);
+    CanFilter_Check("ring full", "dropped9 kept31");
+
+    /* Transmit objects stay pending on a busy bus */
+    g_BusBusy = TRUE;
+    for(i = 0; i <= CAN_TX_OBJECTS; i++){
+        frame.data[0] = (uint8)i;
+        if(!CAN_Send(CAN_MODULE0, &frame)){
+            CanFilter_Log("full");
+        }
+    }
+    g_BusBusy = FALSE;
+    CanFilter_Update();
+    frame.data[0] = 0x05;
+    (void)CAN_Send(CAN_MODULE0, &frame);
+    CanFilter_Check("transmit", "full tx123:00 tx123:01 tx123:02 tx123:03 tx123:05");
+
+    /* Filters needing more receive objects than there are */
+    if(CAN_SetFilters(CAN_MODULE0, tooDeep, 2)){
+        CanFilter_Log("accepted");
+    }
+    CanFilter_Check("too many objects", "");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
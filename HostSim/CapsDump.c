@@ -0,0 +1,88 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: CapsDump.c
+ *
+ * Description: Host tool loading a recorded register dump into the simulated register
+ *              file and printing the capabilities Caps_Discover decodes from it
+ *
+ *              caps_dump <dump.txt>
+ *
+ *              One register per line, '#' starts a comment:
+ *                  address value          e.g. 0x400FE000 0x18050102
+ *              Registers missing from the dump read as 0.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include "HostRegisters.h"
+#include "Caps.h"
+
+static const char *g_CapsDumpNames[CAPS_NUMBER_OF_INDEXES] =
+{
+    "wd", "timer", "gpio", "dma", NULL_PTR, "hib", "uart", "ssi",
+    "i2c", NULL_PTR, "usb", NULL_PTR, NULL_PTR, "can", "adc", "acmp",
+    "pwm", "qei", NULL_PTR, NULL_PTR, NULL_PTR, NULL_PTR, "eeprom", "wtimer"
+};
+
+static boolean CapsDump_Load(const char *Path){
+
+    FILE *file = fopen(Path, "r");
+    char line[128];
+
+    if(file == NULL_PTR){
+        return FALSE;
+    }
+
+    while(fgets(line, sizeof(line), file) != NULL_PTR){
+
+        unsigned address, value;
+
+        if((line[0] == '#') || (sscanf(line, "%x %x", &address, &value) != 2)){
+            continue;
+        }
+        HostReg_Poke(address, value);
+    }
+
+    fclose(file);
+
+    return TRUE;
+}
+
+int main(int argc, char *argv[]){
+
+    const Caps_Type *caps;
+    uint8 index;
+    boolean first = TRUE;
+
+    HostReg_Init();
+
+    if((argc < 2) || !CapsDump_Load(argv[1])){
+        fprintf(stderr, "usage: caps_dump <dump.txt>\n");
+        return 2;
+    }
+
+    caps = Caps_Discover();
+
+    printf("{\n  \"class\": %u,\n  \"revision\": \"%u.%u\",\n  \"part\": \"0x%02X\",\n  \"pins\": %u,\n",
+           caps->deviceClass, caps->major, caps->minor, caps->partNumber, caps->pinCount);
+    printf("  \"flash_kb\": %u,\n  \"sram_kb\": %u,\n", caps->flashKB, caps->sramKB);
+    printf("  \"adc_channels\": [\"0x%04X\", \"0x%04X\"],\n  \"adc_comparators\": [\"0x%02X\", \"0x%02X\"],\n",
+           caps->adcChannels[0], caps->adcChannels[1], caps->adcComparators[0], caps->adcComparators[1]);
+    printf("  \"dma_channels\": \"0x%08X\",\n  \"present\": {", (unsigned)caps->dmaChannels);
+
+    for(index = 0; index < CAPS_NUMBER_OF_INDEXES; index++){
+
+        if(g_CapsDumpNames[index] != NULL_PTR){
+
+            printf("%s\n    \"%s\": \"0x%02X\"", first ? "" : ",", g_CapsDumpNames[index], caps->present[index]);
+            first = FALSE;
+        }
+    }
+
+    printf("\n  }\n}\n");
+
+    return (caps->deviceClass == 0) ? 1 : 0;
+}
@@ -0,0 +1,216 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: ClockGating.c
+ *
+ * Description: Host check of the reference counted clock gating. Logs every access
+ *              to the run, sleep and deep-sleep gates of the peripherals under test
+ *              and compares the gate values after each step with the expected ones
+ *
+ *              clock_gating
+ *
+ *              The activity is a list of tokens:
+ *                  R, S, D       RCGC, SCGC, DCGC of the peripheral accessed
+ *                  r, s, d       the peripheral gated on in RCGC, SCGC, DCGC after the step
+ *                  refused       Clock_Request or Clock_Release returned FALSE
+ *                  i:b           Clock_GetClocked listed bit b of register index i
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "HostRegisters.h"
+#include "tm4c123gh6pm_registers.h"
+#include "Clock.h"
+#include "GPTM.h"
+
+#define CLOCK_GATING_LOG_SIZE      1024
+
+/* Gate registers of register index n */
+#define CLOCK_GATING_RCGC(Index)   (0x400FE600 + ((Index) * 4))
+#define CLOCK_GATING_SCGC(Index)   (0x400FE700 + ((Index) * 4))
+#define CLOCK_GATING_DCGC(Index)   (0x400FE800 + ((Index) * 4))
+
+static char g_Log[CLOCK_GATING_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void ClockGating_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < CLOCK_GATING_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+static void ClockGating_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+/* Any access of a gate register, a write after a read shows once as in a read-modify-write */
+static uint32 ClockGating_Gate(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    (void)OldValue;
+
+    if(Address >= CLOCK_GATING_DCGC(0)){
+        ClockGating_Log("D");
+    }
+    else if(Address >= CLOCK_GATING_SCGC(0)){
+        ClockGating_Log("S");
+    }
+    else{
+        ClockGating_Log("R");
+    }
+
+    return NewValue;
+}
+
+static void ClockGating_Watch(Clock_PeripheralType Peripheral){
+
+    uint32 index = CLOCK_ID_INDEX(Peripheral);
+
+    HostReg_AddAccessCallback(CLOCK_GATING_RCGC(index), ClockGating_Gate);
+    HostReg_AddAccessCallback(CLOCK_GATING_SCGC(index), ClockGating_Gate);
+    HostReg_AddAccessCallback(CLOCK_GATING_DCGC(index), ClockGating_Gate);
+}
+
+/* Gates of the peripheral that are on, read without side effects */
+static void ClockGating_Gates(Clock_PeripheralType Peripheral){
+
+    uint32 index = CLOCK_ID_INDEX(Peripheral);
+    uint32 mask  = 1u << CLOCK_ID_BIT(Peripheral);
+
+    HostReg_Sync();
+    if(HostReg_Peek(CLOCK_GATING_RCGC(index)) & mask){
+        ClockGating_Log("r");
+    }
+    if(HostReg_Peek(CLOCK_GATING_SCGC(index)) & mask){
+        ClockGating_Log("s");
+    }
+    if(HostReg_Peek(CLOCK_GATING_DCGC(index)) & mask){
+        ClockGating_Log("d");
+    }
+}
+
+static void ClockGating_Request(Clock_PeripheralType Peripheral){
+
+    if(!Clock_Request(Peripheral)){
+        ClockGating_Log("refused");
+    }
+    ClockGating_Gates(Peripheral);
+}
+
+static void ClockGating_Release(Clock_PeripheralType Peripheral){
+
+    if(!Clock_Release(Peripheral)){
+        ClockGating_Log("refused");
+    }
+    ClockGating_Gates(Peripheral);
+}
+
+static void ClockGating_Reset(void){
+
+    HostReg_Init();
+    Clock_Init();
+    HostReg_Sync();
+
+    ClockGating_Watch(CLOCK_GPIOF);
+    ClockGating_Watch(CLOCK_UART1);
+    ClockGating_Watch(CLOCK_ADC0);
+}
+
+int main(void){
+
+    static const GPTM_ConfigType timer = { GPTM_TIMER0, GPTM_HALF_A, GPTM_MODE_ONE_SHOT, GPTM_EDGE_RISING, 16000, TRUE };
+    Clock_PeripheralType list[8];
+    char token[24];     /*two %u and the colon*/
+    uint8 count;
+    uint8 i;
+
+    /* First request: run gate, and the sleep gate by default, no deep-sleep gate */
+    ClockGating_Reset();
+    ClockGating_Request(CLOCK_GPIOF);
+    ClockGating_Check("first request", "S R r s");
+
+    /* Further users touch no gate, every user but the last leaves the gates on */
+    ClockGating_Request(CLOCK_GPIOF);
+    ClockGating_Request(CLOCK_GPIOF);
+    ClockGating_Release(CLOCK_GPIOF);
+    ClockGating_Release(CLOCK_GPIOF);
+    ClockGating_Check("nested requests", "r s r s r s r s");
+
+    /* The last user clears the three gates */
+    ClockGating_Release(CLOCK_GPIOF);
+    ClockGating_Check("last release", "R S D");
+
+    /* Nothing left to release */
+    ClockGating_Release(CLOCK_GPIOF);
+    ClockGating_Check("release at zero", "refused");
+
+    /* Deep-sleep only: the sleep gate stays off, the deep-sleep gate goes on */
+    Clock_SetSleepGating(CLOCK_UART1, FALSE, TRUE);
+    ClockGating_Request(CLOCK_UART1);
+    Clock_SetSleepGating(CLOCK_UART1, TRUE, TRUE);
+    ClockGating_Gates(CLOCK_UART1);
+    ClockGating_Release(CLOCK_UART1);
+    ClockGating_Check("sleep masks", "D R r d S S D D r s d R S D");
+
+    /* The ADC driver owns its clock, a reference count would stop it */
+    ClockGating_Request(CLOCK_ADC0);
+    ClockGating_Release(CLOCK_ADC0);
+    ClockGating_Check("driver owned", "refused refused");
+
+    /* A driver started before Clock_Init keeps the sleep and deep-sleep gates it set */
+    HostReg_Init();
+    HostReg_Poke(CLOCK_GATING_RCGC(CLOCK_INDEX_TIMER), 0x00000002);     /*TIMER1, clocked by GPTM*/
+    HostReg_Poke(CLOCK_GATING_SCGC(CLOCK_INDEX_TIMER), 0x00000002);
+    HostReg_Poke(CLOCK_GATING_DCGC(CLOCK_INDEX_TIMER), 0x00000002);
+    Clock_Init();
+    ClockGating_Gates(CLOCK_TIMER1);
+    ClockGating_Check("driver before init", "r s d");
+
+    /* One started after it clocks its timer in every mode, a deadline wakes deep-sleep */
+    ClockGating_Reset();
+    (void)GPTM_Init(&timer);
+    ClockGating_Gates(CLOCK_TIMER0);
+    ClockGating_Check("driver after init", "r s d");
+
+    /* 255 users at most */
+    for(i = 0; i < 255; i++){
+        (void)Clock_Request(CLOCK_GPIOF);
+    }
+    g_Log[0] = '\0';
+    ClockGating_Request(CLOCK_GPIOF);
+    ClockGating_Check("saturated", "refused r s");
+
+    /* Listed in index and bit order, the ones clocked without this module included */
+    ClockGating_Reset();
+    HostReg_Poke(CLOCK_GATING_RCGC(CLOCK_INDEX_TIMER), 0x00000004);     /*TIMER2, clocked by GPTM*/
+    (void)Clock_Request(CLOCK_UART1);
+    (void)Clock_Request(CLOCK_GPIOF);
+    (void)Clock_Request(CLOCK_GPIOA);
+    g_Log[0] = '\0';
+    count = Clock_GetClocked(list, 8);
+    for(i = 0; (i < count) && (i < 8); i++){
+        snprintf(token, sizeof(token), "%u:%u", (unsigned)CLOCK_ID_INDEX(list[i]), (unsigned)CLOCK_ID_BIT(list[i]));
+        ClockGating_Log(token);
+    }
+    if(Clock_GetClocked(list, 2) != count){
+        ClockGating_Log("short");
+    }
+    ClockGating_Check("clocked list", "R R R 1:2 2:0 2:5 6:1 R R R");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
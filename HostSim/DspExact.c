@@ -0,0 +1,360 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: DspExact.c
+ *
+ * Description: Host check that the q15 kernels give the same results bit for bit as
+ *              plain scalar references with 64-bit accumulators. Random taps,
+ *              coefficients and samples, odd tap counts and odd block lengths so the
+ *              paired loops take their single sample tails, and full scale inputs
+ *              that saturate the products, the accumulators and the outputs
+ *
+ *              dsp_exact
+ *
+ *              The activity is a list of tokens:
+ *                  exact         every output of the case matches the reference
+ *                  n:got/want    first output n that differs
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "DSP.h"
+
+#define DSP_EXACT_LOG_SIZE         1024
+
+#define DSP_EXACT_MAX_TAPS         33
+#define DSP_EXACT_MAX_BLOCK        64
+#define DSP_EXACT_MAX_SAMPLES      1024
+#define DSP_EXACT_MAX_STAGES       3
+
+/* Input kinds */
+#define DSP_EXACT_RANDOM           0
+#define DSP_EXACT_MIN              1       /* every sample -1.0                  */
+#define DSP_EXACT_EXTREMES         2       /* random mix of -1.0 and 1.0 - 2^-15 */
+
+static char g_Log[DSP_EXACT_LOG_SIZE];
+static uint32 g_Failures = 0;
+static uint32 g_Seed = 0x2545F491;
+
+/* Odd block lengths, every call of a case walks through them in turn */
+static const uint16 g_Blocks[] = { 13, 1, 31, 7, 63, 3, 17 };
+
+static sint16 g_In[DSP_EXACT_MAX_SAMPLES];
+static sint16 g_In2[DSP_EXACT_MAX_SAMPLES];
+static sint16 g_Out[DSP_EXACT_MAX_SAMPLES];
+static sint16 g_Want[DSP_EXACT_MAX_SAMPLES];
+
+static void DspExact_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < DSP_EXACT_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+static void DspExact_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+static sint16 DspExact_Random(void){
+
+    g_Seed ^= g_Seed << 13;
+    g_Seed ^= g_Seed >> 17;
+    g_Seed ^= g_Seed << 5;
+
+    return (sint16)(g_Seed >> 8);
+}
+
+static void DspExact_Fill(sint16 *Samples, uint16 Count, uint8 Kind){
+
+    uint16 n;
+
+    for(n = 0; n < Count; n++){
+
+        switch(Kind){
+
+        case DSP_EXACT_MIN:
+            Samples[n] = DSP_Q15_MIN;
+            break;
+
+        case DSP_EXACT_EXTREMES:
+            Samples[n] = (DspExact_Random() & 1) ? DSP_Q15_MAX : DSP_Q15_MIN;
+            break;
+
+        default:
+            Samples[n] = DspExact_Random();
+            break;
+        }
+    }
+}
+
+static sint16 DspExact_Saturate(sint64 Value){
+
+    return (Value > DSP_Q15_MAX) ? DSP_Q15_MAX : ((Value < DSP_Q15_MIN) ? DSP_Q15_MIN : (sint16)Value);
+}
+
+/* One token for the first Count outputs */
+static void DspExact_Compare(uint16 Count){
+
+    char token[32];
+    uint16 n;
+
+    for(n = 0; n < Count; n++){
+
+        if(g_Out[n] != g_Want[n]){
+            sprintf(token, "%u:%d/%d", (unsigned)n, g_Out[n], g_Want[n]);
+            DspExact_Log(token);
+            return;
+        }
+    }
+    DspExact_Log("exact");
+}
+
+/* y[i] = sum(h[k] * x[i - k]), the taps given time reversed, zero history */
+static void DspExact_FirReference(const sint16 *Coeffs, uint16 Taps, uint16 Count, uint8 Factor){
+
+    uint16 i;
+    uint16 kept = 0;
+
+    for(i = Factor - 1; i < Count; i += Factor){
+
+        sint64 acc = 0;
+        uint16 k;
+
+        for(k = 0; k < Taps; k++){
+
+            sint32 index = (sint32)i - k;
+            if(index >= 0){
+                acc += (sint64)Coeffs[Taps - 1 - k] * g_In[index];
+            }
+        }
+        g_Want[kept++] = DspExact_Saturate(acc >> 15);
+    }
+}
+
+/* Filters g_In through the kernel in blocks of g_Blocks lengths, multiples of Factor */
+static void DspExact_Fir(uint16 Taps, uint8 Factor, uint8 CoeffKind, uint8 InputKind){
+
+    static sint16 state[DSP_FIR_STATE_SIZE(DSP_EXACT_MAX_TAPS, DSP_EXACT_MAX_BLOCK * 3)];
+    sint16 coeffs[DSP_EXACT_MAX_TAPS];
+    DSP_FirType fir;
+    uint16 done = 0;
+    uint16 kept = 0;
+    uint8 block = 0;
+
+    DspExact_Fill(coeffs, Taps, CoeffKind);
+    DspExact_Fill(g_In, DSP_EXACT_MAX_SAMPLES, InputKind);
+    DSP_FirInit(&fir, coeffs, Taps, state, DSP_EXACT_MAX_BLOCK * Factor);
+
+    while(done + (DSP_EXACT_MAX_BLOCK * Factor) <= DSP_EXACT_MAX_SAMPLES){
+
+        uint16 count = g_Blocks[block] * Factor;
+
+        if(Factor == 1){
+            DSP_Fir(&fir, &g_In[done], &g_Out[kept], count);
+        }
+        else{
+            DSP_FirDecimate(&fir, &g_In[done], &g_Out[kept], count, Factor);
+        }
+        done += count;
+        kept += count / Factor;
+        block = (block + 1) % (sizeof(g_Blocks) / sizeof(g_Blocks[0]));
+    }
+
+    DspExact_FirReference(coeffs, Taps, done, Factor);
+    DspExact_Compare(kept);
+}
+
+/* Direct form I per stage, the feedback coefficients already negated */
+static void DspExact_Biquad(uint8 Stages, uint8 PostShift, uint8 InputKind){
+
+    sint16 coeffs[DSP_EXACT_MAX_STAGES * DSP_BIQUAD_COEFFS];
+    sint16 state[DSP_BIQUAD_STATE_SIZE(DSP_EXACT_MAX_STAGES)];
+    DSP_BiquadType biquad;
+    uint16 done = 0;
+    uint8 block = 0;
+    uint8 stage;
+
+    DspExact_Fill(coeffs, Stages * DSP_BIQUAD_COEFFS, DSP_EXACT_RANDOM);
+    DspExact_Fill(g_In, DSP_EXACT_MAX_SAMPLES, InputKind);
+    DSP_BiquadInit(&biquad, coeffs, Stages, state, PostShift);
+
+    while(done + DSP_EXACT_MAX_BLOCK <= DSP_EXACT_MAX_SAMPLES){
+
+        DSP_Biquad(&biquad, &g_In[done], &g_Out[done], g_Blocks[block]);
+        done += g_Blocks[block];
+        block = (block + 1) % (sizeof(g_Blocks) / sizeof(g_Blocks[0]));
+    }
+
+    memcpy(g_Want, g_In, done * sizeof(sint16));
+    for(stage = 0; stage < Stages; stage++){
+
+        const sint16 *c = &coeffs[stage * DSP_BIQUAD_COEFFS];
+        sint64 x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+        uint16 n;
+
+        for(n = 0; n < done; n++){
+
+            sint64 x0 = g_Want[n];
+            sint64 acc = c[0] * x0 + c[1] * x1 + c[2] * x2 + c[3] * y1 + c[4] * y2;
+            sint16 y0 = DspExact_Saturate(acc >> (15 - PostShift));
+
+            x2 = x1;
+            x1 = x0;
+            y2 = y1;
+            y1 = y0;
+            g_Want[n] = y0;
+        }
+    }
+
+    DspExact_Compare(done);
+}
+
+static void DspExact_MovingAverage(uint8 Log2Length, uint8 InputKind){
+
+    static sint16 window[1u << 8];
+    DSP_MovingAverageType average;
+    uint16 done = 0;
+    uint16 n;
+    uint8 block = 0;
+
+    DspExact_Fill(g_In, DSP_EXACT_MAX_SAMPLES, InputKind);
+    DSP_MovingAverageInit(&average, window, Log2Length);
+
+    while(done + DSP_EXACT_MAX_BLOCK <= DSP_EXACT_MAX_SAMPLES){
+
+        DSP_MovingAverage(&average, &g_In[done], &g_Out[done], g_Blocks[block]);
+        done += g_Blocks[block];
+        block = (block + 1) % (sizeof(g_Blocks) / sizeof(g_Blocks[0]));
+    }
+
+    for(n = 0; n < done; n++){
+
+        sint64 sum = 0;
+        sint32 k;
+
+        for(k = (sint32)n - (1 << Log2Length) + 1; k <= n; k++){
+            if(k >= 0){
+                sum += g_In[k];
+            }
+        }
+        g_Want[n] = (sint16)(sum >> Log2Length);
+    }
+
+    DspExact_Compare(done);
+}
+
+/* Minimum, maximum, truncated mean and floor of the root mean square, capped at 1.0 - 2^-15 */
+static void DspExact_Stats(uint16 Count, uint8 InputKind){
+
+    DSP_StatsType stats;
+    sint64 sum = 0;
+    uint64 squares = 0;
+    uint64 root = 0;
+    uint64 bit;
+    uint16 n;
+
+    DspExact_Fill(g_In, Count, InputKind);
+    DSP_Stats(g_In, Count, &stats);
+
+    g_Want[0] = DSP_Q15_MAX;
+    g_Want[1] = DSP_Q15_MIN;
+    for(n = 0; n < Count; n++){
+
+        if(g_In[n] < g_Want[0]) { g_Want[0] = g_In[n]; }
+        if(g_In[n] > g_Want[1]) { g_Want[1] = g_In[n]; }
+        sum     += g_In[n];
+        squares += (uint64)((sint64)g_In[n] * g_In[n]);
+    }
+    squares /= Count;
+    for(bit = 1u << 16; bit != 0; bit >>= 1){
+        if((root + bit) * (root + bit) <= squares){
+            root += bit;
+        }
+    }
+    g_Want[2] = (sint16)(sum / Count);
+    g_Want[3] = (sint16)((root > DSP_Q15_MAX) ? DSP_Q15_MAX : root);
+
+    g_Out[0] = stats.min;
+    g_Out[1] = stats.max;
+    g_Out[2] = stats.mean;
+    g_Out[3] = stats.rms;
+    DspExact_Compare(4);
+}
+
+static void DspExact_AddSat(uint16 Count, uint8 InputKind){
+
+    uint16 n;
+
+    DspExact_Fill(g_In, Count, InputKind);
+    DspExact_Fill(g_In2, Count, InputKind);
+    DSP_AddSat(g_In, g_In2, g_Out, Count);
+
+    for(n = 0; n < Count; n++){
+        g_Want[n] = DspExact_Saturate((sint64)g_In[n] + g_In2[n]);
+    }
+
+    DspExact_Compare(Count);
+}
+
+int main(void){
+
+    /* Odd and even tap counts, the odd ones end on a single tap */
+    DspExact_Fir(1, 1, DSP_EXACT_RANDOM, DSP_EXACT_RANDOM);
+    DspExact_Fir(7, 1, DSP_EXACT_RANDOM, DSP_EXACT_RANDOM);
+    DspExact_Fir(32, 1, DSP_EXACT_RANDOM, DSP_EXACT_RANDOM);
+    DspExact_Fir(33, 1, DSP_EXACT_RANDOM, DSP_EXACT_RANDOM);
+    DspExact_Check("fir random", "exact exact exact exact");
+
+    /* -1.0 * -1.0 on both halves of a pair is 2^31, past a 32-bit sum */
+    DspExact_Fir(7, 1, DSP_EXACT_MIN, DSP_EXACT_MIN);
+    DspExact_Fir(32, 1, DSP_EXACT_EXTREMES, DSP_EXACT_EXTREMES);
+    DspExact_Check("fir saturating", "exact exact");
+
+    DspExact_Fir(15, 3, DSP_EXACT_RANDOM, DSP_EXACT_RANDOM);
+    DspExact_Fir(8, 2, DSP_EXACT_RANDOM, DSP_EXACT_RANDOM);
+    DspExact_Fir(9, 3, DSP_EXACT_MIN, DSP_EXACT_MIN);
+    DspExact_Check("fir decimate", "exact exact exact");
+
+    /* Random coefficients, mostly unstable, the outputs saturate on and off */
+    DspExact_Biquad(1, 0, DSP_EXACT_RANDOM);
+    DspExact_Biquad(3, 1, DSP_EXACT_RANDOM);
+    DspExact_Biquad(2, 2, DSP_EXACT_EXTREMES);
+    DspExact_Biquad(2, 0, DSP_EXACT_MIN);
+    DspExact_Check("biquad", "exact exact exact exact");
+
+    DspExact_MovingAverage(0, DSP_EXACT_RANDOM);
+    DspExact_MovingAverage(4, DSP_EXACT_RANDOM);
+    DspExact_MovingAverage(8, DSP_EXACT_EXTREMES);
+    DspExact_MovingAverage(5, DSP_EXACT_MIN);
+    DspExact_Check("moving average", "exact exact exact exact");
+
+    DspExact_Stats(1, DSP_EXACT_RANDOM);
+    DspExact_Stats(2, DSP_EXACT_RANDOM);
+    DspExact_Stats(255, DSP_EXACT_RANDOM);
+    DspExact_Stats(1024, DSP_EXACT_EXTREMES);
+    DspExact_Stats(33, DSP_EXACT_MIN);
+    DspExact_Check("stats", "exact exact exact exact exact");
+
+    DspExact_AddSat(1, DSP_EXACT_RANDOM);
+    DspExact_AddSat(255, DSP_EXACT_RANDOM);
+    DspExact_AddSat(33, DSP_EXACT_EXTREMES);
+    DspExact_AddSat(8, DSP_EXACT_MIN);
+    DspExact_Check("add saturated", "exact exact exact exact");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
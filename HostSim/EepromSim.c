@@ -0,0 +1,319 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: EepromSim.c
+ *
+ * Description: Host check of the EEPROM key-value store. Plays the 2 KB EEPROM
+ *              behind the simulated register file, with its block / offset data
+ *              ports and the done interrupt, runs record writes and reboots through
+ *              EEPROM.c and compares the words written with the expected ones.
+ *              Power can be cut after a number of writes to check torn records
+ *
+ *              eeprom_sim
+ *
+ *              The activity is a list of tokens:
+ *                  Wn            word n written
+ *                  Xn            word n lost, the power was cut
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "HostRegisters.h"
+#include "tm4c123gh6pm_registers.h"
+#include "EEPROM.h"
+
+#define EEPROM_SIM_LOG_SIZE        1024
+#define EEPROM_SIM_WORDS           512
+#define EEPROM_SIM_NO_LIMIT        0xFFFFFFFF
+
+/* Registers the check plays the hardware side of */
+#define EEPROM_SIM_EEBLOCK         0x400AF004
+#define EEPROM_SIM_EEOFFSET        0x400AF008
+#define EEPROM_SIM_EERDWR          0x400AF010
+#define EEPROM_SIM_EERDWRINC       0x400AF014
+#define EEPROM_SIM_EEDONE          0x400AF018
+#define EEPROM_SIM_EEINT           0x400AF040
+#define EEPROM_SIM_FCRIS           0x400FD00C
+#define EEPROM_SIM_FCIM            0x400FD010
+
+#define EEPROM_SIM_WORKING         0x00000001
+#define EEPROM_SIM_FLASH_INT       0x00000004
+
+static uint32 g_Memory[EEPROM_SIM_WORDS];
+static uint32 g_Block;
+static uint32 g_Offset;
+static uint32 g_Reads;
+static uint32 g_Writes;
+static uint32 g_WriteLimit = EEPROM_SIM_NO_LIMIT;
+static boolean g_Busy;
+
+static char g_Log[EEPROM_SIM_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void EepromSim_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < EEPROM_SIM_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+static uint32 EepromSim_Word(void){
+
+    return (g_Block * 16) + g_Offset;
+}
+
+/* EERDWRINC reads the word at the current block and offset */
+static void EepromSim_Refresh(void){
+
+    HostReg_Poke(EEPROM_SIM_EERDWRINC, g_Memory[EepromSim_Word()]);
+}
+
+static uint32 EepromSim_Block(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    (void)Address;
+    (void)OldValue;
+
+    g_Block = NewValue & 0x1F;
+    EepromSim_Refresh();
+
+    return NewValue;
+}
+
+static uint32 EepromSim_Offset(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    (void)Address;
+    (void)OldValue;
+
+    g_Offset = NewValue & 0xF;
+    EepromSim_Refresh();
+
+    return NewValue;
+}
+
+/* The store only reads EERDWRINC: each access moves to the next word of the block */
+static uint32 EepromSim_ReadIncrement(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    (void)Address;
+    (void)OldValue;
+    (void)NewValue;
+
+    g_Reads++;
+    g_Offset = (g_Offset + 1) & 0xF;
+    HostReg_Poke(EEPROM_SIM_EEOFFSET, g_Offset);
+
+    return g_Memory[EepromSim_Word()];
+}
+
+/* The store only writes EERDWR: each access is a word write, done on the next run step */
+static uint32 EepromSim_Write(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    char token[16];
+
+    (void)Address;
+    (void)OldValue;
+
+    if(g_Writes < g_WriteLimit){
+        g_Memory[EepromSim_Word()] = NewValue;
+        sprintf(token, "W%u", (unsigned)EepromSim_Word());
+    }
+    else{
+        sprintf(token, "X%u", (unsigned)EepromSim_Word());
+    }
+    EepromSim_Log(token);
+    g_Writes++;
+
+    g_Busy = TRUE;
+    HostReg_Poke(EEPROM_SIM_EEDONE, EEPROM_SIM_WORKING);
+    EepromSim_Refresh();
+
+    return NewValue;
+}
+
+/* Power on: a new register file in front of the same EEPROM contents */
+static boolean EepromSim_Boot(uint32 WriteLimit){
+
+    HostReg_Init();
+    HostReg_AddCallback(EEPROM_SIM_EEBLOCK, EepromSim_Block);
+    HostReg_AddCallback(EEPROM_SIM_EEOFFSET, EepromSim_Offset);
+    HostReg_AddAccessCallback(EEPROM_SIM_EERDWRINC, EepromSim_ReadIncrement);
+    HostReg_AddAccessCallback(EEPROM_SIM_EERDWR, EepromSim_Write);
+
+    g_Block = 0;
+    g_Offset = 0;
+    g_Reads = 0;
+    g_Writes = 0;
+    g_WriteLimit = WriteLimit;
+    g_Busy = FALSE;
+    EepromSim_Refresh();
+
+    return EEPROM_Init();
+}
+
+/* Completes writes until the store is committed or the power is cut */
+static void EepromSim_Run(void){
+
+    uint32 guard;
+
+    HostReg_Sync();
+
+    for(guard = 0; g_Busy && (g_Writes <= g_WriteLimit) && (guard < 1000); guard++){
+
+        g_Busy = FALSE;
+        HostReg_Poke(EEPROM_SIM_EEDONE, 0);
+
+        if(HostReg_Peek(EEPROM_SIM_EEINT) & 0x1){
+            HostReg_Poke(EEPROM_SIM_FCRIS, HostReg_Peek(EEPROM_SIM_FCRIS) | EEPROM_SIM_FLASH_INT);
+        }
+        if(HostReg_Peek(EEPROM_SIM_FCIM) & EEPROM_SIM_FLASH_INT){
+            EEPROM_Handler();
+        }
+        HostReg_Sync();
+    }
+}
+
+static void EepromSim_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+static void EepromSim_Expect(uint16 Key, uint8 Words, const uint32 *Expected){
+
+    uint32 value[EEPROM_MAX_VALUE_WORDS];
+
+    if(Expected == NULL_PTR){
+        if(EEPROM_Get(Key, value, Words)){
+            EepromSim_Log("present");
+        }
+    }
+    else if(!EEPROM_Get(Key, value, Words) || (memcmp(value, Expected, Words * sizeof(uint32)) != 0)){
+        EepromSim_Log("bad-value");
+    }
+}
+
+int main(void){
+
+    static const uint32 gains[2]   = { 100, 200 };
+    static const uint32 updated[2] = { 104, 200 };
+    static const uint32 torn[2]    = { 1, 2 };
+    static const uint32 limit[1]   = { 7 };
+    static const uint32 table[3]   = { 5, 6, 7 };
+    static const uint32 wide[EEPROM_MAX_VALUE_WORDS + 1] = { 0 };
+    uint32 value[2];
+    uint16 key;
+    uint32 i;
+
+    memset(g_Memory, 0xFF, sizeof(g_Memory));
+
+    /* Erased EEPROM, the whole store read once */
+    if(!EepromSim_Boot(EEPROM_SIM_NO_LIMIT) || (g_Reads != EEPROM_STORE_WORDS)){
+        EepromSim_Log("bad-boot");
+    }
+    EepromSim_Expect(0x10, 2, NULL_PTR);
+    EepromSim_Check("empty boot", "");
+
+    /* A new record: value words first, its header last */
+    (void)EEPROM_Set(0x10, gains, 2);
+    EepromSim_Expect(0x10, 2, gains);
+    EepromSim_Run();
+    if(!EEPROM_IsCommitted()){
+        EepromSim_Log("pending");
+    }
+    EepromSim_Check("append", "W2 W1 W0");
+
+    /* Four values set while the first is written: two writes of word 1, one header */
+    for(i = 1; i <= 4; i++){
+        value[0] = 100 + i;
+        value[1] = 200;
+        (void)EEPROM_Set(0x10, value, 2);
+    }
+    EepromSim_Run();
+    if(g_Memory[1] != 104){
+        EepromSim_Log("bad-memory");
+    }
+    (void)EEPROM_Set(0x10, updated, 2);
+    EepromSim_Run();
+    EepromSim_Check("coalesced", "W1 W1 W0");
+
+    /* A second record after the first */
+    (void)EEPROM_Set(0x20, limit, 1);
+    EepromSim_Run();
+    EepromSim_Check("second record", "W4 W3");
+
+    /* Both records back after a reboot, looked up by key and length */
+    (void)EepromSim_Boot(EEPROM_SIM_NO_LIMIT);
+    EepromSim_Expect(0x10, 2, updated);
+    EepromSim_Expect(0x20, 1, limit);
+    EepromSim_Expect(0x10, 1, NULL_PTR);
+    EepromSim_Check("reboot", "");
+
+    /* Power cut in the middle of an update: the record fails its check */
+    (void)EepromSim_Boot(1);
+    (void)EEPROM_Set(0x10, torn, 2);
+    EepromSim_Run();
+    (void)EepromSim_Boot(EEPROM_SIM_NO_LIMIT);
+    EepromSim_Expect(0x10, 2, NULL_PTR);
+    EepromSim_Expect(0x20, 1, limit);
+    (void)EEPROM_Set(0x10, torn, 2);
+    EepromSim_Run();
+    (void)EepromSim_Boot(EEPROM_SIM_NO_LIMIT);
+    EepromSim_Expect(0x10, 2, torn);
+    EepromSim_Check("torn update", "W2 X1 W1 W0");
+
+    /* Power cut in the middle of an append: the header is still the end of the store */
+    (void)EepromSim_Boot(2);
+    (void)EEPROM_Set(0x30, table, 3);
+    EepromSim_Run();
+    (void)EepromSim_Boot(EEPROM_SIM_NO_LIMIT);
+    EepromSim_Expect(0x30, 3, NULL_PTR);
+    EepromSim_Expect(0x10, 2, torn);
+    (void)EEPROM_Set(0x30, table, 3);
+    EepromSim_Run();
+    (void)EepromSim_Boot(EEPROM_SIM_NO_LIMIT);
+    EepromSim_Expect(0x30, 3, table);
+    EepromSim_Check("torn append", "W8 W7 X6 W6 W5");
+
+    /* Records the store can not take, then records until it is full */
+    if(EEPROM_Set(EEPROM_NO_KEY, limit, 1) || EEPROM_Set(0x10, table, 3) || EEPROM_Set(0x40, limit, 0) ||
+       EEPROM_Set(0x40, wide, EEPROM_MAX_VALUE_WORDS + 1)){
+        EepromSim_Log("accepted");
+    }
+    for(key = 0x100; EEPROM_Set(key, wide, EEPROM_MAX_VALUE_WORDS); key++){
+        EepromSim_Run();
+    }
+    g_Log[0] = '\0';
+    if(key != (0x100 + ((EEPROM_STORE_WORDS - 9) / (EEPROM_MAX_VALUE_WORDS + 1)))){
+        EepromSim_Log("bad-capacity");
+    }
+    (void)EepromSim_Boot(EEPROM_SIM_NO_LIMIT);
+    EepromSim_Expect(0x30, 3, table);
+    EepromSim_Expect(key - 1, EEPROM_MAX_VALUE_WORDS, wide);
+    EepromSim_Check("limits", "");
+
+    /* Contents left by another program: the store starts empty and ends itself */
+    for(i = 0; i < EEPROM_SIM_WORDS; i++){
+        g_Memory[i] = 0x12345678;
+    }
+    (void)EepromSim_Boot(EEPROM_SIM_NO_LIMIT);
+    EepromSim_Expect(0x10, 2, NULL_PTR);
+    (void)EEPROM_Set(0x20, limit, 1);
+    EepromSim_Run();
+    (void)EepromSim_Boot(EEPROM_SIM_NO_LIMIT);
+    EepromSim_Expect(0x20, 1, limit);
+    EepromSim_Check("foreign contents", "W2 W1 W0");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: FaultRecord.c
+ *
+ * Description: Host check of the crash record. Seals records with
+ *              Fault_EncodeRecord, reads them back with the decoder, compares the
+ *              printed dump with the expected text and runs Fault_Capture on a
+ *              stack pointer the handler must not follow. Corrupted records must
+ *              be refused
+ *
+ *              fault_record
+ *
+ *              The activity is a list of tokens:
+ *                  ok            record accepted by the decoder
+ *                  bad           record refused by the decoder
+ *                  reset         system reset requested through APINT
+ *                  printed       the dump matched the expected text
+ *                  misprinted    the dump differed, the text follows
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "HostRegisters.h"
+#include "tm4c123gh6pm_registers.h"
+#include "Fault.h"
+
+#define FAULT_RECORD_LOG_SIZE      1024
+#define FAULT_RECORD_TEXT_SIZE     4096
+
+/* Registers the check reads back */
+#define FAULT_RECORD_INTCTRL       0xE000ED04
+#define FAULT_RECORD_APINT         0xE000ED0C
+#define FAULT_RECORD_FAULTSTAT     0xE000ED28
+
+static char g_Text[FAULT_RECORD_TEXT_SIZE];
+
+static char g_Log[FAULT_RECORD_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void FaultRecord_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < FAULT_RECORD_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+/* Fault_PrintFuncType collecting the dump */
+static void FaultRecord_Print(const char *String){
+
+    if((strlen(g_Text) + strlen(String)) < FAULT_RECORD_TEXT_SIZE){
+        strcat(g_Text, String);
+    }
+}
+
+static void FaultRecord_Decode(const Fault_RecordType *Record){
+
+    FaultRecord_Log(Fault_DecodeRecord(Record) ? "ok" : "bad");
+}
+
+static void FaultRecord_Expect(const char *Text){
+
+    if(strcmp(g_Text, Text) == 0){
+        FaultRecord_Log("printed");
+    }
+    else{
+        FaultRecord_Log("misprinted");
+        printf("%s", g_Text);
+    }
+    g_Text[0] = '\0';
+}
+
+static void FaultRecord_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+/* A usage fault (vector 6) at 0x00001234 with two words of the thread stack */
+static void FaultRecord_Sample(Fault_RecordType *Record){
+
+    memset(Record, 0, sizeof(Fault_RecordType));
+    Record->frame.r0   = 0x00000001;
+    Record->frame.r1   = 0x00000002;
+    Record->frame.r2   = 0x00000003;
+    Record->frame.r3   = 0x00000004;
+    Record->frame.r12  = 0x0000000C;
+    Record->frame.lr   = 0x00000801;
+    Record->frame.pc   = 0x00001234;
+    Record->frame.xpsr = 0x61000200;
+    Record->cfsr       = 0x00020000;
+    Record->excReturn  = 0xFFFFFFFD;
+    Record->stackPointer = 0x20001024;
+    Record->activeVector = 6;
+    Record->resetCount = 3;
+    Record->snapshotWords = 2;
+    Record->stackSnapshot[0] = 0xDEADBEEF;
+    Record->stackSnapshot[1] = 0x00000800;
+}
+
+int main(void){
+
+    static const char sample[] =
+        "*** Fault reset ***\r\n"
+        "resets: 0x00000003\r\n"
+        "vector: 0x00000006\r\n"
+        "pc:     0x00001234\r\n"
+        "lr:     0x00000801\r\n"
+        "xpsr:   0x61000200\r\n"
+        "r0:     0x00000001\r\n"
+        "r1:     0x00000002\r\n"
+        "r2:     0x00000003\r\n"
+        "r3:     0x00000004\r\n"
+        "r12:    0x0000000C\r\n"
+        "cfsr:   0x00020000\r\n"
+        "hfsr:   0x00000000\r\n"
+        "mmfar:  0x00000000\r\n"
+        "bfar:   0x00000000\r\n"
+        "excret: 0xFFFFFFFD\r\n"
+        "sp:     0x20001024\r\n"
+        "stack:  0xDEADBEEF\r\n"
+        "stack:  0x00000800\r\n";
+    static const char lost[] =
+        "*** Fault reset ***\r\n"
+        "resets: 0x00000001\r\n"
+        "vector: 0x00000025\r\n"
+        "irq:    0x00000015\r\n"
+        "pc:     0x00000000\r\n"
+        "lr:     0x00000000\r\n"
+        "xpsr:   0x00000000\r\n"
+        "r0:     0x00000000\r\n"
+        "r1:     0x00000000\r\n"
+        "r2:     0x00000000\r\n"
+        "r3:     0x00000000\r\n"
+        "r12:    0x00000000\r\n"
+        "cfsr:   0x00008200\r\n"
+        "hfsr:   0x00000000\r\n"
+        "mmfar:  0x00000000\r\n"
+        "bfar:   0x00000000\r\n"
+        "excret: 0xFFFFFFE9\r\n"
+        "sp:     0x20008058\r\n";
+    Fault_RecordType record;
+    Fault_RecordType copy;
+
+    HostReg_Init();
+
+    /* Sealed, validated and printed back word for word */
+    FaultRecord_Sample(&record);
+    Fault_EncodeRecord(&record);
+    if(record.magic != FAULT_RECORD_MAGIC){
+        FaultRecord_Log("no-magic");
+    }
+    FaultRecord_Decode(&record);
+    Fault_PrintRecord(&record, FaultRecord_Print);
+    FaultRecord_Expect(sample);
+    FaultRecord_Check("round trip", "ok printed");
+
+    /* Checksum, payload and magic each damaged in turn */
+    copy = record;
+    copy.checksum ^= 0x00000100;
+    FaultRecord_Decode(&copy);
+    copy = record;
+    copy.frame.pc ^= 0x00000002;
+    FaultRecord_Decode(&copy);
+    copy = record;
+    copy.stackSnapshot[1] = 0;
+    FaultRecord_Decode(&copy);
+    copy = record;
+    copy.magic = 0;
+    FaultRecord_Decode(&copy);
+    FaultRecord_Check("corrupted record", "bad bad bad bad");
+
+    /* A snapshot longer than the record holds is refused even when sealed */
+    copy = record;
+    copy.snapshotWords = FAULT_STACK_SNAPSHOT_WORDS + 1;
+    Fault_EncodeRecord(&copy);
+    FaultRecord_Decode(&copy);
+    FaultRecord_Check("snapshot length", "bad");
+
+    /* Power-on: the no-init RAM holds no record */
+    if(Fault_Init(FaultRecord_Print)){
+        FaultRecord_Log("faulted");
+    }
+    FaultRecord_Expect("");
+    FaultRecord_Check("power on", "printed");
+
+    /* Bus fault in IRQ 21 with the SP past the end of SRAM: the frame is not read */
+    HostReg_Poke(FAULT_RECORD_INTCTRL, 16 + 21);
+    HostReg_Poke(FAULT_RECORD_FAULTSTAT, 0x00008200);
+    Fault_Capture((const uint32 *)(unsigned long)(FAULT_SRAM_END - 16), 0xFFFFFFE9);
+    if(HostReg_Peek(FAULT_RECORD_APINT) == (FAULT_APINT_VECTKEY | FAULT_APINT_SYSRESETREQ)){
+        FaultRecord_Log("reset");
+    }
+    HostReg_Init();
+    if(Fault_Init(FaultRecord_Print)){
+        FaultRecord_Log("ok");
+    }
+    FaultRecord_Expect(lost);
+    FaultRecord_Check("capture outside sram", "reset ok printed");
+
+    /* The record is consumed once, the reset counter goes on */
+    if(Fault_Init(FaultRecord_Print)){
+        FaultRecord_Log("again");
+    }
+    Fault_Capture((const uint32 *)(unsigned long)(FAULT_SRAM_START - 64), 0xFFFFFFF9);
+    (void)Fault_Init(NULL_PTR);
+    Fault_Capture((const uint32 *)(unsigned long)(FAULT_SRAM_START + 2), 0xFFFFFFF9);
+    if(Fault_Init(FaultRecord_Print)){
+        FaultRecord_Log("ok");
+    }
+    if(strstr(g_Text, "resets: 0x00000003\r\n") == NULL_PTR){
+        FaultRecord_Log("bad-count");
+    }
+    g_Text[0] = '\0';
+    FaultRecord_Check("reset count", "ok");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,235 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: HibernateWake.c
+ *
+ * Description: Host check of the hibernate / wake / restore sequence. Plays the
+ *              battery-backed hibernation module behind the simulated register file,
+ *              which keeps its registers when the rest of the register file is reset
+ *              by a wake, and compares the HIB writes of each step with the expected
+ *              ones. Every HIB write costs a WRC wait on the target, the resume path
+ *              must stay free of them
+ *
+ *              hibernate_wake
+ *
+ *              The activity is a list of tokens:
+ *                  CTL           HIBCTL written
+ *                  Dn            HIBDATA word n written
+ *                  IC            wake cause cleared
+ *                  H@s           hibernation requested, RTC wake at second s
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "HostRegisters.h"
+#include "tm4c123gh6pm_registers.h"
+#include "Hibernate.h"
+
+#define HIBERNATE_WAKE_LOG_SIZE    1024
+
+/* Registers the check plays the hardware side of, all kept across a wake */
+#define HIBERNATE_WAKE_BASE        0x400FC000
+#define HIBERNATE_WAKE_RTCC        (HIBERNATE_WAKE_BASE + 0x000)
+#define HIBERNATE_WAKE_RTCM0       (HIBERNATE_WAKE_BASE + 0x004)
+#define HIBERNATE_WAKE_CTL         (HIBERNATE_WAKE_BASE + 0x010)
+#define HIBERNATE_WAKE_RIS         (HIBERNATE_WAKE_BASE + 0x018)
+#define HIBERNATE_WAKE_IC          (HIBERNATE_WAKE_BASE + 0x020)
+#define HIBERNATE_WAKE_DATA        (HIBERNATE_WAKE_BASE + 0x030)
+#define HIBERNATE_WAKE_REGS        28
+
+#define HIBERNATE_WAKE_HIBREQ      0x00000002
+#define HIBERNATE_WAKE_CONFIGURED  0x80000049      /* WRC, CLK32EN, RTCWEN, RTCEN */
+#define HIBERNATE_WAKE_RTCALT0     0x00000001
+#define HIBERNATE_WAKE_EXTW        0x00000008
+
+/* Resume reads the state and its check word, the cause, and sets the run, sleep and deep-sleep clock gates */
+#define HIBERNATE_WAKE_RESUME_ACCESSES(Words)   ((Words) + 9)
+
+static boolean g_Requested = FALSE;
+
+static char g_Log[HIBERNATE_WAKE_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void HibernateWake_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < HIBERNATE_WAKE_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+/* HIBREQ powers the device down, the bit reads back as 0 */
+static uint32 HibernateWake_Control(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    char token[16];
+
+    (void)Address;
+    (void)OldValue;
+
+    if(NewValue & HIBERNATE_WAKE_HIBREQ){
+        sprintf(token, "H@%u", (unsigned)HostReg_Peek(HIBERNATE_WAKE_RTCM0));
+        HibernateWake_Log(token);
+        g_Requested = TRUE;
+    }
+    else{
+        HibernateWake_Log("CTL");
+    }
+
+    return NewValue & ~HIBERNATE_WAKE_HIBREQ;
+}
+
+static uint32 HibernateWake_Data(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    char token[16];
+
+    (void)OldValue;
+
+    sprintf(token, "D%u", (unsigned)((Address - HIBERNATE_WAKE_DATA) / 4));
+    HibernateWake_Log(token);
+
+    return NewValue;
+}
+
+/* Write 1 to clear HIBRIS, reads as 0 so every clear is seen */
+static uint32 HibernateWake_Clear(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    (void)Address;
+    (void)OldValue;
+
+    HostReg_Poke(HIBERNATE_WAKE_RIS, HostReg_Peek(HIBERNATE_WAKE_RIS) & ~NewValue);
+    HibernateWake_Log("IC");
+
+    return 0;
+}
+
+/* Reset of everything but the hibernation module, Keep FALSE when the battery goes too */
+static void HibernateWake_Reset(boolean Keep){
+
+    uint32 regs[HIBERNATE_WAKE_REGS];
+    uint8 i;
+
+    for(i = 0; i < HIBERNATE_WAKE_REGS; i++){
+        regs[i] = HostReg_Peek(HIBERNATE_WAKE_BASE + (4 * i));
+    }
+
+    HostReg_Init();
+    if(Keep){
+        for(i = 0; i < HIBERNATE_WAKE_REGS; i++){
+            HostReg_Poke(HIBERNATE_WAKE_BASE + (4 * i), regs[i]);
+        }
+    }
+
+    HostReg_AddCallback(HIBERNATE_WAKE_CTL, HibernateWake_Control);
+    HostReg_AddCallback(HIBERNATE_WAKE_IC, HibernateWake_Clear);
+    for(i = 0; i <= HIBERNATE_STATE_WORDS; i++){
+        HostReg_AddCallback(HIBERNATE_WAKE_DATA + (4 * i), HibernateWake_Data);
+    }
+    g_Requested = FALSE;
+}
+
+/* The RTC reaches the match or the WAKE pin goes low, then the power comes back */
+static void HibernateWake_Wake(uint32 Cause){
+
+    if(!g_Requested){
+        HibernateWake_Log("not-hibernating");
+    }
+    if(Cause == HIBERNATE_WAKE_RTCALT0){
+        HostReg_Poke(HIBERNATE_WAKE_RTCC, HostReg_Peek(HIBERNATE_WAKE_RTCM0));
+    }
+    HostReg_Poke(HIBERNATE_WAKE_RIS, HostReg_Peek(HIBERNATE_WAKE_RIS) | Cause);
+    HibernateWake_Reset(TRUE);
+}
+
+/* Resume with the expected cause and state, on the access budget of the fast path */
+static void HibernateWake_Resume(Hibernate_WakeType Expected, const uint32 *State, uint8 Words){
+
+    uint32 state[HIBERNATE_STATE_WORDS] = { 0 };
+    uint32 accesses = HostReg_GetAccessCount();
+
+    if(Hibernate_Resume(state, Words) != Expected){
+        HibernateWake_Log("bad-cause");
+    }
+    HostReg_Sync();
+
+    if((State != NULL_PTR) && (memcmp(state, State, Words * sizeof(uint32)) != 0)){
+        HibernateWake_Log("bad-state");
+    }
+    if((HostReg_GetAccessCount() - accesses) > HIBERNATE_WAKE_RESUME_ACCESSES(Words)){
+        HibernateWake_Log("slow");
+    }
+}
+
+static void HibernateWake_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+int main(void){
+
+    const Hibernate_ConfigType config = { FALSE, FALSE };
+    static const uint32 first[3]  = { 1, 2, 3 };
+    static const uint32 second[3] = { 1, 9, 3 };
+    static const uint32 wide[HIBERNATE_STATE_WORDS + 1] = { 0 };
+
+    HibernateWake_Reset(FALSE);
+
+    /* First power up: nothing to restore, the oscillator and RTC started */
+    HibernateWake_Resume(HIBERNATE_WAKE_NONE, NULL_PTR, 3);
+    Hibernate_Init(&config);
+    if(HostReg_Peek(HIBERNATE_WAKE_CTL) != HIBERNATE_WAKE_CONFIGURED){
+        HibernateWake_Log("bad-ctl");
+    }
+    (void)Hibernate_Enter(5, first, 3);
+    HostReg_Sync();
+    HibernateWake_Check("cold start", "CTL CTL D1 D2 D3 D0 H@5");
+
+    /* RTC match: the state back with a single HIB write */
+    HibernateWake_Wake(HIBERNATE_WAKE_RTCALT0);
+    HibernateWake_Resume(HIBERNATE_WAKE_RTC, first, 3);
+    HibernateWake_Check("rtc wake", "IC");
+
+    /* Only the word that changed and the check word are written again */
+    (void)Hibernate_Enter(5, second, 3);
+    HostReg_Sync();
+    HibernateWake_Check("partial save", "D2 D0 H@10");
+
+    HibernateWake_Wake(HIBERNATE_WAKE_EXTW);
+    HibernateWake_Resume(HIBERNATE_WAKE_PIN, second, 3);
+    HibernateWake_Check("pin wake", "IC");
+
+    /* A reset while running: the cause is gone, the state is still there */
+    HibernateWake_Reset(TRUE);
+    HibernateWake_Resume(HIBERNATE_WAKE_RESET, second, 3);
+    HibernateWake_Check("reset", "");
+
+    /* A state of another length is not restored */
+    HibernateWake_Reset(TRUE);
+    HibernateWake_Resume(HIBERNATE_WAKE_NONE, NULL_PTR, 2);
+    HibernateWake_Check("other length", "");
+
+    /* Battery removed: the module starts from its reset values */
+    HibernateWake_Reset(FALSE);
+    HibernateWake_Resume(HIBERNATE_WAKE_NONE, NULL_PTR, 3);
+    HibernateWake_Check("battery removed", "");
+
+    if(Hibernate_Enter(0, first, 3) || Hibernate_Enter(5, wide, HIBERNATE_STATE_WORDS + 1)){
+        HibernateWake_Log("accepted");
+    }
+    HostReg_Sync();
+    HibernateWake_Check("limits", "");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
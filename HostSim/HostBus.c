@@ -0,0 +1,93 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: HostBus.c
+ *
+ * Description: Bus access counting of the bench build. The drivers are compiled
+ *              with the thread sanitizer instrumentation but linked without its
+ *              runtime, so every load and store they make calls the entry points
+ *              below. A volatile load of the register file is one bus read and a
+ *              volatile store one bus write, REG |= x costs both where REG = x
+ *              costs a write only
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "HostRegisters.h"
+
+/* Register accesses, HW_REG hands out volatile lvalues */
+#define HOSTBUS_READ(Size)                                              \
+    void __tsan_volatile_read##Size(void *Address){                     \
+        HostReg_CountAccess(Address, FALSE);                            \
+    }                                                                   \
+    void __tsan_unaligned_volatile_read##Size(void *Address){           \
+        HostReg_CountAccess(Address, FALSE);                            \
+    }
+
+#define HOSTBUS_WRITE(Size)                                             \
+    void __tsan_volatile_write##Size(void *Address){                    \
+        HostReg_CountAccess(Address, TRUE);                             \
+    }                                                                   \
+    void __tsan_unaligned_volatile_write##Size(void *Address){          \
+        HostReg_CountAccess(Address, TRUE);                             \
+    }
+
+/* RAM accesses, not on the peripheral bus */
+#define HOSTBUS_RAM(Size)                                               \
+    void __tsan_read##Size(void *Address){ (void)Address; }             \
+    void __tsan_write##Size(void *Address){ (void)Address; }            \
+    void __tsan_unaligned_read##Size(void *Address){ (void)Address; }   \
+    void __tsan_unaligned_write##Size(void *Address){ (void)Address; }
+
+HOSTBUS_READ(1)
+HOSTBUS_READ(2)
+HOSTBUS_READ(4)
+HOSTBUS_READ(8)
+HOSTBUS_READ(16)
+
+HOSTBUS_WRITE(1)
+HOSTBUS_WRITE(2)
+HOSTBUS_WRITE(4)
+HOSTBUS_WRITE(8)
+HOSTBUS_WRITE(16)
+
+HOSTBUS_RAM(1)
+HOSTBUS_RAM(2)
+HOSTBUS_RAM(4)
+HOSTBUS_RAM(8)
+HOSTBUS_RAM(16)
+
+void __tsan_read_range(void *Address, unsigned long Size){
+
+    (void)Address;
+    (void)Size;
+}
+
+void __tsan_write_range(void *Address, unsigned long Size){
+
+    (void)Address;
+    (void)Size;
+}
+
+/* Called by the constructor of every instrumented object, nothing to set up */
+void __tsan_init(void){
+}
+
+void __tsan_func_entry(void *Caller){
+
+    (void)Caller;
+}
+
+void __tsan_func_exit(void){
+}
+
+/* The compare and swap of Queue.h, used by MemPool, done here as the runtime would */
+int __tsan_atomic32_compare_exchange_strong(volatile int *Address, int *Expected, int Desired,
+                                            int Order, int FailOrder){
+
+    (void)Order;
+    (void)FailOrder;
+
+    return __atomic_compare_exchange_n(Address, Expected, Desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
@@ -0,0 +1,858 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: HostModel.c
+ *
+ * Description: Source file for the cycle level SysTick and NVIC behavioural model
+ *              running on top of the simulated register file
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "HostModel.h"
+
+/* Registers read and written back by the model */
+#define HOSTMODEL_SYSTICK_CTRL        0xE000E010
+#define HOSTMODEL_SYSTICK_RELOAD      0xE000E014
+#define HOSTMODEL_SYSTICK_CURRENT     0xE000E018
+#define HOSTMODEL_NVIC_EN0            0xE000E100
+#define HOSTMODEL_NVIC_PEND0          0xE000E200
+#define HOSTMODEL_NVIC_UNPEND0        0xE000E280
+#define HOSTMODEL_NVIC_ACTIVE0        0xE000E300
+#define HOSTMODEL_NVIC_PRI0           0xE000E400
+#define HOSTMODEL_SYSTEM_INTCTRL      0xE000ED04
+#define HOSTMODEL_SYSTEM_APINT        0xE000ED0C
+#define HOSTMODEL_SYSTEM_PRI1         0xE000ED18
+#define HOSTMODEL_SYSTEM_SYSHNDCTRL   0xE000ED24
+#define HOSTMODEL_DWT_CYCCNT          0xE0001004
+#define HOSTMODEL_NVIC_GROUPS         5
+
+#define HOSTMODEL_CTRL_ENABLE         0x00000001
+#define HOSTMODEL_CTRL_INTEN          0x00000002
+#define HOSTMODEL_CTRL_COUNT          0x00010000
+#define HOSTMODEL_CURRENT_MASK        0x00FFFFFF
+
+#define HOSTMODEL_INTCTRL_PENDSV_SET  0x10000000
+#define HOSTMODEL_INTCTRL_PENDSV_CLR  0x08000000
+#define HOSTMODEL_INTCTRL_PENDST_SET  0x04000000
+#define HOSTMODEL_INTCTRL_PENDST_CLR  0x02000000
+#define HOSTMODEL_INTCTRL_ISRPEND     0x00400000
+#define HOSTMODEL_INTCTRL_RETBASE     0x00000800
+
+#define HOSTMODEL_FIRST_VECTOR        4     /* memory management fault */
+#define HOSTMODEL_MAX_NESTING         9     /* 8 group priorities + one spare */
+#define HOSTMODEL_NEVER               (~(uint64)0)
+
+typedef struct
+{
+    uint8 vector;
+    uint16 group;
+    uint32 remaining;               /* body cycles left */
+} HostModel_FrameType;
+
+typedef struct
+{
+    boolean used;
+    uint8 vector;
+    uint64 cycle;
+    uint32 period;
+} HostModel_EventType;
+
+static uint64 g_Cycles = 0;
+static uint64 g_ThreadCycles = 0;
+
+static HostModel_HandlerType g_Handlers[HOSTMODEL_VECTORS];
+static uint32 g_BodyCycles[HOSTMODEL_VECTORS];
+static boolean g_Pending[HOSTMODEL_VECTORS];
+static uint64 g_PendCycle[HOSTMODEL_VECTORS];
+static HostModel_StatsType g_Stats[HOSTMODEL_VECTORS];
+
+static HostModel_FrameType g_Active[HOSTMODEL_MAX_NESTING];
+static uint8 g_Depth = 0;
+
+static HostModel_EventType g_Events[HOSTMODEL_MAX_EVENTS];
+
+/* SysTick counter is kept here and published to STCURRENT, a different value in
+ * STCURRENT means the software wrote it (the register hook clears it to 0) */
+static uint32 g_SysTickCurrent = 0;
+static uint32 g_SysTickPublished = 0;
+
+static HostModel_TraceEntryType g_Trace[HOSTMODEL_TRACE_SIZE];
+static uint32 g_TraceCount = 0;
+
+static void HostModel_Trace(HostModel_TraceKindType Kind, uint8 Vector, uint8 PriorityByte){
+
+    HostModel_TraceEntryType *entry = &g_Trace[g_TraceCount & (HOSTMODEL_TRACE_SIZE - 1)];
+
+    entry->cycle    = g_Cycles;
+    entry->vector   = Vector;
+    entry->kind     = (uint8)Kind;
+    entry->depth    = g_Depth;
+    entry->priority = PriorityByte >> 5;
+    g_TraceCount++;
+}
+
+/* Priority byte of a vector, only bits 7:5 are implemented */
+static uint8 HostModel_PriorityByte(uint8 Vector){
+
+    uint32 address;
+
+    if(Vector >= HOSTMODEL_VECTOR_IRQ(0)){
+        address = HOSTMODEL_NVIC_PRI0 + (Vector - HOSTMODEL_VECTOR_IRQ(0));
+    }
+    else{
+        address = HOSTMODEL_SYSTEM_PRI1 + (Vector - HOSTMODEL_FIRST_VECTOR);
+    }
+
+    return (uint8)((HostReg_Peek(address & ~3UL) >> ((address & 3) * 8)) & 0xE0);
+}
+
+/* Group priority field of a priority byte (or HOSTMODEL_THREAD_PRIORITY), PRIGROUP of APINT */
+static uint16 HostModel_GroupPriority(uint16 PriorityByte){
+
+    uint8 shift = (uint8)(((HostReg_Peek(HOSTMODEL_SYSTEM_APINT) >> 8) & 0x7) + 1);
+
+    if(shift < 5){
+        shift = 5;
+    }
+
+    return (uint16)(PriorityByte >> shift);
+}
+
+static boolean HostModel_IsEnabled(uint8 Vector){
+
+    if(Vector >= HOSTMODEL_VECTOR_IRQ(0)){
+
+        uint8 irq = Vector - HOSTMODEL_VECTOR_IRQ(0);
+        return (HostReg_Peek(HOSTMODEL_NVIC_EN0 + (4 * (irq / 32))) >> (irq % 32)) & 1;
+    }
+
+    if(Vector < 7){
+
+        /* MEM, BUS and USAGE faults are enabled in SYSHNDCTRL bits 16..18 */
+        return (HostReg_Peek(HOSTMODEL_SYSTEM_SYSHNDCTRL) >> (Vector - HOSTMODEL_FIRST_VECTOR + 16)) & 1;
+    }
+
+    return TRUE;
+}
+
+static void HostModel_Pend(uint8 Vector){
+
+    if(!g_Pending[Vector]){
+
+        g_Pending[Vector]   = TRUE;
+        g_PendCycle[Vector] = g_Cycles;
+        HostModel_Trace(HOSTMODEL_TRACE_PEND, Vector, HostModel_PriorityByte(Vector));
+    }
+}
+
+/* Highest priority pending and enabled vector, lowest number wins a tie, 0 if none */
+static uint8 HostModel_SelectPending(void){
+
+    uint8 best = 0;
+    uint16 bestPriority = HOSTMODEL_THREAD_PRIORITY;
+    uint8 v;
+
+    for(v = HOSTMODEL_FIRST_VECTOR; v < HOSTMODEL_VECTORS; v++){
+
+        if(g_Pending[v] && HostModel_IsEnabled(v)){
+
+            uint16 priority = HostModel_PriorityByte(v);
+            if(priority < bestPriority){
+                best = v;
+                bestPriority = priority;
+            }
+        }
+    }
+
+    return best;
+}
+
+/* Group priority the core runs at, after popping Skip frames */
+static uint16 HostModel_ExecutionPriority(uint8 Skip){
+
+    if(g_Depth <= Skip){
+        return HostModel_GroupPriority(HOSTMODEL_THREAD_PRIORITY);
+    }
+
+    return g_Active[g_Depth - 1 - Skip].group;
+}
+
+static boolean HostModel_CanPreempt(uint8 Vector, uint8 Skip){
+
+    if(HostReg_GetPrimask() || HostReg_GetFaultmask()){
+        return FALSE;
+    }
+
+    return HostModel_GroupPriority(HostModel_PriorityByte(Vector)) < HostModel_ExecutionPriority(Skip);
+}
+
+/* Publish the model state into SysTick, INTCTRL, NVIC PEND/ACTIVE and DWT CYCCNT */
+static void HostModel_SyncOut(void){
+
+    uint32 intctrl = 0;
+    uint32 group[HOSTMODEL_NVIC_GROUPS] = { 0 };
+    uint8 pending = HostModel_SelectPending();
+    uint8 i;
+
+    g_SysTickPublished = g_SysTickCurrent;
+    HostReg_Poke(HOSTMODEL_SYSTICK_CURRENT, g_SysTickCurrent);
+
+    for(i = HOSTMODEL_VECTOR_IRQ(0); i < HOSTMODEL_VECTORS; i++){
+
+        if(g_Pending[i]){
+            group[(i - 16) / 32] |= 1UL << ((i - 16) % 32);
+            intctrl |= HOSTMODEL_INTCTRL_ISRPEND;
+        }
+    }
+    for(i = 0; i < HOSTMODEL_NVIC_GROUPS; i++){
+        HostReg_Poke(HOSTMODEL_NVIC_PEND0 + (4 * i), group[i]);
+        group[i] = 0;
+    }
+
+    for(i = 0; i < g_Depth; i++){
+
+        if(g_Active[i].vector >= HOSTMODEL_VECTOR_IRQ(0)){
+            group[(g_Active[i].vector - 16) / 32] |= 1UL << ((g_Active[i].vector - 16) % 32);
+        }
+    }
+    for(i = 0; i < HOSTMODEL_NVIC_GROUPS; i++){
+        HostReg_Poke(HOSTMODEL_NVIC_ACTIVE0 + (4 * i), group[i]);
+    }
+
+    if(g_Pending[HOSTMODEL_VECTOR_PENDSV]){
+        intctrl |= HOSTMODEL_INTCTRL_PENDSV_SET;
+    }
+    if(g_Pending[HOSTMODEL_VECTOR_SYSTICK]){
+        intctrl |= HOSTMODEL_INTCTRL_PENDST_SET;
+    }
+    if(g_Depth <= 1){
+        intctrl |= HOSTMODEL_INTCTRL_RETBASE;
+    }
+    if(g_Depth > 0){
+        intctrl |= g_Active[g_Depth - 1].vector;
+    }
+    intctrl |= (uint32)pending << 12;
+
+    HostReg_Poke(HOSTMODEL_SYSTEM_INTCTRL, intctrl);
+    HostReg_Poke(HOSTMODEL_DWT_CYCCNT, (uint32)g_Cycles);
+}
+
+/* Pick up what the software wrote: STCURRENT, INTCTRL set/clear bits and NVIC PEND/UNPEND */
+static void HostModel_SyncIn(void){
+
+    uint32 intctrl = HostReg_Peek(HOSTMODEL_SYSTEM_INTCTRL);
+    uint32 current = HostReg_Peek(HOSTMODEL_SYSTICK_CURRENT);
+    uint8 i;
+
+    if(current != g_SysTickPublished){
+        g_SysTickCurrent = current & HOSTMODEL_CURRENT_MASK;
+    }
+
+    if(intctrl & HOSTMODEL_INTCTRL_PENDSV_SET){
+        HostModel_Pend(HOSTMODEL_VECTOR_PENDSV);
+    }
+    if(intctrl & HOSTMODEL_INTCTRL_PENDSV_CLR){
+        g_Pending[HOSTMODEL_VECTOR_PENDSV] = FALSE;
+    }
+    if(intctrl & HOSTMODEL_INTCTRL_PENDST_SET){
+        HostModel_Pend(HOSTMODEL_VECTOR_SYSTICK);
+    }
+    if(intctrl & HOSTMODEL_INTCTRL_PENDST_CLR){
+        g_Pending[HOSTMODEL_VECTOR_SYSTICK] = FALSE;
+    }
+
+    for(i = 0; i < HOSTMODEL_NVIC_GROUPS; i++){
+
+        uint32 set   = HostReg_Peek(HOSTMODEL_NVIC_PEND0 + (4 * i));
+        uint32 clear = HostReg_Peek(HOSTMODEL_NVIC_UNPEND0 + (4 * i));
+        uint8 bit;
+
+        for(bit = 0; bit < 32; bit++){
+
+            uint8 vector = HOSTMODEL_VECTOR_IRQ(32 * i + bit);
+            if(vector >= HOSTMODEL_VECTORS){
+                break;
+            }
+            if((set >> bit) & 1){
+                HostModel_Pend(vector);
+            }
+            if((clear >> bit) & 1){
+                g_Pending[vector] = FALSE;
+            }
+        }
+
+        /* UNPEND is kept at zero so that a write is always visible */
+        HostReg_Poke(HOSTMODEL_NVIC_UNPEND0 + (4 * i), 0);
+    }
+
+    HostModel_SyncOut();
+}
+
+/* Cycles until the SysTick counter next goes from 1 to 0 */
+static uint64 HostModel_SysTickDelta(void){
+
+    uint32 reload = HostReg_Peek(HOSTMODEL_SYSTICK_RELOAD) & HOSTMODEL_CURRENT_MASK;
+
+    if(!(HostReg_Peek(HOSTMODEL_SYSTICK_CTRL) & HOSTMODEL_CTRL_ENABLE) || (reload == 0)){
+        return HOSTMODEL_NEVER;
+    }
+
+    /* 0 reloads on the next clock, a period is therefore RELOAD + 1 cycles */
+    return (g_SysTickCurrent == 0) ? ((uint64)reload + 1) : g_SysTickCurrent;
+}
+
+/* The counter runs on the core clock whatever CLK_SRC says. Called with the time
+ * already advanced, a step never goes past a wrap so the wrap is stamped right */
+static void HostModel_SysTickAdvance(uint64 Cycles){
+
+    uint32 ctrl = HostReg_Peek(HOSTMODEL_SYSTICK_CTRL);
+    uint32 reload = HostReg_Peek(HOSTMODEL_SYSTICK_RELOAD) & HOSTMODEL_CURRENT_MASK;
+
+    if(!(ctrl & HOSTMODEL_CTRL_ENABLE)){
+        return;
+    }
+
+    while(Cycles > 0){
+
+        if(g_SysTickCurrent == 0){
+
+            if(reload == 0){
+                break;
+            }
+            g_SysTickCurrent = reload;
+            Cycles--;
+        }
+        else if(Cycles >= g_SysTickCurrent){
+
+            Cycles -= g_SysTickCurrent;
+            g_SysTickCurrent = 0;
+
+            HostReg_Poke(HOSTMODEL_SYSTICK_CTRL, HostReg_Peek(HOSTMODEL_SYSTICK_CTRL) | HOSTMODEL_CTRL_COUNT);
+            if(ctrl & HOSTMODEL_CTRL_INTEN){
+                HostModel_Pend(HOSTMODEL_VECTOR_SYSTICK);
+            }
+        }
+        else{
+
+            g_SysTickCurrent -= (uint32)Cycles;
+            Cycles = 0;
+        }
+    }
+}
+
+static uint64 HostModel_EventDelta(void){
+
+    uint64 delta = HOSTMODEL_NEVER;
+    uint8 i;
+
+    for(i = 0; i < HOSTMODEL_MAX_EVENTS; i++){
+
+        if(g_Events[i].used){
+
+            uint64 d = (g_Events[i].cycle > g_Cycles) ? (g_Events[i].cycle - g_Cycles) : 0;
+            if(d < delta){
+                delta = d;
+            }
+        }
+    }
+
+    return delta;
+}
+
+static void HostModel_FireEvents(void){
+
+    uint8 i;
+
+    for(i = 0; i < HOSTMODEL_MAX_EVENTS; i++){
+
+        if(g_Events[i].used && (g_Events[i].cycle <= g_Cycles)){
+
+            HostModel_Pend(g_Events[i].vector);
+
+            if(g_Events[i].period != 0){
+                g_Events[i].cycle += g_Events[i].period;
+            }
+            else{
+                g_Events[i].used = FALSE;
+            }
+        }
+    }
+}
+
+/* Advance the time, stopping at every SysTick wrap and external event on the way */
+static void HostModel_Advance(uint64 Cycles){
+
+    do{
+        uint64 step = Cycles;
+        uint64 delta = HostModel_SysTickDelta();
+
+        if(delta < step){
+            step = delta;
+        }
+        delta = HostModel_EventDelta();
+        if(delta < step){
+            step = delta;
+        }
+
+        g_Cycles += step;
+        HostModel_SysTickAdvance(step);
+        Cycles -= step;
+
+        HostModel_FireEvents();
+
+    }while(Cycles > 0);
+}
+
+static void HostModel_Enter(uint8 Vector, boolean TailChain){
+
+    HostModel_StatsType *stats = &g_Stats[Vector];
+    HostModel_FrameType *frame;
+    uint8 priority = HostModel_PriorityByte(Vector);
+    uint32 latency;
+
+    /* Pending is cleared when the stacking starts */
+    g_Pending[Vector] = FALSE;
+    HostModel_Advance(TailChain ? HOSTMODEL_TAIL_CHAIN_CYCLES : HOSTMODEL_ENTRY_CYCLES);
+
+    latency = (uint32)(g_Cycles - g_PendCycle[Vector]);
+    stats->count++;
+    stats->lastLatency = latency;
+    stats->totalLatency += latency;
+    if(latency > stats->maxLatency){
+        stats->maxLatency = latency;
+    }
+    if((g_Depth > 0) && !TailChain){
+        stats->preemptCount++;
+    }
+
+    frame = &g_Active[g_Depth++];
+    frame->vector    = Vector;
+    frame->group     = HostModel_GroupPriority(priority);
+    frame->remaining = g_BodyCycles[Vector];
+
+    HostModel_Trace(TailChain ? HOSTMODEL_TRACE_TAIL_CHAIN : HOSTMODEL_TRACE_ENTER, Vector, priority);
+
+    HostModel_SyncOut();
+    if(g_Handlers[Vector] != NULL_PTR){
+        g_Handlers[Vector]();
+    }
+    HostModel_SyncIn();
+}
+
+static void HostModel_Exit(void){
+
+    uint8 vector = g_Active[g_Depth - 1].vector;
+    uint8 next = HostModel_SelectPending();
+
+    if((next != 0) && HostModel_CanPreempt(next, 1)){
+
+        /* Tail chaining skips the unstacking and the stacking of the next handler */
+        g_Depth--;
+        HostModel_Trace(HOSTMODEL_TRACE_EXIT, vector, HostModel_PriorityByte(vector));
+        HostModel_Enter(next, TRUE);
+    }
+    else{
+
+        HostModel_Advance(HOSTMODEL_EXIT_CYCLES);
+        g_Depth--;
+        HostModel_Trace(HOSTMODEL_TRACE_EXIT, vector, HostModel_PriorityByte(vector));
+        HostModel_SyncIn();
+    }
+}
+
+/*********************************************************************
+* Service Name: HostModel_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to reset the register file, the simulated time, the exception
+*              state, the handlers, the trace and the statistics.
+**********************************************************************/
+void HostModel_Init(void){
+
+    uint8 v;
+
+    HostReg_Init();
+
+    g_Cycles = 0;
+    g_ThreadCycles = 0;
+    g_Depth = 0;
+    g_SysTickCurrent = 0;
+    g_SysTickPublished = 0;
+    g_TraceCount = 0;
+
+    for(v = 0; v < HOSTMODEL_VECTORS; v++){
+
+        g_Handlers[v]   = NULL_PTR;
+        g_BodyCycles[v] = 0;
+        g_Pending[v]    = FALSE;
+        g_PendCycle[v]  = 0;
+        g_Stats[v].count        = 0;
+        g_Stats[v].preemptCount = 0;
+        g_Stats[v].lastLatency  = 0;
+        g_Stats[v].maxLatency   = 0;
+        g_Stats[v].totalLatency = 0;
+    }
+
+    for(v = 0; v < HOSTMODEL_MAX_EVENTS; v++){
+        g_Events[v].used = FALSE;
+    }
+
+    HostModel_SyncOut();
+}
+
+/*********************************************************************
+* Service Name: HostModel_SetHandler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Vector - Exception number / Handler - Function called on entry, may be
+*                  NULL_PTR / BodyCycles - Cycles the handler body occupies the core
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for an invalid vector
+* Description: Function to bind a driver handler (e.g. SysTick_Handler) to a vector. The
+*              host function runs at once on entry, the core then stays in the handler
+*              for BodyCycles during which higher priority exceptions may preempt it.
+**********************************************************************/
+boolean HostModel_SetHandler(uint8 Vector, HostModel_HandlerType Handler, uint32 BodyCycles){
+
+    if((Vector < HOSTMODEL_FIRST_VECTOR) || (Vector >= HOSTMODEL_VECTORS)){
+        return FALSE;
+    }
+
+    g_Handlers[Vector]   = Handler;
+    g_BodyCycles[Vector] = BodyCycles;
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: HostModel_PendVector
+* Sync/Async: Asynchronous
+* Reentrancy: non reentrant
+* Parameters (in): Vector - Exception number
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to make an exception pending now, as a peripheral would.
+**********************************************************************/
+void HostModel_PendVector(uint8 Vector){
+
+    if((Vector >= HOSTMODEL_FIRST_VECTOR) && (Vector < HOSTMODEL_VECTORS)){
+
+        HostModel_Pend(Vector);
+        HostModel_SyncOut();
+    }
+}
+
+/*********************************************************************
+* Service Name: HostModel_ScheduleVector
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Vector - Exception number / Cycle - Absolute time of the first request
+*                  Period - Cycles between requests, 0 for a single one
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the event table is full
+* Description: Function to model an external interrupt source.
+**********************************************************************/
+boolean HostModel_ScheduleVector(uint8 Vector, uint64 Cycle, uint32 Period){
+
+    uint8 i;
+
+    if((Vector < HOSTMODEL_FIRST_VECTOR) || (Vector >= HOSTMODEL_VECTORS)){
+        return FALSE;
+    }
+
+    for(i = 0; i < HOSTMODEL_MAX_EVENTS; i++){
+
+        if(!g_Events[i].used){
+
+            g_Events[i].used   = TRUE;
+            g_Events[i].vector = Vector;
+            g_Events[i].cycle  = Cycle;
+            g_Events[i].period = Period;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/*********************************************************************
+* Service Name: HostModel_Run
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Cycles - Simulated core cycles to advance
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to advance the SysTick counter, take pending exceptions in
+*              priority order with preemption and tail chaining, and call the bound
+*              handlers. The cycles not spent in handlers are counted as thread time.
+**********************************************************************/
+void HostModel_Run(uint64 Cycles){
+
+    uint64 end = g_Cycles + Cycles;
+
+    HostModel_SyncIn();
+
+    while(g_Cycles < end){
+
+        uint8 next = HostModel_SelectPending();
+        uint64 step;
+        uint64 delta;
+
+        if((next != 0) && HostModel_CanPreempt(next, 0)){
+            HostModel_Enter(next, FALSE);
+            continue;
+        }
+
+        /* Run the thread or the current handler body up to the next event */
+        step = end - g_Cycles;
+        if((g_Depth > 0) && (g_Active[g_Depth - 1].remaining < step)){
+            step = g_Active[g_Depth - 1].remaining;
+        }
+        delta = HostModel_SysTickDelta();
+        if(delta < step){
+            step = delta;
+        }
+        delta = HostModel_EventDelta();
+        if(delta < step){
+            step = delta;
+        }
+
+        if(g_Depth == 0){
+            g_ThreadCycles += step;
+        }
+        else{
+            g_Active[g_Depth - 1].remaining -= (uint32)step;
+        }
+
+        HostModel_Advance(step);
+        HostModel_SyncIn();
+
+        if((g_Depth > 0) && (g_Active[g_Depth - 1].remaining == 0)){
+            HostModel_Exit();
+        }
+    }
+}
+
+/*********************************************************************
+* Service Name: HostModel_Execute
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Cycles - Cycles of work of the caller
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to model work of a length only known at run time, called from
+*              a bound handler or from thread code. The time advances by Cycles plus
+*              the handlers that preempt the caller on the way, which run before it
+*              returns.
+**********************************************************************/
+void HostModel_Execute(uint32 Cycles){
+
+    uint8 level = g_Depth;          /* frame of the caller, 0 in thread mode */
+    uint64 left = Cycles;
+
+    HostModel_SyncIn();
+
+    while((left > 0) || (g_Depth > level)){
+
+        uint8 next = HostModel_SelectPending();
+        uint64 step;
+        uint64 delta;
+
+        if((next != 0) && HostModel_CanPreempt(next, 0)){
+            HostModel_Enter(next, FALSE);
+            continue;
+        }
+
+        /* The caller's work or the body of a handler that preempted it */
+        step = (g_Depth > level) ? g_Active[g_Depth - 1].remaining : left;
+        delta = HostModel_SysTickDelta();
+        if(delta < step){
+            step = delta;
+        }
+        delta = HostModel_EventDelta();
+        if(delta < step){
+            step = delta;
+        }
+
+        if(g_Depth > level){
+            g_Active[g_Depth - 1].remaining -= (uint32)step;
+        }
+        else{
+            left -= step;
+            if(level == 0){
+                g_ThreadCycles += step;
+            }
+        }
+
+        HostModel_Advance(step);
+        HostModel_SyncIn();
+
+        if((g_Depth > level) && (g_Active[g_Depth - 1].remaining == 0)){
+            HostModel_Exit();
+        }
+    }
+
+    HostModel_SyncOut();
+}
+
+/*********************************************************************
+* Service Name: HostModel_WaitForInterrupt
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): WakeCycles - Cycles from the wake-up event to the first handler
+*                  instruction (clock restart) / Sleep - FALSE for a busy wait in thread mode
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint64 - Cycles spent waiting, 0 when nothing can ever wake the core
+* Description: Function to model WFI from thread mode: the time advances to the next
+*              SysTick wrap or external event, then the woken handlers run to completion.
+**********************************************************************/
+uint64 HostModel_WaitForInterrupt(uint32 WakeCycles, boolean Sleep){
+
+    uint64 start = g_Cycles;
+    uint64 waited;
+
+    HostModel_SyncIn();
+
+    /* WFI wakes on any enabled pending exception, PRIMASK only delays its handler */
+    while(HostModel_SelectPending() == 0){
+
+        uint64 step = HostModel_SysTickDelta();
+        uint64 delta = HostModel_EventDelta();
+
+        if(delta < step){
+            step = delta;
+        }
+        if(step == HOSTMODEL_NEVER){
+            return 0;
+        }
+
+        HostModel_Advance(step);
+    }
+
+    waited = g_Cycles - start;
+    if(Sleep){
+        HostModel_Advance(WakeCycles);
+    }
+    else{
+        g_ThreadCycles += waited;
+    }
+
+    while(TRUE){
+
+        uint8 next = HostModel_SelectPending();
+
+        if((g_Depth == 0) && ((next == 0) || !HostModel_CanPreempt(next, 0))){
+            break;
+        }
+        HostModel_Run(((g_Depth > 0) && (g_Active[g_Depth - 1].remaining > 0)) ? g_Active[g_Depth - 1].remaining : 1);
+    }
+    HostModel_SyncOut();
+
+    return waited;
+}
+
+/*********************************************************************
+* Service Name: HostModel_GetCycles
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint64 - Simulated cycles since HostModel_Init
+* Description: Function to read the simulated time, also mirrored into DWT CYCCNT.
+**********************************************************************/
+uint64 HostModel_GetCycles(void){
+
+    return g_Cycles;
+}
+
+/*********************************************************************
+* Service Name: HostModel_GetThreadCycles
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint64 - Simulated cycles spent in thread mode
+* Description: Function to read the time left to the application, used for CPU load.
+**********************************************************************/
+uint64 HostModel_GetThreadCycles(void){
+
+    return g_ThreadCycles;
+}
+
+/*********************************************************************
+* Service Name: HostModel_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Vector - Exception number
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the vector statistics, NULL_PTR for an invalid vector
+* Description: Function to read the entry count and latency of a vector.
+**********************************************************************/
+const HostModel_StatsType *HostModel_GetStats(uint8 Vector){
+
+    if(Vector >= HOSTMODEL_VECTORS){
+        return NULL_PTR;
+    }
+
+    return &g_Stats[Vector];
+}
+
+/*********************************************************************
+* Service Name: HostModel_GetTrace
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Index - 0 for the oldest entry still in the ring buffer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the trace entry, NULL_PTR past the last one
+* Description: Function to walk the interrupt trace.
+**********************************************************************/
+const HostModel_TraceEntryType *HostModel_GetTrace(uint32 Index){
+
+    uint32 available = (g_TraceCount < HOSTMODEL_TRACE_SIZE) ? g_TraceCount : HOSTMODEL_TRACE_SIZE;
+
+    if(Index >= available){
+        return NULL_PTR;
+    }
+
+    return &g_Trace[(g_TraceCount - available + Index) & (HOSTMODEL_TRACE_SIZE - 1)];
+}
+
+/*********************************************************************
+* Service Name: HostModel_PrintTrace
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Stream - Output file
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to print the trace as "cycle,vector,event,depth,priority" lines,
+*              stable across runs so two traces can be diffed.
+**********************************************************************/
+void HostModel_PrintTrace(FILE *Stream){
+
+    static const char *const kindName[] = { "pend", "enter", "tail", "exit" };
+    const HostModel_TraceEntryType *entry;
+    uint32 i = 0;
+
+    while((entry = HostModel_GetTrace(i++)) != NULL_PTR){
+
+        fprintf(Stream, "%llu,%u,%s,%u,%u\n", (unsigned long long)entry->cycle, entry->vector,
+                kindName[entry->kind], entry->depth, entry->priority);
+    }
+}
@@ -0,0 +1,275 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: HostModel.h
+ *
+ * Description: Header file for the cycle level SysTick and NVIC behavioural model
+ *              running on top of the simulated register file
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef HOST_MODEL_H_
+#define HOST_MODEL_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include <stdio.h>
+#include "std_types.h"
+#include "HostRegisters.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Exception numbers (vector table index) handled by the model */
+#define HOSTMODEL_VECTOR_SVC                 11
+#define HOSTMODEL_VECTOR_PENDSV              14
+#define HOSTMODEL_VECTOR_SYSTICK             15
+#define HOSTMODEL_VECTOR_IRQ(IrqNum)         (16 + (IrqNum))
+#define HOSTMODEL_VECTORS                    (16 + 139)
+
+/* Cortex-M4 exception timing in core cycles, zero wait state memory */
+#ifndef HOSTMODEL_ENTRY_CYCLES
+#define HOSTMODEL_ENTRY_CYCLES               12
+#endif
+
+#ifndef HOSTMODEL_EXIT_CYCLES
+#define HOSTMODEL_EXIT_CYCLES                10
+#endif
+
+#ifndef HOSTMODEL_TAIL_CHAIN_CYCLES
+#define HOSTMODEL_TAIL_CHAIN_CYCLES          6
+#endif
+
+/* Trace ring buffer depth, must be a power of two */
+#ifndef HOSTMODEL_TRACE_SIZE
+#define HOSTMODEL_TRACE_SIZE                 1024
+#endif
+
+/* Number of scheduled external interrupt sources */
+#ifndef HOSTMODEL_MAX_EVENTS
+#define HOSTMODEL_MAX_EVENTS                 16
+#endif
+
+/* Priority of the thread mode (lower than any 3 bit exception priority) */
+#define HOSTMODEL_THREAD_PRIORITY            0x100
+
+#if ((HOSTMODEL_TRACE_SIZE & (HOSTMODEL_TRACE_SIZE - 1)) != 0)
+#error "HOSTMODEL_TRACE_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef void (*HostModel_HandlerType)(void);
+
+typedef enum
+{
+    HOSTMODEL_TRACE_PEND,           /* exception became pending                    */
+    HOSTMODEL_TRACE_ENTER,          /* first handler instruction, from thread/ISR  */
+    HOSTMODEL_TRACE_TAIL_CHAIN,     /* first handler instruction, tail chained     */
+    HOSTMODEL_TRACE_EXIT            /* exception return completed                  */
+}HostModel_TraceKindType;
+
+typedef struct
+{
+    uint64 cycle;
+    uint8 vector;
+    uint8 kind;                     /* HostModel_TraceKindType                     */
+    uint8 depth;                    /* active exceptions after the event, 2+ = nested */
+    uint8 priority;
+} HostModel_TraceEntryType;
+
+/* Per vector statistics, latency is pend to first handler instruction */
+typedef struct
+{
+    uint32 count;
+    uint32 preemptCount;            /* entries that preempted another handler      */
+    uint32 lastLatency;
+    uint32 maxLatency;
+    uint64 totalLatency;            /* divide by count for the mean                */
+} HostModel_StatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: HostModel_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to reset the register file, the simulated time, the exception
+*              state, the handlers, the trace and the statistics.
+**********************************************************************/
+
+void HostModel_Init(void);
+
+/*********************************************************************
+* Service Name: HostModel_SetHandler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Vector - Exception number / Handler - Function called on entry, may be
+*                  NULL_PTR / BodyCycles - Cycles the handler body occupies the core
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for an invalid vector
+* Description: Function to bind a driver handler (e.g. SysTick_Handler) to a vector. The
+*              host function runs at once on entry, the core then stays in the handler
+*              for BodyCycles during which higher priority exceptions may preempt it.
+**********************************************************************/
+
+boolean HostModel_SetHandler(uint8 Vector, HostModel_HandlerType Handler, uint32 BodyCycles);
+
+/*********************************************************************
+* Service Name: HostModel_PendVector
+* Sync/Async: Asynchronous
+* Reentrancy: non reentrant
+* Parameters (in): Vector - Exception number
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to make an exception pending now, as a peripheral would.
+**********************************************************************/
+
+void HostModel_PendVector(uint8 Vector);
+
+/*********************************************************************
+* Service Name: HostModel_ScheduleVector
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Vector - Exception number / Cycle - Absolute time of the first request
+*                  Period - Cycles between requests, 0 for a single one
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the event table is full
+* Description: Function to model an external interrupt source.
+**********************************************************************/
+
+boolean HostModel_ScheduleVector(uint8 Vector, uint64 Cycle, uint32 Period);
+
+/*********************************************************************
+* Service Name: HostModel_Run
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Cycles - Simulated core cycles to advance
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to advance the SysTick counter, take pending exceptions in
+*              priority order with preemption and tail chaining, and call the bound
+*              handlers. The cycles not spent in handlers are counted as thread time.
+**********************************************************************/
+
+void HostModel_Run(uint64 Cycles);
+
+/*********************************************************************
+* Service Name: HostModel_Execute
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Cycles - Cycles of work of the caller
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to model work of a length only known at run time, called from
+*              a bound handler or from thread code. The time advances by Cycles plus
+*              the handlers that preempt the caller on the way, which run before it
+*              returns.
+**********************************************************************/
+
+void HostModel_Execute(uint32 Cycles);
+
+/*********************************************************************
+* Service Name: HostModel_WaitForInterrupt
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): WakeCycles - Cycles from the wake-up event to the first handler
+*                  instruction (clock restart) / Sleep - FALSE for a busy wait in thread mode
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint64 - Cycles spent waiting, 0 when nothing can ever wake the core
+* Description: Function to model WFI from thread mode: the time advances to the next
+*              SysTick wrap or external event, then the woken handlers run to completion.
+**********************************************************************/
+
+uint64 HostModel_WaitForInterrupt(uint32 WakeCycles, boolean Sleep);
+
+/*********************************************************************
+* Service Name: HostModel_GetCycles
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint64 - Simulated cycles since HostModel_Init
+* Description: Function to read the simulated time, also mirrored into DWT CYCCNT.
+**********************************************************************/
+
+uint64 HostModel_GetCycles(void);
+
+/*********************************************************************
+* Service Name: HostModel_GetThreadCycles
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint64 - Simulated cycles spent in thread mode
+* Description: Function to read the time left to the application, used for CPU load.
+**********************************************************************/
+
+uint64 HostModel_GetThreadCycles(void);
+
+/*********************************************************************
+* Service Name: HostModel_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Vector - Exception number
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the vector statistics, NULL_PTR for an invalid vector
+* Description: Function to read the entry count and latency of a vector.
+**********************************************************************/
+
+const HostModel_StatsType *HostModel_GetStats(uint8 Vector);
+
+/*********************************************************************
+* Service Name: HostModel_GetTrace
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Index - 0 for the oldest entry still in the ring buffer
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the trace entry, NULL_PTR past the last one
+* Description: Function to walk the interrupt trace.
+**********************************************************************/
+
+const HostModel_TraceEntryType *HostModel_GetTrace(uint32 Index);
+
+/*********************************************************************
+* Service Name: HostModel_PrintTrace
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Stream - Output file
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to print the trace as "cycle,vector,event,depth,priority" lines,
+*              stable across runs so two traces can be diffed.
+**********************************************************************/
+
+void HostModel_PrintTrace(FILE *Stream);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* HOST_MODEL_H_ */
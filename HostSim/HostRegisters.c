@@ -0,0 +1,575 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: HostRegisters.c
+ *
+ * Description: Source file for the simulated TM4C123GH6PM register file used when
+ *              the drivers are built natively with HOST_SIMULATION defined
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "HostRegisters.h"
+
+/* Registers that get a default hook in HostReg_Init */
+#define HOSTREG_NVIC_EN0              0xE000E100
+#define HOSTREG_NVIC_DIS0             0xE000E180
+#define HOSTREG_NVIC_GROUPS           5
+#define HOSTREG_SYSTICK_CTRL          0xE000E010
+#define HOSTREG_SYSTICK_CURRENT       0xE000E018
+#define HOSTREG_SYSTICK_COUNT_MASK    0x00010000
+#define HOSTREG_GPIO_RIS_OFFSET       0x414
+#define HOSTREG_GPIO_ICR_OFFSET       0x41C
+#define HOSTREG_UART0_RIS             0x4000C03C
+#define HOSTREG_UART0_ICR             0x4000C044
+#define HOSTREG_SYSCTL_RCGC_FIRST     0x400FE600
+#define HOSTREG_SYSCTL_RCGC_LAST      0x400FE65C
+#define HOSTREG_SYSCTL_PR_OFFSET      0x400       /* PRxxx = RCGCxxx + 0x400 */
+#define HOSTREG_TIMER_RIS_OFFSET      0x01C
+#define HOSTREG_TIMER_ICR_OFFSET      0x024
+#define HOSTREG_ADC_RIS_OFFSET        0x004
+#define HOSTREG_ADC_ISC_OFFSET        0x00C
+#define HOSTREG_I2C_MRIS_OFFSET       0x014
+#define HOSTREG_I2C_MICR_OFFSET       0x01C
+#define HOSTREG_QEI_RIS_OFFSET        0x024
+#define HOSTREG_QEI_ISC_OFFSET        0x028
+#define HOSTREG_PWM_RIS_OFFSET        0x018
+#define HOSTREG_PWM_ISC_OFFSET        0x01C
+#define HOSTREG_PWM_GEN_RIS_OFFSET    0x048       /* + 0x40 per generator */
+#define HOSTREG_PWM_GEN_ISC_OFFSET    0x04C
+#define HOSTREG_FLASH_FCRIS           0x400FD00C
+#define HOSTREG_FLASH_FCMISC          0x400FD014
+#define HOSTREG_HIB_CTL               0x400FC010
+#define HOSTREG_HIB_CTL_WRC           0x80000000
+
+typedef struct
+{
+    uint32 base;
+    uint32 words[HOSTREG_PAGE_WORDS];
+    uint8  hook[HOSTREG_PAGE_WORDS];    /* first hook index + 1, 0 when not hooked */
+} HostReg_PageType;
+
+typedef struct
+{
+    uint32 address;
+    HostReg_HookKindType kind;
+    uint32 pairAddress;
+    uint32 mask;
+    HostReg_CallbackType callback;
+    uint8 next;                         /* next hook on the same register + 1 */
+} HostReg_HookType;
+
+static HostReg_PageType g_Pages[HOSTREG_MAX_PAGES];
+static uint8 g_PageCount = 0;
+static HostReg_PageType *g_LastPage = NULL_PTR;
+
+static HostReg_HookType g_Hooks[HOSTREG_MAX_HOOKS];
+static uint8 g_HookCount = 0;
+
+/* Register handed out by the last HostReg_Access whose hooks are still to be applied */
+static volatile uint32 *g_PendingSlot = NULL_PTR;
+static uint32 g_PendingValue = 0;
+static uint8 g_PendingHook = 0;
+
+static uint32 g_AccessCount = 0;
+static uint32 g_ReadCount = 0;
+static uint32 g_WriteCount = 0;
+static boolean g_Primask = FALSE;
+static boolean g_Faultmask = FALSE;
+
+static HostReg_PageType *HostReg_GetPage(uint32 Address){
+
+    uint32 base = Address & ~(uint32)(HOSTREG_PAGE_SIZE - 1);
+    uint8 i;
+
+    if((g_LastPage != NULL_PTR) && (g_LastPage->base == base)){
+        return g_LastPage;
+    }
+
+    for(i = 0; i < g_PageCount; i++){
+
+        if(g_Pages[i].base == base){
+            g_LastPage = &g_Pages[i];
+            return g_LastPage;
+        }
+    }
+
+    if(g_PageCount == HOSTREG_MAX_PAGES){
+
+        fprintf(stderr, "HostReg: out of pages at 0x%08X\n", (unsigned)Address);
+        abort();
+    }
+
+    g_LastPage = &g_Pages[g_PageCount++];
+    g_LastPage->base = base;
+
+    return g_LastPage;
+}
+
+static volatile uint32 *HostReg_Slot(uint32 Address){
+
+    return &HostReg_GetPage(Address)->words[(Address & (HOSTREG_PAGE_SIZE - 1)) >> 2];
+}
+
+static boolean HostReg_NewHook(uint32 Address, HostReg_HookKindType Kind, uint32 PairAddress,
+                               uint32 Mask, HostReg_CallbackType Callback){
+
+    HostReg_PageType *page;
+    uint8 *first;
+    HostReg_HookType *hook;
+
+    if(g_HookCount == HOSTREG_MAX_HOOKS){
+        return FALSE;
+    }
+
+    hook = &g_Hooks[g_HookCount];
+    hook->address = Address;
+    hook->kind = Kind;
+    hook->pairAddress = PairAddress;
+    hook->mask = Mask;
+    hook->callback = Callback;
+    hook->next = 0;
+
+    /* Append to the chain of hooks of this register */
+    page = HostReg_GetPage(Address);
+    first = &page->hook[(Address & (HOSTREG_PAGE_SIZE - 1)) >> 2];
+    if(*first == 0){
+
+        *first = ++g_HookCount;
+    }
+    else{
+
+        hook = &g_Hooks[*first - 1];
+        while(hook->next != 0){
+            hook = &g_Hooks[hook->next - 1];
+        }
+        hook->next = ++g_HookCount;
+    }
+
+    return TRUE;
+}
+
+/* SYSCTL PRxxx follows RCGCxxx, a peripheral is ready as soon as its clock is enabled */
+static uint32 HostReg_PeripheralReady(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    (void)OldValue;
+    HostReg_Poke(Address + HOSTREG_SYSCTL_PR_OFFSET, NewValue);
+
+    return NewValue;
+}
+
+/* HIBCTL WRC, the hibernation module takes every write at once */
+static uint32 HostReg_HibernateWriteComplete(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    (void)Address;
+    (void)OldValue;
+
+    return NewValue | HOSTREG_HIB_CTL_WRC;
+}
+
+/*********************************************************************
+* Service Name: HostReg_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the register file and install the default hooks for
+*              NVIC EN/DIS, SysTick COUNT/CURRENT, the GPIO/UART/timer ICR registers,
+*              the ADC, PWM and QEI ISC, I2C MICR and flash FCMISC registers, the
+*              SYSCTL peripheral ready registers and the HIBCTL write complete bit.
+**********************************************************************/
+void HostReg_Init(void){
+
+    const uint32 gpioBase[] = { 0x40004000, 0x40005000, 0x40006000, 0x40007000, 0x40024000, 0x40025000 };
+    const uint32 timerBase[] = { 0x40030000, 0x40031000, 0x40032000, 0x40033000, 0x40034000, 0x40035000,
+                                 0x40036000, 0x40037000, 0x4004C000, 0x4004D000, 0x4004E000, 0x4004F000 };
+    const uint32 adcBase[] = { 0x40038000, 0x40039000 };
+    const uint32 pwmBase[] = { 0x40028000, 0x40029000 };
+    const uint32 i2cBase[] = { 0x40020000, 0x40021000, 0x40022000, 0x40023000 };
+    const uint32 qeiBase[] = { 0x4002C000, 0x4002D000 };
+    uint32 address;
+    uint8 i;
+    uint8 gen;
+
+    g_PageCount = 0;
+    g_LastPage = NULL_PTR;
+    g_HookCount = 0;
+    g_PendingSlot = NULL_PTR;
+    g_AccessCount = 0;
+    g_ReadCount = 0;
+    g_WriteCount = 0;
+    g_Primask = FALSE;
+    g_Faultmask = FALSE;
+
+    for(i = 0; i < HOSTREG_MAX_PAGES; i++){
+
+        uint32 w;
+        for(w = 0; w < HOSTREG_PAGE_WORDS; w++){
+            g_Pages[i].words[w] = 0;
+            g_Pages[i].hook[w] = 0;
+        }
+    }
+
+    for(i = 0; i < HOSTREG_NVIC_GROUPS; i++){
+
+        HostReg_AddHook(HOSTREG_NVIC_EN0 + (4 * i), HOSTREG_HOOK_WRITE_1_TO_SET, 0, 0xFFFFFFFF);
+        HostReg_AddHook(HOSTREG_NVIC_DIS0 + (4 * i), HOSTREG_HOOK_CLEAR_ENABLE,
+                        HOSTREG_NVIC_EN0 + (4 * i), 0xFFFFFFFF);
+    }
+
+    HostReg_AddHook(HOSTREG_SYSTICK_CTRL, HOSTREG_HOOK_CLEAR_ON_READ, 0, HOSTREG_SYSTICK_COUNT_MASK);
+    HostReg_AddHook(HOSTREG_SYSTICK_CURRENT, HOSTREG_HOOK_WRITE_CLEARS,
+                    HOSTREG_SYSTICK_CTRL, HOSTREG_SYSTICK_COUNT_MASK);
+
+    for(i = 0; i < (sizeof(gpioBase) / sizeof(gpioBase[0])); i++){
+
+        HostReg_AddHook(gpioBase[i] + HOSTREG_GPIO_ICR_OFFSET, HOSTREG_HOOK_WRITE_1_TO_CLEAR,
+                        gpioBase[i] + HOSTREG_GPIO_RIS_OFFSET, 0x000000FF);
+    }
+
+    HostReg_AddHook(HOSTREG_UART0_ICR, HOSTREG_HOOK_WRITE_1_TO_CLEAR, HOSTREG_UART0_RIS, 0x000017F2);
+
+    for(i = 0; i < (sizeof(timerBase) / sizeof(timerBase[0])); i++){
+
+        HostReg_AddHook(timerBase[i] + HOSTREG_TIMER_ICR_OFFSET, HOSTREG_HOOK_WRITE_1_TO_CLEAR,
+                        timerBase[i] + HOSTREG_TIMER_RIS_OFFSET, 0x00010F1F);
+    }
+
+    for(i = 0; i < (sizeof(adcBase) / sizeof(adcBase[0])); i++){
+
+        HostReg_AddHook(adcBase[i] + HOSTREG_ADC_ISC_OFFSET, HOSTREG_HOOK_WRITE_1_TO_CLEAR,
+                        adcBase[i] + HOSTREG_ADC_RIS_OFFSET, 0x00010F0F);
+    }
+
+    for(i = 0; i < (sizeof(pwmBase) / sizeof(pwmBase[0])); i++){
+
+        HostReg_AddHook(pwmBase[i] + HOSTREG_PWM_ISC_OFFSET, HOSTREG_HOOK_WRITE_1_TO_CLEAR,
+                        pwmBase[i] + HOSTREG_PWM_RIS_OFFSET, 0x000F000F);
+
+        for(gen = 0; gen < 4; gen++){
+            HostReg_AddHook(pwmBase[i] + HOSTREG_PWM_GEN_ISC_OFFSET + (0x40 * gen), HOSTREG_HOOK_WRITE_1_TO_CLEAR,
+                            pwmBase[i] + HOSTREG_PWM_GEN_RIS_OFFSET + (0x40 * gen), 0x0000003F);
+        }
+    }
+
+    for(i = 0; i < (sizeof(i2cBase) / sizeof(i2cBase[0])); i++){
+
+        HostReg_AddHook(i2cBase[i] + HOSTREG_I2C_MICR_OFFSET, HOSTREG_HOOK_WRITE_1_TO_CLEAR,
+                        i2cBase[i] + HOSTREG_I2C_MRIS_OFFSET, 0x00000003);
+    }
+
+    for(i = 0; i < (sizeof(qeiBase) / sizeof(qeiBase[0])); i++){
+
+        HostReg_AddHook(qeiBase[i] + HOSTREG_QEI_ISC_OFFSET, HOSTREG_HOOK_WRITE_1_TO_CLEAR,
+                        qeiBase[i] + HOSTREG_QEI_RIS_OFFSET, 0x0000000F);
+    }
+
+    HostReg_AddHook(HOSTREG_FLASH_FCMISC, HOSTREG_HOOK_WRITE_1_TO_CLEAR, HOSTREG_FLASH_FCRIS, 0x00000007);
+
+    HostReg_Poke(HOSTREG_HIB_CTL, HOSTREG_HIB_CTL_WRC);
+    HostReg_AddCallback(HOSTREG_HIB_CTL, HostReg_HibernateWriteComplete);
+
+    for(address = HOSTREG_SYSCTL_RCGC_FIRST; address <= HOSTREG_SYSCTL_RCGC_LAST; address += 4){
+        HostReg_AddCallback(address, HostReg_PeripheralReady);
+    }
+}
+
+/*********************************************************************
+* Service Name: HostReg_Access
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register address
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the simulated register
+* Description: Backend of HW_REG. Applies the pending side effect of the previous
+*              access, then returns the slot of Address.
+**********************************************************************/
+volatile uint32 *HostReg_Access(uint32 Address){
+
+    HostReg_PageType *page;
+    uint32 index;
+
+    HostReg_Sync();
+
+    g_AccessCount++;
+
+    page  = HostReg_GetPage(Address);
+    index = (Address & (HOSTREG_PAGE_SIZE - 1)) >> 2;
+
+    /* DISn reads back the enable bits of ENn, so DISn |= x disables them all as on the part */
+    if((page->hook[index] != 0) && (g_Hooks[page->hook[index] - 1].kind == HOSTREG_HOOK_CLEAR_ENABLE)){
+        page->words[index] = *HostReg_Slot(g_Hooks[page->hook[index] - 1].pairAddress);
+    }
+
+    /* Every slot is kept pending, the next access tells a write by the changed value */
+    g_PendingSlot  = &page->words[index];
+    g_PendingValue = page->words[index];
+    g_PendingHook  = page->hook[index];
+
+    return &page->words[index];
+}
+
+/*********************************************************************
+* Service Name: HostReg_Sync
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to apply the side effect of the last register access now.
+**********************************************************************/
+void HostReg_Sync(void){
+
+    volatile uint32 *slot = g_PendingSlot;
+    uint8 next = g_PendingHook;
+    uint32 value;
+
+    if(slot == NULL_PTR){
+        return;
+    }
+    g_PendingSlot = NULL_PTR;      /*hooks may access registers through HostReg_Poke*/
+
+    while(next != 0){
+
+        HostReg_HookType *hook = &g_Hooks[next - 1];
+        value = *slot;
+
+        switch(hook->kind){
+
+        case HOSTREG_HOOK_WRITE_1_TO_SET:
+            *slot = g_PendingValue | (value & hook->mask);
+            break;
+
+        case HOSTREG_HOOK_WRITE_1_TO_CLEAR:
+            if(value != 0){
+                *HostReg_Slot(hook->pairAddress) &= ~(value & hook->mask);
+            }
+            *slot = 0;
+            break;
+
+        case HOSTREG_HOOK_CLEAR_ENABLE:
+            *HostReg_Slot(hook->pairAddress) &= ~(value & hook->mask);
+            *slot = *HostReg_Slot(hook->pairAddress);
+            break;
+
+        case HOSTREG_HOOK_CLEAR_ON_READ:
+            *slot = value & ~hook->mask;
+            break;
+
+        case HOSTREG_HOOK_WRITE_CLEARS:
+            if(value != g_PendingValue){
+                *slot = 0;
+                if(hook->pairAddress != 0){
+                    *HostReg_Slot(hook->pairAddress) &= ~hook->mask;
+                }
+            }
+            break;
+
+        case HOSTREG_HOOK_CALLBACK:
+            if(value != g_PendingValue){
+                *slot = hook->callback(hook->address, g_PendingValue, value);
+            }
+            break;
+
+        case HOSTREG_HOOK_ACCESS_CALLBACK:
+            *slot = hook->callback(hook->address, g_PendingValue, value);
+            break;
+
+        default:
+            break;
+        }
+
+        next = hook->next;
+    }
+}
+
+/*********************************************************************
+* Service Name: HostReg_AddHook
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register / Kind - Side effect / PairAddress - Register
+*                  affected by the side effect, or 0 / Mask - Bits affected
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the hook table is full
+* Description: Function to install a side-effect hook on a register.
+**********************************************************************/
+boolean HostReg_AddHook(uint32 Address, HostReg_HookKindType Kind, uint32 PairAddress, uint32 Mask){
+
+    return HostReg_NewHook(Address, Kind, PairAddress, Mask, NULL_PTR);
+}
+
+/*********************************************************************
+* Service Name: HostReg_AddCallback
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register / Callback - Function called when the value changes
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the hook table is full
+* Description: Function to install a user callback on a register.
+**********************************************************************/
+boolean HostReg_AddCallback(uint32 Address, HostReg_CallbackType Callback){
+
+    if(Callback == NULL_PTR){
+        return FALSE;
+    }
+
+    return HostReg_NewHook(Address, HOSTREG_HOOK_CALLBACK, 0, 0xFFFFFFFF, Callback);
+}
+
+/*********************************************************************
+* Service Name: HostReg_AddAccessCallback
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register / Callback - Function called after every access
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the hook table is full
+* Description: Function to install a user callback on a register that is called even
+*              when the value did not change, OldValue equal to NewValue for a read.
+**********************************************************************/
+boolean HostReg_AddAccessCallback(uint32 Address, HostReg_CallbackType Callback){
+
+    if(Callback == NULL_PTR){
+        return FALSE;
+    }
+
+    return HostReg_NewHook(Address, HOSTREG_HOOK_ACCESS_CALLBACK, 0, 0xFFFFFFFF, Callback);
+}
+
+/*********************************************************************
+* Service Name: HostReg_Peek
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register address
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Register value
+* Description: Function to read a register without triggering its side effects.
+**********************************************************************/
+uint32 HostReg_Peek(uint32 Address){
+
+    HostReg_Sync();
+
+    return *HostReg_Slot(Address);
+}
+
+/*********************************************************************
+* Service Name: HostReg_Poke
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register address / Value - New value
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set a register without triggering its side effects,
+*              used by models to emulate the hardware side of a register.
+**********************************************************************/
+void HostReg_Poke(uint32 Address, uint32 Value){
+
+    HostReg_Sync();
+
+    *HostReg_Slot(Address) = Value;
+}
+
+/*********************************************************************
+* Service Name: HostReg_GetAccessCount
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Number of HW_REG accesses since HostReg_Init
+* Description: Function to read the register access counter.
+**********************************************************************/
+uint32 HostReg_GetAccessCount(void){
+
+    return g_AccessCount;
+}
+
+/*********************************************************************
+* Service Name: HostReg_GetReadCount / HostReg_GetWriteCount
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Number of register file loads / stores since HostReg_Init
+* Description: Functions to read the access counter split by direction, counted by
+*              HostReg_CountAccess in the instrumented bench build (HostBus.c), so a
+*              read-modify-write is a read and a write. 0 in the other builds.
+**********************************************************************/
+uint32 HostReg_GetReadCount(void){
+
+    return g_ReadCount;
+}
+
+uint32 HostReg_GetWriteCount(void){
+
+    return g_WriteCount;
+}
+
+/*********************************************************************
+* Service Name: HostReg_CountAccess
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Accessed memory / Write - TRUE for a store
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function called by the load and store instrumentation of HostBus.c,
+*              counts the accesses that fall into the register file.
+**********************************************************************/
+void HostReg_CountAccess(const volatile void *Address, boolean Write){
+
+    const volatile uint8 *byte = (const volatile uint8 *)Address;
+
+    if((byte < (const volatile uint8 *)&g_Pages[0]) || (byte >= (const volatile uint8 *)&g_Pages[g_PageCount])){
+        return;
+    }
+
+    if(Write){
+        g_WriteCount++;
+    }
+    else{
+        g_ReadCount++;
+    }
+}
+
+/*********************************************************************
+* Service Name: HostReg_SetPrimask / HostReg_SetFaultmask
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Masked - TRUE to mask
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Simulated CPSID/CPSIE, used by Enable_Exceptions and friends in NVIC.h.
+**********************************************************************/
+void HostReg_SetPrimask(boolean Masked){
+
+    g_Primask = Masked;
+}
+
+void HostReg_SetFaultmask(boolean Masked){
+
+    g_Faultmask = Masked;
+}
+
+boolean HostReg_GetPrimask(void){
+
+    return g_Primask;
+}
+
+boolean HostReg_GetFaultmask(void){
+
+    return g_Faultmask;
+}
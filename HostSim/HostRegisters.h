@@ -0,0 +1,241 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: HostRegisters.h
+ *
+ * Description: Header file for the simulated TM4C123GH6PM register file used when
+ *              the drivers are built natively with HOST_SIMULATION defined
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef HOST_REGISTERS_H_
+#define HOST_REGISTERS_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* The register file is allocated in 4 KB pages on first access */
+#define HOSTREG_PAGE_SIZE                    0x1000
+#define HOSTREG_PAGE_WORDS                   (HOSTREG_PAGE_SIZE / 4)
+#define HOSTREG_MAX_PAGES                    64
+#define HOSTREG_MAX_HOOKS                    128
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/*
+ * Side effects applied to a register after it was accessed. A plain C lvalue
+ * access can not tell a read from a write, so the effect is applied lazily on
+ * the next register access (or HostReg_Sync) by comparing the register slot
+ * with the value it held when it was handed out:
+ *  - W1C registers (NVIC DISn, GPIO/UART ICR) read back as zero, so any
+ *    non-zero value left in the slot is a write.
+ *  - W1S registers (NVIC ENn) read back the state, so writing it back is a no-op.
+ */
+typedef enum
+{
+    HOSTREG_HOOK_NONE,
+    HOSTREG_HOOK_WRITE_1_TO_SET,      /* slot |= previous value (NVIC ENn)            */
+    HOSTREG_HOOK_WRITE_1_TO_CLEAR,    /* pair &= ~written, reads as 0 (ICR)           */
+    HOSTREG_HOOK_CLEAR_ENABLE,        /* pair &= ~written, reads as the pair (NVIC
+                                         DISn). A read can not be told from a store
+                                         of the value read and clears those bits */
+    HOSTREG_HOOK_CLEAR_ON_READ,       /* mask bits cleared after any access (COUNT)   */
+    HOSTREG_HOOK_WRITE_CLEARS,        /* any write clears the register and pair mask  */
+    HOSTREG_HOOK_CALLBACK,            /* user function called on every change         */
+    HOSTREG_HOOK_ACCESS_CALLBACK      /* user function called on every access, for
+                                         data ports a model must answer on each read */
+}HostReg_HookKindType;
+
+/* Callback for HOSTREG_HOOK_CALLBACK, returns the value kept in the register */
+typedef uint32 (*HostReg_CallbackType)(uint32 Address, uint32 OldValue, uint32 NewValue);
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: HostReg_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear the register file and install the default hooks for
+*              NVIC EN/DIS, SysTick COUNT/CURRENT, the GPIO/UART/timer ICR registers,
+*              the ADC, PWM and QEI ISC, I2C MICR and flash FCMISC registers, the
+*              SYSCTL peripheral ready registers and the HIBCTL write complete bit.
+**********************************************************************/
+
+void HostReg_Init(void);
+
+/*********************************************************************
+* Service Name: HostReg_Access
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register address
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the simulated register
+* Description: Backend of HW_REG. Applies the pending side effect of the previous
+*              access, then returns the slot of Address.
+**********************************************************************/
+
+volatile uint32 *HostReg_Access(uint32 Address);
+
+/*********************************************************************
+* Service Name: HostReg_Sync
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to apply the side effect of the last register access now.
+**********************************************************************/
+
+void HostReg_Sync(void);
+
+/*********************************************************************
+* Service Name: HostReg_AddHook
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register / Kind - Side effect / PairAddress - Register
+*                  affected by the side effect, or 0 / Mask - Bits affected
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the hook table is full
+* Description: Function to install a side-effect hook on a register.
+**********************************************************************/
+
+boolean HostReg_AddHook(uint32 Address, HostReg_HookKindType Kind, uint32 PairAddress, uint32 Mask);
+
+/*********************************************************************
+* Service Name: HostReg_AddCallback
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register / Callback - Function called when the value changes
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the hook table is full
+* Description: Function to install a user callback on a register.
+**********************************************************************/
+
+boolean HostReg_AddCallback(uint32 Address, HostReg_CallbackType Callback);
+
+/*********************************************************************
+* Service Name: HostReg_AddAccessCallback
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register / Callback - Function called after every access
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the hook table is full
+* Description: Function to install a user callback on a register that is called even
+*              when the value did not change, OldValue equal to NewValue for a read.
+**********************************************************************/
+
+boolean HostReg_AddAccessCallback(uint32 Address, HostReg_CallbackType Callback);
+
+/*********************************************************************
+* Service Name: HostReg_Peek
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register address
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Register value
+* Description: Function to read a register without triggering its side effects.
+**********************************************************************/
+
+uint32 HostReg_Peek(uint32 Address);
+
+/*********************************************************************
+* Service Name: HostReg_Poke
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Register address / Value - New value
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set a register without triggering its side effects,
+*              used by models to emulate the hardware side of a register.
+**********************************************************************/
+
+void HostReg_Poke(uint32 Address, uint32 Value);
+
+/*********************************************************************
+* Service Name: HostReg_GetAccessCount
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Number of HW_REG accesses since HostReg_Init
+* Description: Function to read the register access counter.
+**********************************************************************/
+
+uint32 HostReg_GetAccessCount(void);
+
+/*********************************************************************
+* Service Name: HostReg_GetReadCount / HostReg_GetWriteCount
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Number of register file loads / stores since HostReg_Init
+* Description: Functions to read the access counter split by direction, counted by
+*              HostReg_CountAccess in the instrumented bench build (HostBus.c), so a
+*              read-modify-write is a read and a write. 0 in the other builds.
+**********************************************************************/
+
+uint32 HostReg_GetReadCount(void);
+uint32 HostReg_GetWriteCount(void);
+
+/*********************************************************************
+* Service Name: HostReg_CountAccess
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Address - Accessed memory / Write - TRUE for a store
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function called by the load and store instrumentation of HostBus.c,
+*              counts the accesses that fall into the register file.
+**********************************************************************/
+
+void HostReg_CountAccess(const volatile void *Address, boolean Write);
+
+/*********************************************************************
+* Service Name: HostReg_SetPrimask / HostReg_SetFaultmask
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Masked - TRUE to mask
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Simulated CPSID/CPSIE, used by Enable_Exceptions and friends in NVIC.h.
+**********************************************************************/
+
+void HostReg_SetPrimask(boolean Masked);
+void HostReg_SetFaultmask(boolean Masked);
+boolean HostReg_GetPrimask(void);
+boolean HostReg_GetFaultmask(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* HOST_REGISTERS_H_ */
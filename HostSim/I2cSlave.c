@@ -0,0 +1,336 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: I2cSlave.c
+ *
+ * Description: Host check of the I2C master state machine. Plays the I2C0 master
+ *              and two register file slaves behind the simulated register file, runs
+ *              queued jobs through I2C.c and compares the bus activity with the
+ *              expected one
+ *
+ *              i2c_slave
+ *
+ *              The activity is a list of tokens:
+ *                  Saaw Saar     start to slave aa for writing / reading
+ *                  Raar          repeated start to slave aa for reading
+ *                  xx            byte written and acknowledged
+ *                  <xx <xx.      byte read and acknowledged / not acknowledged
+ *                  !             address or written byte not acknowledged
+ *                  ~             arbitration lost
+ *                  P             stop
+ *                  name:result   call back of a job
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "HostRegisters.h"
+#include "tm4c123gh6pm_registers.h"
+#include "I2C.h"
+
+#define I2C_SLAVE_LOG_SIZE         2048
+
+/* Registers the check plays the hardware side of */
+#define I2C_SLAVE_MSA              (I2C0_BASE + 0x000)
+#define I2C_SLAVE_MCS              (I2C0_BASE + 0x004)
+#define I2C_SLAVE_MDR              (I2C0_BASE + 0x008)
+#define I2C_SLAVE_MRIS             (I2C0_BASE + 0x014)
+
+/* I2CMCS commands and status */
+#define I2C_SLAVE_RUN              0x01
+#define I2C_SLAVE_START            0x02
+#define I2C_SLAVE_STOP             0x04
+#define I2C_SLAVE_ACK              0x08
+#define I2C_SLAVE_ERROR            0x02
+#define I2C_SLAVE_ADRACK           0x04
+#define I2C_SLAVE_DATACK           0x08
+#define I2C_SLAVE_ARBLST           0x10
+#define I2C_SLAVE_IDLE             0x20
+
+/* Status values differ from every command, so each command is seen */
+#define I2C_SLAVE_WRITTEN          0x10000
+
+/* Register file slave, the first written byte of a transfer sets its pointer */
+typedef struct
+{
+    uint8 address;
+    uint8 regs[256];
+    uint8 pointer;
+    uint16 readOnlyFrom;                /* written bytes from this register are NACKed */
+    boolean addressed;
+}I2cSlave_DeviceType;
+
+static I2cSlave_DeviceType g_Sensor = { 0x48, { 0 }, 0, 0x100, FALSE };
+static I2cSlave_DeviceType g_Imu    = { 0x68, { 0 }, 0, 0x75,  FALSE };
+
+static I2cSlave_DeviceType *g_Device = NULL_PTR;
+static boolean g_Held = FALSE;            /* bus held by the master between commands */
+static boolean g_Receive = FALSE;
+static boolean g_LoseArbitration = FALSE;
+
+static char g_Log[I2C_SLAVE_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void I2cSlave_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < I2C_SLAVE_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+/* Append to the last token */
+static void I2cSlave_Mark(const char *Mark){
+
+    if((strlen(g_Log) + strlen(Mark) + 1) < I2C_SLAVE_LOG_SIZE){
+        strcat(g_Log, Mark);
+    }
+}
+
+static I2cSlave_DeviceType *I2cSlave_Find(uint8 Address){
+
+    if(Address == g_Sensor.address){
+        return &g_Sensor;
+    }
+    if(Address == g_Imu.address){
+        return &g_Imu;
+    }
+    return NULL_PTR;
+}
+
+/* The master executing a command: one address and/or data byte, then the interrupt */
+static uint32 I2cSlave_Command(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    uint32 status = 0;
+    char token[16];
+
+    (void)Address;
+    (void)OldValue;
+
+    if(NewValue & I2C_SLAVE_START){
+
+        uint32 msa = HostReg_Peek(I2C_SLAVE_MSA);
+
+        g_Receive = (msa & 0x1) ? TRUE : FALSE;
+        sprintf(token, "%c%02x%c", g_Held ? 'R' : 'S', (unsigned)(msa >> 1), g_Receive ? 'r' : 'w');
+        I2cSlave_Log(token);
+
+        if(g_LoseArbitration){
+
+            g_LoseArbitration = FALSE;
+            g_Held = FALSE;
+            I2cSlave_Mark("~");
+            HostReg_Poke(I2C_SLAVE_MRIS, 0x1);
+            return I2C_SLAVE_WRITTEN | I2C_SLAVE_ARBLST | I2C_SLAVE_ERROR;
+        }
+
+        g_Held = TRUE;
+        g_Device = I2cSlave_Find((uint8)(msa >> 1));
+        if(g_Device == NULL_PTR){
+            I2cSlave_Mark("!");
+            status = I2C_SLAVE_ERROR | I2C_SLAVE_ADRACK;
+        }
+        else{
+            g_Device->addressed = !g_Receive;
+        }
+    }
+
+    if((NewValue & I2C_SLAVE_RUN) && (status == 0)){
+
+        if(g_Receive){
+
+            uint8 data = g_Device->regs[g_Device->pointer++];
+
+            HostReg_Poke(I2C_SLAVE_MDR, data);
+            sprintf(token, "<%02x%s", (unsigned)data, (NewValue & I2C_SLAVE_ACK) ? "" : ".");
+            I2cSlave_Log(token);
+        }
+        else{
+
+            uint8 data = (uint8)HostReg_Peek(I2C_SLAVE_MDR);
+
+            sprintf(token, "%02x", (unsigned)data);
+            I2cSlave_Log(token);
+
+            if(g_Device->addressed){
+                g_Device->pointer   = data;
+                g_Device->addressed = FALSE;
+            }
+            else if(g_Device->pointer >= g_Device->readOnlyFrom){
+                I2cSlave_Mark("!");
+                status = I2C_SLAVE_ERROR | I2C_SLAVE_DATACK;
+            }
+            else{
+                g_Device->regs[g_Device->pointer++] = data;
+            }
+        }
+    }
+
+    if(NewValue & I2C_SLAVE_STOP){
+        I2cSlave_Log("P");
+        g_Held = FALSE;
+        status |= I2C_SLAVE_IDLE;
+    }
+
+    HostReg_Poke(I2C_SLAVE_MRIS, 0x1);
+
+    return I2C_SLAVE_WRITTEN | status;
+}
+
+typedef struct
+{
+    I2C_JobType job;
+    const char *name;
+}I2cSlave_NamedType;
+
+static void I2cSlave_CallBack(I2C_JobType *Job){
+
+    static const char *const results[] = { "ok", "nack", "arbitration" };
+    char token[32];
+
+    if(Job->result == I2C_OK){
+        sprintf(token, "%s:ok", ((I2cSlave_NamedType *)Job)->name);
+    }
+    else{
+        sprintf(token, "%s:%s@%u", ((I2cSlave_NamedType *)Job)->name, results[Job->result], (unsigned)Job->failed);
+    }
+    I2cSlave_Log(token);
+}
+
+static void I2cSlave_Setup(I2cSlave_NamedType *Named, const char *Name, const I2C_TransferType *Transfers,
+                           uint8 Count){
+
+    Named->name          = Name;
+    Named->job.transfers = Transfers;
+    Named->job.count     = Count;
+    Named->job.callBack  = I2cSlave_CallBack;
+    Named->job.state     = I2C_JOB_IDLE;
+}
+
+/* Interrupt loop: every command completes at once */
+static void I2cSlave_Run(void){
+
+    uint32 guard;
+
+    for(guard = 0; !I2C_IsIdle(I2C_MODULE0) && (guard < 1000); guard++){
+
+        HostReg_Sync();
+        if(HostReg_Peek(I2C_SLAVE_MRIS) & 0x1){
+            I2C_Handler(I2C_MODULE0);
+        }
+    }
+    HostReg_Sync();
+}
+
+static void I2cSlave_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+int main(void){
+
+    static const uint8 tempRegister[1]  = { 0x00 };
+    static const uint8 accelRegister[1] = { 0x3B };
+    static const uint8 wakeUp[2]        = { 0x6B, 0x00 };
+    static const uint8 whoAmI[2]        = { 0x75, 0x12 };
+    uint8 temp[2];
+    uint8 accel[6];
+    uint8 config[1];
+    uint8 spare[1];
+    uint8 i;
+
+    const I2C_TransferType sensors[2] =
+    {
+        { 0x48, tempRegister, 1, temp, 2 },
+        { 0x68, accelRegister, 1, accel, 6 }
+    };
+    const I2C_TransferType wake[1]     = { { 0x68, wakeUp, 2, NULL_PTR, 0 } };
+    const I2C_TransferType next[1]     = { { 0x48, NULL_PTR, 0, config, 1 } };
+    const I2C_TransferType missing[2]  =
+    {
+        { 0x50, tempRegister, 1, spare, 1 },
+        { 0x48, tempRegister, 1, spare, 1 }
+    };
+    const I2C_TransferType readOnly[1] = { { 0x68, whoAmI, 2, NULL_PTR, 0 } };
+    const I2C_TransferType empty[1]    = { { 0x48, NULL_PTR, 0, NULL_PTR, 0 } };
+    I2cSlave_NamedType a, b, c, d, e, f, g;
+
+    g_Sensor.regs[0x00] = 0x1A;
+    g_Sensor.regs[0x01] = 0x2B;
+    g_Sensor.regs[0x02] = 0x3C;
+    g_Imu.regs[0x6B]    = 0x40;
+    for(i = 0; i < 6; i++){
+        g_Imu.regs[0x3B + i] = (uint8)(0x01 + i);
+    }
+
+    HostReg_Init();
+    HostReg_Poke(I2C_SLAVE_MCS, I2C_SLAVE_WRITTEN | I2C_SLAVE_IDLE);
+    HostReg_AddCallback(I2C_SLAVE_MCS, I2cSlave_Command);
+
+    I2C_Init(I2C_MODULE0, 16000000, I2C_SPEED_FAST);
+    if(HostReg_Peek(I2C0_BASE + 0x00C) != 1){
+        I2cSlave_Log("bad-tpr");
+    }
+
+    /* Two sensor reads batched in one job, one call back */
+    I2cSlave_Setup(&a, "A", sensors, 2);
+    (void)I2C_Submit(I2C_MODULE0, &a.job);
+    if(I2C_Submit(I2C_MODULE0, &a.job)){
+        I2cSlave_Log("resubmitted");
+    }
+    I2cSlave_Run();
+    if((temp[0] != 0x1A) || (temp[1] != 0x2B) || (accel[0] != 0x01) || (accel[5] != 0x06)){
+        I2cSlave_Log("bad-data");
+    }
+    I2cSlave_Check("batched reads", "S48w 00 R48r <1a <2b. P S68w 3b R68r <01 <02 <03 <04 <05 <06. P A:ok");
+
+    /* A write only job, then a read only job queued behind it */
+    I2cSlave_Setup(&b, "B", wake, 1);
+    I2cSlave_Setup(&c, "C", next, 1);
+    (void)I2C_Submit(I2C_MODULE0, &b.job);
+    (void)I2C_Submit(I2C_MODULE0, &c.job);
+    I2cSlave_Run();
+    if((g_Imu.regs[0x6B] != 0x00) || (config[0] != 0x3C)){
+        I2cSlave_Log("bad-data");
+    }
+    I2cSlave_Check("write, read only", "S68w 6b 00 P B:ok S48r <3c. P C:ok");
+
+    /* Missing slave ends its job with a stop, the next job runs */
+    I2cSlave_Setup(&d, "D", missing, 2);
+    I2cSlave_Setup(&e, "E", readOnly, 1);
+    (void)I2C_Submit(I2C_MODULE0, &d.job);
+    (void)I2C_Submit(I2C_MODULE0, &e.job);
+    I2cSlave_Run();
+    I2cSlave_Check("nack", "S50w! P D:nack@0 S68w 75 12! P E:nack@0");
+
+    /* Arbitration lost, no stop from this master */
+    I2cSlave_Setup(&f, "F", sensors, 2);
+    I2cSlave_Setup(&g, "G", wake, 1);
+    g_LoseArbitration = TRUE;
+    (void)I2C_Submit(I2C_MODULE0, &f.job);
+    (void)I2C_Submit(I2C_MODULE0, &g.job);
+    I2cSlave_Run();
+    I2cSlave_Check("arbitration lost", "S48w~ F:arbitration@0 S68w 6b 00 P G:ok");
+
+    /* Jobs the bus cannot run */
+    I2cSlave_Setup(&a, "A", sensors, 0);
+    I2cSlave_Setup(&b, "B", empty, 1);
+    if(I2C_Submit(I2C_MODULE0, &a.job) || I2C_Submit(I2C_MODULE0, &b.job) || !I2C_IsIdle(I2C_MODULE0)){
+        I2cSlave_Log("accepted");
+    }
+    I2cSlave_Check("empty rejected", "");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
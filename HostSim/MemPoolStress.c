@@ -0,0 +1,329 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: MemPoolStress.c
+ *
+ * Description: Host stress test of the lock-free memory pool with POSIX threads
+ *              standing in for the interrupt handlers. Every thread allocates and
+ *              frees blocks of random sizes and holds a few at a time, a block handed
+ *              out twice or lost shows in the owner table, in the stamp written into
+ *              the block and in the free lists drained at the end. Built with
+ *              MEMPOOL_STRESS_REJECT set the file holds a size class MEMPOOL_DEFINE
+ *              must refuse to build, make mempool checks it does
+ *
+ *              mempool_stress [operations_per_thread]
+ *
+ *              The activity is a list of tokens:
+ *                  twice         a block was handed out while another thread held it
+ *                  stamp         a held block was written by someone else
+ *                  lost          a drained pool gave fewer blocks than it owns
+ *                  used=n        blocks still counted as used after the run
+ *                  count         allocCount differs from the allocations seen
+ *                  high          a high-water mark below the blocks seen held at once
+ *                                or above the pool size
+ *                  hw=n          high-water mark of the single thread scenario
+ *                  rejected      MemPool_Init refused the pools
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "std_types.h"
+
+/* Thread switch at the preemption points of Queue.h, one in MEMPOOL_STRESS_PREEMPT_RATE */
+static void MemPoolStress_Preempt(void);
+#define QUEUE_PREEMPTION_POINT()             MemPoolStress_Preempt()
+
+/* The pool is compiled into this file, so its compare and swap switches threads too */
+#include "MemPool.c"
+
+#define MEMPOOL_STRESS_LOG_SIZE      1024
+#define MEMPOOL_STRESS_THREADS       4
+#define MEMPOOL_STRESS_OPERATIONS    200000
+#define MEMPOOL_STRESS_HELD          6
+#define MEMPOOL_STRESS_PREEMPT_RATE  8
+
+#define MEMPOOL_STRESS_SMALL_BLOCKS  16
+#define MEMPOOL_STRESS_LARGE_BLOCKS  8
+
+MEMPOOL_DEFINE(g_Small, 12, MEMPOOL_STRESS_SMALL_BLOCKS);
+MEMPOOL_DEFINE(g_Large, 60, MEMPOOL_STRESS_LARGE_BLOCKS);
+
+/* Largest size class the 16 bit blockSize holds */
+MEMPOOL_DEFINE(g_Widest, MEMPOOL_MAX_BLOCK_SIZE, 1);
+
+#ifdef MEMPOOL_STRESS_REJECT
+MEMPOOL_DEFINE(g_Rejected, MEMPOOL_MAX_BLOCK_SIZE + 1, 1);
+#endif
+
+static MemPool_PoolType *const g_Pools[2] = { &g_Small, &g_Large };
+
+/* Thread holding each block + 1, 0 when free */
+static uint32 g_Owner[2][MEMPOOL_STRESS_SMALL_BLOCKS];
+
+/* Blocks held at once as seen by the threads, and the most of it */
+static uint32 g_Held[2];
+static uint32 g_MostHeld[2];
+
+static uint32 g_Operations = MEMPOOL_STRESS_OPERATIONS;
+static uint32 g_Allocated[MEMPOOL_STRESS_THREADS];
+static uint32 g_Twice = 0;
+static uint32 g_Stamp = 0;
+
+static char g_Log[MEMPOOL_STRESS_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static uint32 MemPoolStress_Random(void){
+
+    static __thread uint32 seed = 0;
+
+    /* xorshift, a sequence of its own per thread */
+    if(seed == 0){
+        seed = (uint32)(unsigned long)&seed | 1;
+    }
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    return seed;
+}
+
+static void MemPoolStress_Preempt(void){
+
+    if((MemPoolStress_Random() % MEMPOOL_STRESS_PREEMPT_RATE) == 0){
+        sched_yield();
+    }
+}
+
+static void MemPoolStress_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < MEMPOOL_STRESS_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+static void MemPoolStress_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+/* Pool and block index of a block handed out by MemPool_Alloc */
+static uint8 MemPoolStress_Locate(const void *Block, uint32 *Index){
+
+    uint8 pool = ((const uint8 *)Block >= g_Large.memory) &&
+                 ((const uint8 *)Block < g_Large.memory + (MEMPOOL_STRESS_LARGE_BLOCKS * g_Large.blockSize)) ? 1 : 0;
+
+    *Index = (uint32)((const uint8 *)Block - g_Pools[pool]->memory) / g_Pools[pool]->blockSize;
+
+    return pool;
+}
+
+static void MemPoolStress_Take(void *Block, uint32 Thread){
+
+    uint32 index;
+    uint8 pool = MemPoolStress_Locate(Block, &index);
+    uint32 held;
+    uint32 most;
+
+    if(__atomic_exchange_n(&g_Owner[pool][index], Thread + 1, __ATOMIC_SEQ_CST) != 0){
+        __atomic_fetch_add(&g_Twice, 1, __ATOMIC_SEQ_CST);
+    }
+    memset(Block, (int)(Thread + 1), g_Pools[pool]->blockSize);
+
+    held = __atomic_add_fetch(&g_Held[pool], 1, __ATOMIC_SEQ_CST);
+    most = __atomic_load_n(&g_MostHeld[pool], __ATOMIC_SEQ_CST);
+    while((held > most) && !__atomic_compare_exchange_n(&g_MostHeld[pool], &most, held, FALSE,
+                                                         __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)){}
+}
+
+static void MemPoolStress_Give(void *Block, uint32 Thread){
+
+    uint32 index;
+    uint8 pool = MemPoolStress_Locate(Block, &index);
+    uint32 i;
+
+    for(i = 0; i < g_Pools[pool]->blockSize; i++){
+        if(((uint8 *)Block)[i] != (uint8)(Thread + 1)){
+            __atomic_fetch_add(&g_Stamp, 1, __ATOMIC_SEQ_CST);
+            break;
+        }
+    }
+
+    __atomic_sub_fetch(&g_Held[pool], 1, __ATOMIC_SEQ_CST);
+    if(__atomic_exchange_n(&g_Owner[pool][index], 0, __ATOMIC_SEQ_CST) != (Thread + 1)){
+        __atomic_fetch_add(&g_Twice, 1, __ATOMIC_SEQ_CST);
+    }
+    (void)MemPool_Free(Block);
+}
+
+/* Random sizes over both classes, up to MEMPOOL_STRESS_HELD blocks held, freed in random order */
+static void *MemPoolStress_Thread(void *Arg){
+
+    uint32 thread = (uint32)(unsigned long)Arg;
+    void *held[MEMPOOL_STRESS_HELD];
+    uint32 count = 0;
+    uint32 operation;
+
+    for(operation = 0; operation < g_Operations; operation++){
+
+        uint32 random = MemPoolStress_Random();
+
+        if((count < MEMPOOL_STRESS_HELD) && ((count == 0) || (random & 1))){
+
+            void *block = MemPool_Alloc(1 + ((random >> 1) % 60));
+
+            if(block != NULL_PTR){
+                MemPoolStress_Take(block, thread);
+                held[count++] = block;
+                g_Allocated[thread]++;
+            }
+        }
+        else{
+
+            uint32 pick = (random >> 1) % count;
+
+            MemPoolStress_Give(held[pick], thread);
+            held[pick] = held[--count];
+        }
+    }
+
+    while(count > 0){
+        MemPoolStress_Give(held[--count], thread);
+    }
+
+    return NULL_PTR;
+}
+
+/* Every block comes out of the free list once, then goes back */
+static void MemPoolStress_Drain(MemPool_PoolType *Pool){
+
+    void *blocks[MEMPOOL_STRESS_SMALL_BLOCKS];
+    uint32 count = 0;
+    uint32 i;
+    uint32 j;
+
+    while((count < MEMPOOL_STRESS_SMALL_BLOCKS) && ((blocks[count] = MemPool_AllocFrom(Pool)) != NULL_PTR)){
+        count++;
+    }
+    for(i = 0; i < count; i++){
+        for(j = i + 1; j < count; j++){
+            if(blocks[i] == blocks[j]){
+                MemPoolStress_Log("twice");
+            }
+        }
+    }
+    if(count != Pool->blockCount){
+        MemPoolStress_Log("lost");
+    }
+    for(i = 0; i < count; i++){
+        MemPool_FreeTo(Pool, blocks[i]);
+    }
+}
+
+static void MemPoolStress_Threads(void){
+
+    pthread_t threads[MEMPOOL_STRESS_THREADS];
+    MemPool_StatsType stats;
+    uint32 allocated = 0;
+    char token[24];
+    uint8 pool;
+    uint8 i;
+
+    for(i = 0; i < MEMPOOL_STRESS_THREADS; i++){
+        pthread_create(&threads[i], NULL_PTR, MemPoolStress_Thread, (void *)(unsigned long)i);
+    }
+    for(i = 0; i < MEMPOOL_STRESS_THREADS; i++){
+        pthread_join(threads[i], NULL_PTR);
+        allocated += g_Allocated[i];
+    }
+
+    if(g_Twice != 0){
+        MemPoolStress_Log("twice");
+    }
+    if(g_Stamp != 0){
+        MemPoolStress_Log("stamp");
+    }
+    for(pool = 0; pool < 2; pool++){
+
+        MemPool_GetStats(g_Pools[pool], &stats);
+        if(stats.used != 0){
+            snprintf(token, sizeof(token), "used=%u", (unsigned)stats.used);
+            MemPoolStress_Log(token);
+        }
+        if((stats.highWater < g_MostHeld[pool]) || (stats.highWater > stats.blockCount)){
+            MemPoolStress_Log("high");
+        }
+        allocated -= stats.allocCount;
+        MemPoolStress_Drain(g_Pools[pool]);
+    }
+    if(allocated != 0){
+        MemPoolStress_Log("count");
+    }
+}
+
+int main(int argc, char *argv[]){
+
+    MemPool_PoolType *const widest[1] = { &g_Widest };
+    MemPool_StatsType stats;
+    void *blocks[5];
+    char token[24];
+    uint32 i;
+
+    if(argc > 1){
+        g_Operations = (uint32)atoi(argv[1]);
+    }
+    if(g_Operations == 0){
+        fprintf(stderr, "usage: mempool_stress [operations_per_thread]\n");
+        return 2;
+    }
+
+    /* Threads fight over pools far smaller than their demand, both classes in use */
+    if(!MemPool_Init(g_Pools, 2)){
+        MemPoolStress_Log("rejected");
+    }
+    MemPoolStress_Threads();
+    MemPoolStress_Check("threads", "");
+
+    /* Single thread: five held at once, then back to one, the mark stays at five */
+    (void)MemPool_Init(g_Pools, 2);
+    for(i = 0; i < 5; i++){
+        blocks[i] = MemPool_AllocFrom(&g_Small);
+    }
+    for(i = 1; i < 5; i++){
+        MemPool_FreeTo(&g_Small, blocks[i]);
+    }
+    blocks[1] = MemPool_AllocFrom(&g_Small);
+    MemPool_GetStats(&g_Small, &stats);
+    snprintf(token, sizeof(token), "hw=%u used=%u", (unsigned)stats.highWater, (unsigned)stats.used);
+    MemPoolStress_Log(token);
+    MemPoolStress_Check("high-water", "hw=5 used=2");
+
+    /* The largest class keeps its size, a hand-built unaligned one is refused */
+    if(!MemPool_Init(widest, 1) || (MemPool_Alloc(MEMPOOL_MAX_BLOCK_SIZE) == NULL_PTR)){
+        MemPoolStress_Log("widest");
+    }
+    g_Small.blockSize = 12;
+    if(!MemPool_Init(g_Pools, 2)){
+        MemPoolStress_Log("rejected");
+    }
+    g_Small.blockSize = MEMPOOL_ROUND_SIZE(12);
+    MemPoolStress_Check("block sizes", "rejected");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
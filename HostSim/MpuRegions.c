@@ -0,0 +1,279 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: MpuRegions.c
+ *
+ * Description: Host check of the MPU region encoding. Runs every power of two size
+ *              from 32 bytes to 2 GB against every base alignment through
+ *              MPU_EncodeRegion and MPU_REGION, then plays the eight region slots
+ *              behind MPU_NUMBER / MPU_BASE / MPU_ATTR and their aliases to check the
+ *              loads of MPU.c. Built with MPU_REGIONS_REJECT set to 1, 2 or 3 the file
+ *              holds a region MPU_REGION must refuse to build, make mpu checks it does
+ *
+ *              mpu_regions
+ *
+ *              The activity is a list of tokens:
+ *                  n:s/b         region n holds size field s, base b (hex)
+ *                  n:off         region n disabled
+ *                  on/off        MPU_CTRL enable bit
+ *                  bad@s+b       size s (hex) at base b (hex) encoded wrongly
+ *                  refused       MPU_Init turned a region table down
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "HostRegisters.h"
+#include "tm4c123gh6pm_registers.h"
+#include "MPU.h"
+
+#define MPU_REGIONS_LOG_SIZE       1024
+
+/* Registers the check plays the hardware side of */
+#define MPU_REGIONS_CTRL           0xE000ED94
+#define MPU_REGIONS_NUMBER         0xE000ED98
+#define MPU_REGIONS_BASE           0xE000ED9C
+#define MPU_REGIONS_ATTR           0xE000EDA0
+#define MPU_REGIONS_ALIASES        4
+
+#define MPU_REGIONS_SIZE_MASK      0x0000003E
+
+/* One static region of each size at base 0, the compiler encodes them */
+#define MPU_REGIONS_SIZE(Bit)      MPU_REGION(0, 0, 1u << (Bit), MPU_TEMPLATE_SRAM_DATA)
+
+#if defined(MPU_REGIONS_REJECT) && (MPU_REGIONS_REJECT == 1)
+static const MPU_RegionType g_Rejected = MPU_REGION(0, 0x20000100, 0x400, MPU_TEMPLATE_SRAM_DATA);
+#elif defined(MPU_REGIONS_REJECT) && (MPU_REGIONS_REJECT == 2)
+static const MPU_RegionType g_Rejected = MPU_REGION(0, 0x20000000, 0x300, MPU_TEMPLATE_SRAM_DATA);
+#elif defined(MPU_REGIONS_REJECT) && (MPU_REGIONS_REJECT == 3)
+static const MPU_RegionType g_Rejected = MPU_REGION(0, 0x20000000, 16, MPU_TEMPLATE_SRAM_DATA);
+#endif
+
+static const MPU_RegionType g_Sizes[] = {
+    MPU_REGIONS_SIZE(5),  MPU_REGIONS_SIZE(6),  MPU_REGIONS_SIZE(7),  MPU_REGIONS_SIZE(8),
+    MPU_REGIONS_SIZE(9),  MPU_REGIONS_SIZE(10), MPU_REGIONS_SIZE(11), MPU_REGIONS_SIZE(12),
+    MPU_REGIONS_SIZE(13), MPU_REGIONS_SIZE(14), MPU_REGIONS_SIZE(15), MPU_REGIONS_SIZE(16),
+    MPU_REGIONS_SIZE(17), MPU_REGIONS_SIZE(18), MPU_REGIONS_SIZE(19), MPU_REGIONS_SIZE(20),
+    MPU_REGIONS_SIZE(21), MPU_REGIONS_SIZE(22), MPU_REGIONS_SIZE(23), MPU_REGIONS_SIZE(24),
+    MPU_REGIONS_SIZE(25), MPU_REGIONS_SIZE(26), MPU_REGIONS_SIZE(27), MPU_REGIONS_SIZE(28),
+    MPU_REGIONS_SIZE(29), MPU_REGIONS_SIZE(30), MPU_REGIONS_SIZE(31)
+};
+
+static MPU_RegionType g_Slots[MPU_NUMBER_OF_REGIONS];
+
+static char g_Log[MPU_REGIONS_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void MpuRegions_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < MPU_REGIONS_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+/* BASE and ATTR read back the slot MPU_NUMBER selects */
+static void MpuRegions_Select(uint32 Region){
+
+    HostReg_Poke(MPU_REGIONS_NUMBER, Region);
+    HostReg_Poke(MPU_REGIONS_BASE, g_Slots[Region].base | Region);
+    HostReg_Poke(MPU_REGIONS_ATTR, g_Slots[Region].attr);
+}
+
+static uint32 MpuRegions_Number(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    (void)Address;
+    (void)OldValue;
+
+    MpuRegions_Select(NewValue & MPU_BASE_REGION_MASK);
+
+    return NewValue & MPU_BASE_REGION_MASK;
+}
+
+/* MPU_BASE and its aliases: VALID selects the region written by the following ATTR */
+static uint32 MpuRegions_Base(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    uint32 region = HostReg_Peek(MPU_REGIONS_NUMBER);
+
+    (void)Address;
+    (void)OldValue;
+
+    if(NewValue & MPU_BASE_VALID){
+        region = NewValue & MPU_BASE_REGION_MASK;
+    }
+    g_Slots[region].base = NewValue & MPU_BASE_ADDR_MASK;
+    MpuRegions_Select(region);
+
+    return g_Slots[region].base | region;
+}
+
+static uint32 MpuRegions_Attr(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    uint32 region = HostReg_Peek(MPU_REGIONS_NUMBER);
+
+    (void)Address;
+    (void)OldValue;
+
+    g_Slots[region].attr = NewValue;
+    MpuRegions_Select(region);
+
+    return NewValue;
+}
+
+static void MpuRegions_Reset(void){
+
+    uint8 i;
+
+    HostReg_Init();
+    memset(g_Slots, 0, sizeof(g_Slots));
+    HostReg_AddAccessCallback(MPU_REGIONS_NUMBER, MpuRegions_Number);
+    for(i = 0; i < MPU_REGIONS_ALIASES; i++){
+        HostReg_AddAccessCallback(MPU_REGIONS_BASE + (8 * i), MpuRegions_Base);
+        HostReg_AddAccessCallback(MPU_REGIONS_ATTR + (8 * i), MpuRegions_Attr);
+    }
+}
+
+/* Every slot as the MPU holds it */
+static void MpuRegions_Dump(void){
+
+    char token[32];
+    uint8 i;
+
+    HostReg_Sync();
+
+    for(i = 0; i < MPU_NUMBER_OF_REGIONS; i++){
+        if(g_Slots[i].attr & MPU_ATTR_ENABLE){
+            sprintf(token, "%u:%u/%x", (unsigned)i,
+                    (unsigned)((g_Slots[i].attr & MPU_REGIONS_SIZE_MASK) >> MPU_ATTR_SIZE_BITS_POS),
+                    (unsigned)g_Slots[i].base);
+        }
+        else{
+            sprintf(token, "%u:off", (unsigned)i);
+        }
+        MpuRegions_Log(token);
+    }
+    MpuRegions_Log((HostReg_Peek(MPU_REGIONS_CTRL) & MPU_CTRL_ENABLE) ? "on" : "off");
+}
+
+static void MpuRegions_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+/* One size against the base 0 and every single-bit base */
+static void MpuRegions_Encode(uint32 Size){
+
+    MPU_RegionType encoded;
+    uint32 field;
+    uint32 base;
+    boolean valid;
+    boolean accepted;
+    char token[32];
+    sint32 bit;
+
+    for(field = 0; (1u << (field + 1)) != Size; field++){}
+
+    for(bit = -1; bit < 32; bit++){
+
+        base = (bit < 0) ? 0 : (1u << bit);
+        valid = ((base % Size) == 0) ? TRUE : FALSE;
+        accepted = MPU_EncodeRegion(3, base, Size, MPU_TEMPLATE_SRAM_DATA, &encoded);
+
+        if((accepted != valid) ||
+           (accepted && ((encoded.base != (base | MPU_BASE_VALID | 3)) ||
+                         (encoded.attr != (MPU_TEMPLATE_SRAM_DATA | (field << MPU_ATTR_SIZE_BITS_POS) | MPU_ATTR_ENABLE))))){
+            sprintf(token, "bad@%x+%x", (unsigned)Size, (unsigned)base);
+            MpuRegions_Log(token);
+        }
+    }
+}
+
+int main(void){
+
+    static const uint32 oddSizes[] = { 0, 1, 16, 31, 33, 48, 96, 0x300, 0x1000 - 32, 0x80000001, 0xFFFFFFFF };
+    static const MPU_RegionType boot[3] = {
+        MPU_REGION(0, 0x00000000, 0x00040000, MPU_TEMPLATE_FLASH_CODE),
+        MPU_REGION(1, 0x20000000, 0x00008000, MPU_TEMPLATE_SRAM_DATA),
+        MPU_REGION(2, 0x40000000, 0x20000000, MPU_TEMPLATE_PERIPHERAL)
+    };
+    static const MPU_RegionType task[4] = {
+        MPU_REGION(4, 0x20001000, 0x00000400, MPU_TEMPLATE_SRAM_DATA),
+        MPU_REGION(5, 0x20001400, 0x00000020, MPU_TEMPLATE_STACK_GUARD),
+        MPU_REGION_DISABLED(6),
+        MPU_REGION(7, 0x40004000, 0x00001000, MPU_TEMPLATE_PERIPHERAL_PRIV)
+    };
+    MPU_RegionType encoded;
+    char token[32];
+    uint8 i;
+
+    /* Every power of two, aligned and misaligned bases */
+    for(i = 5; i < 32; i++){
+        MpuRegions_Encode(1u << i);
+    }
+    MpuRegions_Check("power of two sizes", "");
+
+    for(i = 0; i < (sizeof(oddSizes) / sizeof(oddSizes[0])); i++){
+        if(MPU_EncodeRegion(0, 0, oddSizes[i], MPU_TEMPLATE_SRAM_DATA, &encoded)){
+            sprintf(token, "bad@%x+0", (unsigned)oddSizes[i]);
+            MpuRegions_Log(token);
+        }
+    }
+    MpuRegions_Check("other sizes", "");
+
+    /* The compile-time encoding equals the run-time one */
+    for(i = 0; i < (sizeof(g_Sizes) / sizeof(g_Sizes[0])); i++){
+        if(!MPU_EncodeRegion(0, 0, 1u << (i + 5), MPU_TEMPLATE_SRAM_DATA, &encoded) ||
+           (encoded.base != g_Sizes[i].base) || (encoded.attr != g_Sizes[i].attr)){
+            sprintf(token, "bad@%x+0", (unsigned)(1u << (i + 5)));
+            MpuRegions_Log(token);
+        }
+    }
+    MpuRegions_Check("static regions", "");
+
+    /* Init clears a region left enabled, loads the table and turns the MPU on */
+    MpuRegions_Reset();
+    g_Slots[6].attr = MPU_ATTR_VALUE(32, MPU_TEMPLATE_SRAM_DATA);
+    if(!MPU_Init(boot, 3, MPU_CTRL_PRIVDEFENA)){
+        MpuRegions_Log("refused");
+    }
+    MpuRegions_Dump();
+    MpuRegions_Check("init", "0:17/0 1:14/20000000 2:28/40000000 3:off 4:off 5:off 6:off 7:off on");
+
+    /* A table longer than the eight regions is refused, the loaded map stays */
+    if(!MPU_Init(boot, MPU_NUMBER_OF_REGIONS + 1, MPU_CTRL_PRIVDEFENA)){
+        MpuRegions_Log("refused");
+    }
+    MpuRegions_Dump();
+    MpuRegions_Check("too many regions", "refused 0:17/0 1:14/20000000 2:28/40000000 3:off 4:off 5:off 6:off 7:off on");
+
+    /* Four regions in one burst through the aliases */
+    MPU_LoadRegions4(task);
+    MpuRegions_Dump();
+    MpuRegions_Check("burst", "0:17/0 1:14/20000000 2:28/40000000 3:off 4:9/20001000 5:4/20001400 6:off 7:11/40004000 on");
+
+    /* One region off, the others and its attributes kept */
+    MPU_DisableRegion(4);
+    MpuRegions_Dump();
+    if(g_Slots[4].attr != (task[0].attr & ~MPU_ATTR_ENABLE)){
+        MpuRegions_Log("bad-attr");
+    }
+    MPU_Disable();
+    MpuRegions_Dump();
+    MpuRegions_Check("disable",
+                     "0:17/0 1:14/20000000 2:28/40000000 3:off 4:off 5:4/20001400 6:off 7:11/40004000 on "
+                     "0:17/0 1:14/20000000 2:28/40000000 3:off 4:off 5:4/20001400 6:off 7:11/40004000 off");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
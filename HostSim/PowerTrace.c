@@ -0,0 +1,197 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: PowerTrace.c
+ *
+ * Description: Host tool replaying an interrupt event trace against the idle loop of
+ *              the power manager and printing the residency of every power state
+ *
+ *              power_trace <trace.csv> [tick_ms] [deep_sleep_wake_cycles]
+ *
+ *              One event per line, '#' starts a comment:
+ *                  cycle,irq,body_cycles[,timed]
+ *              timed = 1 marks a timer event the power manager knows in advance
+ *              (deadline callback), the others come from pins and wake it unannounced.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "HostModel.h"
+#include "NVIC.h"
+#include "SysTick.h"
+#include "Power.h"
+
+#define POWER_TRACE_MAX_EVENTS     4096
+
+/* Tick handler body, cycles */
+#define POWER_TRACE_TICK_CYCLES    60
+
+typedef struct
+{
+    uint64 cycle;
+    uint8 irq;
+    uint32 body;
+    boolean timed;
+}PowerTrace_EventType;
+
+static PowerTrace_EventType g_TraceEvents[POWER_TRACE_MAX_EVENTS];
+static uint32 g_TraceCount = 0;
+static uint32 g_TraceScheduled = 0;
+
+static int PowerTrace_Compare(const void *A, const void *B){
+
+    const PowerTrace_EventType *a = (const PowerTrace_EventType *)A;
+    const PowerTrace_EventType *b = (const PowerTrace_EventType *)B;
+
+    return (a->cycle > b->cycle) - (a->cycle < b->cycle);
+}
+
+static boolean PowerTrace_Load(const char *Path){
+
+    FILE *file = fopen(Path, "r");
+    char line[128];
+
+    if(file == NULL_PTR){
+        return FALSE;
+    }
+
+    while(fgets(line, sizeof(line), file) != NULL_PTR){
+
+        unsigned long long cycle;
+        unsigned irq, body, timed = 0;
+
+        if((line[0] == '#') || (sscanf(line, "%llu,%u,%u,%u", &cycle, &irq, &body, &timed) < 3)){
+            continue;
+        }
+        if((g_TraceCount == POWER_TRACE_MAX_EVENTS) || (irq >= (HOSTMODEL_VECTORS - 16))){
+            fprintf(stderr, "power_trace: event at cycle %llu skipped\n", cycle);
+            continue;
+        }
+
+        g_TraceEvents[g_TraceCount].cycle = cycle;
+        g_TraceEvents[g_TraceCount].irq   = (uint8)irq;
+        g_TraceEvents[g_TraceCount].body  = body;
+        g_TraceEvents[g_TraceCount].timed = (timed != 0) ? TRUE : FALSE;
+        g_TraceCount++;
+    }
+
+    fclose(file);
+    qsort(g_TraceEvents, g_TraceCount, sizeof(g_TraceEvents[0]), PowerTrace_Compare);
+
+    return TRUE;
+}
+
+/* The model holds HOSTMODEL_MAX_EVENTS events, hand them over in time order */
+static void PowerTrace_Schedule(void){
+
+    while(g_TraceScheduled < g_TraceCount){
+
+        const PowerTrace_EventType *event = &g_TraceEvents[g_TraceScheduled];
+        uint8 vector = HOSTMODEL_VECTOR_IRQ(event->irq);
+
+        if(!HostModel_ScheduleVector(vector, event->cycle, 0)){
+            break;
+        }
+
+        /* Every event of a line runs the body of its last trace entry */
+        HostModel_SetHandler(vector, NULL_PTR, event->body);
+        NVIC_EnableIRQ((NVIC_IRQType)event->irq);
+        g_TraceScheduled++;
+    }
+}
+
+/* Deadline callback: next timed event not reached yet */
+static uint32 PowerTrace_Deadline(void){
+
+    uint64 now = HostModel_GetCycles();
+    uint32 i;
+
+    for(i = 0; i < g_TraceCount; i++){
+
+        if(g_TraceEvents[i].timed && (g_TraceEvents[i].cycle > now)){
+
+            uint64 delta = g_TraceEvents[i].cycle - now;
+            return (delta < POWER_NO_DEADLINE) ? (uint32)delta : POWER_NO_DEADLINE;
+        }
+    }
+
+    return POWER_NO_DEADLINE;
+}
+
+int main(int argc, char *argv[]){
+
+    static const char *names[POWER_NUMBER_OF_STATES] = {"run", "sleep", "deep_sleep"};
+    Power_ConfigType config = {
+        POWER_DSLPCLKCFG_PIOSC,
+        POWER_SLEEP_WAKE_CYCLES,
+        POWER_DEEP_SLEEP_WAKE_CYCLES,
+        POWER_DEEP_SLEEP_MIN_CYCLES,
+        FALSE,
+        PowerTrace_Deadline
+    };
+    uint16 tickMs = 10;
+    uint64 end;
+    uint64 total;
+    uint64 handlers;
+    uint8 state;
+
+    if((argc < 2) || !PowerTrace_Load(argv[1])){
+        fprintf(stderr, "usage: power_trace <trace.csv> [tick_ms] [deep_sleep_wake_cycles]\n");
+        return 2;
+    }
+    if(argc > 2){
+        tickMs = (uint16)atoi(argv[2]);
+    }
+    if(argc > 3){
+        config.deepSleepWakeCycles = (uint32)atoi(argv[3]);
+    }
+
+    HostModel_Init();
+    HostModel_SetHandler(HOSTMODEL_VECTOR_SYSTICK, NULL_PTR, POWER_TRACE_TICK_CYCLES);
+    if(tickMs != 0){
+        SysTick_Init(tickMs);
+    }
+    Power_Init(&config);
+
+    end = (g_TraceCount > 0) ? (g_TraceEvents[g_TraceCount - 1].cycle + 1) : 0;
+
+    /* Idle loop until the last event was handled, the wait returns 0 once nothing is left */
+    while(HostModel_GetCycles() < end){
+
+        uint64 before = HostModel_GetCycles();
+
+        PowerTrace_Schedule();
+        Power_Idle();
+
+        if(HostModel_GetCycles() == before){
+            break;
+        }
+    }
+
+    /* Thread time holds the run state waits, the rest is sleep, wake-up and handlers */
+    total = HostModel_GetCycles();
+    handlers = total - HostModel_GetThreadCycles()
+             - Power_GetStats(POWER_STATE_SLEEP)->cycles - Power_GetStats(POWER_STATE_DEEP_SLEEP)->cycles
+             - (uint64)Power_GetStats(POWER_STATE_SLEEP)->entries * config.sleepWakeCycles
+             - (uint64)Power_GetStats(POWER_STATE_DEEP_SLEEP)->entries * config.deepSleepWakeCycles;
+
+    printf("{\n  \"cycles\": %llu,\n  \"events\": %lu,\n  \"handlers\": %llu,\n  \"states\": {\n",
+           (unsigned long long)total, (unsigned long)g_TraceCount, (unsigned long long)handlers);
+
+    for(state = 0; state < POWER_NUMBER_OF_STATES; state++){
+
+        const Power_StatsType *stats = Power_GetStats((Power_StateType)state);
+
+        printf("    \"%s\": {\"entries\": %lu, \"cycles\": %llu, \"residency\": %.4f}%s\n",
+               names[state], (unsigned long)stats->entries, (unsigned long long)stats->cycles,
+               (total != 0) ? ((double)stats->cycles / (double)total) : 0.0,
+               (state + 1 < POWER_NUMBER_OF_STATES) ? "," : "");
+    }
+
+    printf("  }\n}\n");
+
+    return 0;
+}
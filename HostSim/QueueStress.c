@@ -0,0 +1,343 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: QueueStress.c
+ *
+ * Description: Host stress test of the lock-free queues with POSIX threads standing
+ *              in for the interrupt handlers. Producers and the consumer run truly
+ *              in parallel, which is harder on the queues than the preemption of a
+ *              single core. Every item carries its producer and sequence number, the
+ *              consumer checks that none is lost or seen twice and that the items of
+ *              each producer arrive in the order they were enqueued
+ *
+ *              queue_stress [items_per_producer]
+ *
+ *              The activity is a list of tokens:
+ *                  pn            every item of producer n received once, in order
+ *                  order         an item arrived out of order, twice or from nowhere
+ *                  full          the queue took an item past its size
+ *                  empty         the queue gave an item it did not hold
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "std_types.h"
+
+/* Thread switch at the preemption points of Queue.h, one in QUEUE_STRESS_PREEMPT_RATE */
+static void QueueStress_Preempt(void);
+#define QUEUE_PREEMPTION_POINT()             QueueStress_Preempt()
+
+#include "Queue.h"
+
+#define QUEUE_STRESS_LOG_SIZE      1024
+#define QUEUE_STRESS_PRODUCERS     4
+#define QUEUE_STRESS_ITEMS         200000
+#define QUEUE_STRESS_BATCH         5
+#define QUEUE_STRESS_PREEMPT_RATE  8
+
+/* Free running counters just below the 32-bit wrap */
+#define QUEUE_STRESS_NEAR_WRAP     0xFFFFFF00
+
+/* Item: producer in the top byte, sequence number below */
+#define QUEUE_STRESS_ITEM(Producer, Sequence)  (((uint32)(Producer) << 24) | (Sequence))
+#define QUEUE_STRESS_PRODUCER(Item)            ((Item) >> 24)
+#define QUEUE_STRESS_SEQUENCE(Item)            ((Item) & 0x00FFFFFF)
+
+QUEUE_MPSC_DEFINE(QueueStress_Mpsc, uint32, 16)
+QUEUE_SPSC_DEFINE(QueueStress_Spsc, uint32, 8)
+
+static QueueStress_Mpsc_Type g_Mpsc;
+static QueueStress_Spsc_Type g_Spsc;
+
+static uint32 g_Items = QUEUE_STRESS_ITEMS;
+static uint8 g_Producers = QUEUE_STRESS_PRODUCERS;
+static uint32 g_Next[QUEUE_STRESS_PRODUCERS];
+static uint32 g_Disorder = 0;
+
+static char g_Log[QUEUE_STRESS_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void QueueStress_Preempt(void){
+
+    static __thread uint32 seed = 0;
+
+    /* xorshift, a sequence of its own per thread */
+    if(seed == 0){
+        seed = (uint32)(unsigned long)&seed | 1;
+    }
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    if((seed % QUEUE_STRESS_PREEMPT_RATE) == 0){
+        sched_yield();
+    }
+}
+
+static void QueueStress_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < QUEUE_STRESS_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+static void QueueStress_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+/* Consumer side of every scenario: the item must be the next one of its producer */
+static void QueueStress_Receive(uint32 Item){
+
+    uint32 producer = QUEUE_STRESS_PRODUCER(Item);
+
+    if((producer >= g_Producers) || (QUEUE_STRESS_SEQUENCE(Item) != g_Next[producer])){
+        g_Disorder++;
+        return;
+    }
+    g_Next[producer]++;
+}
+
+/* One token per producer that delivered everything, then the disorder verdict */
+static void QueueStress_Report(void){
+
+    char token[8];
+    uint8 producer;
+
+    for(producer = 0; producer < g_Producers; producer++){
+
+        if(g_Next[producer] == g_Items){
+            sprintf(token, "p%u", (unsigned)producer);
+            QueueStress_Log(token);
+        }
+        g_Next[producer] = 0;
+    }
+    if(g_Disorder != 0){
+        QueueStress_Log("order");
+    }
+    g_Disorder = 0;
+}
+
+/* Positions the MPSC counters at Base, as Init does at 0 */
+static void QueueStress_MpscStartAt(uint32 Base){
+
+    uint32 i;
+
+    QueueStress_Mpsc_Init(&g_Mpsc);
+    g_Mpsc.head = Base;
+    g_Mpsc.tail = Base;
+    for(i = 0; i < 16; i++){
+        g_Mpsc.slots[(Base + i) & 15].sequence = Base + i;
+    }
+}
+
+static void *QueueStress_MpscProducer(void *Arg){
+
+    uint32 producer = (uint32)(unsigned long)Arg;
+    uint32 sequence;
+
+    for(sequence = 0; sequence < g_Items; sequence++){
+
+        uint32 item = QUEUE_STRESS_ITEM(producer, sequence);
+
+        while(!QueueStress_Mpsc_Enqueue(&g_Mpsc, &item)){
+            sched_yield();
+        }
+    }
+
+    return NULL_PTR;
+}
+
+static void *QueueStress_SpscProducer(void *Arg){
+
+    uint32 sequence;
+
+    (void)Arg;
+
+    for(sequence = 0; sequence < g_Items; sequence++){
+
+        uint32 item = QUEUE_STRESS_ITEM(0, sequence);
+
+        while(!QueueStress_Spsc_Enqueue(&g_Spsc, &item)){
+            sched_yield();
+        }
+    }
+
+    return NULL_PTR;
+}
+
+/* Producers on their own threads, the consumer on this one, single and batch dequeues mixed */
+static void QueueStress_Mpsc(uint8 Producers){
+
+    pthread_t threads[QUEUE_STRESS_PRODUCERS];
+    uint32 items[QUEUE_STRESS_BATCH];
+    uint32 expected = Producers * g_Items;
+    uint32 received = 0;
+    uint8 i;
+
+    g_Producers = Producers;
+    for(i = 0; i < Producers; i++){
+        pthread_create(&threads[i], NULL_PTR, QueueStress_MpscProducer, (void *)(unsigned long)i);
+    }
+
+    while(received < expected){
+
+        uint32 count = 0;
+        uint32 n;
+
+        if((received & 1) == 0){
+            count = QueueStress_Mpsc_Dequeue(&g_Mpsc, &items[0]) ? 1 : 0;
+        }
+        else{
+            count = QueueStress_Mpsc_DequeueBatch(&g_Mpsc, items, QUEUE_STRESS_BATCH);
+        }
+        for(n = 0; n < count; n++){
+            QueueStress_Receive(items[n]);
+        }
+        if(count == 0){
+            sched_yield();
+        }
+        received += count;
+    }
+
+    for(i = 0; i < Producers; i++){
+        pthread_join(threads[i], NULL_PTR);
+    }
+    if(QueueStress_Mpsc_Dequeue(&g_Mpsc, &items[0])){
+        QueueStress_Log("empty");
+    }
+    QueueStress_Report();
+}
+
+static void QueueStress_Spsc(void){
+
+    pthread_t thread;
+    uint32 items[QUEUE_STRESS_BATCH];
+    uint32 received = 0;
+
+    g_Producers = 1;
+    pthread_create(&thread, NULL_PTR, QueueStress_SpscProducer, NULL_PTR);
+
+    while(received < g_Items){
+
+        uint32 count;
+        uint32 n;
+
+        if((received & 1) == 0){
+            count = QueueStress_Spsc_Dequeue(&g_Spsc, &items[0]) ? 1 : 0;
+        }
+        else{
+            count = QueueStress_Spsc_DequeueBatch(&g_Spsc, items, QUEUE_STRESS_BATCH);
+        }
+        for(n = 0; n < count; n++){
+            QueueStress_Receive(items[n]);
+        }
+        if(count == 0){
+            sched_yield();
+        }
+        received += count;
+    }
+
+    pthread_join(thread, NULL_PTR);
+    if(QueueStress_Spsc_Count(&g_Spsc) != 0){
+        QueueStress_Log("empty");
+    }
+    QueueStress_Report();
+}
+
+/* Single thread: exactly Size items fit, the overflow is refused, all come back in order */
+static void QueueStress_Capacity(void){
+
+    uint32 items[16];
+    uint32 item;
+    uint32 count;
+    uint32 i;
+
+    g_Producers = 1;
+    g_Items = 8;
+    for(i = 0; i < 8; i++){
+        item = QUEUE_STRESS_ITEM(0, i);
+        (void)QueueStress_Spsc_Enqueue(&g_Spsc, &item);
+    }
+    if(QueueStress_Spsc_Enqueue(&g_Spsc, &item)){
+        QueueStress_Log("full");
+    }
+    count = QueueStress_Spsc_DequeueBatch(&g_Spsc, items, 16);
+    for(i = 0; i < count; i++){
+        QueueStress_Receive(items[i]);
+    }
+    QueueStress_Report();
+
+    g_Items = 16;
+    for(i = 0; i < 16; i++){
+        item = QUEUE_STRESS_ITEM(0, i);
+        (void)QueueStress_Mpsc_Enqueue(&g_Mpsc, &item);
+    }
+    if(QueueStress_Mpsc_Enqueue(&g_Mpsc, &item)){
+        QueueStress_Log("full");
+    }
+    count = QueueStress_Mpsc_DequeueBatch(&g_Mpsc, items, 16);
+    for(i = 0; i < count; i++){
+        QueueStress_Receive(items[i]);
+    }
+    if(QueueStress_Mpsc_Dequeue(&g_Mpsc, &item) || QueueStress_Spsc_Dequeue(&g_Spsc, &item)){
+        QueueStress_Log("empty");
+    }
+    QueueStress_Report();
+}
+
+int main(int argc, char *argv[]){
+
+    uint32 items = QUEUE_STRESS_ITEMS;
+
+    if(argc > 1){
+        items = (uint32)atoi(argv[1]);
+    }
+    if((items == 0) || (items > QUEUE_STRESS_SEQUENCE(0xFFFFFFFF))){
+        fprintf(stderr, "usage: queue_stress [items_per_producer]\n");
+        return 2;
+    }
+
+    /* Size items fit in each queue, one more is refused */
+    QueueStress_Spsc_Init(&g_Spsc);
+    QueueStress_MpscStartAt(0);
+    QueueStress_Capacity();
+    QueueStress_Check("capacity", "p0 p0");
+
+    /* Many producers at once into a queue far smaller than the traffic */
+    g_Items = items;
+    QueueStress_MpscStartAt(0);
+    QueueStress_Mpsc(QUEUE_STRESS_PRODUCERS);
+    QueueStress_Check("mpsc 4 producers", "p0 p1 p2 p3");
+
+    /* head, tail and the slot sequences cross the 32-bit wrap during the run */
+    QueueStress_MpscStartAt(QUEUE_STRESS_NEAR_WRAP);
+    QueueStress_Mpsc(2);
+    QueueStress_Check("mpsc counter wrap", "p0 p1");
+
+    /* The index wraps every 8 items, the free running counters cross the 32-bit wrap */
+    QueueStress_Spsc_Init(&g_Spsc);
+    g_Spsc.head = QUEUE_STRESS_NEAR_WRAP;
+    g_Spsc.tail = QUEUE_STRESS_NEAR_WRAP;
+    QueueStress_Spsc();
+    QueueStress_Check("spsc wraparound", "p0");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
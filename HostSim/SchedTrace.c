@@ -0,0 +1,209 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: SchedTrace.c
+ *
+ * Description: Host tool replaying an interrupt event trace through the scheduler.
+ *              Every event is an interrupt whose handler posts to a task, the task
+ *              bodies run from PendSV and take their cycles in the HostModel, where
+ *              the later interrupts preempt them. Prints the dispatch count and the
+ *              post to start response times of every task
+ *
+ *              sched_trace <trace.csv> [dispatch_cycles]
+ *
+ *              One event per line, '#' starts a comment:
+ *                  cycle,irq,body_cycles,task,task_cycles
+ *              Exit code 1 when an event was not dispatched.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "HostModel.h"
+#include "NVIC.h"
+#include "Scheduler.h"
+
+#define SCHED_TRACE_MAX_EVENTS     4096
+
+/* PendSV entry to the first task, cycles */
+#define SCHED_TRACE_DISPATCH_CYCLES  40
+
+/* VECACT field of INTCTRL, the vector whose handler runs */
+#define SCHED_TRACE_INTCTRL        0xE000ED04
+#define SCHED_TRACE_VECACT_MASK    0x000000FF
+
+typedef struct
+{
+    uint64 cycle;
+    uint8 irq;
+    uint32 body;
+    Sched_TaskIdType task;
+    uint32 taskCycles;
+    boolean posted;
+}SchedTrace_EventType;
+
+static SchedTrace_EventType g_TraceEvents[SCHED_TRACE_MAX_EVENTS];
+static uint32 g_TraceCount = 0;
+static uint32 g_TraceScheduled = 0;
+static uint32 g_TraceRejected = 0;
+
+static int SchedTrace_Compare(const void *A, const void *B){
+
+    const SchedTrace_EventType *a = (const SchedTrace_EventType *)A;
+    const SchedTrace_EventType *b = (const SchedTrace_EventType *)B;
+
+    return (a->cycle > b->cycle) - (a->cycle < b->cycle);
+}
+
+static boolean SchedTrace_Load(const char *Path){
+
+    FILE *file = fopen(Path, "r");
+    char line[128];
+
+    if(file == NULL_PTR){
+        return FALSE;
+    }
+
+    while(fgets(line, sizeof(line), file) != NULL_PTR){
+
+        unsigned long long cycle;
+        unsigned irq, body, task, taskCycles;
+
+        if((line[0] == '#') || (sscanf(line, "%llu,%u,%u,%u,%u", &cycle, &irq, &body, &task, &taskCycles) < 5)){
+            continue;
+        }
+        if((g_TraceCount == SCHED_TRACE_MAX_EVENTS) || (irq >= (HOSTMODEL_VECTORS - 16)) || (task >= SCHED_MAX_TASKS)){
+            fprintf(stderr, "sched_trace: event at cycle %llu skipped\n", cycle);
+            continue;
+        }
+
+        g_TraceEvents[g_TraceCount].cycle      = cycle;
+        g_TraceEvents[g_TraceCount].irq        = (uint8)irq;
+        g_TraceEvents[g_TraceCount].body       = body;
+        g_TraceEvents[g_TraceCount].task       = (Sched_TaskIdType)task;
+        g_TraceEvents[g_TraceCount].taskCycles = taskCycles;
+        g_TraceEvents[g_TraceCount].posted     = FALSE;
+        g_TraceCount++;
+    }
+
+    fclose(file);
+    qsort(g_TraceEvents, g_TraceCount, sizeof(g_TraceEvents[0]), SchedTrace_Compare);
+
+    return TRUE;
+}
+
+/* Interrupt handler: posts every event of its IRQ that is due, as a driver drains a FIFO */
+static void SchedTrace_Handler(void){
+
+    uint8 irq = (uint8)((HostReg_Peek(SCHED_TRACE_INTCTRL) & SCHED_TRACE_VECACT_MASK) - 16);
+    uint64 now = HostModel_GetCycles();
+    uint32 i;
+
+    for(i = 0; (i < g_TraceCount) && (g_TraceEvents[i].cycle <= now); i++){
+
+        if((g_TraceEvents[i].irq == irq) && !g_TraceEvents[i].posted){
+
+            g_TraceEvents[i].posted = TRUE;
+            if(Sched_Post(g_TraceEvents[i].task, i) != SCHED_OK){
+                g_TraceRejected++;
+            }
+        }
+    }
+}
+
+/* The model holds HOSTMODEL_MAX_EVENTS events, hand them over in time order */
+static void SchedTrace_Schedule(void){
+
+    while(g_TraceScheduled < g_TraceCount){
+
+        const SchedTrace_EventType *event = &g_TraceEvents[g_TraceScheduled];
+        uint8 vector = HOSTMODEL_VECTOR_IRQ(event->irq);
+
+        if(!HostModel_ScheduleVector(vector, event->cycle, 0)){
+            break;
+        }
+
+        /* Every event of a line runs the body of its last trace entry */
+        HostModel_SetHandler(vector, SchedTrace_Handler, event->body);
+        NVIC_EnableIRQ((NVIC_IRQType)event->irq);
+        g_TraceScheduled++;
+    }
+}
+
+static uint32 SchedTrace_Dispatched(void){
+
+    uint32 dispatched = 0;
+    Sched_TaskIdType task;
+
+    for(task = 0; task < SCHED_MAX_TASKS; task++){
+        dispatched += Sched_GetStats(task)->dispatchCount;
+    }
+
+    return dispatched;
+}
+
+/* Every task body: the work of the event it was posted */
+static void SchedTrace_Task(Sched_EventType Event){
+
+    HostModel_Execute(g_TraceEvents[Event].taskCycles);
+}
+
+int main(int argc, char *argv[]){
+
+    uint32 dispatchCycles = SCHED_TRACE_DISPATCH_CYCLES;
+    uint32 i;
+    uint64 end;
+    boolean first = TRUE;
+    Sched_TaskIdType task;
+
+    if((argc < 2) || !SchedTrace_Load(argv[1])){
+        fprintf(stderr, "usage: sched_trace <trace.csv> [dispatch_cycles]\n");
+        return 2;
+    }
+    if(argc > 2){
+        dispatchCycles = (uint32)atoi(argv[2]);
+    }
+
+    HostModel_Init();
+    Sched_Init();
+    HostModel_SetHandler(HOSTMODEL_VECTOR_PENDSV, PendSV_Handler, dispatchCycles);
+
+    for(i = 0; i < g_TraceCount; i++){
+        (void)Sched_CreateTask(g_TraceEvents[i].task, SchedTrace_Task);
+    }
+
+    /* Run until the last event was posted and no task is left with work */
+    end = (g_TraceCount > 0) ? g_TraceEvents[g_TraceCount - 1].cycle : 0;
+    while(HostModel_GetCycles() <= end){
+
+        SchedTrace_Schedule();
+        HostModel_Run(1000);
+    }
+    for(i = 0; (i < 1000) && (SchedTrace_Dispatched() + g_TraceRejected < g_TraceCount); i++){
+        HostModel_Run(1000);
+    }
+
+    printf("{\n  \"cycles\": %llu,\n  \"events\": %lu,\n  \"rejected\": %lu,\n  \"tasks\": {\n",
+           (unsigned long long)HostModel_GetCycles(), (unsigned long)g_TraceCount, (unsigned long)g_TraceRejected);
+
+    for(task = 0; task < SCHED_MAX_TASKS; task++){
+
+        const Sched_StatsType *stats = Sched_GetStats(task);
+
+        if(stats->dispatchCount == 0){
+            continue;
+        }
+
+        printf("%s    \"%u\": {\"dispatches\": %lu, \"overflows\": %lu, \"max_response\": %lu, \"mean_response\": %.1f}",
+               first ? "" : ",\n", (unsigned)task, (unsigned long)stats->dispatchCount,
+               (unsigned long)stats->overflowCount, (unsigned long)stats->maxResponseTime,
+               (double)stats->totalResponseTime / (double)stats->dispatchCount);
+        first = FALSE;
+    }
+
+    printf("\n  }\n}\n");
+
+    return ((SchedTrace_Dispatched() + g_TraceRejected) == g_TraceCount) ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: SsiQueue.c
+ *
+ * Description: Host check of the SSI transaction queue. Runs scripted transactions
+ *              through SSI.c against the simulated register file and compares the bus
+ *              activity with the expected one
+ *
+ *              ssi_queue
+ *
+ *              The activity is a list of tokens:
+ *                  xx            byte written to SSIDR
+ *                  F f / P p     flash / display chip select low / high
+ *                  Dn            uDMA transfer of n frames
+ *                  name          call back of a transaction
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "HostRegisters.h"
+#include "tm4c123gh6pm_registers.h"
+#include "SSI.h"
+
+#define SSI_QUEUE_LOG_SIZE         8192
+
+/* Chip selects on PA3 and PA4 */
+#define SSI_QUEUE_FLASH_PIN        0x08
+#define SSI_QUEUE_DISPLAY_PIN      0x10
+
+/* Registers the check plays the hardware side of */
+#define SSI_QUEUE_SSI0_SR          (SSI0_BASE + 0x00C)
+#define SSI_QUEUE_UDMA_ENASET      0x400FF028
+#define SSI_QUEUE_UDMA_CHIS        0x400FF504
+
+/* SSI0 uDMA channels */
+#define SSI_QUEUE_RX_BIT           (1u << 10)
+#define SSI_QUEUE_TX_BIT           (1u << 11)
+#define SSI_QUEUE_TX_CHCTL         ((11 * 4) + 2)
+#define SSI_QUEUE_TX_SRCENDP       (11 * 4)
+
+/* Written values differ from every value the slot holds, so each write is seen */
+#define SSI_QUEUE_WRITTEN          0x10000
+
+static const SSI_DeviceType g_Flash   = { GPIO_PORTA_BASE, SSI_QUEUE_FLASH_PIN, SSI_MODE0, 2, 0 };
+static const SSI_DeviceType g_Display = { GPIO_PORTA_BASE, SSI_QUEUE_DISPLAY_PIN, SSI_MODE3, 4, 1 };
+
+static uint32 g_DmaTable[256];
+static char g_Log[SSI_QUEUE_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void SsiQueue_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < SSI_QUEUE_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+static uint32 SsiQueue_Data(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    char token[8];
+
+    (void)Address;
+    (void)OldValue;
+    sprintf(token, "%02x", (unsigned)(NewValue & 0xFF));
+    SsiQueue_Log(token);
+
+    return SSI_QUEUE_WRITTEN | NewValue;
+}
+
+static uint32 SsiQueue_Select(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    boolean flash = (Address == (GPIO_PORTA_BASE + (SSI_QUEUE_FLASH_PIN << 2))) ? TRUE : FALSE;
+
+    (void)OldValue;
+    if((NewValue & 0xFF) == 0){
+        SsiQueue_Log(flash ? "F" : "P");
+    }
+    else{
+        SsiQueue_Log(flash ? "f" : "p");
+    }
+
+    return SSI_QUEUE_WRITTEN | NewValue;
+}
+
+typedef struct
+{
+    SSI_TransactionType trans;
+    const char *name;
+}SsiQueue_NamedType;
+
+static void SsiQueue_CallBack(SSI_TransactionType *Transaction){
+
+    /* Apply the chip select write before the call back token */
+    HostReg_Sync();
+    SsiQueue_Log(((SsiQueue_NamedType *)Transaction)->name);
+}
+
+static void SsiQueue_Setup(SsiQueue_NamedType *Named, const char *Name, const SSI_DeviceType *Device,
+                           const uint8 *Tx, uint8 *Rx, uint16 Length, boolean KeepSelected){
+
+    Named->name                = Name;
+    Named->trans.device        = Device;
+    Named->trans.tx            = Tx;
+    Named->trans.rx            = Rx;
+    Named->trans.length        = Length;
+    Named->trans.keepSelected  = KeepSelected;
+    Named->trans.callBack      = SsiQueue_CallBack;
+    Named->trans.state         = SSI_TRANSACTION_IDLE;
+}
+
+/* Interrupt loop: a running uDMA transfer completes at once, the FIFOs never stall */
+static void SsiQueue_Run(void){
+
+    uint32 guard;
+
+    for(guard = 0; !SSI_IsIdle(SSI_MODULE0) && (guard < 1000); guard++){
+
+        HostReg_Sync();
+        if(HostReg_Peek(SSI_QUEUE_UDMA_ENASET) & (SSI_QUEUE_RX_BIT | SSI_QUEUE_TX_BIT)){
+
+            char token[16];
+
+            sprintf(token, "D%u", (unsigned)(((g_DmaTable[SSI_QUEUE_TX_CHCTL] >> 4) & 0x3FF) + 1));
+            SsiQueue_Log(token);
+
+            HostReg_Poke(SSI_QUEUE_UDMA_ENASET, 0);
+            HostReg_Poke(SSI_QUEUE_UDMA_CHIS, SSI_QUEUE_RX_BIT | SSI_QUEUE_TX_BIT);
+        }
+        else{
+            HostReg_Poke(SSI_QUEUE_UDMA_CHIS, 0);
+        }
+
+        SSI_Handler(SSI_MODULE0);
+    }
+    HostReg_Sync();
+}
+
+static void SsiQueue_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+int main(void){
+
+    static const uint8 txA[4]  = { 0x01, 0x02, 0x03, 0x04 };
+    static const uint8 txB[12] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B };
+    static const uint8 txC[3]  = { 0x20, 0x21, 0x22 };
+    static const uint8 txG[2]  = { 0x30, 0x31 };
+    static const uint8 txH[2]  = { 0x40, 0x41 };
+    static uint8 txD[100];
+    static uint8 rxE[2000];
+    uint8 rx[12];
+    SsiQueue_NamedType a, b, c, d, e, g, h;
+
+    HostReg_Init();
+    HostReg_Poke(SSI_DR_ADDRESS(SSI0_BASE), SSI_QUEUE_WRITTEN);
+    HostReg_Poke(GPIO_PORTA_BASE + (SSI_QUEUE_FLASH_PIN << 2), SSI_QUEUE_WRITTEN);
+    HostReg_Poke(GPIO_PORTA_BASE + (SSI_QUEUE_DISPLAY_PIN << 2), SSI_QUEUE_WRITTEN);
+    HostReg_AddCallback(SSI_DR_ADDRESS(SSI0_BASE), SsiQueue_Data);
+    HostReg_AddCallback(GPIO_PORTA_BASE + (SSI_QUEUE_FLASH_PIN << 2), SsiQueue_Select);
+    HostReg_AddCallback(GPIO_PORTA_BASE + (SSI_QUEUE_DISPLAY_PIN << 2), SsiQueue_Select);
+
+    SSI_Init(SSI_MODULE0, g_DmaTable);
+
+    /* Transmit FIFO never full, receive FIFO never empty */
+    HostReg_Poke(SSI_QUEUE_SSI0_SR, 0x6);
+
+    /* Command kept selected, its data follows in the same FIFO fill, then another device */
+    SsiQueue_Setup(&a, "A", &g_Flash, txA, NULL_PTR, sizeof(txA), TRUE);
+    SsiQueue_Setup(&b, "B", &g_Flash, txB, rx, sizeof(txB), FALSE);
+    SsiQueue_Setup(&c, "C", &g_Display, txC, NULL_PTR, sizeof(txC), FALSE);
+    (void)SSI_Submit(SSI_MODULE0, &a.trans);
+    (void)SSI_Submit(SSI_MODULE0, &b.trans);
+    (void)SSI_Submit(SSI_MODULE0, &c.trans);
+    if(SSI_Submit(SSI_MODULE0, &b.trans)){
+        SsiQueue_Log("resubmitted");
+    }
+    SsiQueue_Run();
+    SsiQueue_Check("burst chained", "F 01 02 03 04 10 11 12 13 A 14 15 16 17 18 19 1a 1b f B P 20 21 22 p C");
+
+    /* Chip select kept low between two separately submitted transactions */
+    SsiQueue_Setup(&g, "G", &g_Flash, txG, NULL_PTR, sizeof(txG), TRUE);
+    SsiQueue_Setup(&h, "H", &g_Flash, txH, NULL_PTR, sizeof(txH), FALSE);
+    (void)SSI_Submit(SSI_MODULE0, &g.trans);
+    SsiQueue_Run();
+    (void)SSI_Submit(SSI_MODULE0, &h.trans);
+    SsiQueue_Run();
+    SsiQueue_Check("kept selected", "F 30 31 G 40 41 f H");
+
+    /* Long transfers on the uDMA, split in chunks of SSI_DMA_MAX_FRAMES */
+    SsiQueue_Setup(&d, "D", &g_Flash, txD, NULL_PTR, sizeof(txD), FALSE);
+    SsiQueue_Setup(&e, "E", &g_Display, NULL_PTR, rxE, sizeof(rxE), FALSE);
+    (void)SSI_Submit(SSI_MODULE0, &d.trans);
+    if(g_DmaTable[SSI_QUEUE_TX_SRCENDP] != (uint32)(unsigned long)&txD[99]){
+        SsiQueue_Log("bad-source");
+    }
+    (void)SSI_Submit(SSI_MODULE0, &e.trans);
+    SsiQueue_Run();
+    SsiQueue_Check("dma", "F D100 f D P D1024 D976 p E");
+
+    /* Empty transaction */
+    SsiQueue_Setup(&a, "A", &g_Flash, txA, NULL_PTR, 0, FALSE);
+    if(SSI_Submit(SSI_MODULE0, &a.trans) || !SSI_IsIdle(SSI_MODULE0)){
+        SsiQueue_Log("accepted");
+    }
+    SsiQueue_Check("empty rejected", "");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
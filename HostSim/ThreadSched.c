@@ -0,0 +1,182 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: ThreadSched.c
+ *
+ * Description: Host check of the thread layer scheduling. The host build of Thread.c
+ *              switches at once where the target pends PendSV, so every call is made
+ *              as the running thread would make it and the thread running after it
+ *              is compared with the expected one
+ *
+ *              thread_sched
+ *
+ *              The activity is a list of tokens:
+ *                  tn            thread n runs after the call
+ *                  accepted      an invalid create was taken
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "Thread.h"
+
+#define THREAD_SCHED_LOG_SIZE      1024
+
+/* Running thread, defined by Thread.c for Thread_Switch.asm */
+extern Thread_ControlBlockType *g_ThreadCurrent;
+
+static char g_Log[THREAD_SCHED_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void ThreadSched_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < THREAD_SCHED_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+static void ThreadSched_Running(void){
+
+    char token[8];
+
+    sprintf(token, "t%u", (unsigned)Thread_GetCurrent());
+    ThreadSched_Log(token);
+}
+
+static void ThreadSched_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+/* Thread bodies never run on the host, only their start address is stacked */
+static void ThreadSched_Body(void *Arg){
+
+    (void)Arg;
+}
+
+static void ThreadSched_Tick(uint8 Ticks){
+
+    while(Ticks--){
+        Thread_Tick();
+    }
+    ThreadSched_Running();
+}
+
+int main(void){
+
+    uint32 switches[THREAD_MAX_THREADS] = { 0 };
+    uint32 total = 0;
+    uint8 i;
+
+    /* Nothing runs before Thread_Start, then the highest priority one does */
+    Thread_Init(NULL_PTR);
+    (void)Thread_Create(2, ThreadSched_Body, NULL_PTR);
+    (void)Thread_Create(5, ThreadSched_Body, NULL_PTR);
+    (void)Thread_Create(3, ThreadSched_Body, NULL_PTR);
+    ThreadSched_Running();
+    Thread_Start();
+    ThreadSched_Running();
+    ThreadSched_Check("start", "t0 t5");
+
+    /* A thread created from a running one preempts it only when it is higher */
+    (void)Thread_Create(4, ThreadSched_Body, NULL_PTR);
+    ThreadSched_Running();
+    (void)Thread_Create(7, ThreadSched_Body, NULL_PTR);
+    ThreadSched_Running();
+    if((Thread_Create(7, ThreadSched_Body, NULL_PTR) != THREAD_ALREADY_CREATED) ||
+       (Thread_Create(THREAD_IDLE_ID, ThreadSched_Body, NULL_PTR) != THREAD_INVALID_ID) ||
+       (Thread_Create(THREAD_MAX_THREADS, ThreadSched_Body, NULL_PTR) != THREAD_INVALID_ID) ||
+       (Thread_Create(6, NULL_PTR, NULL_PTR) != THREAD_INVALID_ID)){
+        ThreadSched_Log("accepted");
+    }
+    Thread_Yield();
+    ThreadSched_Running();
+    ThreadSched_Check("priority", "t5 t7 t7");
+
+    /* Sleeping threads step aside and come back on their tick */
+    Thread_Sleep(2);
+    ThreadSched_Running();
+    Thread_Sleep(3);
+    ThreadSched_Running();
+    Thread_Sleep(3);
+    ThreadSched_Running();
+    ThreadSched_Tick(1);
+    ThreadSched_Tick(1);
+    ThreadSched_Tick(1);
+    ThreadSched_Tick(1);
+    ThreadSched_Check("sleep", "t5 t4 t3 t3 t7 t7 t7");
+
+    /* Suspended threads wait for a resume, the idle thread takes over when none is ready */
+    Thread_Suspend();
+    ThreadSched_Running();
+    Thread_Suspend();
+    ThreadSched_Running();
+    Thread_Suspend();
+    ThreadSched_Running();
+    Thread_Suspend();
+    ThreadSched_Running();
+    Thread_Suspend();
+    ThreadSched_Running();
+    Thread_Suspend();
+    Thread_Sleep(4);
+    ThreadSched_Running();
+    ThreadSched_Check("suspend", "t5 t4 t3 t2 t0 t0");
+
+    Thread_Resume(3);
+    ThreadSched_Running();
+    Thread_Resume(6);
+    Thread_Resume(THREAD_MAX_THREADS);
+    ThreadSched_Running();
+    Thread_Resume(7);
+    ThreadSched_Running();
+    Thread_Resume(2);
+    ThreadSched_Running();
+    ThreadSched_Check("resume", "t3 t3 t7 t7");
+
+    /* A resume ends a sleep early, the pending tick count is dropped */
+    Thread_Sleep(5);
+    ThreadSched_Running();
+    Thread_Resume(7);
+    ThreadSched_Running();
+    Thread_Suspend();
+    ThreadSched_Tick(5);
+    ThreadSched_Check("resume from sleep", "t3 t7 t3");
+
+    /* Every thread counts the switches into it, their sum is the global count */
+    Thread_Init(NULL_PTR);
+    for(i = 1; i < THREAD_MAX_THREADS; i++){
+        (void)Thread_Create(i, ThreadSched_Body, NULL_PTR);
+    }
+    Thread_Start();
+    for(i = THREAD_MAX_THREADS - 1; i > 0; i--){
+
+        switches[i] += g_ThreadCurrent->switchCount;
+        Thread_Sleep(1);
+    }
+    switches[0] = g_ThreadCurrent->switchCount;
+    Thread_Tick();
+    for(i = 0; i < THREAD_MAX_THREADS; i++){
+        total += switches[i];
+    }
+    ThreadSched_Running();
+    if((total != THREAD_MAX_THREADS) || (Thread_GetSwitchStats()->switchCount != (THREAD_MAX_THREADS + 1)) ||
+       (g_ThreadCurrent->switchCount != 2)){
+        ThreadSched_Log("bad-count");
+    }
+    ThreadSched_Check("switch count", "t7");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: WatchdogSupervision.c
+ *
+ * Description: Host check of the watchdog supervisor. Plays WDT0 counting down
+ *              behind the simulated register file, drives Watchdog.c with scripted
+ *              task check-ins one SysTick tick at a time and compares the watchdog
+ *              activity with the expected one
+ *
+ *              watchdog_supervision
+ *
+ *              The activity is a list of tokens:
+ *                  K             watchdog kicked
+ *                  I             first timeout, pre-reset interrupt
+ *                  N             the handler disabled its NVIC line, the DIS0 write
+ *                                clears the EN0 bit in the register file
+ *                  cleared       the handler cleared the timeout, no reset would follow
+ *                  m/r@w+t       call back record: missed / registered tasks, windows,
+ *                                ticks since the last kick
+ *                  R             second timeout, device reset
+ *              Exit code 1 when a scenario differs.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "HostRegisters.h"
+#include "tm4c123gh6pm_registers.h"
+#include "Watchdog.h"
+
+#define WATCHDOG_SUPERVISION_LOG_SIZE      1024
+
+/* 10 ticks per window, the interrupt two and a half windows after the last kick */
+#define WATCHDOG_SUPERVISION_CLOCKS_PER_TICK   1000
+#define WATCHDOG_SUPERVISION_WINDOW_TICKS      10
+#define WATCHDOG_SUPERVISION_TIMEOUT           25000
+
+/* Registers the check plays the hardware side of */
+#define WATCHDOG_SUPERVISION_LOAD          (WDT0_BASE + 0x000)
+#define WATCHDOG_SUPERVISION_CTL           (WDT0_BASE + 0x008)
+#define WATCHDOG_SUPERVISION_ICR           (WDT0_BASE + 0x00C)
+#define WATCHDOG_SUPERVISION_RIS           (WDT0_BASE + 0x010)
+#define WATCHDOG_SUPERVISION_RESC          0x400FE05C
+#define WATCHDOG_SUPERVISION_NVIC_EN0      0xE000E100
+
+/* NVIC_WATCHDOG_TIMERS_0_AND_1, IRQ 18 */
+#define WATCHDOG_SUPERVISION_NVIC_BIT      0x00040000
+
+#define WATCHDOG_SUPERVISION_RESC_POR      0x00000002
+#define WATCHDOG_SUPERVISION_RESC_WDT0     0x00000008
+
+/* Written values differ from every value the slot holds, so each kick is seen */
+#define WATCHDOG_SUPERVISION_WRITTEN       0x10000
+
+static uint32 g_Count;
+static boolean g_Reset;
+static uint32 g_TaskA;
+static uint32 g_TaskB;
+
+static char g_Log[WATCHDOG_SUPERVISION_LOG_SIZE];
+static uint32 g_Failures = 0;
+
+static void WatchdogSupervision_Log(const char *Token){
+
+    if((strlen(g_Log) + strlen(Token) + 2) < WATCHDOG_SUPERVISION_LOG_SIZE){
+        if(g_Log[0] != '\0'){
+            strcat(g_Log, " ");
+        }
+        strcat(g_Log, Token);
+    }
+}
+
+/* Any write of WDTICR reloads the counter and clears the interrupt */
+static uint32 WatchdogSupervision_Kick(uint32 Address, uint32 OldValue, uint32 NewValue){
+
+    (void)Address;
+    (void)OldValue;
+    (void)NewValue;
+
+    g_Count = HostReg_Peek(WATCHDOG_SUPERVISION_LOAD);
+    HostReg_Poke(WATCHDOG_SUPERVISION_RIS, 0);
+    WatchdogSupervision_Log("K");
+
+    return WATCHDOG_SUPERVISION_WRITTEN;
+}
+
+static void WatchdogSupervision_CallBack(const Watchdog_RecordType *Record){
+
+    char token[48];
+
+    sprintf(token, "%x/%x@%u+%u", (unsigned)Record->missed, (unsigned)Record->registered,
+            (unsigned)Record->window, (unsigned)Record->ticksSinceKick);
+    WatchdogSupervision_Log(token);
+}
+
+/* Power on or the reset that follows a second timeout */
+static void WatchdogSupervision_Start(uint32 ResetCause){
+
+    const Watchdog_ConfigType config =
+    {
+        WATCHDOG_MODULE0, WATCHDOG_SUPERVISION_TIMEOUT, WATCHDOG_SUPERVISION_WINDOW_TICKS, FALSE
+    };
+
+    HostReg_Poke(WATCHDOG_SUPERVISION_RESC, ResetCause);
+    HostReg_Poke(WATCHDOG_SUPERVISION_RIS, 0);
+    HostReg_Poke(WATCHDOG_SUPERVISION_NVIC_EN0, WATCHDOG_SUPERVISION_NVIC_BIT);
+    if(!Watchdog_Init(&config)){
+        WatchdogSupervision_Log("rejected");
+    }
+    Watchdog_SetCallBack(WatchdogSupervision_CallBack);
+    g_Count = WATCHDOG_SUPERVISION_TIMEOUT;
+    g_Reset = FALSE;
+}
+
+/* One tick of the counter, then the SysTick call back, until the device resets */
+static void WatchdogSupervision_Run(uint32 Ticks, void (*Tasks)(uint32 Tick)){
+
+    uint32 tick;
+
+    for(tick = 1; (tick <= Ticks) && !g_Reset; tick++){
+
+        g_Count -= WATCHDOG_SUPERVISION_CLOCKS_PER_TICK;
+        if(g_Count == 0){
+
+            if(HostReg_Peek(WATCHDOG_SUPERVISION_RIS) & 0x1){
+                WatchdogSupervision_Log("R");
+                g_Reset = TRUE;
+                break;
+            }
+
+            HostReg_Poke(WATCHDOG_SUPERVISION_RIS, 0x1);
+            WatchdogSupervision_Log("I");
+            Watchdog_Handler();
+            HostReg_Sync();
+            if(!(HostReg_Peek(WATCHDOG_SUPERVISION_NVIC_EN0) & WATCHDOG_SUPERVISION_NVIC_BIT)){
+                WatchdogSupervision_Log("N");
+            }
+
+            /* Left pending, entering again must not save a second record */
+            Watchdog_Handler();
+            HostReg_Sync();
+            if(!(HostReg_Peek(WATCHDOG_SUPERVISION_RIS) & 0x1)){
+                WatchdogSupervision_Log("cleared");
+            }
+            g_Count = HostReg_Peek(WATCHDOG_SUPERVISION_LOAD);
+        }
+
+        Tasks(tick);
+        Watchdog_Tick();
+        HostReg_Sync();
+    }
+}
+
+static void WatchdogSupervision_Check(const char *Scenario, const char *Expected){
+
+    if(strcmp(g_Log, Expected) == 0){
+        printf("%-28s pass\n", Scenario);
+    }
+    else{
+        printf("%-28s FAIL\n    expected: %s\n    got:      %s\n", Scenario, Expected, g_Log);
+        g_Failures++;
+    }
+    g_Log[0] = '\0';
+}
+
+/* Both tasks check in on every tick */
+static void WatchdogSupervision_Healthy(uint32 Tick){
+
+    (void)Tick;
+    Watchdog_CheckIn(g_TaskA);
+    Watchdog_CheckIn(g_TaskB);
+}
+
+/* Task B hangs after tick 15, in the second window */
+static void WatchdogSupervision_Hung(uint32 Tick){
+
+    Watchdog_CheckIn(g_TaskA);
+    if(Tick <= 15){
+        Watchdog_CheckIn(g_TaskB);
+    }
+}
+
+/* Task A checks in many times in the second window and never after */
+static void WatchdogSupervision_Burst(uint32 Tick){
+
+    if((Tick > 10) && (Tick <= 20)){
+        Watchdog_CheckIn(g_TaskA);
+    }
+}
+
+/* Task B registers in the middle of the third window and checks in from the fourth */
+static void WatchdogSupervision_Late(uint32 Tick){
+
+    Watchdog_CheckIn(g_TaskA);
+    if(Tick == 25){
+        g_TaskB = Watchdog_Register();
+    }
+    if(Tick > 30){
+        Watchdog_CheckIn(g_TaskB);
+    }
+}
+
+int main(void){
+
+    const Watchdog_ConfigType noTimeout = { WATCHDOG_MODULE0, 0, WATCHDOG_SUPERVISION_WINDOW_TICKS, FALSE };
+    const Watchdog_ConfigType noWindow  = { WATCHDOG_MODULE0, WATCHDOG_SUPERVISION_TIMEOUT, 0, FALSE };
+    Watchdog_RecordType record;
+    uint32 i;
+
+    HostReg_Init();
+    HostReg_Poke(WATCHDOG_SUPERVISION_ICR, WATCHDOG_SUPERVISION_WRITTEN);
+    HostReg_AddCallback(WATCHDOG_SUPERVISION_ICR, WatchdogSupervision_Kick);
+
+    /* Power on, no record */
+    WatchdogSupervision_Start(WATCHDOG_SUPERVISION_RESC_POR);
+    if(Watchdog_GetRecord(&record)){
+        WatchdogSupervision_Log("record");
+    }
+    if(HostReg_Peek(WATCHDOG_SUPERVISION_CTL) != 0x3){
+        WatchdogSupervision_Log("bad-ctl");
+    }
+    WatchdogSupervision_Check("power on", "");
+
+    /* Every task alive, a kick at the end of every window */
+    g_TaskA = Watchdog_Register();
+    g_TaskB = Watchdog_Register();
+    WatchdogSupervision_Run(50, WatchdogSupervision_Healthy);
+    WatchdogSupervision_Check("all alive", "K K K K K");
+
+    /* The third window misses task B: no kick, the interrupt 25 ticks after the last
+       kick at tick 20 and the reset one timeout later */
+    WatchdogSupervision_Start(WATCHDOG_SUPERVISION_RESC_POR);
+    g_TaskA = Watchdog_Register();
+    g_TaskB = Watchdog_Register();
+    WatchdogSupervision_Run(100, WatchdogSupervision_Hung);
+    WatchdogSupervision_Check("hung task", "K K I 2/3@4+24 N R");
+
+    /* The record survives the reset and is read once */
+    WatchdogSupervision_Start(WATCHDOG_SUPERVISION_RESC_WDT0);
+    if(!Watchdog_GetRecord(&record) || (record.missed != 0x2) || (record.registered != 0x3) ||
+       (record.window != 4) || (record.ticksSinceKick != 24)){
+        WatchdogSupervision_Log("bad-record");
+    }
+    if(Watchdog_GetRecord(&record)){
+        WatchdogSupervision_Log("read-twice");
+    }
+    WatchdogSupervision_Check("record after reset", "");
+
+    /* Check-ins do not carry over to the next window */
+    g_TaskA = Watchdog_Register();
+    WatchdogSupervision_Run(100, WatchdogSupervision_Burst);
+    WatchdogSupervision_Check("stale check-ins", "K K I 1/1@4+24 N R");
+
+    /* A task registered during a window is supervised from the next one */
+    WatchdogSupervision_Start(WATCHDOG_SUPERVISION_RESC_POR);
+    g_TaskA = Watchdog_Register();
+    WatchdogSupervision_Run(50, WatchdogSupervision_Late);
+    WatchdogSupervision_Check("late registration", "K K K K K");
+
+    /* A full table, then a bad configuration */
+    WatchdogSupervision_Start(WATCHDOG_SUPERVISION_RESC_POR);
+    for(i = 0; i < WATCHDOG_MAX_TASKS; i++){
+        if(Watchdog_Register() != (1u << i)){
+            WatchdogSupervision_Log("bad-bit");
+        }
+    }
+    if((Watchdog_Register() != 0) || Watchdog_Init(&noTimeout) || Watchdog_Init(&noWindow)){
+        WatchdogSupervision_Log("accepted");
+    }
+    WatchdogSupervision_Check("limits", "");
+
+    return (g_Failures == 0) ? 0 : 1;
+}
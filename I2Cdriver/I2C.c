@@ -0,0 +1,329 @@
+/******************************************************************************
+ *
+ * Module: I2C
+ *
+ * File Name: I2C.c
+ *
+ * Description: Source file for the TM4C123GH6PM I2C master driver, an interrupt
+ *              driven state machine running queued jobs of write-then-read
+ *              transfers with a repeated start
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "I2C.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef __TI_ARM__
+#define I2C_ENTER_CRITICAL()       uint32 savedPrimask = _disable_IRQ()
+#define I2C_EXIT_CRITICAL()        _restore_interrupts(savedPrimask)
+#else
+#define I2C_ENTER_CRITICAL()
+#define I2C_EXIT_CRITICAL()
+#endif
+
+/* I2CMCR master function enable */
+#define I2C_MCR_MFE                   0x10
+
+/* I2CMCS commands on a write */
+#define I2C_MCS_RUN                   0x01
+#define I2C_MCS_START                 0x02
+#define I2C_MCS_STOP                  0x04
+#define I2C_MCS_ACK                   0x08
+
+/* I2CMCS status on a read, ERROR covers the address and data NACKs */
+#define I2C_MCS_ERROR                 0x02
+#define I2C_MCS_ARBLST                0x10
+
+/* Master interrupt, raised at the end of every byte and of a lone stop */
+#define I2C_MINT_IM                   0x01
+
+/* I2CMSA receive bit */
+#define I2C_MSA_READ                  0x01
+
+typedef enum
+{
+    I2C_PHASE_WRITE,
+    I2C_PHASE_READ,
+    I2C_PHASE_STOP                      /* stop after an error, then the job ends      */
+}I2C_PhaseType;
+
+typedef struct
+{
+    I2C_JobType *head;                  /* running, the oldest one                      */
+    I2C_JobType *tail;
+    uint8 transfer;                     /* index of the running transfer in the head    */
+    uint16 index;                       /* byte of the running phase                    */
+    I2C_PhaseType phase;
+    boolean stopped;                    /* the last command ended with a stop           */
+}I2C_BusType;
+
+static const uint32 g_I2cBase[I2C_NUMBER_OF_MODULES] = { I2C0_BASE, I2C1_BASE, I2C2_BASE, I2C3_BASE };
+
+static I2C_BusType g_I2cBus[I2C_NUMBER_OF_MODULES];
+
+static void I2C_Command(I2C_BusType *Bus, uint32 Base, uint32 Command){
+
+    Bus->stopped = (Command & I2C_MCS_STOP) ? TRUE : FALSE;
+    I2C_MCS_REG(Base) = Command;
+}
+
+/* Receive the read bytes, all acknowledged but the last one */
+static void I2C_StartRead(I2C_BusType *Bus, uint32 Base, const I2C_TransferType *Trans){
+
+    Bus->phase = I2C_PHASE_READ;
+    Bus->index = 0;
+
+    I2C_MSA_REG(Base) = ((uint32)Trans->address << 1) | I2C_MSA_READ;
+    I2C_Command(Bus, Base, I2C_MCS_START | I2C_MCS_RUN | ((Trans->readLength == 1) ? I2C_MCS_STOP : I2C_MCS_ACK));
+}
+
+/* Address the slave of the running transfer, the stop goes with its last byte */
+static void I2C_StartTransfer(I2C_BusType *Bus, uint32 Base){
+
+    const I2C_TransferType *trans = &Bus->head->transfers[Bus->transfer];
+
+    if(trans->writeLength == 0){
+        I2C_StartRead(Bus, Base, trans);
+        return;
+    }
+
+    Bus->phase = I2C_PHASE_WRITE;
+    Bus->index = 0;
+
+    I2C_MSA_REG(Base) = (uint32)trans->address << 1;
+    I2C_MDR_REG(Base) = trans->write[0];
+    I2C_Command(Bus, Base, I2C_MCS_START | I2C_MCS_RUN |
+                           (((trans->writeLength == 1) && (trans->readLength == 0)) ? I2C_MCS_STOP : 0));
+}
+
+/* Retire the head */
+static void I2C_Complete(I2C_BusType *Bus){
+
+    I2C_JobType *job = Bus->head;
+
+    Bus->head = job->next;
+    if(Bus->head == NULL_PTR){
+        Bus->tail = NULL_PTR;
+    }
+
+    job->state = I2C_JOB_DONE;
+    if(job->callBack != NULL_PTR){
+        job->callBack(job);
+    }
+}
+
+/* Start the head when the bus has finished the previous one */
+static void I2C_Start(I2C_BusType *Bus, I2C_ModuleType Module){
+
+    I2C_JobType *job = Bus->head;
+
+    if((job == NULL_PTR) || (job->state == I2C_JOB_ACTIVE)){
+        return;
+    }
+
+    job->state    = I2C_JOB_ACTIVE;
+    job->result   = I2C_OK;
+    Bus->transfer = 0;
+    I2C_StartTransfer(Bus, g_I2cBase[Module]);
+}
+
+/* Step the running transfer after a byte without error, FALSE once it has ended */
+static boolean I2C_Step(I2C_BusType *Bus, uint32 Base){
+
+    const I2C_TransferType *trans = &Bus->head->transfers[Bus->transfer];
+
+    if(Bus->phase == I2C_PHASE_WRITE){
+
+        if(++Bus->index < trans->writeLength){
+
+            boolean last = ((Bus->index + 1u) == trans->writeLength) ? TRUE : FALSE;
+
+            I2C_MDR_REG(Base) = trans->write[Bus->index];
+            I2C_Command(Bus, Base, I2C_MCS_RUN | ((last && (trans->readLength == 0)) ? I2C_MCS_STOP : 0));
+            return TRUE;
+        }
+        if(trans->readLength != 0){
+
+            /* Repeated start, the slave keeps the register pointer just written */
+            I2C_StartRead(Bus, Base, trans);
+            return TRUE;
+        }
+        return FALSE;
+    }
+
+    trans->read[Bus->index] = (uint8)I2C_MDR_REG(Base);
+    if(++Bus->index < trans->readLength){
+
+        I2C_Command(Bus, Base, I2C_MCS_RUN | (((Bus->index + 1u) == trans->readLength) ? I2C_MCS_STOP : I2C_MCS_ACK));
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/*********************************************************************
+* Service Name: I2C_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - I2C module / SysClock - System clock in Hz /
+*                  Speed - SCL frequency in Hz, I2C_SPEED_STANDARD ... I2C_SPEED_FAST_PLUS
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clock the module as a master, set its SCL frequency and
+*              empty its queue. The I2C pins and the NVIC line are configured by the
+*              application.
+**********************************************************************/
+void I2C_Init(I2C_ModuleType Module, uint32 SysClock, uint32 Speed){
+
+    I2C_BusType *bus = &g_I2cBus[Module];
+    uint32 base = g_I2cBase[Module];
+
+    SYSCTL_RCGCI2C_REG |= (1u << Module);
+    SYSCTL_SCGCI2C_REG |= (1u << Module);
+    SYSCTL_DCGCI2C_REG |= (1u << Module);
+    while(!(SYSCTL_PRI2C_REG & (1u << Module))){}
+
+    /* SCL period of 20 system clocks per (1 + TPR), rounded up to stay under Speed */
+    I2C_MCR_REG(base)  = I2C_MCR_MFE;
+    I2C_MTPR_REG(base) = ((SysClock + (20u * Speed) - 1u) / (20u * Speed)) - 1u;
+    I2C_MICR_REG(base) = I2C_MINT_IM;
+    I2C_MIMR_REG(base) = I2C_MINT_IM;
+
+    bus->head    = NULL_PTR;
+    bus->tail    = NULL_PTR;
+    bus->stopped = TRUE;
+}
+
+/*********************************************************************
+* Service Name: I2C_Submit
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - I2C module
+* Parameters (inout): Job - Job, owned by the driver until done
+* Parameters (out): None
+* Return value: boolean - FALSE for an empty job or transfer, or a job already queued
+* Description: Function to queue a job, it starts at once on an idle bus. The handler
+*              starts the next one as soon as the previous one completes.
+**********************************************************************/
+boolean I2C_Submit(I2C_ModuleType Module, I2C_JobType *Job){
+
+    I2C_BusType *bus = &g_I2cBus[Module];
+    uint8 i;
+
+    if((Job->count == 0) || (Job->state == I2C_JOB_QUEUED) || (Job->state == I2C_JOB_ACTIVE)){
+        return FALSE;
+    }
+    for(i = 0; i < Job->count; i++){
+        if((Job->transfers[i].writeLength == 0) && (Job->transfers[i].readLength == 0)){
+            return FALSE;
+        }
+    }
+
+    Job->next   = NULL_PTR;
+    Job->state  = I2C_JOB_QUEUED;
+    Job->failed = 0;
+
+    {
+        I2C_ENTER_CRITICAL();
+
+        if(bus->tail != NULL_PTR){
+            bus->tail->next = Job;
+            bus->tail = Job;
+        }
+        else{
+            bus->head = Job;
+            bus->tail = Job;
+            I2C_Start(bus, Module);
+        }
+
+        I2C_EXIT_CRITICAL();
+    }
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: I2C_IsIdle
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - I2C module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when no job is queued or running
+* Description: Function to check that the queue of a module is empty.
+**********************************************************************/
+boolean I2C_IsIdle(I2C_ModuleType Module){
+
+    return (g_I2cBus[Module].head == NULL_PTR) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+* Service Name: I2C_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - I2C module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the master interrupt of a module, raised once per
+*              byte. The vector table entries I2C_I2c0_Handler ... I2C_I2c3_Handler
+*              call it.
+**********************************************************************/
+void I2C_Handler(I2C_ModuleType Module){
+
+    I2C_BusType *bus = &g_I2cBus[Module];
+    uint32 base = g_I2cBase[Module];
+    I2C_JobType *job = bus->head;
+    uint32 status;
+
+    if(!(I2C_MRIS_REG(base) & I2C_MINT_IM)){
+        return;
+    }
+    I2C_MICR_REG(base) = I2C_MINT_IM;
+
+    if(job == NULL_PTR){
+        return;
+    }
+
+    status = I2C_MCS_REG(base);
+
+    if(bus->phase == I2C_PHASE_STOP){
+
+        /* The stop after an error is on the bus */
+        I2C_Complete(bus);
+    }
+    else if(status & (I2C_MCS_ERROR | I2C_MCS_ARBLST)){
+
+        job->result = (status & I2C_MCS_ARBLST) ? I2C_ARBITRATION_LOST : I2C_NACK;
+        job->failed = bus->transfer;
+
+        /* A lost bus belongs to the other master, a NACK still needs the stop */
+        if((status & I2C_MCS_ARBLST) || bus->stopped){
+            I2C_Complete(bus);
+        }
+        else{
+            bus->phase = I2C_PHASE_STOP;
+            I2C_Command(bus, base, I2C_MCS_STOP);
+            return;
+        }
+    }
+    else if(!I2C_Step(bus, base)){
+
+        if(++bus->transfer < job->count){
+            I2C_StartTransfer(bus, base);
+            return;
+        }
+        I2C_Complete(bus);
+    }
+
+    I2C_Start(bus, Module);
+}
+
+/* Vector table entries */
+#define I2C_DEFINE_HANDLER(Name, Module)            void I2C_##Name##_Handler(void){ I2C_Handler(Module); }
+
+I2C_DEFINE_HANDLER(I2c0, I2C_MODULE0)
+I2C_DEFINE_HANDLER(I2c1, I2C_MODULE1)
+I2C_DEFINE_HANDLER(I2c2, I2C_MODULE2)
+I2C_DEFINE_HANDLER(I2c3, I2C_MODULE3)
@@ -0,0 +1,160 @@
+/******************************************************************************
+ *
+ * Module: I2C
+ *
+ * File Name: I2C.h
+ *
+ * Description: Header file for the TM4C123GH6PM I2C master driver, an interrupt
+ *              driven state machine running queued jobs of write-then-read
+ *              transfers with a repeated start
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef I2C_H_
+#define I2C_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define I2C_NUMBER_OF_MODULES                4
+
+/* SCL of the master, SysClk / (20 * (1 + tpr)) */
+#define I2C_SPEED_STANDARD                   100000u
+#define I2C_SPEED_FAST                       400000u
+#define I2C_SPEED_FAST_PLUS                  1000000u
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    I2C_MODULE0, I2C_MODULE1, I2C_MODULE2, I2C_MODULE3
+}I2C_ModuleType;
+
+/*
+ * One exchange with a slave: the write bytes, then after a repeated start the read
+ * bytes, then a stop. Either part may be empty but not both.
+ */
+typedef struct
+{
+    uint8 address;                      /* 7-bit slave address                          */
+    const uint8 *write;
+    uint16 writeLength;
+    uint8 *read;
+    uint16 readLength;
+}I2C_TransferType;
+
+typedef enum
+{
+    I2C_JOB_IDLE,                       /* never submitted                             */
+    I2C_JOB_QUEUED,
+    I2C_JOB_ACTIVE,
+    I2C_JOB_DONE
+}I2C_JobStateType;
+
+typedef enum
+{
+    I2C_OK,
+    I2C_NACK,                           /* address or data not acknowledged            */
+    I2C_ARBITRATION_LOST                /* another master took the bus                 */
+}I2C_ResultType;
+
+/*
+ * Transfers run back to back from the interrupt, with one call back at the end of
+ * the job. The first failing transfer ends the job, failed is then its index. The
+ * job belongs to the driver from I2C_Submit until its state is I2C_JOB_DONE, the
+ * call back may submit it again.
+ */
+typedef struct I2C_Job
+{
+    const I2C_TransferType *transfers;
+    uint8 count;
+    void (*callBack)(struct I2C_Job *Job);
+    volatile I2C_JobStateType state;
+    I2C_ResultType result;
+    uint8 failed;
+    struct I2C_Job *next;               /* queue link, driver owned                     */
+}I2C_JobType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: I2C_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - I2C module / SysClock - System clock in Hz /
+*                  Speed - SCL frequency in Hz, I2C_SPEED_STANDARD ... I2C_SPEED_FAST_PLUS
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clock the module as a master, set its SCL frequency and
+*              empty its queue. The I2C pins and the NVIC line are configured by the
+*              application.
+**********************************************************************/
+
+void I2C_Init(I2C_ModuleType Module, uint32 SysClock, uint32 Speed);
+
+/*********************************************************************
+* Service Name: I2C_Submit
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - I2C module
+* Parameters (inout): Job - Job, owned by the driver until done
+* Parameters (out): None
+* Return value: boolean - FALSE for an empty job or transfer, or a job already queued
+* Description: Function to queue a job, it starts at once on an idle bus. The handler
+*              starts the next one as soon as the previous one completes.
+**********************************************************************/
+
+boolean I2C_Submit(I2C_ModuleType Module, I2C_JobType *Job);
+
+/*********************************************************************
+* Service Name: I2C_IsIdle
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - I2C module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when no job is queued or running
+* Description: Function to check that the queue of a module is empty.
+**********************************************************************/
+
+boolean I2C_IsIdle(I2C_ModuleType Module);
+
+/*********************************************************************
+* Service Name: I2C_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - I2C module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the master interrupt of a module, raised once per
+*              byte. The vector table entries I2C_I2c0_Handler ... I2C_I2c3_Handler
+*              call it.
+**********************************************************************/
+
+void I2C_Handler(I2C_ModuleType Module);
+
+/* Vector table entries, one per NVIC_I2Cn_IRQ */
+void I2C_I2c0_Handler(void);
+void I2C_I2c1_Handler(void);
+void I2C_I2c2_Handler(void);
+void I2C_I2c3_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* I2C_H_ */
@@ -0,0 +1,166 @@
+/******************************************************************************
+ *
+ * Module: MPU
+ *
+ * File Name: MPU.c
+ *
+ * Description: Source file for the ARM Cortex M4 Memory Protection Unit driver
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "MPU.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* Make the new memory map visible to the following instructions */
+#ifdef __TI_ARM__
+#define MPU_SYNC()     __asm(" DSB\n ISB")
+#else
+#define MPU_SYNC()
+#endif
+
+/*********************************************************************
+* Service Name: MPU_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Regions - Array of pre-encoded regions / Count - Number of regions
+*                  CtrlFlags - MPU_CTRL_PRIVDEFENA and/or MPU_CTRL_HFNMIENA
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE if Count is above MPU_NUMBER_OF_REGIONS, the MPU is left untouched
+* Description: Function to disable the MPU, clear every region, load the given
+*              regions and enable the MPU with the given control flags.
+**********************************************************************/
+boolean MPU_Init(const MPU_RegionType *Regions, uint8 Count, uint32 CtrlFlags){
+
+    uint8 region;
+
+    if(Count > MPU_NUMBER_OF_REGIONS){
+        return FALSE;
+    }
+
+    MPU_Disable();
+
+    for(region = 0; region < MPU_NUMBER_OF_REGIONS; region++){
+
+        MPU_NUMBER_REG = region;    /*select the region then clear its enable bit*/
+        MPU_ATTR_REG   = 0;
+    }
+
+    for(region = 0; region < Count; region++){
+
+        MPU_BASE_REG = Regions[region].base;   /*VALID bit selects the region number*/
+        MPU_ATTR_REG = Regions[region].attr;
+    }
+
+    MPU_Enable(CtrlFlags);
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: MPU_LoadRegions4
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Regions - Four pre-encoded regions
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to load four regions in one burst through the MPU_BASE/ATTR
+*              alias registers (8 stores). Used for per-task reconfiguration.
+**********************************************************************/
+void MPU_LoadRegions4(const MPU_RegionType *Regions){
+
+    MPU_BASE_REG  = Regions[0].base;
+    MPU_ATTR_REG  = Regions[0].attr;
+    MPU_BASE1_REG = Regions[1].base;
+    MPU_ATTR1_REG = Regions[1].attr;
+    MPU_BASE2_REG = Regions[2].base;
+    MPU_ATTR2_REG = Regions[2].attr;
+    MPU_BASE3_REG = Regions[3].base;
+    MPU_ATTR3_REG = Regions[3].attr;
+
+    MPU_SYNC();
+}
+
+/*********************************************************************
+* Service Name: MPU_DisableRegion
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Region - Region number
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to disable a single MPU region.
+**********************************************************************/
+void MPU_DisableRegion(uint8 Region){
+
+    MPU_NUMBER_REG = Region & MPU_BASE_REGION_MASK;
+    MPU_ATTR_REG  &= ~MPU_ATTR_ENABLE;
+
+    MPU_SYNC();
+}
+
+/*********************************************************************
+* Service Name: MPU_Enable
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): CtrlFlags - MPU_CTRL_PRIVDEFENA and/or MPU_CTRL_HFNMIENA
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable the MPU.
+**********************************************************************/
+void MPU_Enable(uint32 CtrlFlags){
+
+    MPU_CTRL_REG = (CtrlFlags & (MPU_CTRL_PRIVDEFENA | MPU_CTRL_HFNMIENA)) | MPU_CTRL_ENABLE;
+
+    MPU_SYNC();
+}
+
+/*********************************************************************
+* Service Name: MPU_Disable
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to disable the MPU.
+**********************************************************************/
+void MPU_Disable(void){
+
+    MPU_SYNC();                 /*complete outstanding accesses under the old map*/
+
+    MPU_CTRL_REG = 0;
+}
+
+/*********************************************************************
+* Service Name: MPU_EncodeRegion
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Region - Region number / Base - Base address / Size - Size in bytes
+*                  Attributes - Access permission, memory type and XN bits
+* Parameters (inout): None
+* Parameters (out): Encoded - Register values for the region
+* Return value: boolean - FALSE if the size is not a power of two >= 32 or the base is misaligned
+* Description: Run-time equivalent of MPU_REGION for regions not known at compile time.
+**********************************************************************/
+boolean MPU_EncodeRegion(uint8 Region, uint32 Base, uint32 Size, uint32 Attributes, MPU_RegionType *Encoded){
+
+    uint32 field = 4;           /*SIZE field of a 32 byte region*/
+
+    if(!MPU_IS_VALID_REGION(Base, Size)){
+        return FALSE;
+    }
+
+    /* The size is a power of two, the region spans 2^(SIZE + 1) bytes */
+    while((MPU_MIN_REGION_SIZE << (field - 4)) != Size){
+        field++;
+    }
+
+    Encoded->base = (Base & MPU_BASE_ADDR_MASK) | MPU_BASE_VALID | (Region & MPU_BASE_REGION_MASK);
+    Encoded->attr = Attributes | (field << MPU_ATTR_SIZE_BITS_POS) | MPU_ATTR_ENABLE;
+
+    return TRUE;
+}
@@ -0,0 +1,235 @@
+/******************************************************************************
+ *
+ * Module: MPU
+ *
+ * File Name: MPU.h
+ *
+ * Description: Header file for the ARM Cortex M4 Memory Protection Unit driver
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef MPU_H_
+#define MPU_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define MPU_NUMBER_OF_REGIONS                8
+#define MPU_REGIONS_PER_BURST                4   /* MPU_BASE/ATTR + 3 alias pairs */
+#define MPU_MIN_REGION_SIZE                  32
+
+/* MPU_CTRL_REG bits */
+#define MPU_CTRL_ENABLE                      0x00000001
+#define MPU_CTRL_HFNMIENA                    0x00000002
+#define MPU_CTRL_PRIVDEFENA                  0x00000004
+
+/* MPU_BASE_REG fields */
+#define MPU_BASE_ADDR_MASK                   0xFFFFFFE0
+#define MPU_BASE_VALID                       0x00000010
+#define MPU_BASE_REGION_MASK                 0x00000007
+
+/* MPU_ATTR_REG fields */
+#define MPU_ATTR_ENABLE                      0x00000001
+#define MPU_ATTR_SIZE_BITS_POS               1
+#define MPU_ATTR_SRD_BITS_POS                8
+#define MPU_ATTR_B                           0x00010000
+#define MPU_ATTR_C                           0x00020000
+#define MPU_ATTR_S                           0x00040000
+#define MPU_ATTR_TEX_BITS_POS                19
+#define MPU_ATTR_AP_BITS_POS                 24
+#define MPU_ATTR_XN                          0x10000000
+
+/* Access permissions (privileged / unprivileged) */
+#define MPU_AP_NO_ACCESS                     (0u << MPU_ATTR_AP_BITS_POS)
+#define MPU_AP_PRIV_RW                       (1u << MPU_ATTR_AP_BITS_POS)
+#define MPU_AP_PRIV_RW_USER_RO               (2u << MPU_ATTR_AP_BITS_POS)
+#define MPU_AP_FULL_ACCESS                   (3u << MPU_ATTR_AP_BITS_POS)
+#define MPU_AP_PRIV_RO                       (5u << MPU_ATTR_AP_BITS_POS)
+#define MPU_AP_READ_ONLY                     (6u << MPU_ATTR_AP_BITS_POS)
+
+/* Memory types (TEX, C, B) */
+#define MPU_MEM_STRONGLY_ORDERED             (0u)
+#define MPU_MEM_DEVICE                       (MPU_ATTR_B)
+#define MPU_MEM_NORMAL_WT                    (MPU_ATTR_C)
+#define MPU_MEM_NORMAL_WB                    (MPU_ATTR_C | MPU_ATTR_B)
+#define MPU_MEM_NORMAL_NON_CACHEABLE         (1u << MPU_ATTR_TEX_BITS_POS)
+#define MPU_MEM_NORMAL_WB_WRITE_ALLOCATE     ((1u << MPU_ATTR_TEX_BITS_POS) | MPU_ATTR_C | MPU_ATTR_B)
+
+/* Region templates */
+#define MPU_TEMPLATE_FLASH_CODE              (MPU_AP_READ_ONLY | MPU_MEM_NORMAL_WT)
+#define MPU_TEMPLATE_FLASH_CONST             (MPU_AP_READ_ONLY | MPU_MEM_NORMAL_WT | MPU_ATTR_XN)
+#define MPU_TEMPLATE_SRAM_DATA               (MPU_AP_FULL_ACCESS | MPU_MEM_NORMAL_WB_WRITE_ALLOCATE | MPU_ATTR_S | MPU_ATTR_XN)
+#define MPU_TEMPLATE_SRAM_CODE               (MPU_AP_FULL_ACCESS | MPU_MEM_NORMAL_WB_WRITE_ALLOCATE | MPU_ATTR_S)
+#define MPU_TEMPLATE_PERIPHERAL              (MPU_AP_FULL_ACCESS | MPU_MEM_DEVICE | MPU_ATTR_S | MPU_ATTR_XN)
+#define MPU_TEMPLATE_PERIPHERAL_PRIV         (MPU_AP_PRIV_RW | MPU_MEM_DEVICE | MPU_ATTR_S | MPU_ATTR_XN)
+#define MPU_TEMPLATE_STACK_GUARD             (MPU_AP_NO_ACCESS | MPU_MEM_NORMAL_WB | MPU_ATTR_XN)
+
+/* Constant 0 that fails to build when Condition is false, for use inside initializers */
+#define MPU_ASSERT_ZERO(Condition)           (0u * sizeof(char[(Condition) ? 1 : -1]))
+
+/* SIZE field value for a power of two region size of 32 bytes up to 2 GB. Size must be
+ * a constant, any other value fails to build instead of being rounded down */
+#define MPU_REGION_SIZE_FIELD(Size)         (MPU_ASSERT_ZERO(MPU_IS_POWER_OF_TWO_SIZE(Size)) + \
+                                            ((Size) >= 0x80000000u ? 30 : \
+                                             (Size) >= 0x40000000u ? 29 : \
+                                             (Size) >= 0x20000000u ? 28 : \
+                                             (Size) >= 0x10000000u ? 27 : \
+                                             (Size) >= 0x08000000u ? 26 : \
+                                             (Size) >= 0x04000000u ? 25 : \
+                                             (Size) >= 0x02000000u ? 24 : \
+                                             (Size) >= 0x01000000u ? 23 : \
+                                             (Size) >= 0x00800000u ? 22 : \
+                                             (Size) >= 0x00400000u ? 21 : \
+                                             (Size) >= 0x00200000u ? 20 : \
+                                             (Size) >= 0x00100000u ? 19 : \
+                                             (Size) >= 0x00080000u ? 18 : \
+                                             (Size) >= 0x00040000u ? 17 : \
+                                             (Size) >= 0x00020000u ? 16 : \
+                                             (Size) >= 0x00010000u ? 15 : \
+                                             (Size) >= 0x00008000u ? 14 : \
+                                             (Size) >= 0x00004000u ? 13 : \
+                                             (Size) >= 0x00002000u ? 12 : \
+                                             (Size) >= 0x00001000u ? 11 : \
+                                             (Size) >= 0x00000800u ? 10 : \
+                                             (Size) >= 0x00000400u ?  9 : \
+                                             (Size) >= 0x00000200u ?  8 : \
+                                             (Size) >= 0x00000100u ?  7 : \
+                                             (Size) >= 0x00000080u ?  6 : \
+                                             (Size) >= 0x00000040u ?  5 : 4))
+
+/* SIZE field value for the whole 4 GB address space */
+#define MPU_REGION_SIZE_FIELD_4GB            31
+
+/* TRUE when Size is a power of two of at least 32 bytes */
+#define MPU_IS_POWER_OF_TWO_SIZE(Size)      (((Size) >= MPU_MIN_REGION_SIZE) && \
+                                             (((Size) & ((Size) - 1u)) == 0u))
+
+/* TRUE when Size is a power of two of at least 32 bytes and Base is aligned to it */
+#define MPU_IS_VALID_REGION(Base, Size)     (MPU_IS_POWER_OF_TWO_SIZE(Size) && \
+                                             (((Base) & ((Size) - 1u)) == 0u))
+
+/* Compile-time check of a region outside an initializer, MPU_REGION does the same */
+#define MPU_CHECK_REGION(Name, Base, Size)   typedef char Name##_mpu_region_check[MPU_IS_VALID_REGION(Base, Size) ? 1 : -1]
+
+/* Register values for a region, usable in static initializers. The base is checked
+ * against the size, a misaligned region fails to build */
+#define MPU_BASE_VALUE(Region, Base, Size)  ((uint32)MPU_ASSERT_ZERO(MPU_IS_VALID_REGION(Base, Size)) + \
+                                             (((uint32)(Base) & MPU_BASE_ADDR_MASK) | MPU_BASE_VALID | ((Region) & MPU_BASE_REGION_MASK)))
+#define MPU_ATTR_VALUE(Size, Attributes)    ((uint32)(Attributes) | ((uint32)(MPU_REGION_SIZE_FIELD(Size)) << MPU_ATTR_SIZE_BITS_POS) | MPU_ATTR_ENABLE)
+
+/* Static initializer of an MPU_RegionType entry, Base and Size must be constants */
+#define MPU_REGION(Region, Base, Size, Attributes)  { MPU_BASE_VALUE(Region, Base, Size), MPU_ATTR_VALUE(Size, Attributes) }
+
+/* Static initializer of an entry that turns a region off */
+#define MPU_REGION_DISABLED(Region)          { MPU_BASE_VALID | ((Region) & MPU_BASE_REGION_MASK), 0 }
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Pre-encoded region, written as is to the MPU_BASE / MPU_ATTR register pair */
+typedef struct
+{
+    uint32 base;
+    uint32 attr;
+} MPU_RegionType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: MPU_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Regions - Array of pre-encoded regions / Count - Number of regions
+*                  CtrlFlags - MPU_CTRL_PRIVDEFENA and/or MPU_CTRL_HFNMIENA
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE if Count is above MPU_NUMBER_OF_REGIONS, the MPU is left untouched
+* Description: Function to disable the MPU, clear every region, load the given
+*              regions and enable the MPU with the given control flags.
+**********************************************************************/
+
+boolean MPU_Init(const MPU_RegionType *Regions, uint8 Count, uint32 CtrlFlags);
+
+/*********************************************************************
+* Service Name: MPU_LoadRegions4
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Regions - Four pre-encoded regions
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to load four regions in one burst through the MPU_BASE/ATTR
+*              alias registers (8 stores). Used for per-task reconfiguration.
+**********************************************************************/
+
+void MPU_LoadRegions4(const MPU_RegionType *Regions);
+
+/*********************************************************************
+* Service Name: MPU_DisableRegion
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Region - Region number
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to disable a single MPU region.
+**********************************************************************/
+
+void MPU_DisableRegion(uint8 Region);
+
+/*********************************************************************
+* Service Name: MPU_Enable
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): CtrlFlags - MPU_CTRL_PRIVDEFENA and/or MPU_CTRL_HFNMIENA
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable the MPU.
+**********************************************************************/
+
+void MPU_Enable(uint32 CtrlFlags);
+
+/*********************************************************************
+* Service Name: MPU_Disable
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to disable the MPU.
+**********************************************************************/
+
+void MPU_Disable(void);
+
+/*********************************************************************
+* Service Name: MPU_EncodeRegion
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Region - Region number / Base - Base address / Size - Size in bytes
+*                  Attributes - Access permission, memory type and XN bits
+* Parameters (inout): None
+* Parameters (out): Encoded - Register values for the region
+* Return value: boolean - FALSE if the size is not a power of two >= 32 or the base is misaligned
+* Description: Run-time equivalent of MPU_REGION for regions not known at compile time.
+**********************************************************************/
+
+boolean MPU_EncodeRegion(uint8 Region, uint32 Base, uint32 Size, uint32 Attributes, MPU_RegionType *Encoded);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* MPU_H_ */
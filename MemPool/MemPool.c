@@ -0,0 +1,238 @@
+/******************************************************************************
+ *
+ * Module: Memory Pool
+ *
+ * File Name: MemPool.c
+ *
+ * Description: Source file for the fixed-block memory pool allocator with size
+ *              classes and O(1) lock-free allocate/free from any interrupt priority
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "MemPool.h"
+#include "Queue.h"               /* Queue_CompareAndSwap, LDREX/STREX on target */
+
+#define MEMPOOL_INDEX_MASK            0x0000FFFF
+#define MEMPOOL_TAG_INCREMENT         0x00010000
+
+/* Free list head: the tag changes on every push and pop so a stale head never matches */
+#define MEMPOOL_HEAD(Tag, Index)      (((Tag) & ~MEMPOOL_INDEX_MASK) | (Index))
+
+static MemPool_PoolType *g_MemPoolClasses[MEMPOOL_MAX_CLASSES];
+static uint8 g_MemPoolClassCount = 0;
+
+/* Statistics counter update, an ISR may update the same counter in between */
+static uint32 MemPool_Add(volatile uint32 *Counter, uint32 Value){
+
+    uint32 old;
+
+    do{
+        old = *Counter;
+    }while(!Queue_CompareAndSwap(Counter, old, old + Value));
+
+    return old + Value;
+}
+
+/* Free list link kept in the first word of a free block, next block index + 1 */
+static volatile uint32 *MemPool_Link(const MemPool_PoolType *Pool, uint32 Index){
+
+    return (volatile uint32 *)(Pool->memory + (Index * Pool->blockSize));
+}
+
+/*********************************************************************
+* Service Name: MemPool_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Pools - Pools sorted by increasing block size / Count - Number of pools
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for too many pools, pools not sorted by size or a
+*                         block size MEMPOOL_DEFINE would not give (unaligned, < 4)
+* Description: Function to link the blocks of every pool into its free list and
+*              register the pools as the size classes of MemPool_Alloc.
+**********************************************************************/
+boolean MemPool_Init(MemPool_PoolType *const *Pools, uint8 Count){
+
+    uint8 i;
+
+    if(Count > MEMPOOL_MAX_CLASSES){
+        return FALSE;
+    }
+
+    for(i = 0; i < Count; i++){
+
+        MemPool_PoolType *pool = Pools[i];
+        uint32 block;
+
+        if((i > 0) && (pool->blockSize < Pools[i - 1]->blockSize)){
+            return FALSE;
+        }
+        if((pool->blockSize < 4) || ((pool->blockSize % MEMPOOL_ALIGNMENT) != 0)){
+            return FALSE;
+        }
+
+        for(block = 0; block < pool->blockCount; block++){
+            *MemPool_Link(pool, block) = ((block + 1) < pool->blockCount) ? (block + 2) : 0;
+        }
+
+        pool->freeHead   = MEMPOOL_HEAD(0, 1);
+        pool->used       = 0;
+        pool->highWater  = 0;
+        pool->allocCount = 0;
+        pool->failCount  = 0;
+
+        g_MemPoolClasses[i] = pool;
+    }
+    g_MemPoolClassCount = Count;
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: MemPool_AllocFrom
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Pool - Pool to take the block from
+* Parameters (out): None
+* Return value: Pointer to the block, NULL_PTR when the pool is empty
+* Description: Function to pop a block, O(1) and lock-free, safe from any ISR.
+**********************************************************************/
+void *MemPool_AllocFrom(MemPool_PoolType *Pool){
+
+    uint32 head;
+    uint32 index;
+    uint32 used;
+    uint32 highWater;
+
+    do{
+        head  = Pool->freeHead;
+        index = head & MEMPOOL_INDEX_MASK;
+
+        if(index == 0){
+
+            (void)MemPool_Add(&Pool->failCount, 1);
+            return NULL_PTR;
+        }
+        /*the link may be stale if the block was taken meanwhile, the tag then fails the swap*/
+    }while(!Queue_CompareAndSwap(&Pool->freeHead, head,
+                                 MEMPOOL_HEAD(head + MEMPOOL_TAG_INCREMENT, *MemPool_Link(Pool, index - 1))));
+
+    used = MemPool_Add(&Pool->used, 1);
+    (void)MemPool_Add(&Pool->allocCount, 1);
+
+    do{
+        highWater = Pool->highWater;
+    }while((used > highWater) && !Queue_CompareAndSwap(&Pool->highWater, highWater, used));
+
+    return Pool->memory + ((index - 1) * Pool->blockSize);
+}
+
+/*********************************************************************
+* Service Name: MemPool_FreeTo
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Block - Block of this pool
+* Parameters (inout): Pool - Pool owning the block
+* Parameters (out): None
+* Return value: None
+* Description: Function to push a block back, O(1) and lock-free, safe from any ISR.
+**********************************************************************/
+void MemPool_FreeTo(MemPool_PoolType *Pool, void *Block){
+
+    uint32 index = (uint32)((uint8 *)Block - Pool->memory) / Pool->blockSize;
+    uint32 head;
+
+    /* Uncounted before the push, a block popped right after it would be counted twice */
+    (void)MemPool_Add(&Pool->used, (uint32)-1);
+
+    do{
+        head = Pool->freeHead;
+        *MemPool_Link(Pool, index) = head & MEMPOOL_INDEX_MASK;
+    }while(!Queue_CompareAndSwap(&Pool->freeHead, head,
+                                 MEMPOOL_HEAD(head + MEMPOOL_TAG_INCREMENT, index + 1)));
+}
+
+/*********************************************************************
+* Service Name: MemPool_Alloc
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Size - Requested bytes
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the block, NULL_PTR when every large enough class is empty
+* Description: Function to allocate from the smallest class that fits, falling back
+*              to the next larger classes. Bounded by the number of classes.
+**********************************************************************/
+void *MemPool_Alloc(uint32 Size){
+
+    uint8 i;
+
+    for(i = 0; i < g_MemPoolClassCount; i++){
+
+        if(g_MemPoolClasses[i]->blockSize >= Size){
+
+            void *block = MemPool_AllocFrom(g_MemPoolClasses[i]);
+            if(block != NULL_PTR){
+                return block;
+            }
+        }
+    }
+
+    return NULL_PTR;
+}
+
+/*********************************************************************
+* Service Name: MemPool_Free
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Block - Block from MemPool_Alloc, NULL_PTR is ignored
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the block belongs to no registered pool
+* Description: Function to return a block to the pool that owns it.
+**********************************************************************/
+boolean MemPool_Free(void *Block){
+
+    uint8 i;
+
+    if(Block == NULL_PTR){
+        return TRUE;
+    }
+
+    for(i = 0; i < g_MemPoolClassCount; i++){
+
+        MemPool_PoolType *pool = g_MemPoolClasses[i];
+        uint8 *start = pool->memory;
+        uint8 *end = start + ((uint32)pool->blockCount * pool->blockSize);
+
+        if(((uint8 *)Block >= start) && ((uint8 *)Block < end)){
+
+            MemPool_FreeTo(pool, Block);
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+/*********************************************************************
+* Service Name: MemPool_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Pool - Pool
+* Parameters (inout): None
+* Parameters (out): Stats - Usage and high-water mark
+* Return value: None
+* Description: Function to read the statistics of a pool.
+**********************************************************************/
+void MemPool_GetStats(const MemPool_PoolType *Pool, MemPool_StatsType *Stats){
+
+    Stats->blockSize  = Pool->blockSize;
+    Stats->blockCount = Pool->blockCount;
+    Stats->used       = Pool->used;
+    Stats->highWater  = Pool->highWater;
+    Stats->allocCount = Pool->allocCount;
+    Stats->failCount  = Pool->failCount;
+}
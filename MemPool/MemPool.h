@@ -0,0 +1,168 @@
+/******************************************************************************
+ *
+ * Module: Memory Pool
+ *
+ * File Name: MemPool.h
+ *
+ * Description: Header file for the fixed-block memory pool allocator with size
+ *              classes and O(1) lock-free allocate/free from any interrupt priority
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef MEMPOOL_H_
+#define MEMPOOL_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of size classes handled by MemPool_Alloc */
+#ifndef MEMPOOL_MAX_CLASSES
+#define MEMPOOL_MAX_CLASSES                  8
+#endif
+
+/* Blocks are 8 byte aligned and hold the free list link while free */
+#define MEMPOOL_ALIGNMENT                    8
+#define MEMPOOL_ROUND_SIZE(Size)             ((((Size) < 4 ? 4 : (Size)) + MEMPOOL_ALIGNMENT - 1) & ~(MEMPOOL_ALIGNMENT - 1))
+
+/* At most 65535 blocks per pool, the free list head keeps a 16 bit ABA tag */
+#define MEMPOOL_MAX_BLOCKS                   0xFFFF
+
+/* Largest block size whose rounded size fits the 16 bit blockSize */
+#define MEMPOOL_MAX_BLOCK_SIZE               0xFFF8
+
+/*
+ * Static pool of BlockCount blocks of BlockSize bytes, declared at file scope:
+ *   MEMPOOL_DEFINE(g_UartPool, 64, 16);
+ * then registered from the smallest class to the largest with MemPool_Init.
+ */
+#define MEMPOOL_DEFINE(Name, BlockSize, BlockCount)                                             \
+    static uint64 Name##_Storage[(MEMPOOL_ROUND_SIZE(BlockSize) / 8) * (BlockCount)];           \
+    typedef char Name##_mempool_count_check[((BlockCount) > 0) && ((BlockCount) <= MEMPOOL_MAX_BLOCKS) ? 1 : -1]; \
+    typedef char Name##_mempool_size_check[((BlockSize) <= MEMPOOL_MAX_BLOCK_SIZE) ? 1 : -1];  \
+    MemPool_PoolType Name = { (uint8 *)Name##_Storage, MEMPOOL_ROUND_SIZE(BlockSize), (BlockCount), 0, 0, 0, 0, 0 }
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Pool descriptor, initialize it with MEMPOOL_DEFINE only */
+typedef struct
+{
+    uint8 *memory;
+    uint16 blockSize;
+    uint16 blockCount;
+    volatile uint32 freeHead;           /* ABA tag << 16 | (first free block + 1), 0 when empty */
+    volatile uint32 used;
+    volatile uint32 highWater;
+    volatile uint32 allocCount;
+    volatile uint32 failCount;
+} MemPool_PoolType;
+
+typedef struct
+{
+    uint16 blockSize;
+    uint16 blockCount;
+    uint32 used;
+    uint32 highWater;                   /* most blocks in use at the same time */
+    uint32 allocCount;
+    uint32 failCount;                   /* requests that found the pool empty  */
+} MemPool_StatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: MemPool_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Pools - Pools sorted by increasing block size / Count - Number of pools
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for too many pools, pools not sorted by size or a
+*                         block size MEMPOOL_DEFINE would not give (unaligned, < 4)
+* Description: Function to link the blocks of every pool into its free list and
+*              register the pools as the size classes of MemPool_Alloc.
+**********************************************************************/
+
+boolean MemPool_Init(MemPool_PoolType *const *Pools, uint8 Count);
+
+/*********************************************************************
+* Service Name: MemPool_Alloc
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Size - Requested bytes
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the block, NULL_PTR when every large enough class is empty
+* Description: Function to allocate from the smallest class that fits, falling back
+*              to the next larger classes. Bounded by the number of classes.
+**********************************************************************/
+
+void *MemPool_Alloc(uint32 Size);
+
+/*********************************************************************
+* Service Name: MemPool_Free
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Block - Block from MemPool_Alloc, NULL_PTR is ignored
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE when the block belongs to no registered pool
+* Description: Function to return a block to the pool that owns it.
+**********************************************************************/
+
+boolean MemPool_Free(void *Block);
+
+/*********************************************************************
+* Service Name: MemPool_AllocFrom
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Pool - Pool to take the block from
+* Parameters (out): None
+* Return value: Pointer to the block, NULL_PTR when the pool is empty
+* Description: Function to pop a block, O(1) and lock-free, safe from any ISR.
+**********************************************************************/
+
+void *MemPool_AllocFrom(MemPool_PoolType *Pool);
+
+/*********************************************************************
+* Service Name: MemPool_FreeTo
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Block - Block of this pool
+* Parameters (inout): Pool - Pool owning the block
+* Parameters (out): None
+* Return value: None
+* Description: Function to push a block back, O(1) and lock-free, safe from any ISR.
+**********************************************************************/
+
+void MemPool_FreeTo(MemPool_PoolType *Pool, void *Block);
+
+/*********************************************************************
+* Service Name: MemPool_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Pool - Pool
+* Parameters (inout): None
+* Parameters (out): Stats - Usage and high-water mark
+* Return value: None
+* Description: Function to read the statistics of a pool.
+**********************************************************************/
+
+void MemPool_GetStats(const MemPool_PoolType *Pool, MemPool_StatsType *Stats);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* MEMPOOL_H_ */
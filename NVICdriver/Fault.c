@@ -0,0 +1,267 @@
+/******************************************************************************
+ *
+ * Module: Fault
+ *
+ * File Name: Fault.c
+ *
+ * Description: Source file for the TM4C123GH6PM fault capture and crash record driver
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Fault.h"
+#include "NVIC.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* Magic left in the record after it was printed, so the reset counter survives */
+#define FAULT_RECORD_CLEARED_MAGIC     0xFA01C1EA
+
+/* Address of a pointer as the 32-bit value the target sees (the host pointers are wider) */
+#define FAULT_ADDRESS(Ptr)             ((uint32)(unsigned long)(Ptr))
+
+/* Crash record in the .noinit section, the C start-up code does not clear it */
+#ifdef __TI_ARM__
+#pragma DATA_SECTION(g_FaultRecord, ".noinit")
+#endif
+static Fault_RecordType g_FaultRecord;
+
+/* Checksum over every word of the record except the checksum itself */
+static uint32 Fault_Checksum(const Fault_RecordType *Record){
+
+    const uint32 *word = (const uint32 *)Record;
+    uint32 count = (sizeof(Fault_RecordType) / sizeof(uint32)) - 1;
+    uint32 sum = 0x5A5A5A5A;
+
+    while(count--){
+
+        sum = ((sum << 5) | (sum >> 27)) ^ *word++;   /*rotate then mix the next word*/
+    }
+    return sum;
+}
+
+/* TRUE when Words words from Address are aligned and inside the SRAM */
+static boolean Fault_InSram(uint32 Address, uint32 Words){
+
+    return (((Address & 0x3) == 0) && (Address >= FAULT_SRAM_START) &&
+            (Address <= FAULT_SRAM_END) && ((FAULT_SRAM_END - Address) >= (Words * 4))) ? TRUE : FALSE;
+}
+
+/* Format Value as "0xXXXXXXXX" into Buffer (at least 11 characters) */
+static void Fault_FormatHex(uint32 Value, char *Buffer){
+
+    const char digits[] = "0123456789ABCDEF";
+    uint8 i;
+
+    Buffer[0] = '0';
+    Buffer[1] = 'x';
+    for(i = 0; i < 8; i++){
+
+        Buffer[9 - i] = digits[Value & 0xF];
+        Value >>= 4;
+    }
+    Buffer[10] = '\0';
+}
+
+static void Fault_PrintField(Fault_PrintFuncType PrintFunc, const char *Name, uint32 Value){
+
+    char hex[11];
+
+    Fault_FormatHex(Value, hex);
+    PrintFunc(Name);
+    PrintFunc(hex);
+    PrintFunc("\r\n");
+}
+
+/*********************************************************************
+* Service Name: Fault_Capture
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): StackFrame - Pointer to the stacked register frame
+*                  ExcReturn - EXC_RETURN value from LR at fault entry
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to save the crash record in no-init RAM and reset the system.
+**********************************************************************/
+void Fault_Capture(const uint32 *StackFrame, uint32 ExcReturn){
+
+    static const Fault_StackFrameType noFrame = { 0 };
+    Fault_RecordType *record = &g_FaultRecord;
+    const uint32 *words;
+    uint32 stack;
+    uint8 i;
+
+    /* Keep counting fault resets as long as the previous record was consumed */
+    if(record->magic == FAULT_RECORD_CLEARED_MAGIC){
+
+        record->resetCount++;
+    }
+    else{
+
+        record->resetCount = 1;
+    }
+
+    /* A corrupted SP must not fault again inside the handler */
+    if(Fault_InSram(FAULT_ADDRESS(StackFrame), FAULT_BASIC_FRAME_WORDS)){
+        record->frame = *(const Fault_StackFrameType *)StackFrame;
+    }
+    else{
+        record->frame = noFrame;
+    }
+    record->cfsr       = NVIC_SYSTEM_FAULTSTAT;
+    record->hfsr       = NVIC_SYSTEM_HFAULTSTAT;
+    record->mmfar      = NVIC_SYSTEM_MMADDR;
+    record->bfar       = NVIC_SYSTEM_FAULTADDR;
+    record->excReturn  = ExcReturn;
+    record->activeVector = (uint8)(NVIC_SYSTEM_INTCTRL & FAULT_INTCTRL_VECACT_MASK);
+
+    /* The stack in use before the fault starts right after the stacked frame */
+    stack = FAULT_ADDRESS(StackFrame);
+    if(ExcReturn & FAULT_EXC_RETURN_FTYPE_MASK){
+
+        stack += FAULT_BASIC_FRAME_WORDS * 4;
+    }
+    else{
+
+        stack += FAULT_EXTENDED_FRAME_WORDS * 4;
+    }
+    if(record->frame.xpsr & FAULT_XPSR_STKALIGN_MASK){
+
+        stack += 4;                     /*padding word pushed to 8-byte align the frame*/
+    }
+    record->stackPointer = stack;
+    words = StackFrame + ((stack - FAULT_ADDRESS(StackFrame)) / 4);
+
+    record->snapshotWords = 0;
+    for(i = 0; i < FAULT_STACK_SNAPSHOT_WORDS; i++){
+
+        /*never read past the end of SRAM*/
+        if(!Fault_InSram(stack + (4 * i), 1)){
+            break;
+        }
+        record->stackSnapshot[i] = words[i];
+        record->snapshotWords++;
+    }
+
+    Fault_EncodeRecord(record);
+
+    /* Request a system reset, the record is decoded by Fault_Init on the next boot */
+    NVIC_SYSTEM_APINT = FAULT_APINT_VECTKEY | FAULT_APINT_SYSRESETREQ;
+
+#ifdef __TI_ARM__
+    while(1){}    /*wait for the reset to take effect*/
+#endif
+}
+
+/*********************************************************************
+* Service Name: Fault_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): PrintFunc - Output function for the previous crash record, or NULL_PTR
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE if the last reset was caused by a captured fault
+* Description: Function to decode and print the crash record left by the previous
+*              boot, clear it and enable the memory, bus and usage fault handlers.
+**********************************************************************/
+boolean Fault_Init(Fault_PrintFuncType PrintFunc){
+
+    boolean faulted = Fault_DecodeRecord(&g_FaultRecord);
+
+    if(faulted){
+
+        if(PrintFunc != NULL_PTR){
+            Fault_PrintRecord(&g_FaultRecord, PrintFunc);
+        }
+        g_FaultRecord.magic = FAULT_RECORD_CLEARED_MAGIC;   /*consume the record, keep the counter*/
+    }
+    else if(g_FaultRecord.magic != FAULT_RECORD_CLEARED_MAGIC){
+
+        g_FaultRecord.resetCount = 0;                       /*power-on reset, RAM content is random*/
+        g_FaultRecord.magic = FAULT_RECORD_CLEARED_MAGIC;
+    }
+
+    /* Route configurable faults to their own vectors instead of escalating to hard fault */
+    NVIC_EnableException(EXCEPTION_MEM_FAULT_TYPE);
+    NVIC_EnableException(EXCEPTION_BUS_FAULT_TYPE);
+    NVIC_EnableException(EXCEPTION_USAGE_FAULT_TYPE);
+
+    return faulted;
+}
+
+/*********************************************************************
+* Service Name: Fault_EncodeRecord
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Record - Crash record to seal
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the magic number and checksum of a crash record.
+**********************************************************************/
+void Fault_EncodeRecord(Fault_RecordType *Record){
+
+    Record->magic = FAULT_RECORD_MAGIC;
+    Record->checksum = Fault_Checksum(Record);
+}
+
+/*********************************************************************
+* Service Name: Fault_DecodeRecord
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Record - Crash record to validate
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE if the magic number and checksum are valid
+* Description: Function to validate a crash record read back after reset.
+**********************************************************************/
+boolean Fault_DecodeRecord(const Fault_RecordType *Record){
+
+    if(Record->magic != FAULT_RECORD_MAGIC){
+        return FALSE;
+    }
+    if(Record->snapshotWords > FAULT_STACK_SNAPSHOT_WORDS){
+        return FALSE;
+    }
+    return (Record->checksum == Fault_Checksum(Record)) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+* Service Name: Fault_PrintRecord
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Record - Crash record / PrintFunc - Output function
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to print a human readable dump of a crash record.
+**********************************************************************/
+void Fault_PrintRecord(const Fault_RecordType *Record, Fault_PrintFuncType PrintFunc){
+
+    uint8 i;
+
+    PrintFunc("*** Fault reset ***\r\n");
+    Fault_PrintField(PrintFunc, "resets: ", Record->resetCount);
+    Fault_PrintField(PrintFunc, "vector: ", Record->activeVector);
+    if(Record->activeVector >= FAULT_FIRST_IRQ_VECTOR){
+        Fault_PrintField(PrintFunc, "irq:    ", Record->activeVector - FAULT_FIRST_IRQ_VECTOR);
+    }
+    Fault_PrintField(PrintFunc, "pc:     ", Record->frame.pc);
+    Fault_PrintField(PrintFunc, "lr:     ", Record->frame.lr);
+    Fault_PrintField(PrintFunc, "xpsr:   ", Record->frame.xpsr);
+    Fault_PrintField(PrintFunc, "r0:     ", Record->frame.r0);
+    Fault_PrintField(PrintFunc, "r1:     ", Record->frame.r1);
+    Fault_PrintField(PrintFunc, "r2:     ", Record->frame.r2);
+    Fault_PrintField(PrintFunc, "r3:     ", Record->frame.r3);
+    Fault_PrintField(PrintFunc, "r12:    ", Record->frame.r12);
+    Fault_PrintField(PrintFunc, "cfsr:   ", Record->cfsr);
+    Fault_PrintField(PrintFunc, "hfsr:   ", Record->hfsr);
+    Fault_PrintField(PrintFunc, "mmfar:  ", Record->mmfar);
+    Fault_PrintField(PrintFunc, "bfar:   ", Record->bfar);
+    Fault_PrintField(PrintFunc, "excret: ", Record->excReturn);
+    Fault_PrintField(PrintFunc, "sp:     ", Record->stackPointer);
+
+    for(i = 0; i < Record->snapshotWords; i++){
+        Fault_PrintField(PrintFunc, "stack:  ", Record->stackSnapshot[i]);
+    }
+}
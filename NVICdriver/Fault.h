@@ -0,0 +1,180 @@
+/******************************************************************************
+ *
+ * Module: Fault
+ *
+ * File Name: Fault.h
+ *
+ * Description: Header file for the TM4C123GH6PM fault capture and crash record driver
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef FAULT_H_
+#define FAULT_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define FAULT_RECORD_MAGIC                   0xFA017EC0
+#define FAULT_STACK_SNAPSHOT_WORDS           8
+
+/* Number of words pushed by the hardware on exception entry */
+#define FAULT_BASIC_FRAME_WORDS              8
+#define FAULT_EXTENDED_FRAME_WORDS           26
+
+/* EXC_RETURN bit that is cleared when the FPU extended frame was stacked */
+#define FAULT_EXC_RETURN_FTYPE_MASK          0x00000010
+
+/* Stacked xPSR bit set when the processor pushed a padding word to align the frame */
+#define FAULT_XPSR_STKALIGN_MASK             0x00000200
+
+/* APINT write key and system reset request */
+#define FAULT_APINT_VECTKEY                  0x05FA0000
+#define FAULT_APINT_SYSRESETREQ              0x00000004
+
+/* VECACT field of the Interrupt Control and State register */
+#define FAULT_INTCTRL_VECACT_MASK            0x000000FF
+
+/* Exception numbers below this value are system exceptions, not IRQs */
+#define FAULT_FIRST_IRQ_VECTOR               16
+
+/* Bounds used to keep the stacked frame and the snapshot inside the SRAM */
+#define FAULT_SRAM_START                     0x20000000
+#define FAULT_SRAM_END                       0x20008000
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Register frame pushed by the processor on exception entry */
+typedef struct
+{
+    uint32 r0;
+    uint32 r1;
+    uint32 r2;
+    uint32 r3;
+    uint32 r12;
+    uint32 lr;
+    uint32 pc;
+    uint32 xpsr;
+} Fault_StackFrameType;
+
+/* Compact crash record kept in the no-init RAM region across the reset */
+typedef struct
+{
+    uint32 magic;
+    Fault_StackFrameType frame;
+    uint32 cfsr;                /* Configurable Fault Status (FAULTSTAT) */
+    uint32 hfsr;                /* Hard Fault Status (HFAULTSTAT)        */
+    uint32 mmfar;               /* Memory Management Fault Address       */
+    uint32 bfar;                /* Bus Fault Address                     */
+    uint32 excReturn;           /* EXC_RETURN value at fault entry       */
+    uint32 stackPointer;        /* SP value before the frame was pushed  */
+    uint8  activeVector;        /* Active exception number (VECACT)      */
+    uint8  snapshotWords;       /* Valid words in stackSnapshot          */
+    uint16 resetCount;          /* Number of fault resets since power-up */
+    uint32 stackSnapshot[FAULT_STACK_SNAPSHOT_WORDS];
+    uint32 checksum;
+} Fault_RecordType;
+
+/* Output function used by the decoder, writes one null terminated string */
+typedef void (*Fault_PrintFuncType)(const char *String);
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Fault_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Assembly entry for NMI, hard, memory, bus and usage faults and
+*              unexpected interrupts, placed directly in their vector table slots.
+*              Selects MSP or PSP and calls Fault_Capture.
+**********************************************************************/
+
+void Fault_Handler(void);
+
+/*********************************************************************
+* Service Name: Fault_Capture
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): StackFrame - Pointer to the stacked register frame
+*                  ExcReturn - EXC_RETURN value from LR at fault entry
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to save the crash record in no-init RAM and reset the system.
+**********************************************************************/
+
+void Fault_Capture(const uint32 *StackFrame, uint32 ExcReturn);
+
+/*********************************************************************
+* Service Name: Fault_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): PrintFunc - Output function for the previous crash record, or NULL_PTR
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE if the last reset was caused by a captured fault
+* Description: Function to decode and print the crash record left by the previous
+*              boot, clear it and enable the memory, bus and usage fault handlers.
+**********************************************************************/
+
+boolean Fault_Init(Fault_PrintFuncType PrintFunc);
+
+/*********************************************************************
+* Service Name: Fault_EncodeRecord
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): Record - Crash record to seal
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the magic number and checksum of a crash record.
+**********************************************************************/
+
+void Fault_EncodeRecord(Fault_RecordType *Record);
+
+/*********************************************************************
+* Service Name: Fault_DecodeRecord
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Record - Crash record to validate
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE if the magic number and checksum are valid
+* Description: Function to validate a crash record read back after reset.
+**********************************************************************/
+
+boolean Fault_DecodeRecord(const Fault_RecordType *Record);
+
+/*********************************************************************
+* Service Name: Fault_PrintRecord
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Record - Crash record / PrintFunc - Output function
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to print a human readable dump of a crash record.
+**********************************************************************/
+
+void Fault_PrintRecord(const Fault_RecordType *Record, Fault_PrintFuncType PrintFunc);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* FAULT_H_ */
@@ -0,0 +1,34 @@
+;******************************************************************************
+;
+; Module: Fault
+;
+; File Name: Fault_Entry.asm
+;
+; Description: Assembly entry point of the TM4C123GH6PM fault capture driver
+;
+; Author: Abdelrahman Hussien
+;
+;******************************************************************************
+
+        .thumb
+        .text
+
+        .global Fault_Handler
+        .global Fault_Capture
+
+;******************************************************************************
+; Fault_Handler
+; Bit 2 of EXC_RETURN tells which stack the processor pushed the register frame
+; on. Pass that stack pointer and EXC_RETURN to Fault_Capture, which never
+; returns, so nothing else needs to be saved here.
+;******************************************************************************
+Fault_Handler: .asmfunc
+        TST     LR, #4
+        ITE     EQ
+        MRSEQ   R0, MSP
+        MRSNE   R0, PSP
+        MOV     R1, LR
+        B.W     Fault_Capture
+        .endasmfunc
+
+        .end
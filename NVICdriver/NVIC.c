@@ -23,30 +23,30 @@
 * Return value: None
 * Description: Function to enable Interrupt request for specific IRQ
 **********************************************************************/
-void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num){
+RAMFUNC void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num){
 
     uint8 bit;
     bit = IRQ_Num % 32;    /*to know which bit i will enable it*/
 
     if(IRQ_Num < 32){
 
-        NVIC_EN0_REG  |= (1<<bit);
+        NVIC_EN0_REG  = (1UL<<bit);      /*write 1 to set, zeros have no effect*/
     }
     else if(IRQ_Num < 64){
 
-        NVIC_EN1_REG  |= (1<<bit);
+        NVIC_EN1_REG  = (1UL<<bit);      /*write 1 to set, zeros have no effect*/
     }
     else if(IRQ_Num < 96){
 
-        NVIC_EN2_REG  |= (1<<bit);
+        NVIC_EN2_REG  = (1UL<<bit);      /*write 1 to set, zeros have no effect*/
     }
     else if (IRQ_Num < 128) {
 
-        NVIC_EN3_REG  |= (1<<bit);
+        NVIC_EN3_REG  = (1UL<<bit);      /*write 1 to set, zeros have no effect*/
     }
     else{
 
-        NVIC_EN4_REG  |=(1<<bit);
+        NVIC_EN4_REG  = (1UL<<bit);      /*write 1 to set, zeros have no effect*/
     }
 
 
@@ -62,30 +62,30 @@ void NVIC_EnableIRQ(NVIC_IRQType IRQ_Num){
 * Return value: None
 * Description: Function to disable Interrupt request for specific IRQ
 **********************************************************************/
-void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num){
+RAMFUNC void NVIC_DisableIRQ(NVIC_IRQType IRQ_Num){
 
     uint8 bitNum;
     bitNum = IRQ_Num % 32;      /*to know which bit i will disable it*/
 
     if(IRQ_Num < 32){
 
-        NVIC_DIS0_REG  |= (1<<bitNum);
+        NVIC_DIS0_REG = (1UL<<bitNum);  /*write 1 to clear, a read-modify-write would disable all*/
     }
     else if(IRQ_Num < 64){
 
-        NVIC_DIS1_REG  |= (1<<bitNum);
+        NVIC_DIS1_REG = (1UL<<bitNum);  /*write 1 to clear, a read-modify-write would disable all*/
     }
     else if(IRQ_Num < 96){
 
-        NVIC_DIS2_REG  |= (1<<bitNum);
+        NVIC_DIS2_REG = (1UL<<bitNum);  /*write 1 to clear, a read-modify-write would disable all*/
     }
     else if (IRQ_Num < 128) {
 
-        NVIC_DIS3_REG  |= (1<<bitNum);
+        NVIC_DIS3_REG = (1UL<<bitNum);  /*write 1 to clear, a read-modify-write would disable all*/
     }
     else{
 
-        NVIC_DIS4_REG  |= (1<<bitNum);
+        NVIC_DIS4_REG = (1UL<<bitNum);  /*write 1 to clear, a read-modify-write would disable all*/
     }
 }
 /*********************************************************************
@@ -103,9 +103,7 @@ void NVIC_SetPriorityIRQ(NVIC_IRQType IRQ_Num,NVIC_IRQPriorityType IRQ_Priority)
     uint8 offset = IRQ_Num / 4 ;         /*Calculate the offset to know PRIn*/
     uint8 bit  = ((IRQ_Num % 4)*8) + 5;  /*Calculate the bit number to set the priority*/
 
-    volatile uint32 *interruptAddress = (NVIC_PRI0_REG + offset);
-
-    *interruptAddress |= (IRQ_Priority<<bit);
+    NVIC_PRI_REG(offset) = (NVIC_PRI_REG(offset) & ~(0x7UL<<bit)) | ((uint32)(IRQ_Priority & 0x7)<<bit);
 
 }
 
@@ -199,43 +197,43 @@ void NVIC_SetPriorityException(NVIC_ExceptionType Exception_Num, NVIC_ExceptionP
        if (Exception_Num == EXCEPTION_MEM_FAULT_TYPE){
 
            /* Assign priority to memory management fault */
-           NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & MEM_FAULT_PRIORITY_MASK) | (Exception_Priority << MEM_FAULT_PRIORITY_BITS_POS);
+           NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & ~MEM_FAULT_PRIORITY_MASK) | (((uint32)Exception_Priority & 0x7) << MEM_FAULT_PRIORITY_BITS_POS);
 
        }
        else if (Exception_Num == EXCEPTION_BUS_FAULT_TYPE){
 
            /* Assign priority to BUS fault */
-           NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & BUS_FAULT_PRIORITY_MASK) | (Exception_Priority << BUS_FAULT_PRIORITY_BITS_POS);
+           NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & ~BUS_FAULT_PRIORITY_MASK) | (((uint32)Exception_Priority & 0x7) << BUS_FAULT_PRIORITY_BITS_POS);
 
        }
        else if (Exception_Num == EXCEPTION_USAGE_FAULT_TYPE){
 
            /* Assign priority to USAGE fault */
-           NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & USAGE_FAULT_PRIORITY_MASK) | (Exception_Priority << USAGE_FAULT_PRIORITY_BITS_POS);
+           NVIC_SYSTEM_PRI1_REG = (NVIC_SYSTEM_PRI1_REG & ~USAGE_FAULT_PRIORITY_MASK) | (((uint32)Exception_Priority & 0x7) << USAGE_FAULT_PRIORITY_BITS_POS);
 
        }
        else if (Exception_Num == EXCEPTION_SVC_TYPE){
 
            /* Assign priority to SVC */
-           NVIC_SYSTEM_PRI2_REG = (NVIC_SYSTEM_PRI2_REG & SVC_PRIORITY_MASK) | (Exception_Priority << SVC_PRIORITY_BITS_POS);
+           NVIC_SYSTEM_PRI2_REG = (NVIC_SYSTEM_PRI2_REG & ~SVC_PRIORITY_MASK) | (((uint32)Exception_Priority & 0x7) << SVC_PRIORITY_BITS_POS);
 
        }
        else if (Exception_Num == EXCEPTION_PEND_SV_TYPE){
 
            /* Assign priority to PENDSV */
-           NVIC_SYSTEM_PRI3_REG =  (NVIC_SYSTEM_PRI3_REG & PENDSV_PRIORITY_MASK) | (Exception_Priority << PENDSV_PRIORITY_BITS_POS);
+           NVIC_SYSTEM_PRI3_REG =  (NVIC_SYSTEM_PRI3_REG & ~PENDSV_PRIORITY_MASK) | (((uint32)Exception_Priority & 0x7) << PENDSV_PRIORITY_BITS_POS);
 
        }
        else if (Exception_Num == EXCEPTION_SYSTICK_TYPE){
 
            /* Assign priority to SysTick timer */
-           NVIC_SYSTEM_PRI3_REG =  (NVIC_SYSTEM_PRI3_REG & SYSTICK_PRIORITY_MASK) | (Exception_Priority << SYSTICK_PRIORITY_BITS_POS );
+           NVIC_SYSTEM_PRI3_REG =  (NVIC_SYSTEM_PRI3_REG & ~SYSTICK_PRIORITY_MASK) | (((uint32)Exception_Priority & 0x7) << SYSTICK_PRIORITY_BITS_POS);
 
        }
        else if (Exception_Num == EXCEPTION_DEBUG_MONITOR_TYPE) {
 
            /* Assign priority to Debug Monitor */
-           NVIC_SYSTEM_PRI3_REG =  (NVIC_SYSTEM_PRI3_REG & DEBUG_MONITOR_PRIORITY_MASK) | (Exception_Priority << DEBUG_MONITOR_PRIORITY_BITS_POS);
+           NVIC_SYSTEM_PRI3_REG =  (NVIC_SYSTEM_PRI3_REG & ~DEBUG_MONITOR_PRIORITY_MASK) | (((uint32)Exception_Priority & 0x7) << DEBUG_MONITOR_PRIORITY_BITS_POS);
     }
 
 }
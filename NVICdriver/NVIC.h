@@ -19,6 +19,10 @@
  *******************************************************************************/
 #include "std_types.h"
 
+#ifdef HOST_SIMULATION
+#include "HostRegisters.h"
+#endif
+
 /*******************************************************************************
  *                           Preprocessor Definitions                          *
  *******************************************************************************/
@@ -48,6 +52,16 @@
 #define BUS_FAULT_ENABLE_MASK                0x00020000
 #define USAGE_FAULT_ENABLE_MASK              0x00040000
 
+#ifdef HOST_SIMULATION
+
+/* Host build: PRIMASK and FAULTMASK are simulated in HostRegisters.c */
+#define Enable_Exceptions()    HostReg_SetPrimask(FALSE)
+#define Disable_Exceptions()   HostReg_SetPrimask(TRUE)
+#define Enable_Faults()        HostReg_SetFaultmask(FALSE)
+#define Disable_Faults()       HostReg_SetFaultmask(TRUE)
+
+#else
+
 /* Enable Exceptions ... This Macro enable IRQ interrupts, Programmable Systems Exceptions and Faults by clearing the I-bit in the PRIMASK. */
 #define Enable_Exceptions()    __asm(" CPSIE I ")
 
@@ -60,6 +74,8 @@
 /* Disable Faults ... This Macro disable Faults by setting the F-bit in the FAULTMASK */
 #define Disable_Faults()       __asm(" CPSID F ")
 
+#endif
+
 
 
 /*******************************************************************************
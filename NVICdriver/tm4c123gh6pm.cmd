@@ -34,12 +34,22 @@ SECTIONS
     .cinit  :   > FLASH
     .pinit  :   > FLASH
     .init_array : > FLASH
+    .binit  :   > FLASH
+
+    /* Code tagged with RAMFUNC (see std_types.h) is stored in FLASH and     */
+    /* copied to SRAM by the boot routine through the BINIT copy table, so   */
+    /* it executes without flash wait states.                                */
+    .ramfunc :  load = FLASH, run = SRAM, table(BINIT),
+                LOAD_START(__ramfunc_load_start),
+                RUN_START(__ramfunc_run_start),
+                SIZE(__ramfunc_size)
 
     .vtable :   > 0x20000000
     .data   :   > SRAM
     .bss    :   > SRAM
     .sysmem :   > SRAM
     .stack  :   > SRAM
+    .noinit :   > SRAM, type = NOINIT   /* Fault crash record, kept across resets */
 }
 
 __STACK_TOP = __stack + 512;
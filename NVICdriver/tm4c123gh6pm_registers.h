@@ -3,439 +3,769 @@
 
 #include "std_types.h"
 
+/*****************************************************************************
+Register access
+On target every register is a fixed address. With HOST_SIMULATION defined the
+address is mapped onto the simulated register file in HostRegisters.c.
+*****************************************************************************/
+#ifdef HOST_SIMULATION
+#include "HostRegisters.h"
+#define HW_REG(Address)           (*HostReg_Access(Address))
+#else
+#define HW_REG(Address)           (*((volatile uint32 *)(Address)))
+#endif
+
 /*****************************************************************************
 GPIO registers (PORTA)
 *****************************************************************************/
-#define GPIO_PORTA_DATA_REG       (*((volatile uint32 *)0x400043FC))
-#define GPIO_PORTA_DIR_REG        (*((volatile uint32 *)0x40004400))
-#define GPIO_PORTA_AFSEL_REG      (*((volatile uint32 *)0x40004420))
-#define GPIO_PORTA_PUR_REG        (*((volatile uint32 *)0x40004510))
-#define GPIO_PORTA_PDR_REG        (*((volatile uint32 *)0x40004514))
-#define GPIO_PORTA_DEN_REG        (*((volatile uint32 *)0x4000451C))
-#define GPIO_PORTA_LOCK_REG       (*((volatile uint32 *)0x40004520))
-#define GPIO_PORTA_CR_REG         (*((volatile uint32 *)0x40004524))
-#define GPIO_PORTA_AMSEL_REG      (*((volatile uint32 *)0x40004528))
-#define GPIO_PORTA_PCTL_REG       (*((volatile uint32 *)0x4000452C))
+#define GPIO_PORTA_DATA_REG       HW_REG(0x400043FC)
+#define GPIO_PORTA_DIR_REG        HW_REG(0x40004400)
+#define GPIO_PORTA_AFSEL_REG      HW_REG(0x40004420)
+#define GPIO_PORTA_PUR_REG        HW_REG(0x40004510)
+#define GPIO_PORTA_PDR_REG        HW_REG(0x40004514)
+#define GPIO_PORTA_DEN_REG        HW_REG(0x4000451C)
+#define GPIO_PORTA_LOCK_REG       HW_REG(0x40004520)
+#define GPIO_PORTA_CR_REG         HW_REG(0x40004524)
+#define GPIO_PORTA_AMSEL_REG      HW_REG(0x40004528)
+#define GPIO_PORTA_PCTL_REG       HW_REG(0x4000452C)
 
 /* PORTA External Interrupts Registers */
-#define GPIO_PORTA_IS_REG         (*((volatile uint32 *)0x40004404))
-#define GPIO_PORTA_IBE_REG        (*((volatile uint32 *)0x40004408))
-#define GPIO_PORTA_IEV_REG        (*((volatile uint32 *)0x4000440C))
-#define GPIO_PORTA_IM_REG         (*((volatile uint32 *)0x40004410))
-#define GPIO_PORTA_RIS_REG        (*((volatile uint32 *)0x40004414))
-#define GPIO_PORTA_ICR_REG        (*((volatile uint32 *)0x4000441C))
+#define GPIO_PORTA_IS_REG         HW_REG(0x40004404)
+#define GPIO_PORTA_IBE_REG        HW_REG(0x40004408)
+#define GPIO_PORTA_IEV_REG        HW_REG(0x4000440C)
+#define GPIO_PORTA_IM_REG         HW_REG(0x40004410)
+#define GPIO_PORTA_RIS_REG        HW_REG(0x40004414)
+#define GPIO_PORTA_ICR_REG        HW_REG(0x4000441C)
 
 /*****************************************************************************
 GPIO registers (PORTB)
 *****************************************************************************/
-#define GPIO_PORTB_DATA_REG       (*((volatile uint32 *)0x400053FC))
-#define GPIO_PORTB_DIR_REG        (*((volatile uint32 *)0x40005400))
-#define GPIO_PORTB_AFSEL_REG      (*((volatile uint32 *)0x40005420))
-#define GPIO_PORTB_PUR_REG        (*((volatile uint32 *)0x40005510))
-#define GPIO_PORTB_PDR_REG        (*((volatile uint32 *)0x40005514))
-#define GPIO_PORTB_DEN_REG        (*((volatile uint32 *)0x4000551C))
-#define GPIO_PORTB_LOCK_REG       (*((volatile uint32 *)0x40005520))
-#define GPIO_PORTB_CR_REG         (*((volatile uint32 *)0x40005524))
-#define GPIO_PORTB_AMSEL_REG      (*((volatile uint32 *)0x40005528))
-#define GPIO_PORTB_PCTL_REG       (*((volatile uint32 *)0x4000552C))
+#define GPIO_PORTB_DATA_REG       HW_REG(0x400053FC)
+#define GPIO_PORTB_DIR_REG        HW_REG(0x40005400)
+#define GPIO_PORTB_AFSEL_REG      HW_REG(0x40005420)
+#define GPIO_PORTB_PUR_REG        HW_REG(0x40005510)
+#define GPIO_PORTB_PDR_REG        HW_REG(0x40005514)
+#define GPIO_PORTB_DEN_REG        HW_REG(0x4000551C)
+#define GPIO_PORTB_LOCK_REG       HW_REG(0x40005520)
+#define GPIO_PORTB_CR_REG         HW_REG(0x40005524)
+#define GPIO_PORTB_AMSEL_REG      HW_REG(0x40005528)
+#define GPIO_PORTB_PCTL_REG       HW_REG(0x4000552C)
 
 /* PORTB External Interrupts Registers */
-#define GPIO_PORTB_IS_REG         (*((volatile uint32 *)0x40005404))
-#define GPIO_PORTB_IBE_REG        (*((volatile uint32 *)0x40005408))
-#define GPIO_PORTB_IEV_REG        (*((volatile uint32 *)0x4000540C))
-#define GPIO_PORTB_IM_REG         (*((volatile uint32 *)0x40005410))
-#define GPIO_PORTB_RIS_REG        (*((volatile uint32 *)0x40005414))
-#define GPIO_PORTB_ICR_REG        (*((volatile uint32 *)0x4000541C))
+#define GPIO_PORTB_IS_REG         HW_REG(0x40005404)
+#define GPIO_PORTB_IBE_REG        HW_REG(0x40005408)
+#define GPIO_PORTB_IEV_REG        HW_REG(0x4000540C)
+#define GPIO_PORTB_IM_REG         HW_REG(0x40005410)
+#define GPIO_PORTB_RIS_REG        HW_REG(0x40005414)
+#define GPIO_PORTB_ICR_REG        HW_REG(0x4000541C)
 
 /*****************************************************************************
 GPIO registers (PORTC)
 *****************************************************************************/
-#define GPIO_PORTC_DATA_REG       (*((volatile uint32 *)0x400063FC))
-#define GPIO_PORTC_DIR_REG        (*((volatile uint32 *)0x40006400))
-#define GPIO_PORTC_AFSEL_REG      (*((volatile uint32 *)0x40006420))
-#define GPIO_PORTC_PUR_REG        (*((volatile uint32 *)0x40006510))
-#define GPIO_PORTC_PDR_REG        (*((volatile uint32 *)0x40006514))
-#define GPIO_PORTC_DEN_REG        (*((volatile uint32 *)0x4000651C))
-#define GPIO_PORTC_LOCK_REG       (*((volatile uint32 *)0x40006520))
-#define GPIO_PORTC_CR_REG         (*((volatile uint32 *)0x40006524))
-#define GPIO_PORTC_AMSEL_REG      (*((volatile uint32 *)0x40006528))
-#define GPIO_PORTC_PCTL_REG       (*((volatile uint32 *)0x4000652C))
+#define GPIO_PORTC_DATA_REG       HW_REG(0x400063FC)
+#define GPIO_PORTC_DIR_REG        HW_REG(0x40006400)
+#define GPIO_PORTC_AFSEL_REG      HW_REG(0x40006420)
+#define GPIO_PORTC_PUR_REG        HW_REG(0x40006510)
+#define GPIO_PORTC_PDR_REG        HW_REG(0x40006514)
+#define GPIO_PORTC_DEN_REG        HW_REG(0x4000651C)
+#define GPIO_PORTC_LOCK_REG       HW_REG(0x40006520)
+#define GPIO_PORTC_CR_REG         HW_REG(0x40006524)
+#define GPIO_PORTC_AMSEL_REG      HW_REG(0x40006528)
+#define GPIO_PORTC_PCTL_REG       HW_REG(0x4000652C)
 
 /* PORTC External Interrupts Registers */
-#define GPIO_PORTC_IS_REG         (*((volatile uint32 *)0x40006404))
-#define GPIO_PORTC_IBE_REG        (*((volatile uint32 *)0x40006408))
-#define GPIO_PORTC_IEV_REG        (*((volatile uint32 *)0x4000640C))
-#define GPIO_PORTC_IM_REG         (*((volatile uint32 *)0x40006410))
-#define GPIO_PORTC_RIS_REG        (*((volatile uint32 *)0x40006414))
-#define GPIO_PORTC_ICR_REG        (*((volatile uint32 *)0x4000641C))
+#define GPIO_PORTC_IS_REG         HW_REG(0x40006404)
+#define GPIO_PORTC_IBE_REG        HW_REG(0x40006408)
+#define GPIO_PORTC_IEV_REG        HW_REG(0x4000640C)
+#define GPIO_PORTC_IM_REG         HW_REG(0x40006410)
+#define GPIO_PORTC_RIS_REG        HW_REG(0x40006414)
+#define GPIO_PORTC_ICR_REG        HW_REG(0x4000641C)
 
 /*****************************************************************************
 GPIO registers (PORTD)
 *****************************************************************************/
-#define GPIO_PORTD_DATA_REG       (*((volatile uint32 *)0x400073FC))
-#define GPIO_PORTD_DIR_REG        (*((volatile uint32 *)0x40007400))
-#define GPIO_PORTD_AFSEL_REG      (*((volatile uint32 *)0x40007420))
-#define GPIO_PORTD_PUR_REG        (*((volatile uint32 *)0x40007510))
-#define GPIO_PORTD_PDR_REG        (*((volatile uint32 *)0x40007514))
-#define GPIO_PORTD_DEN_REG        (*((volatile uint32 *)0x4000751C))
-#define GPIO_PORTD_LOCK_REG       (*((volatile uint32 *)0x40007520))
-#define GPIO_PORTD_CR_REG         (*((volatile uint32 *)0x40007524))
-#define GPIO_PORTD_AMSEL_REG      (*((volatile uint32 *)0x40007528))
-#define GPIO_PORTD_PCTL_REG       (*((volatile uint32 *)0x4000752C))
+#define GPIO_PORTD_DATA_REG       HW_REG(0x400073FC)
+#define GPIO_PORTD_DIR_REG        HW_REG(0x40007400)
+#define GPIO_PORTD_AFSEL_REG      HW_REG(0x40007420)
+#define GPIO_PORTD_PUR_REG        HW_REG(0x40007510)
+#define GPIO_PORTD_PDR_REG        HW_REG(0x40007514)
+#define GPIO_PORTD_DEN_REG        HW_REG(0x4000751C)
+#define GPIO_PORTD_LOCK_REG       HW_REG(0x40007520)
+#define GPIO_PORTD_CR_REG         HW_REG(0x40007524)
+#define GPIO_PORTD_AMSEL_REG      HW_REG(0x40007528)
+#define GPIO_PORTD_PCTL_REG       HW_REG(0x4000752C)
 
 /* PORTD External Interrupts Registers */
-#define GPIO_PORTD_IS_REG         (*((volatile uint32 *)0x40007404))
-#define GPIO_PORTD_IBE_REG        (*((volatile uint32 *)0x40007408))
-#define GPIO_PORTD_IEV_REG        (*((volatile uint32 *)0x4000740C))
-#define GPIO_PORTD_IM_REG         (*((volatile uint32 *)0x40007410))
-#define GPIO_PORTD_RIS_REG        (*((volatile uint32 *)0x40007414))
-#define GPIO_PORTD_ICR_REG        (*((volatile uint32 *)0x4000741C))
+#define GPIO_PORTD_IS_REG         HW_REG(0x40007404)
+#define GPIO_PORTD_IBE_REG        HW_REG(0x40007408)
+#define GPIO_PORTD_IEV_REG        HW_REG(0x4000740C)
+#define GPIO_PORTD_IM_REG         HW_REG(0x40007410)
+#define GPIO_PORTD_RIS_REG        HW_REG(0x40007414)
+#define GPIO_PORTD_ICR_REG        HW_REG(0x4000741C)
 
 /*****************************************************************************
 GPIO registers (PORTE)
 *****************************************************************************/
-#define GPIO_PORTE_DATA_REG       (*((volatile uint32 *)0x400243FC))
-#define GPIO_PORTE_DIR_REG        (*((volatile uint32 *)0x40024400))
-#define GPIO_PORTE_AFSEL_REG      (*((volatile uint32 *)0x40024420))
-#define GPIO_PORTE_PUR_REG        (*((volatile uint32 *)0x40024510))
-#define GPIO_PORTE_PDR_REG        (*((volatile uint32 *)0x40024514))
-#define GPIO_PORTE_DEN_REG        (*((volatile uint32 *)0x4002451C))
-#define GPIO_PORTE_LOCK_REG       (*((volatile uint32 *)0x40024520))
-#define GPIO_PORTE_CR_REG         (*((volatile uint32 *)0x40024524))
-#define GPIO_PORTE_AMSEL_REG      (*((volatile uint32 *)0x40024528))
-#define GPIO_PORTE_PCTL_REG       (*((volatile uint32 *)0x4002452C))
+#define GPIO_PORTE_DATA_REG       HW_REG(0x400243FC)
+#define GPIO_PORTE_DIR_REG        HW_REG(0x40024400)
+#define GPIO_PORTE_AFSEL_REG      HW_REG(0x40024420)
+#define GPIO_PORTE_PUR_REG        HW_REG(0x40024510)
+#define GPIO_PORTE_PDR_REG        HW_REG(0x40024514)
+#define GPIO_PORTE_DEN_REG        HW_REG(0x4002451C)
+#define GPIO_PORTE_LOCK_REG       HW_REG(0x40024520)
+#define GPIO_PORTE_CR_REG         HW_REG(0x40024524)
+#define GPIO_PORTE_AMSEL_REG      HW_REG(0x40024528)
+#define GPIO_PORTE_PCTL_REG       HW_REG(0x4002452C)
 
 /* PORTE External Interrupts Registers */
-#define GPIO_PORTE_IS_REG         (*((volatile uint32 *)0x40024404))
-#define GPIO_PORTE_IBE_REG        (*((volatile uint32 *)0x40024408))
-#define GPIO_PORTE_IEV_REG        (*((volatile uint32 *)0x4002440C))
-#define GPIO_PORTE_IM_REG         (*((volatile uint32 *)0x40024410))
-#define GPIO_PORTE_RIS_REG        (*((volatile uint32 *)0x40024414))
-#define GPIO_PORTE_ICR_REG        (*((volatile uint32 *)0x4002441C))
+#define GPIO_PORTE_IS_REG         HW_REG(0x40024404)
+#define GPIO_PORTE_IBE_REG        HW_REG(0x40024408)
+#define GPIO_PORTE_IEV_REG        HW_REG(0x4002440C)
+#define GPIO_PORTE_IM_REG         HW_REG(0x40024410)
+#define GPIO_PORTE_RIS_REG        HW_REG(0x40024414)
+#define GPIO_PORTE_ICR_REG        HW_REG(0x4002441C)
 
 /*****************************************************************************
 GPIO registers (PORTF)
 *****************************************************************************/
-#define GPIO_PORTF_DATA_REG       (*((volatile uint32 *)0x400253FC))
-#define GPIO_PORTF_DIR_REG        (*((volatile uint32 *)0x40025400))
-#define GPIO_PORTF_AFSEL_REG      (*((volatile uint32 *)0x40025420))
-#define GPIO_PORTF_PUR_REG        (*((volatile uint32 *)0x40025510))
-#define GPIO_PORTF_PDR_REG        (*((volatile uint32 *)0x40025514))
-#define GPIO_PORTF_DEN_REG        (*((volatile uint32 *)0x4002551C))
-#define GPIO_PORTF_LOCK_REG       (*((volatile uint32 *)0x40025520))
-#define GPIO_PORTF_CR_REG         (*((volatile uint32 *)0x40025524))
-#define GPIO_PORTF_AMSEL_REG      (*((volatile uint32 *)0x40025528))
-#define GPIO_PORTF_PCTL_REG       (*((volatile uint32 *)0x4002552C))
+#define GPIO_PORTF_DATA_REG       HW_REG(0x400253FC)
+#define GPIO_PORTF_DIR_REG        HW_REG(0x40025400)
+#define GPIO_PORTF_AFSEL_REG      HW_REG(0x40025420)
+#define GPIO_PORTF_PUR_REG        HW_REG(0x40025510)
+#define GPIO_PORTF_PDR_REG        HW_REG(0x40025514)
+#define GPIO_PORTF_DEN_REG        HW_REG(0x4002551C)
+#define GPIO_PORTF_LOCK_REG       HW_REG(0x40025520)
+#define GPIO_PORTF_CR_REG         HW_REG(0x40025524)
+#define GPIO_PORTF_AMSEL_REG      HW_REG(0x40025528)
+#define GPIO_PORTF_PCTL_REG       HW_REG(0x4002552C)
 
 /* PORTF External Interrupts Registers */
-#define GPIO_PORTF_IS_REG         (*((volatile uint32 *)0x40025404))
-#define GPIO_PORTF_IBE_REG        (*((volatile uint32 *)0x40025408))
-#define GPIO_PORTF_IEV_REG        (*((volatile uint32 *)0x4002540C))
-#define GPIO_PORTF_IM_REG         (*((volatile uint32 *)0x40025410))
-#define GPIO_PORTF_RIS_REG        (*((volatile uint32 *)0x40025414))
-#define GPIO_PORTF_ICR_REG        (*((volatile uint32 *)0x4002541C))
+#define GPIO_PORTF_IS_REG         HW_REG(0x40025404)
+#define GPIO_PORTF_IBE_REG        HW_REG(0x40025408)
+#define GPIO_PORTF_IEV_REG        HW_REG(0x4002540C)
+#define GPIO_PORTF_IM_REG         HW_REG(0x40025410)
+#define GPIO_PORTF_RIS_REG        HW_REG(0x40025414)
+#define GPIO_PORTF_ICR_REG        HW_REG(0x4002541C)
+
+/*****************************************************************************
+GPIO masked data access
+Address bits 9:2 of a GPIODATA access select the pins it reads or writes, so
+a write changes only those pins without a read-modify-write
+*****************************************************************************/
+#define GPIO_PORTA_BASE           0x40004000
+#define GPIO_PORTB_BASE           0x40005000
+#define GPIO_PORTC_BASE           0x40006000
+#define GPIO_PORTD_BASE           0x40007000
+#define GPIO_PORTE_BASE           0x40024000
+#define GPIO_PORTF_BASE           0x40025000
+
+#define GPIO_DATA_BITS_REG(Base, Pins) HW_REG((Base) + ((uint32)(Pins) << 2))
 
 /*****************************************************************************
 Systick Timer Registers
 *****************************************************************************/
-#define SYSTICK_CTRL_REG          (*((volatile uint32 *)0xE000E010))
-#define SYSTICK_RELOAD_REG        (*((volatile uint32 *)0xE000E014))
-#define SYSTICK_CURRENT_REG       (*((volatile uint32 *)0xE000E018))
+#define SYSTICK_CTRL_REG          HW_REG(0xE000E010)
+#define SYSTICK_RELOAD_REG        HW_REG(0xE000E014)
+#define SYSTICK_CURRENT_REG       HW_REG(0xE000E018)
 
 /*****************************************************************************
 NVIC Registers
 *****************************************************************************/
-#define NVIC_PRI0_REG             (*((volatile uint32 *)0xE000E400))
-#define NVIC_PRI1_REG             (*((volatile uint32 *)0xE000E404))
-#define NVIC_PRI2_REG             (*((volatile uint32 *)0xE000E408))
-#define NVIC_PRI3_REG             (*((volatile uint32 *)0xE000E40C))
-#define NVIC_PRI4_REG             (*((volatile uint32 *)0xE000E410))
-#define NVIC_PRI5_REG             (*((volatile uint32 *)0xE000E414))
-#define NVIC_PRI6_REG             (*((volatile uint32 *)0xE000E418))
-#define NVIC_PRI7_REG             (*((volatile uint32 *)0xE000E41C))
-#define NVIC_PRI8_REG             (*((volatile uint32 *)0xE000E420))
-#define NVIC_PRI9_REG             (*((volatile uint32 *)0xE000E424))
-#define NVIC_PRI10_REG            (*((volatile uint32 *)0xE000E428))
-#define NVIC_PRI11_REG            (*((volatile uint32 *)0xE000E42C))
-#define NVIC_PRI12_REG            (*((volatile uint32 *)0xE000E430))
-#define NVIC_PRI13_REG            (*((volatile uint32 *)0xE000E434))
-#define NVIC_PRI14_REG            (*((volatile uint32 *)0xE000E438))
-#define NVIC_PRI15_REG            (*((volatile uint32 *)0xE000E43C))
-#define NVIC_PRI16_REG            (*((volatile uint32 *)0xE000E440))
-#define NVIC_PRI17_REG            (*((volatile uint32 *)0xE000E444))
-#define NVIC_PRI18_REG            (*((volatile uint32 *)0xE000E448))
-#define NVIC_PRI19_REG            (*((volatile uint32 *)0xE000E44C))
-#define NVIC_PRI20_REG            (*((volatile uint32 *)0xE000E450))
-#define NVIC_PRI21_REG            (*((volatile uint32 *)0xE000E454))
-#define NVIC_PRI22_REG            (*((volatile uint32 *)0xE000E458))
-#define NVIC_PRI23_REG            (*((volatile uint32 *)0xE000E45C))
-#define NVIC_PRI24_REG            (*((volatile uint32 *)0xE000E460))
-#define NVIC_PRI25_REG            (*((volatile uint32 *)0xE000E464))
-#define NVIC_PRI26_REG            (*((volatile uint32 *)0xE000E468))
-#define NVIC_PRI27_REG            (*((volatile uint32 *)0xE000E46C))
-#define NVIC_PRI28_REG            (*((volatile uint32 *)0xE000E470))
-#define NVIC_PRI29_REG            (*((volatile uint32 *)0xE000E474))
-#define NVIC_PRI30_REG            (*((volatile uint32 *)0xE000E478))
-#define NVIC_PRI31_REG            (*((volatile uint32 *)0xE000E47C))
-#define NVIC_PRI32_REG            (*((volatile uint32 *)0xE000E480))
-#define NVIC_PRI33_REG            (*((volatile uint32 *)0xE000E484))
-#define NVIC_PRI34_REG            (*((volatile uint32 *)0xE000E488))
-
-#define NVIC_EN0_REG              (*((volatile uint32 *)0xE000E100))
-#define NVIC_EN1_REG              (*((volatile uint32 *)0xE000E104))
-#define NVIC_EN2_REG              (*((volatile uint32 *)0xE000E108))
-#define NVIC_EN3_REG              (*((volatile uint32 *)0xE000E10C))
-#define NVIC_EN4_REG              (*((volatile uint32 *)0xE000E110))
-#define NVIC_DIS0_REG             (*((volatile uint32 *)0xE000E180))
-#define NVIC_DIS1_REG             (*((volatile uint32 *)0xE000E184))
-#define NVIC_DIS2_REG             (*((volatile uint32 *)0xE000E188))
-#define NVIC_DIS3_REG             (*((volatile uint32 *)0xE000E18C))
-#define NVIC_DIS4_REG             (*((volatile uint32 *)0xE000E190))
+#define NVIC_PRI0_REG             HW_REG(0xE000E400)
+#define NVIC_PRI1_REG             HW_REG(0xE000E404)
+#define NVIC_PRI2_REG             HW_REG(0xE000E408)
+#define NVIC_PRI3_REG             HW_REG(0xE000E40C)
+#define NVIC_PRI4_REG             HW_REG(0xE000E410)
+#define NVIC_PRI5_REG             HW_REG(0xE000E414)
+#define NVIC_PRI6_REG             HW_REG(0xE000E418)
+#define NVIC_PRI7_REG             HW_REG(0xE000E41C)
+#define NVIC_PRI8_REG             HW_REG(0xE000E420)
+#define NVIC_PRI9_REG             HW_REG(0xE000E424)
+#define NVIC_PRI10_REG            HW_REG(0xE000E428)
+#define NVIC_PRI11_REG            HW_REG(0xE000E42C)
+#define NVIC_PRI12_REG            HW_REG(0xE000E430)
+#define NVIC_PRI13_REG            HW_REG(0xE000E434)
+#define NVIC_PRI14_REG            HW_REG(0xE000E438)
+#define NVIC_PRI15_REG            HW_REG(0xE000E43C)
+#define NVIC_PRI16_REG            HW_REG(0xE000E440)
+#define NVIC_PRI17_REG            HW_REG(0xE000E444)
+#define NVIC_PRI18_REG            HW_REG(0xE000E448)
+#define NVIC_PRI19_REG            HW_REG(0xE000E44C)
+#define NVIC_PRI20_REG            HW_REG(0xE000E450)
+#define NVIC_PRI21_REG            HW_REG(0xE000E454)
+#define NVIC_PRI22_REG            HW_REG(0xE000E458)
+#define NVIC_PRI23_REG            HW_REG(0xE000E45C)
+#define NVIC_PRI24_REG            HW_REG(0xE000E460)
+#define NVIC_PRI25_REG            HW_REG(0xE000E464)
+#define NVIC_PRI26_REG            HW_REG(0xE000E468)
+#define NVIC_PRI27_REG            HW_REG(0xE000E46C)
+#define NVIC_PRI28_REG            HW_REG(0xE000E470)
+#define NVIC_PRI29_REG            HW_REG(0xE000E474)
+#define NVIC_PRI30_REG            HW_REG(0xE000E478)
+#define NVIC_PRI31_REG            HW_REG(0xE000E47C)
+#define NVIC_PRI32_REG            HW_REG(0xE000E480)
+#define NVIC_PRI33_REG            HW_REG(0xE000E484)
+#define NVIC_PRI34_REG            HW_REG(0xE000E488)
+#define NVIC_PRI_REG(n)           HW_REG(0xE000E400 + (4 * (n)))
+
+#define NVIC_EN0_REG              HW_REG(0xE000E100)
+#define NVIC_EN1_REG              HW_REG(0xE000E104)
+#define NVIC_EN2_REG              HW_REG(0xE000E108)
+#define NVIC_EN3_REG              HW_REG(0xE000E10C)
+#define NVIC_EN4_REG              HW_REG(0xE000E110)
+#define NVIC_DIS0_REG             HW_REG(0xE000E180)
+#define NVIC_DIS1_REG             HW_REG(0xE000E184)
+#define NVIC_DIS2_REG             HW_REG(0xE000E188)
+#define NVIC_DIS3_REG             HW_REG(0xE000E18C)
+#define NVIC_DIS4_REG             HW_REG(0xE000E190)
 
 /*****************************************************************************
 System Control Block Registers
 *****************************************************************************/
-#define NVIC_SYSTEM_PRI1_REG      (*((volatile uint32 *)0xE000ED18))
-#define NVIC_SYSTEM_PRI2_REG      (*((volatile uint32 *)0xE000ED1C))
-#define NVIC_SYSTEM_PRI3_REG      (*((volatile uint32 *)0xE000ED20))
-#define NVIC_SYSTEM_SYSHNDCTRL    (*((volatile uint32 *)0xE000ED24))
-#define NVIC_SYSTEM_INTCTRL       (*((volatile uint32 *)0xE000ED04))
-#define NVIC_SYSTEM_CFGCTRL       (*((volatile uint32 *)0xE000ED14))
+#define NVIC_SYSTEM_PRI1_REG      HW_REG(0xE000ED18)
+#define NVIC_SYSTEM_PRI2_REG      HW_REG(0xE000ED1C)
+#define NVIC_SYSTEM_PRI3_REG      HW_REG(0xE000ED20)
+#define NVIC_SYSTEM_SYSHNDCTRL    HW_REG(0xE000ED24)
+#define NVIC_SYSTEM_INTCTRL       HW_REG(0xE000ED04)
+#define NVIC_SYSTEM_CFGCTRL       HW_REG(0xE000ED14)
+#define NVIC_SYSTEM_APINT         HW_REG(0xE000ED0C)
+#define NVIC_SYSTEM_SYSCTRL       HW_REG(0xE000ED10)
+#define NVIC_SYSTEM_FAULTSTAT     HW_REG(0xE000ED28)
+#define NVIC_SYSTEM_HFAULTSTAT    HW_REG(0xE000ED2C)
+#define NVIC_SYSTEM_MMADDR        HW_REG(0xE000ED34)
+#define NVIC_SYSTEM_FAULTADDR     HW_REG(0xE000ED38)
+
+/*****************************************************************************
+Floating-Point Unit Registers
+*****************************************************************************/
+#define FPU_CPAC_REG              HW_REG(0xE000ED88)
+#define FPU_FPCC_REG              HW_REG(0xE000EF34)
+#define FPU_FPCA_REG              HW_REG(0xE000EF38)
+#define FPU_FPDSC_REG             HW_REG(0xE000EF3C)
+
+/*****************************************************************************
+Debug Cycle Counter Registers (DWT)
+*****************************************************************************/
+#define DWT_CTRL_REG              HW_REG(0xE0001000)
+#define DWT_CYCCNT_REG            HW_REG(0xE0001004)
+#define DEBUG_DEMCR_REG           HW_REG(0xE000EDFC)
 
 /*****************************************************************************
 MPU Registers
 *****************************************************************************/
-#define MPU_TYPE_REG              (*((volatile uint32 *)0xE000ED90))
-#define MPU_CTRL_REG              (*((volatile uint32 *)0xE000ED94))
-#define MPU_NUMBER_REG            (*((volatile uint32 *)0xE000ED98))
-#define MPU_BASE_REG              (*((volatile uint32 *)0xE000ED9C))
-#define MPU_ATTR_REG              (*((volatile uint32 *)0xE000EDA0))
-#define MPU_BASE1_REG             (*((volatile uint32 *)0xE000EDA4))
-#define MPU_ATTR1_REG             (*((volatile uint32 *)0xE000EDA8))
-#define MPU_BASE2_REG             (*((volatile uint32 *)0xE000EDAC))
-#define MPU_ATTR2_REG             (*((volatile uint32 *)0xE000EDB0))
-#define MPU_BASE3_REG             (*((volatile uint32 *)0xE000EDB4))
-#define MPU_ATTR3_REG             (*((volatile uint32 *)0xE000EDB8))
+#define MPU_TYPE_REG              HW_REG(0xE000ED90)
+#define MPU_CTRL_REG              HW_REG(0xE000ED94)
+#define MPU_NUMBER_REG            HW_REG(0xE000ED98)
+#define MPU_BASE_REG              HW_REG(0xE000ED9C)
+#define MPU_ATTR_REG              HW_REG(0xE000EDA0)
+#define MPU_BASE1_REG             HW_REG(0xE000EDA4)
+#define MPU_ATTR1_REG             HW_REG(0xE000EDA8)
+#define MPU_BASE2_REG             HW_REG(0xE000EDAC)
+#define MPU_ATTR2_REG             HW_REG(0xE000EDB0)
+#define MPU_BASE3_REG             HW_REG(0xE000EDB4)
+#define MPU_ATTR3_REG             HW_REG(0xE000EDB8)
 
 /*****************************************************************************
 System Control Registers
 *****************************************************************************/
-#define SYSCTL_DID0_REG           (*((volatile uint32 *)0x400FE000))
-#define SYSCTL_DID1_REG           (*((volatile uint32 *)0x400FE004))
-#define SYSCTL_DC0_REG            (*((volatile uint32 *)0x400FE008))
-#define SYSCTL_DC1_REG            (*((volatile uint32 *)0x400FE010))
-#define SYSCTL_DC2_REG            (*((volatile uint32 *)0x400FE014))
-#define SYSCTL_DC3_REG            (*((volatile uint32 *)0x400FE018))
-#define SYSCTL_DC4_REG            (*((volatile uint32 *)0x400FE01C))
-#define SYSCTL_DC5_REG            (*((volatile uint32 *)0x400FE020))
-#define SYSCTL_DC6_REG            (*((volatile uint32 *)0x400FE024))
-#define SYSCTL_DC7_REG            (*((volatile uint32 *)0x400FE028))
-#define SYSCTL_DC8_REG            (*((volatile uint32 *)0x400FE02C))
-#define SYSCTL_PBORCTL_REG        (*((volatile uint32 *)0x400FE030))
-#define SYSCTL_SRCR0_REG          (*((volatile uint32 *)0x400FE040))
-#define SYSCTL_SRCR1_REG          (*((volatile uint32 *)0x400FE044))
-#define SYSCTL_SRCR2_REG          (*((volatile uint32 *)0x400FE048))
-#define SYSCTL_RIS_REG            (*((volatile uint32 *)0x400FE050))
-#define SYSCTL_IMC_REG            (*((volatile uint32 *)0x400FE054))
-#define SYSCTL_MISC_REG           (*((volatile uint32 *)0x400FE058))
-#define SYSCTL_RESC_REG           (*((volatile uint32 *)0x400FE05C))
-#define SYSCTL_RCC_REG            (*((volatile uint32 *)0x400FE060))
-#define SYSCTL_GPIOHBCTL_REG      (*((volatile uint32 *)0x400FE06C))
-#define SYSCTL_RCC2_REG           (*((volatile uint32 *)0x400FE070))
-#define SYSCTL_MOSCCTL_REG        (*((volatile uint32 *)0x400FE07C))
-#define SYSCTL_RCGC0_REG          (*((volatile uint32 *)0x400FE100))
-#define SYSCTL_RCGC1_REG          (*((volatile uint32 *)0x400FE104))
-#define SYSCTL_RCGC2_REG          (*((volatile uint32 *)0x400FE108))
-#define SYSCTL_SCGC0_REG          (*((volatile uint32 *)0x400FE110))
-#define SYSCTL_SCGC1_REG          (*((volatile uint32 *)0x400FE114))
-#define SYSCTL_SCGC2_REG          (*((volatile uint32 *)0x400FE118))
-#define SYSCTL_DCGC0_REG          (*((volatile uint32 *)0x400FE120))
-#define SYSCTL_DCGC1_REG          (*((volatile uint32 *)0x400FE124))
-#define SYSCTL_DCGC2_REG          (*((volatile uint32 *)0x400FE128))
-#define SYSCTL_DSLPCLKCFG_REG     (*((volatile uint32 *)0x400FE144))
-#define SYSCTL_SYSPROP_REG        (*((volatile uint32 *)0x400FE14C))
-#define SYSCTL_PIOSCCAL_REG       (*((volatile uint32 *)0x400FE150))
-#define SYSCTL_PIOSCSTAT_REG      (*((volatile uint32 *)0x400FE154))
-#define SYSCTL_PLLFREQ0_REG       (*((volatile uint32 *)0x400FE160))
-#define SYSCTL_PLLFREQ1_REG       (*((volatile uint32 *)0x400FE164))
-#define SYSCTL_PLLSTAT_REG        (*((volatile uint32 *)0x400FE168))
-#define SYSCTL_DC9_REG            (*((volatile uint32 *)0x400FE190))
-#define SYSCTL_NVMSTAT_REG        (*((volatile uint32 *)0x400FE1A0))
-#define SYSCTL_PPWD_REG           (*((volatile uint32 *)0x400FE300))
-#define SYSCTL_PPTIMER_REG        (*((volatile uint32 *)0x400FE304))
-#define SYSCTL_PPGPIO_REG         (*((volatile uint32 *)0x400FE308))
-#define SYSCTL_PPDMA_REG          (*((volatile uint32 *)0x400FE30C))
-#define SYSCTL_PPHIB_REG          (*((volatile uint32 *)0x400FE314))
-#define SYSCTL_PPUART_REG         (*((volatile uint32 *)0x400FE318))
-#define SYSCTL_PPSSI_REG          (*((volatile uint32 *)0x400FE31C))
-#define SYSCTL_PPI2C_REG          (*((volatile uint32 *)0x400FE320))
-#define SYSCTL_PPUSB_REG          (*((volatile uint32 *)0x400FE328))
-#define SYSCTL_PPCAN_REG          (*((volatile uint32 *)0x400FE334))
-#define SYSCTL_PPADC_REG          (*((volatile uint32 *)0x400FE338))
-#define SYSCTL_PPACMP_REG         (*((volatile uint32 *)0x400FE33C))
-#define SYSCTL_PPPWM_REG          (*((volatile uint32 *)0x400FE340))
-#define SYSCTL_PPQEI_REG          (*((volatile uint32 *)0x400FE344))
-#define SYSCTL_PPEEPROM_REG       (*((volatile uint32 *)0x400FE358))
-#define SYSCTL_PPWTIMER_REG       (*((volatile uint32 *)0x400FE35C))
-#define SYSCTL_SRWD_REG           (*((volatile uint32 *)0x400FE500))
-#define SYSCTL_SRTIMER_REG        (*((volatile uint32 *)0x400FE504))
-#define SYSCTL_SRGPIO_REG         (*((volatile uint32 *)0x400FE508))
-#define SYSCTL_SRDMA_REG          (*((volatile uint32 *)0x400FE50C))
-#define SYSCTL_SRHIB_REG          (*((volatile uint32 *)0x400FE514))
-#define SYSCTL_SRUART_REG         (*((volatile uint32 *)0x400FE518))
-#define SYSCTL_SRSSI_REG          (*((volatile uint32 *)0x400FE51C))
-#define SYSCTL_SRI2C_REG          (*((volatile uint32 *)0x400FE520))
-#define SYSCTL_SRUSB_REG          (*((volatile uint32 *)0x400FE528))
-#define SYSCTL_SRCAN_REG          (*((volatile uint32 *)0x400FE534))
-#define SYSCTL_SRADC_REG          (*((volatile uint32 *)0x400FE538))
-#define SYSCTL_SRACMP_REG         (*((volatile uint32 *)0x400FE53C))
-#define SYSCTL_SRPWM_REG          (*((volatile uint32 *)0x400FE540))
-#define SYSCTL_SRQEI_REG          (*((volatile uint32 *)0x400FE544))
-#define SYSCTL_SREEPROM_REG       (*((volatile uint32 *)0x400FE558))
-#define SYSCTL_SRWTIMER_REG       (*((volatile uint32 *)0x400FE55C))
-#define SYSCTL_RCGCWD_REG         (*((volatile uint32 *)0x400FE600))
-#define SYSCTL_RCGCTIMER_REG      (*((volatile uint32 *)0x400FE604))
-#define SYSCTL_RCGCGPIO_REG       (*((volatile uint32 *)0x400FE608))
-#define SYSCTL_RCGCDMA_REG        (*((volatile uint32 *)0x400FE60C))
-#define SYSCTL_RCGCHIB_REG        (*((volatile uint32 *)0x400FE614))
-#define SYSCTL_RCGCUART_REG       (*((volatile uint32 *)0x400FE618))
-#define SYSCTL_RCGCSSI_REG        (*((volatile uint32 *)0x400FE61C))
-#define SYSCTL_RCGCI2C_REG        (*((volatile uint32 *)0x400FE620))
-#define SYSCTL_RCGCUSB_REG        (*((volatile uint32 *)0x400FE628))
-#define SYSCTL_RCGCCAN_REG        (*((volatile uint32 *)0x400FE634))
-#define SYSCTL_RCGCADC_REG        (*((volatile uint32 *)0x400FE638))
-#define SYSCTL_RCGCACMP_REG       (*((volatile uint32 *)0x400FE63C))
-#define SYSCTL_RCGCPWM_REG        (*((volatile uint32 *)0x400FE640))
-#define SYSCTL_RCGCQEI_REG        (*((volatile uint32 *)0x400FE644))
-#define SYSCTL_RCGCEEPROM_REG     (*((volatile uint32 *)0x400FE658))
-#define SYSCTL_RCGCWTIMER_REG     (*((volatile uint32 *)0x400FE65C))
-#define SYSCTL_SCGCWD_REG         (*((volatile uint32 *)0x400FE700))
-#define SYSCTL_SCGCTIMER_REG      (*((volatile uint32 *)0x400FE704))
-#define SYSCTL_SCGCGPIO_REG       (*((volatile uint32 *)0x400FE708))
-#define SYSCTL_SCGCDMA_REG        (*((volatile uint32 *)0x400FE70C))
-#define SYSCTL_SCGCHIB_REG        (*((volatile uint32 *)0x400FE714))
-#define SYSCTL_SCGCUART_REG       (*((volatile uint32 *)0x400FE718))
-#define SYSCTL_SCGCSSI_REG        (*((volatile uint32 *)0x400FE71C))
-#define SYSCTL_SCGCI2C_REG        (*((volatile uint32 *)0x400FE720))
-#define SYSCTL_SCGCUSB_REG        (*((volatile uint32 *)0x400FE728))
-#define SYSCTL_SCGCCAN_REG        (*((volatile uint32 *)0x400FE734))
-#define SYSCTL_SCGCADC_REG        (*((volatile uint32 *)0x400FE738))
-#define SYSCTL_SCGCACMP_REG       (*((volatile uint32 *)0x400FE73C))
-#define SYSCTL_SCGCPWM_REG        (*((volatile uint32 *)0x400FE740))
-#define SYSCTL_SCGCQEI_REG        (*((volatile uint32 *)0x400FE744))
-#define SYSCTL_SCGCEEPROM_REG     (*((volatile uint32 *)0x400FE758))
-#define SYSCTL_SCGCWTIMER_REG     (*((volatile uint32 *)0x400FE75C))
-#define SYSCTL_DCGCWD_REG         (*((volatile uint32 *)0x400FE800))
-#define SYSCTL_DCGCTIMER_REG      (*((volatile uint32 *)0x400FE804))
-#define SYSCTL_DCGCGPIO_REG       (*((volatile uint32 *)0x400FE808))
-#define SYSCTL_DCGCDMA_REG        (*((volatile uint32 *)0x400FE80C))
-#define SYSCTL_DCGCHIB_REG        (*((volatile uint32 *)0x400FE814))
-#define SYSCTL_DCGCUART_REG       (*((volatile uint32 *)0x400FE818))
-#define SYSCTL_DCGCSSI_REG        (*((volatile uint32 *)0x400FE81C))
-#define SYSCTL_DCGCI2C_REG        (*((volatile uint32 *)0x400FE820))
-#define SYSCTL_DCGCUSB_REG        (*((volatile uint32 *)0x400FE828))
-#define SYSCTL_DCGCCAN_REG        (*((volatile uint32 *)0x400FE834))
-#define SYSCTL_DCGCADC_REG        (*((volatile uint32 *)0x400FE838))
-#define SYSCTL_DCGCACMP_REG       (*((volatile uint32 *)0x400FE83C))
-#define SYSCTL_DCGCPWM_REG        (*((volatile uint32 *)0x400FE840))
-#define SYSCTL_DCGCQEI_REG        (*((volatile uint32 *)0x400FE844))
-#define SYSCTL_DCGCEEPROM_REG     (*((volatile uint32 *)0x400FE858))
-#define SYSCTL_DCGCWTIMER_REG     (*((volatile uint32 *)0x400FE85C))
-#define SYSCTL_PRWD_REG           (*((volatile uint32 *)0x400FEA00))
-#define SYSCTL_PRTIMER_REG        (*((volatile uint32 *)0x400FEA04))
-#define SYSCTL_PRGPIO_REG         (*((volatile uint32 *)0x400FEA08))
-#define SYSCTL_PRDMA_REG          (*((volatile uint32 *)0x400FEA0C))
-#define SYSCTL_PRHIB_REG          (*((volatile uint32 *)0x400FEA14))
-#define SYSCTL_PRUART_REG         (*((volatile uint32 *)0x400FEA18))
-#define SYSCTL_PRSSI_REG          (*((volatile uint32 *)0x400FEA1C))
-#define SYSCTL_PRI2C_REG          (*((volatile uint32 *)0x400FEA20))
-#define SYSCTL_PRUSB_REG          (*((volatile uint32 *)0x400FEA28))
-#define SYSCTL_PRCAN_REG          (*((volatile uint32 *)0x400FEA34))
-#define SYSCTL_PRADC_REG          (*((volatile uint32 *)0x400FEA38))
-#define SYSCTL_PRACMP_REG         (*((volatile uint32 *)0x400FEA3C))
-#define SYSCTL_PRPWM_REG          (*((volatile uint32 *)0x400FEA40))
-#define SYSCTL_PRQEI_REG          (*((volatile uint32 *)0x400FEA44))
-#define SYSCTL_PREEPROM_REG       (*((volatile uint32 *)0x400FEA58))
-#define SYSCTL_PRWTIMER_REG       (*((volatile uint32 *)0x400FEA5C))
+#define SYSCTL_DID0_REG           HW_REG(0x400FE000)
+#define SYSCTL_DID1_REG           HW_REG(0x400FE004)
+#define SYSCTL_DC0_REG            HW_REG(0x400FE008)
+#define SYSCTL_DC1_REG            HW_REG(0x400FE010)
+#define SYSCTL_DC2_REG            HW_REG(0x400FE014)
+#define SYSCTL_DC3_REG            HW_REG(0x400FE018)
+#define SYSCTL_DC4_REG            HW_REG(0x400FE01C)
+#define SYSCTL_DC5_REG            HW_REG(0x400FE020)
+#define SYSCTL_DC6_REG            HW_REG(0x400FE024)
+#define SYSCTL_DC7_REG            HW_REG(0x400FE028)
+#define SYSCTL_DC8_REG            HW_REG(0x400FE02C)
+#define SYSCTL_PBORCTL_REG        HW_REG(0x400FE030)
+#define SYSCTL_SRCR0_REG          HW_REG(0x400FE040)
+#define SYSCTL_SRCR1_REG          HW_REG(0x400FE044)
+#define SYSCTL_SRCR2_REG          HW_REG(0x400FE048)
+#define SYSCTL_RIS_REG            HW_REG(0x400FE050)
+#define SYSCTL_IMC_REG            HW_REG(0x400FE054)
+#define SYSCTL_MISC_REG           HW_REG(0x400FE058)
+#define SYSCTL_RESC_REG           HW_REG(0x400FE05C)
+#define SYSCTL_RCC_REG            HW_REG(0x400FE060)
+#define SYSCTL_GPIOHBCTL_REG      HW_REG(0x400FE06C)
+#define SYSCTL_RCC2_REG           HW_REG(0x400FE070)
+#define SYSCTL_MOSCCTL_REG        HW_REG(0x400FE07C)
+#define SYSCTL_RCGC0_REG          HW_REG(0x400FE100)
+#define SYSCTL_RCGC1_REG          HW_REG(0x400FE104)
+#define SYSCTL_RCGC2_REG          HW_REG(0x400FE108)
+#define SYSCTL_SCGC0_REG          HW_REG(0x400FE110)
+#define SYSCTL_SCGC1_REG          HW_REG(0x400FE114)
+#define SYSCTL_SCGC2_REG          HW_REG(0x400FE118)
+#define SYSCTL_DCGC0_REG          HW_REG(0x400FE120)
+#define SYSCTL_DCGC1_REG          HW_REG(0x400FE124)
+#define SYSCTL_DCGC2_REG          HW_REG(0x400FE128)
+#define SYSCTL_DSLPCLKCFG_REG     HW_REG(0x400FE144)
+#define SYSCTL_SYSPROP_REG        HW_REG(0x400FE14C)
+#define SYSCTL_PIOSCCAL_REG       HW_REG(0x400FE150)
+#define SYSCTL_PIOSCSTAT_REG      HW_REG(0x400FE154)
+#define SYSCTL_PLLFREQ0_REG       HW_REG(0x400FE160)
+#define SYSCTL_PLLFREQ1_REG       HW_REG(0x400FE164)
+#define SYSCTL_PLLSTAT_REG        HW_REG(0x400FE168)
+#define SYSCTL_DC9_REG            HW_REG(0x400FE190)
+#define SYSCTL_NVMSTAT_REG        HW_REG(0x400FE1A0)
+#define SYSCTL_PPWD_REG           HW_REG(0x400FE300)
+#define SYSCTL_PPTIMER_REG        HW_REG(0x400FE304)
+#define SYSCTL_PPGPIO_REG         HW_REG(0x400FE308)
+#define SYSCTL_PPDMA_REG          HW_REG(0x400FE30C)
+#define SYSCTL_PPHIB_REG          HW_REG(0x400FE314)
+#define SYSCTL_PPUART_REG         HW_REG(0x400FE318)
+#define SYSCTL_PPSSI_REG          HW_REG(0x400FE31C)
+#define SYSCTL_PPI2C_REG          HW_REG(0x400FE320)
+#define SYSCTL_PPUSB_REG          HW_REG(0x400FE328)
+#define SYSCTL_PPCAN_REG          HW_REG(0x400FE334)
+#define SYSCTL_PPADC_REG          HW_REG(0x400FE338)
+#define SYSCTL_PPACMP_REG         HW_REG(0x400FE33C)
+#define SYSCTL_PPPWM_REG          HW_REG(0x400FE340)
+#define SYSCTL_PPQEI_REG          HW_REG(0x400FE344)
+#define SYSCTL_PPEEPROM_REG       HW_REG(0x400FE358)
+#define SYSCTL_PPWTIMER_REG       HW_REG(0x400FE35C)
+#define SYSCTL_SRWD_REG           HW_REG(0x400FE500)
+#define SYSCTL_SRTIMER_REG        HW_REG(0x400FE504)
+#define SYSCTL_SRGPIO_REG         HW_REG(0x400FE508)
+#define SYSCTL_SRDMA_REG          HW_REG(0x400FE50C)
+#define SYSCTL_SRHIB_REG          HW_REG(0x400FE514)
+#define SYSCTL_SRUART_REG         HW_REG(0x400FE518)
+#define SYSCTL_SRSSI_REG          HW_REG(0x400FE51C)
+#define SYSCTL_SRI2C_REG          HW_REG(0x400FE520)
+#define SYSCTL_SRUSB_REG          HW_REG(0x400FE528)
+#define SYSCTL_SRCAN_REG          HW_REG(0x400FE534)
+#define SYSCTL_SRADC_REG          HW_REG(0x400FE538)
+#define SYSCTL_SRACMP_REG         HW_REG(0x400FE53C)
+#define SYSCTL_SRPWM_REG          HW_REG(0x400FE540)
+#define SYSCTL_SRQEI_REG          HW_REG(0x400FE544)
+#define SYSCTL_SREEPROM_REG       HW_REG(0x400FE558)
+#define SYSCTL_SRWTIMER_REG       HW_REG(0x400FE55C)
+#define SYSCTL_RCGCWD_REG         HW_REG(0x400FE600)
+#define SYSCTL_RCGCTIMER_REG      HW_REG(0x400FE604)
+#define SYSCTL_RCGCGPIO_REG       HW_REG(0x400FE608)
+#define SYSCTL_RCGCDMA_REG        HW_REG(0x400FE60C)
+#define SYSCTL_RCGCHIB_REG        HW_REG(0x400FE614)
+#define SYSCTL_RCGCUART_REG       HW_REG(0x400FE618)
+#define SYSCTL_RCGCSSI_REG        HW_REG(0x400FE61C)
+#define SYSCTL_RCGCI2C_REG        HW_REG(0x400FE620)
+#define SYSCTL_RCGCUSB_REG        HW_REG(0x400FE628)
+#define SYSCTL_RCGCCAN_REG        HW_REG(0x400FE634)
+#define SYSCTL_RCGCADC_REG        HW_REG(0x400FE638)
+#define SYSCTL_RCGCACMP_REG       HW_REG(0x400FE63C)
+#define SYSCTL_RCGCPWM_REG        HW_REG(0x400FE640)
+#define SYSCTL_RCGCQEI_REG        HW_REG(0x400FE644)
+#define SYSCTL_RCGCEEPROM_REG     HW_REG(0x400FE658)
+#define SYSCTL_RCGCWTIMER_REG     HW_REG(0x400FE65C)
+#define SYSCTL_SCGCWD_REG         HW_REG(0x400FE700)
+#define SYSCTL_SCGCTIMER_REG      HW_REG(0x400FE704)
+#define SYSCTL_SCGCGPIO_REG       HW_REG(0x400FE708)
+#define SYSCTL_SCGCDMA_REG        HW_REG(0x400FE70C)
+#define SYSCTL_SCGCHIB_REG        HW_REG(0x400FE714)
+#define SYSCTL_SCGCUART_REG       HW_REG(0x400FE718)
+#define SYSCTL_SCGCSSI_REG        HW_REG(0x400FE71C)
+#define SYSCTL_SCGCI2C_REG        HW_REG(0x400FE720)
+#define SYSCTL_SCGCUSB_REG        HW_REG(0x400FE728)
+#define SYSCTL_SCGCCAN_REG        HW_REG(0x400FE734)
+#define SYSCTL_SCGCADC_REG        HW_REG(0x400FE738)
+#define SYSCTL_SCGCACMP_REG       HW_REG(0x400FE73C)
+#define SYSCTL_SCGCPWM_REG        HW_REG(0x400FE740)
+#define SYSCTL_SCGCQEI_REG        HW_REG(0x400FE744)
+#define SYSCTL_SCGCEEPROM_REG     HW_REG(0x400FE758)
+#define SYSCTL_SCGCWTIMER_REG     HW_REG(0x400FE75C)
+#define SYSCTL_DCGCWD_REG         HW_REG(0x400FE800)
+#define SYSCTL_DCGCTIMER_REG      HW_REG(0x400FE804)
+#define SYSCTL_DCGCGPIO_REG       HW_REG(0x400FE808)
+#define SYSCTL_DCGCDMA_REG        HW_REG(0x400FE80C)
+#define SYSCTL_DCGCHIB_REG        HW_REG(0x400FE814)
+#define SYSCTL_DCGCUART_REG       HW_REG(0x400FE818)
+#define SYSCTL_DCGCSSI_REG        HW_REG(0x400FE81C)
+#define SYSCTL_DCGCI2C_REG        HW_REG(0x400FE820)
+#define SYSCTL_DCGCUSB_REG        HW_REG(0x400FE828)
+#define SYSCTL_DCGCCAN_REG        HW_REG(0x400FE834)
+#define SYSCTL_DCGCADC_REG        HW_REG(0x400FE838)
+#define SYSCTL_DCGCACMP_REG       HW_REG(0x400FE83C)
+#define SYSCTL_DCGCPWM_REG        HW_REG(0x400FE840)
+#define SYSCTL_DCGCQEI_REG        HW_REG(0x400FE844)
+#define SYSCTL_DCGCEEPROM_REG     HW_REG(0x400FE858)
+#define SYSCTL_DCGCWTIMER_REG     HW_REG(0x400FE85C)
+#define SYSCTL_PRWD_REG           HW_REG(0x400FEA00)
+#define SYSCTL_PRTIMER_REG        HW_REG(0x400FEA04)
+#define SYSCTL_PRGPIO_REG         HW_REG(0x400FEA08)
+#define SYSCTL_PRDMA_REG          HW_REG(0x400FEA0C)
+#define SYSCTL_PRHIB_REG          HW_REG(0x400FEA14)
+#define SYSCTL_PRUART_REG         HW_REG(0x400FEA18)
+#define SYSCTL_PRSSI_REG          HW_REG(0x400FEA1C)
+#define SYSCTL_PRI2C_REG          HW_REG(0x400FEA20)
+#define SYSCTL_PRUSB_REG          HW_REG(0x400FEA28)
+#define SYSCTL_PRCAN_REG          HW_REG(0x400FEA34)
+#define SYSCTL_PRADC_REG          HW_REG(0x400FEA38)
+#define SYSCTL_PRACMP_REG         HW_REG(0x400FEA3C)
+#define SYSCTL_PRPWM_REG          HW_REG(0x400FEA40)
+#define SYSCTL_PRQEI_REG          HW_REG(0x400FEA44)
+#define SYSCTL_PREEPROM_REG       HW_REG(0x400FEA58)
+#define SYSCTL_PRWTIMER_REG       HW_REG(0x400FEA5C)
+
+/* Peripheral present, clock gating and ready registers by index, WD = 0 ... WTIMER = 23 */
+#define SYSCTL_PP_REG(Index)      HW_REG(0x400FE300 + ((Index) * 4))
+#define SYSCTL_RCGC_REG(Index)    HW_REG(0x400FE600 + ((Index) * 4))
+#define SYSCTL_SCGC_REG(Index)    HW_REG(0x400FE700 + ((Index) * 4))
+#define SYSCTL_DCGC_REG(Index)    HW_REG(0x400FE800 + ((Index) * 4))
+#define SYSCTL_PR_REG(Index)      HW_REG(0x400FEA00 + ((Index) * 4))
 
 /*****************************************************************************
 UART0 Registers
 *****************************************************************************/
-#define UART0_DR_REG              (*((volatile uint32 *)0x4000C000))
-#define UART0_RSR_REG             (*((volatile uint32 *)0x4000C004))
-#define UART0_ECR_REG             (*((volatile uint32 *)0x4000C004))
-#define UART0_FR_REG              (*((volatile uint32 *)0x4000C018))
-#define UART0_ILPR_REG            (*((volatile uint32 *)0x4000C020))
-#define UART0_IBRD_REG            (*((volatile uint32 *)0x4000C024))
-#define UART0_FBRD_REG            (*((volatile uint32 *)0x4000C028))
-#define UART0_LCRH_REG            (*((volatile uint32 *)0x4000C02C))
-#define UART0_CTL_REG             (*((volatile uint32 *)0x4000C030))
-#define UART0_IFLS_REG            (*((volatile uint32 *)0x4000C034))
-#define UART0_IM_REG              (*((volatile uint32 *)0x4000C038))
-#define UART0_RIS_REG             (*((volatile uint32 *)0x4000C03C))
-#define UART0_MIS_REG             (*((volatile uint32 *)0x4000C040))
-#define UART0_ICR_REG             (*((volatile uint32 *)0x4000C044))
-#define UART0_DMACTL_REG          (*((volatile uint32 *)0x4000C048))
-#define UART0_9BITADDR_REG        (*((volatile uint32 *)0x4000C0A4))
-#define UART0_9BITAMASK_REG       (*((volatile uint32 *)0x4000C0A8))
-#define UART0_PP_REG              (*((volatile uint32 *)0x4000CFC0))
-#define UART0_CC_REG              (*((volatile uint32 *)0x4000CFC8))
+#define UART0_DR_REG              HW_REG(0x4000C000)
+#define UART0_RSR_REG             HW_REG(0x4000C004)
+#define UART0_ECR_REG             HW_REG(0x4000C004)
+#define UART0_FR_REG              HW_REG(0x4000C018)
+#define UART0_ILPR_REG            HW_REG(0x4000C020)
+#define UART0_IBRD_REG            HW_REG(0x4000C024)
+#define UART0_FBRD_REG            HW_REG(0x4000C028)
+#define UART0_LCRH_REG            HW_REG(0x4000C02C)
+#define UART0_CTL_REG             HW_REG(0x4000C030)
+#define UART0_IFLS_REG            HW_REG(0x4000C034)
+#define UART0_IM_REG              HW_REG(0x4000C038)
+#define UART0_RIS_REG             HW_REG(0x4000C03C)
+#define UART0_MIS_REG             HW_REG(0x4000C040)
+#define UART0_ICR_REG             HW_REG(0x4000C044)
+#define UART0_DMACTL_REG          HW_REG(0x4000C048)
+#define UART0_9BITADDR_REG        HW_REG(0x4000C0A4)
+#define UART0_9BITAMASK_REG       HW_REG(0x4000C0A8)
+#define UART0_PP_REG              HW_REG(0x4000CFC0)
+#define UART0_CC_REG              HW_REG(0x4000CFC8)
+
+/*****************************************************************************
+General-Purpose Timers Registers (GPTM)
+The 6 16/32-bit and 6 32/64-bit timers share one layout, each register is
+given as an offset from the base address of the timer
+*****************************************************************************/
+#define TIMER0_BASE               0x40030000
+#define TIMER1_BASE               0x40031000
+#define TIMER2_BASE               0x40032000
+#define TIMER3_BASE               0x40033000
+#define TIMER4_BASE               0x40034000
+#define TIMER5_BASE               0x40035000
+#define WTIMER0_BASE              0x40036000
+#define WTIMER1_BASE              0x40037000
+#define WTIMER2_BASE              0x4004C000
+#define WTIMER3_BASE              0x4004D000
+#define WTIMER4_BASE              0x4004E000
+#define WTIMER5_BASE              0x4004F000
+
+#define TIMER_CFG_REG(Base)       HW_REG((Base) + 0x000)
+#define TIMER_TAMR_REG(Base)      HW_REG((Base) + 0x004)
+#define TIMER_TBMR_REG(Base)      HW_REG((Base) + 0x008)
+#define TIMER_CTL_REG(Base)       HW_REG((Base) + 0x00C)
+#define TIMER_SYNC_REG(Base)      HW_REG((Base) + 0x010)
+#define TIMER_IMR_REG(Base)       HW_REG((Base) + 0x018)
+#define TIMER_RIS_REG(Base)       HW_REG((Base) + 0x01C)
+#define TIMER_MIS_REG(Base)       HW_REG((Base) + 0x020)
+#define TIMER_ICR_REG(Base)       HW_REG((Base) + 0x024)
+#define TIMER_TAILR_REG(Base)     HW_REG((Base) + 0x028)
+#define TIMER_TBILR_REG(Base)     HW_REG((Base) + 0x02C)
+#define TIMER_TAMATCHR_REG(Base)  HW_REG((Base) + 0x030)
+#define TIMER_TBMATCHR_REG(Base)  HW_REG((Base) + 0x034)
+#define TIMER_TAPR_REG(Base)      HW_REG((Base) + 0x038)
+#define TIMER_TBPR_REG(Base)      HW_REG((Base) + 0x03C)
+#define TIMER_TAPMR_REG(Base)     HW_REG((Base) + 0x040)
+#define TIMER_TBPMR_REG(Base)     HW_REG((Base) + 0x044)
+#define TIMER_TAR_REG(Base)       HW_REG((Base) + 0x048)
+#define TIMER_TBR_REG(Base)       HW_REG((Base) + 0x04C)
+#define TIMER_TAV_REG(Base)       HW_REG((Base) + 0x050)
+#define TIMER_TBV_REG(Base)       HW_REG((Base) + 0x054)
+#define TIMER_RTCPD_REG(Base)     HW_REG((Base) + 0x058)
+#define TIMER_TAPS_REG(Base)      HW_REG((Base) + 0x05C)
+#define TIMER_TBPS_REG(Base)      HW_REG((Base) + 0x060)
+#define TIMER_PP_REG(Base)        HW_REG((Base) + 0xFC0)
+
+/*****************************************************************************
+Analog-to-Digital Converter Registers (ADC)
+Both modules share one layout, the sample sequencer registers repeat every
+0x20 bytes from sequencer 0
+*****************************************************************************/
+#define ADC0_BASE                 0x40038000
+#define ADC1_BASE                 0x40039000
+
+#define ADC_ACTSS_REG(Base)       HW_REG((Base) + 0x000)
+#define ADC_RIS_REG(Base)         HW_REG((Base) + 0x004)
+#define ADC_IM_REG(Base)          HW_REG((Base) + 0x008)
+#define ADC_ISC_REG(Base)         HW_REG((Base) + 0x00C)
+#define ADC_OSTAT_REG(Base)       HW_REG((Base) + 0x010)
+#define ADC_EMUX_REG(Base)        HW_REG((Base) + 0x014)
+#define ADC_USTAT_REG(Base)       HW_REG((Base) + 0x018)
+#define ADC_TSSEL_REG(Base)       HW_REG((Base) + 0x01C)
+#define ADC_SSPRI_REG(Base)       HW_REG((Base) + 0x020)
+#define ADC_SPC_REG(Base)         HW_REG((Base) + 0x024)
+#define ADC_PSSI_REG(Base)        HW_REG((Base) + 0x028)
+#define ADC_SAC_REG(Base)         HW_REG((Base) + 0x030)
+#define ADC_DCISC_REG(Base)       HW_REG((Base) + 0x034)
+#define ADC_CTL_REG(Base)         HW_REG((Base) + 0x038)
+#define ADC_SSMUX_REG(Base, Seq)  HW_REG((Base) + 0x040 + ((Seq) * 0x20))
+#define ADC_SSCTL_REG(Base, Seq)  HW_REG((Base) + 0x044 + ((Seq) * 0x20))
+#define ADC_SSFIFO_REG(Base, Seq) HW_REG((Base) + 0x048 + ((Seq) * 0x20))
+#define ADC_SSFSTAT_REG(Base,Seq) HW_REG((Base) + 0x04C + ((Seq) * 0x20))
+#define ADC_SSOP_REG(Base, Seq)   HW_REG((Base) + 0x050 + ((Seq) * 0x20))
+#define ADC_SSDC_REG(Base, Seq)   HW_REG((Base) + 0x054 + ((Seq) * 0x20))
+#define ADC_PC_REG(Base)          HW_REG((Base) + 0xFC4)
+#define ADC_CC_REG(Base)          HW_REG((Base) + 0xFC8)
+
+/* Address of a sequencer FIFO, the uDMA source */
+#define ADC_SSFIFO_ADDRESS(Base, Seq) ((Base) + 0x048 + ((Seq) * 0x20))
+
+/*****************************************************************************
+Watchdog Timer Registers (WDT)
+WDT0 runs on the system clock, WDT1 on PIOSC and needs CTL WRC before each write
+*****************************************************************************/
+#define WDT0_BASE                 0x40000000
+#define WDT1_BASE                 0x40001000
+
+#define WDT_LOAD_REG(Base)        HW_REG((Base) + 0x000)
+#define WDT_VALUE_REG(Base)       HW_REG((Base) + 0x004)
+#define WDT_CTL_REG(Base)         HW_REG((Base) + 0x008)
+#define WDT_ICR_REG(Base)         HW_REG((Base) + 0x00C)
+#define WDT_RIS_REG(Base)         HW_REG((Base) + 0x010)
+#define WDT_MIS_REG(Base)         HW_REG((Base) + 0x014)
+#define WDT_TEST_REG(Base)        HW_REG((Base) + 0x418)
+#define WDT_LOCK_REG(Base)        HW_REG((Base) + 0xC00)
+
+/*****************************************************************************
+Inter-Integrated Circuit Registers (I2C)
+Master registers, MCS is the command register on a write and the status
+register on a read
+*****************************************************************************/
+#define I2C0_BASE                 0x40020000
+#define I2C1_BASE                 0x40021000
+#define I2C2_BASE                 0x40022000
+#define I2C3_BASE                 0x40023000
+
+#define I2C_MSA_REG(Base)         HW_REG((Base) + 0x000)
+#define I2C_MCS_REG(Base)         HW_REG((Base) + 0x004)
+#define I2C_MDR_REG(Base)         HW_REG((Base) + 0x008)
+#define I2C_MTPR_REG(Base)        HW_REG((Base) + 0x00C)
+#define I2C_MIMR_REG(Base)        HW_REG((Base) + 0x010)
+#define I2C_MRIS_REG(Base)        HW_REG((Base) + 0x014)
+#define I2C_MMIS_REG(Base)        HW_REG((Base) + 0x018)
+#define I2C_MICR_REG(Base)        HW_REG((Base) + 0x01C)
+#define I2C_MCR_REG(Base)         HW_REG((Base) + 0x020)
+#define I2C_MCLKOCNT_REG(Base)    HW_REG((Base) + 0x024)
+#define I2C_MBMON_REG(Base)       HW_REG((Base) + 0x02C)
+#define I2C_MCR2_REG(Base)        HW_REG((Base) + 0x038)
+#define I2C_PP_REG(Base)          HW_REG((Base) + 0xFC0)
+#define I2C_PC_REG(Base)          HW_REG((Base) + 0xFC4)
+
+/*****************************************************************************
+Controller Area Network Registers (CAN)
+Message objects are reached through the two interface register sets, If is 0
+for IF1 and 1 for IF2
+*****************************************************************************/
+#define CAN0_BASE                 0x40040000
+#define CAN1_BASE                 0x40041000
+
+#define CAN_CTL_REG(Base)         HW_REG((Base) + 0x000)
+#define CAN_STS_REG(Base)         HW_REG((Base) + 0x004)
+#define CAN_ERR_REG(Base)         HW_REG((Base) + 0x008)
+#define CAN_BIT_REG(Base)         HW_REG((Base) + 0x00C)
+#define CAN_INT_REG(Base)         HW_REG((Base) + 0x010)
+#define CAN_TST_REG(Base)         HW_REG((Base) + 0x014)
+#define CAN_BRPE_REG(Base)        HW_REG((Base) + 0x018)
+
+#define CAN_IFCRQ_REG(Base, If)   HW_REG((Base) + 0x020 + ((If) * 0x60))
+#define CAN_IFCMSK_REG(Base, If)  HW_REG((Base) + 0x024 + ((If) * 0x60))
+#define CAN_IFMSK1_REG(Base, If)  HW_REG((Base) + 0x028 + ((If) * 0x60))
+#define CAN_IFMSK2_REG(Base, If)  HW_REG((Base) + 0x02C + ((If) * 0x60))
+#define CAN_IFARB1_REG(Base, If)  HW_REG((Base) + 0x030 + ((If) * 0x60))
+#define CAN_IFARB2_REG(Base, If)  HW_REG((Base) + 0x034 + ((If) * 0x60))
+#define CAN_IFMCTL_REG(Base, If)  HW_REG((Base) + 0x038 + ((If) * 0x60))
+#define CAN_IFDA1_REG(Base, If)   HW_REG((Base) + 0x03C + ((If) * 0x60))
+#define CAN_IFDA2_REG(Base, If)   HW_REG((Base) + 0x040 + ((If) * 0x60))
+#define CAN_IFDB1_REG(Base, If)   HW_REG((Base) + 0x044 + ((If) * 0x60))
+#define CAN_IFDB2_REG(Base, If)   HW_REG((Base) + 0x048 + ((If) * 0x60))
+
+/* One bit per message object, objects 1 ... 16 in the first, 17 ... 32 in the second */
+#define CAN_TXRQ1_REG(Base)       HW_REG((Base) + 0x100)
+#define CAN_TXRQ2_REG(Base)       HW_REG((Base) + 0x104)
+#define CAN_NWDA1_REG(Base)       HW_REG((Base) + 0x120)
+#define CAN_NWDA2_REG(Base)       HW_REG((Base) + 0x124)
+#define CAN_MSG1INT_REG(Base)     HW_REG((Base) + 0x140)
+#define CAN_MSG2INT_REG(Base)     HW_REG((Base) + 0x144)
+#define CAN_MSG1VAL_REG(Base)     HW_REG((Base) + 0x160)
+#define CAN_MSG2VAL_REG(Base)     HW_REG((Base) + 0x164)
+
+/*****************************************************************************
+Quadrature Encoder Interface Registers (QEI)
+*****************************************************************************/
+#define QEI0_BASE                 0x4002C000
+#define QEI1_BASE                 0x4002D000
+
+#define QEI_CTL_REG(Base)         HW_REG((Base) + 0x000)
+#define QEI_STAT_REG(Base)        HW_REG((Base) + 0x004)
+#define QEI_POS_REG(Base)         HW_REG((Base) + 0x008)
+#define QEI_MAXPOS_REG(Base)      HW_REG((Base) + 0x00C)
+#define QEI_LOAD_REG(Base)        HW_REG((Base) + 0x010)
+#define QEI_TIME_REG(Base)        HW_REG((Base) + 0x014)
+#define QEI_COUNT_REG(Base)       HW_REG((Base) + 0x018)
+#define QEI_SPEED_REG(Base)       HW_REG((Base) + 0x01C)
+#define QEI_INTEN_REG(Base)       HW_REG((Base) + 0x020)
+#define QEI_RIS_REG(Base)         HW_REG((Base) + 0x024)
+#define QEI_ISC_REG(Base)         HW_REG((Base) + 0x028)
+
+/*****************************************************************************
+Pulse Width Modulator Registers (PWM)
+Both modules share one layout, the generator registers repeat every 0x40
+bytes from generator 0 and the extended fault registers every 0x80 bytes
+*****************************************************************************/
+#define PWM0_BASE                 0x40028000
+#define PWM1_BASE                 0x40029000
+
+#define PWM_CTL_REG(Base)         HW_REG((Base) + 0x000)
+#define PWM_SYNC_REG(Base)        HW_REG((Base) + 0x004)
+#define PWM_ENABLE_REG(Base)      HW_REG((Base) + 0x008)
+#define PWM_INVERT_REG(Base)      HW_REG((Base) + 0x00C)
+#define PWM_FAULT_REG(Base)       HW_REG((Base) + 0x010)
+#define PWM_INTEN_REG(Base)       HW_REG((Base) + 0x014)
+#define PWM_RIS_REG(Base)         HW_REG((Base) + 0x018)
+#define PWM_ISC_REG(Base)         HW_REG((Base) + 0x01C)
+#define PWM_STATUS_REG(Base)      HW_REG((Base) + 0x020)
+#define PWM_FAULTVAL_REG(Base)    HW_REG((Base) + 0x024)
+#define PWM_ENUPD_REG(Base)       HW_REG((Base) + 0x028)
+#define PWM_GEN_CTL_REG(Base, Gen)      HW_REG((Base) + 0x040 + ((Gen) * 0x40))
+#define PWM_GEN_INTEN_REG(Base, Gen)    HW_REG((Base) + 0x044 + ((Gen) * 0x40))
+#define PWM_GEN_RIS_REG(Base, Gen)      HW_REG((Base) + 0x048 + ((Gen) * 0x40))
+#define PWM_GEN_ISC_REG(Base, Gen)      HW_REG((Base) + 0x04C + ((Gen) * 0x40))
+#define PWM_GEN_LOAD_REG(Base, Gen)     HW_REG((Base) + 0x050 + ((Gen) * 0x40))
+#define PWM_GEN_COUNT_REG(Base, Gen)    HW_REG((Base) + 0x054 + ((Gen) * 0x40))
+#define PWM_GEN_CMPA_REG(Base, Gen)     HW_REG((Base) + 0x058 + ((Gen) * 0x40))
+#define PWM_GEN_CMPB_REG(Base, Gen)     HW_REG((Base) + 0x05C + ((Gen) * 0x40))
+#define PWM_GEN_GENA_REG(Base, Gen)     HW_REG((Base) + 0x060 + ((Gen) * 0x40))
+#define PWM_GEN_GENB_REG(Base, Gen)     HW_REG((Base) + 0x064 + ((Gen) * 0x40))
+#define PWM_GEN_DBCTL_REG(Base, Gen)    HW_REG((Base) + 0x068 + ((Gen) * 0x40))
+#define PWM_GEN_DBRISE_REG(Base, Gen)   HW_REG((Base) + 0x06C + ((Gen) * 0x40))
+#define PWM_GEN_DBFALL_REG(Base, Gen)   HW_REG((Base) + 0x070 + ((Gen) * 0x40))
+#define PWM_GEN_FLTSRC0_REG(Base, Gen)  HW_REG((Base) + 0x074 + ((Gen) * 0x40))
+#define PWM_GEN_FLTSRC1_REG(Base, Gen)  HW_REG((Base) + 0x078 + ((Gen) * 0x40))
+#define PWM_GEN_MINFLTPER_REG(Base, Gen) HW_REG((Base) + 0x07C + ((Gen) * 0x40))
+#define PWM_GEN_FLTSEN_REG(Base, Gen)   HW_REG((Base) + 0x800 + ((Gen) * 0x80))
+#define PWM_GEN_FLTSTAT0_REG(Base, Gen) HW_REG((Base) + 0x804 + ((Gen) * 0x80))
+#define PWM_GEN_FLTSTAT1_REG(Base, Gen) HW_REG((Base) + 0x808 + ((Gen) * 0x80))
+#define PWM_PP_REG(Base)          HW_REG((Base) + 0xFC0)
+
+/*****************************************************************************
+Synchronous Serial Interface Registers (SSI)
+*****************************************************************************/
+#define SSI0_BASE                 0x40008000
+#define SSI1_BASE                 0x40009000
+#define SSI2_BASE                 0x4000A000
+#define SSI3_BASE                 0x4000B000
+
+#define SSI_CR0_REG(Base)         HW_REG((Base) + 0x000)
+#define SSI_CR1_REG(Base)         HW_REG((Base) + 0x004)
+#define SSI_DR_REG(Base)          HW_REG((Base) + 0x008)
+#define SSI_SR_REG(Base)          HW_REG((Base) + 0x00C)
+#define SSI_CPSR_REG(Base)        HW_REG((Base) + 0x010)
+#define SSI_IM_REG(Base)          HW_REG((Base) + 0x014)
+#define SSI_RIS_REG(Base)         HW_REG((Base) + 0x018)
+#define SSI_MIS_REG(Base)         HW_REG((Base) + 0x01C)
+#define SSI_ICR_REG(Base)         HW_REG((Base) + 0x020)
+#define SSI_DMACTL_REG(Base)      HW_REG((Base) + 0x024)
+#define SSI_CC_REG(Base)          HW_REG((Base) + 0xFC8)
+
+/* Address of the data register, the uDMA source and destination */
+#define SSI_DR_ADDRESS(Base)      ((Base) + 0x008)
 
 /*****************************************************************************
 Micro Direct Memory Access Registers (UDMA)
 *****************************************************************************/
-#define UDMA_STAT_REG             (*((volatile uint32 *)0x400FF000))
-#define UDMA_CFG_REG              (*((volatile uint32 *)0x400FF004))
-#define UDMA_CTLBASE_REG          (*((volatile uint32 *)0x400FF008))
-#define UDMA_ALTBASE_REG          (*((volatile uint32 *)0x400FF00C))
-#define UDMA_WAITSTAT_REG         (*((volatile uint32 *)0x400FF010))
-#define UDMA_SWREQ_REG            (*((volatile uint32 *)0x400FF014))
-#define UDMA_USEBURSTSET_REG      (*((volatile uint32 *)0x400FF018))
-#define UDMA_USEBURSTCLR_R      (*((volatile uint32 *)0x400FF01C))
-#define UDMA_REQMASKSET_REG       (*((volatile uint32 *)0x400FF020))
-#define UDMA_REQMASKCLR_REG       (*((volatile uint32 *)0x400FF024))
-#define UDMA_ENASET_REG           (*((volatile uint32 *)0x400FF028))
-#define UDMA_ENACLR_REG           (*((volatile uint32 *)0x400FF02C))
-#define UDMA_ALTSET_REG           (*((volatile uint32 *)0x400FF030))
-#define UDMA_ALTCLR_REG           (*((volatile uint32 *)0x400FF034))
-#define UDMA_PRIOSET_REG          (*((volatile uint32 *)0x400FF038))
-#define UDMA_PRIOCLR_REG          (*((volatile uint32 *)0x400FF03C))
-#define UDMA_ERRCLR_REG           (*((volatile uint32 *)0x400FF04C))
-#define UDMA_CHASGN_REG           (*((volatile uint32 *)0x400FF500))
-#define UDMA_CHIS_REG             (*((volatile uint32 *)0x400FF504))
-#define UDMA_CHMAP0_REG           (*((volatile uint32 *)0x400FF510))
-#define UDMA_CHMAP1_REG           (*((volatile uint32 *)0x400FF514))
-#define UDMA_CHMAP2_REG           (*((volatile uint32 *)0x400FF518))
-#define UDMA_CHMAP3_REG           (*((volatile uint32 *)0x400FF51C))
+#define UDMA_STAT_REG             HW_REG(0x400FF000)
+#define UDMA_CFG_REG              HW_REG(0x400FF004)
+#define UDMA_CTLBASE_REG          HW_REG(0x400FF008)
+#define UDMA_ALTBASE_REG          HW_REG(0x400FF00C)
+#define UDMA_WAITSTAT_REG         HW_REG(0x400FF010)
+#define UDMA_SWREQ_REG            HW_REG(0x400FF014)
+#define UDMA_USEBURSTSET_REG      HW_REG(0x400FF018)
+#define UDMA_USEBURSTCLR_REG      HW_REG(0x400FF01C)
+#define UDMA_REQMASKSET_REG       HW_REG(0x400FF020)
+#define UDMA_REQMASKCLR_REG       HW_REG(0x400FF024)
+#define UDMA_ENASET_REG           HW_REG(0x400FF028)
+#define UDMA_ENACLR_REG           HW_REG(0x400FF02C)
+#define UDMA_ALTSET_REG           HW_REG(0x400FF030)
+#define UDMA_ALTCLR_REG           HW_REG(0x400FF034)
+#define UDMA_PRIOSET_REG          HW_REG(0x400FF038)
+#define UDMA_PRIOCLR_REG          HW_REG(0x400FF03C)
+#define UDMA_ERRCLR_REG           HW_REG(0x400FF04C)
+#define UDMA_CHASGN_REG           HW_REG(0x400FF500)
+#define UDMA_CHIS_REG             HW_REG(0x400FF504)
+#define UDMA_CHMAP0_REG           HW_REG(0x400FF510)
+#define UDMA_CHMAP1_REG           HW_REG(0x400FF514)
+#define UDMA_CHMAP2_REG           HW_REG(0x400FF518)
+#define UDMA_CHMAP3_REG           HW_REG(0x400FF51C)
+#define UDMA_CHMAP_REG(Channel)   HW_REG(0x400FF510 + (((Channel) / 8) * 4))
 
 /*****************************************************************************
 Flash Registers
 *****************************************************************************/
-#define FLASH_FMA_REG             (*((volatile uint32 *)0x400FD000))
-#define FLASH_FMD_REG             (*((volatile uint32 *)0x400FD004))
-#define FLASH_FMC_REG             (*((volatile uint32 *)0x400FD008))
-#define FLASH_FCRIS_REG           (*((volatile uint32 *)0x400FD00C))
-#define FLASH_FCIM_REG            (*((volatile uint32 *)0x400FD010))
-#define FLASH_FCMISC_REG          (*((volatile uint32 *)0x400FD014))
-#define FLASH_FMC2_REG            (*((volatile uint32 *)0x400FD020))
-#define FLASH_FWBVAL_REG          (*((volatile uint32 *)0x400FD030))
-#define FLASH_FWBN_REG            (*((volatile uint32 *)0x400FD100))
-#define FLASH_FSIZE_REG           (*((volatile uint32 *)0x400FDFC0))
-#define FLASH_SSIZE_REG           (*((volatile uint32 *)0x400FDFC4))
-#define FLASH_ROMSWMAP_REG        (*((volatile uint32 *)0x400FDFCC))
-#define FLASH_RMCTL_REG           (*((volatile uint32 *)0x400FE0F0))
-#define FLASH_BOOTCFG_REG         (*((volatile uint32 *)0x400FE1D0))
-#define FLASH_USERREG0_REG        (*((volatile uint32 *)0x400FE1E0))
-#define FLASH_USERREG1_REG        (*((volatile uint32 *)0x400FE1E4))
-#define FLASH_USERREG2_REG        (*((volatile uint32 *)0x400FE1E8))
-#define FLASH_USERREG3_REG        (*((volatile uint32 *)0x400FE1EC))
-#define FLASH_FMPRE0_REG          (*((volatile uint32 *)0x400FE200))
-#define FLASH_FMPRE1_REG          (*((volatile uint32 *)0x400FE204))
-#define FLASH_FMPRE2_REG          (*((volatile uint32 *)0x400FE208))
-#define FLASH_FMPRE3_REG          (*((volatile uint32 *)0x400FE20C))
-#define FLASH_FMPPE0_REG          (*((volatile uint32 *)0x400FE400))
-#define FLASH_FMPPE1_REG          (*((volatile uint32 *)0x400FE404))
-#define FLASH_FMPPE2_REG          (*((volatile uint32 *)0x400FE408))
-#define FLASH_FMPPE3_REG          (*((volatile uint32 *)0x400FE40C))
+#define FLASH_FMA_REG             HW_REG(0x400FD000)
+#define FLASH_FMD_REG             HW_REG(0x400FD004)
+#define FLASH_FMC_REG             HW_REG(0x400FD008)
+#define FLASH_FCRIS_REG           HW_REG(0x400FD00C)
+#define FLASH_FCIM_REG            HW_REG(0x400FD010)
+#define FLASH_FCMISC_REG          HW_REG(0x400FD014)
+#define FLASH_FMC2_REG            HW_REG(0x400FD020)
+#define FLASH_FWBVAL_REG          HW_REG(0x400FD030)
+#define FLASH_FWBN_REG            HW_REG(0x400FD100)
+#define FLASH_FSIZE_REG           HW_REG(0x400FDFC0)
+#define FLASH_SSIZE_REG           HW_REG(0x400FDFC4)
+#define FLASH_ROMSWMAP_REG        HW_REG(0x400FDFCC)
+#define FLASH_RMCTL_REG           HW_REG(0x400FE0F0)
+#define FLASH_BOOTCFG_REG         HW_REG(0x400FE1D0)
+#define FLASH_USERREG0_REG        HW_REG(0x400FE1E0)
+#define FLASH_USERREG1_REG        HW_REG(0x400FE1E4)
+#define FLASH_USERREG2_REG        HW_REG(0x400FE1E8)
+#define FLASH_USERREG3_REG        HW_REG(0x400FE1EC)
+#define FLASH_FMPRE0_REG          HW_REG(0x400FE200)
+#define FLASH_FMPRE1_REG          HW_REG(0x400FE204)
+#define FLASH_FMPRE2_REG          HW_REG(0x400FE208)
+#define FLASH_FMPRE3_REG          HW_REG(0x400FE20C)
+#define FLASH_FMPPE0_REG          HW_REG(0x400FE400)
+#define FLASH_FMPPE1_REG          HW_REG(0x400FE404)
+#define FLASH_FMPPE2_REG          HW_REG(0x400FE408)
+#define FLASH_FMPPE3_REG          HW_REG(0x400FE40C)
+
+/*****************************************************************************
+EEPROM Registers
+2 KB in 32 blocks of 16 words, its done interrupt is reported by the flash
+controller FCRIS/FCIM/FCMISC
+*****************************************************************************/
+#define EEPROM_EESIZE_REG         HW_REG(0x400AF000)
+#define EEPROM_EEBLOCK_REG        HW_REG(0x400AF004)
+#define EEPROM_EEOFFSET_REG       HW_REG(0x400AF008)
+#define EEPROM_EERDWR_REG         HW_REG(0x400AF010)
+#define EEPROM_EERDWRINC_REG      HW_REG(0x400AF014)
+#define EEPROM_EEDONE_REG         HW_REG(0x400AF018)
+#define EEPROM_EESUPP_REG         HW_REG(0x400AF01C)
+#define EEPROM_EEUNLOCK_REG       HW_REG(0x400AF020)
+#define EEPROM_EEPROT_REG         HW_REG(0x400AF030)
+#define EEPROM_EEPASS0_REG        HW_REG(0x400AF034)
+#define EEPROM_EEINT_REG          HW_REG(0x400AF040)
+#define EEPROM_EEHIDE_REG         HW_REG(0x400AF050)
+#define EEPROM_EEDBGME_REG        HW_REG(0x400AF080)
+#define EEPROM_PP_REG             HW_REG(0x400AFFC0)
+
+/*****************************************************************************
+Hibernation Module Registers (HIB)
+Battery backed, a write must wait for HIBCTL WRC; HIBDATA holds 16 words
+*****************************************************************************/
+#define HIB_RTCC_REG              HW_REG(0x400FC000)
+#define HIB_RTCM0_REG             HW_REG(0x400FC004)
+#define HIB_RTCLD_REG             HW_REG(0x400FC00C)
+#define HIB_CTL_REG               HW_REG(0x400FC010)
+#define HIB_IM_REG                HW_REG(0x400FC014)
+#define HIB_RIS_REG               HW_REG(0x400FC018)
+#define HIB_MIS_REG               HW_REG(0x400FC01C)
+#define HIB_IC_REG                HW_REG(0x400FC020)
+#define HIB_RTCT_REG              HW_REG(0x400FC024)
+#define HIB_RTCSS_REG             HW_REG(0x400FC028)
+#define HIB_DATA_REG(Word)        HW_REG(0x400FC030 + ((Word) * 4))
 
 #endif
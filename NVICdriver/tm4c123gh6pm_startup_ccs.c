@@ -26,13 +26,10 @@
 
 //*****************************************************************************
 //
-// Forward declaration of the default fault handlers.
+// Forward declaration of the reset handler.
 //
 //*****************************************************************************
 void ResetISR(void);
-static void NmiSR(void);
-static void FaultISR(void);
-static void IntDefaultHandler(void);
 
 //*****************************************************************************
 //
@@ -42,6 +39,15 @@ static void IntDefaultHandler(void);
 //*****************************************************************************
 extern void _c_int00(void);
 
+//*****************************************************************************
+//
+// External declaration for the fault capture handler (Fault_Entry.asm).  It is
+// placed directly in the NMI, fault and default slots: a C function in between
+// could move MSP in its prologue before the stacked frame is read.
+//
+//*****************************************************************************
+extern void Fault_Handler(void);
+
 //*****************************************************************************
 //
 // Linker variable that marks the top of the stack.
@@ -69,103 +75,103 @@ void (* const g_pfnVectors[])(void) =
     (void (*)(void))((uint32_t)&__STACK_TOP),
                                             // The initial stack pointer
     ResetISR,                               // The reset handler
-    NmiSR,                                  // The NMI handler
-    FaultISR,                               // The hard fault handler
-    IntDefaultHandler,                      // The MPU fault handler
-    IntDefaultHandler,                      // The bus fault handler
-    IntDefaultHandler,                      // The usage fault handler
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    IntDefaultHandler,                      // SVCall handler
-    IntDefaultHandler,                      // Debug monitor handler
-    0,                                      // Reserved
-    IntDefaultHandler,                      // The PendSV handler
-    IntDefaultHandler,                      // The SysTick handler
-    IntDefaultHandler,                      // GPIO Port A
-    IntDefaultHandler,                      // GPIO Port B
-    IntDefaultHandler,                      // GPIO Port C
-    IntDefaultHandler,                      // GPIO Port D
-    IntDefaultHandler,                      // GPIO Port E
-    IntDefaultHandler,                      // UART0 Rx and Tx
-    IntDefaultHandler,                      // UART1 Rx and Tx
-    IntDefaultHandler,                      // SSI0 Rx and Tx
-    IntDefaultHandler,                      // I2C0 Master and Slave
-    IntDefaultHandler,                      // PWM Fault
-    IntDefaultHandler,                      // PWM Generator 0
-    IntDefaultHandler,                      // PWM Generator 1
-    IntDefaultHandler,                      // PWM Generator 2
-    IntDefaultHandler,                      // Quadrature Encoder 0
-    IntDefaultHandler,                      // ADC Sequence 0
-    IntDefaultHandler,                      // ADC Sequence 1
-    IntDefaultHandler,                      // ADC Sequence 2
-    IntDefaultHandler,                      // ADC Sequence 3
-    IntDefaultHandler,                      // Watchdog timer
-    IntDefaultHandler,                      // Timer 0 subtimer A
-    IntDefaultHandler,                      // Timer 0 subtimer B
-    IntDefaultHandler,                      // Timer 1 subtimer A
-    IntDefaultHandler,                      // Timer 1 subtimer B
-    IntDefaultHandler,                      // Timer 2 subtimer A
-    IntDefaultHandler,                      // Timer 2 subtimer B
-    IntDefaultHandler,                      // Analog Comparator 0
-    IntDefaultHandler,                      // Analog Comparator 1
-    IntDefaultHandler,                      // Analog Comparator 2
-    IntDefaultHandler,                      // System Control (PLL, OSC, BO)
-    IntDefaultHandler,                      // FLASH Control
-    IntDefaultHandler,                      // GPIO Port F
-    IntDefaultHandler,                      // GPIO Port G
-    IntDefaultHandler,                      // GPIO Port H
-    IntDefaultHandler,                      // UART2 Rx and Tx
-    IntDefaultHandler,                      // SSI1 Rx and Tx
-    IntDefaultHandler,                      // Timer 3 subtimer A
-    IntDefaultHandler,                      // Timer 3 subtimer B
-    IntDefaultHandler,                      // I2C1 Master and Slave
-    IntDefaultHandler,                      // Quadrature Encoder 1
-    IntDefaultHandler,                      // CAN0
-    IntDefaultHandler,                      // CAN1
-    0,                                      // Reserved
-    0,                                      // Reserved
-    IntDefaultHandler,                      // Hibernate
-    IntDefaultHandler,                      // USB0
-    IntDefaultHandler,                      // PWM Generator 3
-    IntDefaultHandler,                      // uDMA Software Transfer
-    IntDefaultHandler,                      // uDMA Error
-    IntDefaultHandler,                      // ADC1 Sequence 0
-    IntDefaultHandler,                      // ADC1 Sequence 1
-    IntDefaultHandler,                      // ADC1 Sequence 2
-    IntDefaultHandler,                      // ADC1 Sequence 3
-    0,                                      // Reserved
-    0,                                      // Reserved
-    IntDefaultHandler,                      // GPIO Port J
-    IntDefaultHandler,                      // GPIO Port K
-    IntDefaultHandler,                      // GPIO Port L
-    IntDefaultHandler,                      // SSI2 Rx and Tx
-    IntDefaultHandler,                      // SSI3 Rx and Tx
-    IntDefaultHandler,                      // UART3 Rx and Tx
-    IntDefaultHandler,                      // UART4 Rx and Tx
-    IntDefaultHandler,                      // UART5 Rx and Tx
-    IntDefaultHandler,                      // UART6 Rx and Tx
-    IntDefaultHandler,                      // UART7 Rx and Tx
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    IntDefaultHandler,                      // I2C2 Master and Slave
-    IntDefaultHandler,                      // I2C3 Master and Slave
-    IntDefaultHandler,                      // Timer 4 subtimer A
-    IntDefaultHandler,                      // Timer 4 subtimer B
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
-    0,                                      // Reserved
+    Fault_Handler,                          // The NMI handler
+    Fault_Handler,                          // The hard fault handler
+    Fault_Handler,                          // The MPU fault handler
+    Fault_Handler,                          // The bus fault handler
+    Fault_Handler,                          // The usage fault handler
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Fault_Handler,                          // SVCall handler
+    Fault_Handler,                          // Debug monitor handler
+    0,                                      // Reserved
+    Fault_Handler,                          // The PendSV handler
+    Fault_Handler,                          // The SysTick handler
+    Fault_Handler,                          // GPIO Port A
+    Fault_Handler,                          // GPIO Port B
+    Fault_Handler,                          // GPIO Port C
+    Fault_Handler,                          // GPIO Port D
+    Fault_Handler,                          // GPIO Port E
+    Fault_Handler,                          // UART0 Rx and Tx
+    Fault_Handler,                          // UART1 Rx and Tx
+    Fault_Handler,                          // SSI0 Rx and Tx
+    Fault_Handler,                          // I2C0 Master and Slave
+    Fault_Handler,                          // PWM Fault
+    Fault_Handler,                          // PWM Generator 0
+    Fault_Handler,                          // PWM Generator 1
+    Fault_Handler,                          // PWM Generator 2
+    Fault_Handler,                          // Quadrature Encoder 0
+    Fault_Handler,                          // ADC Sequence 0
+    Fault_Handler,                          // ADC Sequence 1
+    Fault_Handler,                          // ADC Sequence 2
+    Fault_Handler,                          // ADC Sequence 3
+    Fault_Handler,                          // Watchdog timer
+    Fault_Handler,                          // Timer 0 subtimer A
+    Fault_Handler,                          // Timer 0 subtimer B
+    Fault_Handler,                          // Timer 1 subtimer A
+    Fault_Handler,                          // Timer 1 subtimer B
+    Fault_Handler,                          // Timer 2 subtimer A
+    Fault_Handler,                          // Timer 2 subtimer B
+    Fault_Handler,                          // Analog Comparator 0
+    Fault_Handler,                          // Analog Comparator 1
+    Fault_Handler,                          // Analog Comparator 2
+    Fault_Handler,                          // System Control (PLL, OSC, BO)
+    Fault_Handler,                          // FLASH Control
+    Fault_Handler,                          // GPIO Port F
+    Fault_Handler,                          // GPIO Port G
+    Fault_Handler,                          // GPIO Port H
+    Fault_Handler,                          // UART2 Rx and Tx
+    Fault_Handler,                          // SSI1 Rx and Tx
+    Fault_Handler,                          // Timer 3 subtimer A
+    Fault_Handler,                          // Timer 3 subtimer B
+    Fault_Handler,                          // I2C1 Master and Slave
+    Fault_Handler,                          // Quadrature Encoder 1
+    Fault_Handler,                          // CAN0
+    Fault_Handler,                          // CAN1
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Fault_Handler,                          // Hibernate
+    Fault_Handler,                          // USB0
+    Fault_Handler,                          // PWM Generator 3
+    Fault_Handler,                          // uDMA Software Transfer
+    Fault_Handler,                          // uDMA Error
+    Fault_Handler,                          // ADC1 Sequence 0
+    Fault_Handler,                          // ADC1 Sequence 1
+    Fault_Handler,                          // ADC1 Sequence 2
+    Fault_Handler,                          // ADC1 Sequence 3
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Fault_Handler,                          // GPIO Port J
+    Fault_Handler,                          // GPIO Port K
+    Fault_Handler,                          // GPIO Port L
+    Fault_Handler,                          // SSI2 Rx and Tx
+    Fault_Handler,                          // SSI3 Rx and Tx
+    Fault_Handler,                          // UART3 Rx and Tx
+    Fault_Handler,                          // UART4 Rx and Tx
+    Fault_Handler,                          // UART5 Rx and Tx
+    Fault_Handler,                          // UART6 Rx and Tx
+    Fault_Handler,                          // UART7 Rx and Tx
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    Fault_Handler,                          // I2C2 Master and Slave
+    Fault_Handler,                          // I2C3 Master and Slave
+    Fault_Handler,                          // Timer 4 subtimer A
+    Fault_Handler,                          // Timer 4 subtimer B
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
+    0,                                      // Reserved
     0,                                      // Reserved
     0,                                      // Reserved
     0,                                      // Reserved
@@ -175,53 +181,53 @@ void (* const g_pfnVectors[])(void) =
     0,                                      // Reserved
     0,                                      // Reserved
     0,                                      // Reserved
-    IntDefaultHandler,                      // Timer 5 subtimer A
-    IntDefaultHandler,                      // Timer 5 subtimer B
-    IntDefaultHandler,                      // Wide Timer 0 subtimer A
-    IntDefaultHandler,                      // Wide Timer 0 subtimer B
-    IntDefaultHandler,                      // Wide Timer 1 subtimer A
-    IntDefaultHandler,                      // Wide Timer 1 subtimer B
-    IntDefaultHandler,                      // Wide Timer 2 subtimer A
-    IntDefaultHandler,                      // Wide Timer 2 subtimer B
-    IntDefaultHandler,                      // Wide Timer 3 subtimer A
-    IntDefaultHandler,                      // Wide Timer 3 subtimer B
-    IntDefaultHandler,                      // Wide Timer 4 subtimer A
-    IntDefaultHandler,                      // Wide Timer 4 subtimer B
-    IntDefaultHandler,                      // Wide Timer 5 subtimer A
-    IntDefaultHandler,                      // Wide Timer 5 subtimer B
-    IntDefaultHandler,                      // FPU
-    0,                                      // Reserved
+    Fault_Handler,                          // Timer 5 subtimer A
+    Fault_Handler,                          // Timer 5 subtimer B
+    Fault_Handler,                          // Wide Timer 0 subtimer A
+    Fault_Handler,                          // Wide Timer 0 subtimer B
+    Fault_Handler,                          // Wide Timer 1 subtimer A
+    Fault_Handler,                          // Wide Timer 1 subtimer B
+    Fault_Handler,                          // Wide Timer 2 subtimer A
+    Fault_Handler,                          // Wide Timer 2 subtimer B
+    Fault_Handler,                          // Wide Timer 3 subtimer A
+    Fault_Handler,                          // Wide Timer 3 subtimer B
+    Fault_Handler,                          // Wide Timer 4 subtimer A
+    Fault_Handler,                          // Wide Timer 4 subtimer B
+    Fault_Handler,                          // Wide Timer 5 subtimer A
+    Fault_Handler,                          // Wide Timer 5 subtimer B
+    Fault_Handler,                          // FPU
+    0,                                      // Reserved
     0,                                      // Reserved
-    IntDefaultHandler,                      // I2C4 Master and Slave
-    IntDefaultHandler,                      // I2C5 Master and Slave
-    IntDefaultHandler,                      // GPIO Port M
-    IntDefaultHandler,                      // GPIO Port N
-    IntDefaultHandler,                      // Quadrature Encoder 2
+    Fault_Handler,                          // I2C4 Master and Slave
+    Fault_Handler,                          // I2C5 Master and Slave
+    Fault_Handler,                          // GPIO Port M
+    Fault_Handler,                          // GPIO Port N
+    Fault_Handler,                          // Quadrature Encoder 2
     0,                                      // Reserved
     0,                                      // Reserved
-    IntDefaultHandler,                      // GPIO Port P (Summary or P0)
-    IntDefaultHandler,                      // GPIO Port P1
-    IntDefaultHandler,                      // GPIO Port P2
-    IntDefaultHandler,                      // GPIO Port P3
-    IntDefaultHandler,                      // GPIO Port P4
-    IntDefaultHandler,                      // GPIO Port P5
-    IntDefaultHandler,                      // GPIO Port P6
-    IntDefaultHandler,                      // GPIO Port P7
-    IntDefaultHandler,                      // GPIO Port Q (Summary or Q0)
-    IntDefaultHandler,                      // GPIO Port Q1
-    IntDefaultHandler,                      // GPIO Port Q2
-    IntDefaultHandler,                      // GPIO Port Q3
-    IntDefaultHandler,                      // GPIO Port Q4
-    IntDefaultHandler,                      // GPIO Port Q5
-    IntDefaultHandler,                      // GPIO Port Q6
-    IntDefaultHandler,                      // GPIO Port Q7
-    IntDefaultHandler,                      // GPIO Port R
-    IntDefaultHandler,                      // GPIO Port S
-    IntDefaultHandler,                      // PWM 1 Generator 0
-    IntDefaultHandler,                      // PWM 1 Generator 1
-    IntDefaultHandler,                      // PWM 1 Generator 2
-    IntDefaultHandler,                      // PWM 1 Generator 3
-    IntDefaultHandler                       // PWM 1 Fault
+    Fault_Handler,                          // GPIO Port P (Summary or P0)
+    Fault_Handler,                          // GPIO Port P1
+    Fault_Handler,                          // GPIO Port P2
+    Fault_Handler,                          // GPIO Port P3
+    Fault_Handler,                          // GPIO Port P4
+    Fault_Handler,                          // GPIO Port P5
+    Fault_Handler,                          // GPIO Port P6
+    Fault_Handler,                          // GPIO Port P7
+    Fault_Handler,                          // GPIO Port Q (Summary or Q0)
+    Fault_Handler,                          // GPIO Port Q1
+    Fault_Handler,                          // GPIO Port Q2
+    Fault_Handler,                          // GPIO Port Q3
+    Fault_Handler,                          // GPIO Port Q4
+    Fault_Handler,                          // GPIO Port Q5
+    Fault_Handler,                          // GPIO Port Q6
+    Fault_Handler,                          // GPIO Port Q7
+    Fault_Handler,                          // GPIO Port R
+    Fault_Handler,                          // GPIO Port S
+    Fault_Handler,                          // PWM 1 Generator 0
+    Fault_Handler,                          // PWM 1 Generator 1
+    Fault_Handler,                          // PWM 1 Generator 2
+    Fault_Handler,                          // PWM 1 Generator 3
+    Fault_Handler                           // PWM 1 Fault
 };
 
 //*****************************************************************************
@@ -244,57 +250,3 @@ ResetISR(void)
     __asm("    .global _c_int00\n"
           "    b.w     _c_int00");
 }
-
-//*****************************************************************************
-//
-// This is the code that gets called when the processor receives a NMI.  This
-// simply enters an infinite loop, preserving the system state for examination
-// by a debugger.
-//
-//*****************************************************************************
-static void
-NmiSR(void)
-{
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
-
-//*****************************************************************************
-//
-// This is the code that gets called when the processor receives a fault
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
-//
-//*****************************************************************************
-static void
-FaultISR(void)
-{
-    //
-    // Enter an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
-
-//*****************************************************************************
-//
-// This is the code that gets called when the processor receives an unexpected
-// interrupt.  This simply enters an infinite loop, preserving the system state
-// for examination by a debugger.
-//
-//*****************************************************************************
-static void
-IntDefaultHandler(void)
-{
-    //
-    // Go into an infinite loop.
-    //
-    while(1)
-    {
-    }
-}
@@ -0,0 +1,454 @@
+/******************************************************************************
+ *
+ * Module: PWM
+ *
+ * File Name: PWM.c
+ *
+ * Description: Source file for the TM4C123GH6PM PWM generator driver with globally
+ *              synchronized duty updates, dead-band and fault inputs
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "PWM.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* RCC PWM clock divider */
+#define PWM_RCC_USEPWMDIV             0x00100000
+#define PWM_RCC_PWMDIV_MASK           0x000E0000
+#define PWM_RCC_PWMDIV_POS            17
+
+/*
+ * PWMnCTL: the load and compare registers wait for a PWMCTL GLOBALSYNCn request,
+ * the generator and dead-band registers are only written while configuring
+ */
+#define PWM_GEN_CTL_ENABLE            0x00001
+#define PWM_GEN_CTL_MODE_POS          1
+#define PWM_GEN_CTL_GLOBAL_UPDATES    0x00038     /* LOADUPD, CMPAUPD, CMPBUPD     */
+#define PWM_GEN_CTL_FLTSRC            0x10000
+#define PWM_GEN_CTL_LATCH             0x40000
+
+/*
+ * PWMnGENA / PWMnGENB actions: counting down high on the load and low on the compare,
+ * counting up and down low on the compare up and high on the compare down
+ */
+#define PWM_GENA_DOWN                 0x08C
+#define PWM_GENB_DOWN                 0x80C
+#define PWM_GENA_UP_DOWN              0x0E0
+#define PWM_GENB_UP_DOWN              0xE00
+
+#define PWM_DBCTL_ENABLE              0x1
+
+/* PWMnINTEN, PWMnRIS, PWMnISC */
+#define PWM_GEN_INT_CNTZERO           0x01
+#define PWM_GEN_INT_ALL               0x3F
+
+/* PWMINTEN, PWMISC */
+#define PWM_INT_GEN(Gen)              (0x00001u << (Gen))
+#define PWM_INT_FAULT(Gen)            (0x10000u << (Gen))
+#define PWM_INT_FAULT_ALL             0xF0000u
+#define PWM_INT_FAULT_POS             16
+
+/* Both outputs of a generator in PWMENABLE, PWMFAULT, PWMFAULTVAL */
+#define PWM_OUTPUTS(Gen)              (0x3u << (2 * (Gen)))
+
+#define PWM_STATUS_FAULT_MASK         0xF
+#define PWM_FLTSTAT_ALL               0xF
+
+#define PWM_MAX_LOAD                  0xFFFFu
+
+static const uint32 g_PwmBase[PWM_NUMBER_OF_MODULES] = { PWM0_BASE, PWM1_BASE };
+
+/* Load value and counting mode of every generator, for the duty to compare conversion */
+static uint16 g_PwmLoad[PWM_NUMBER_OF_MODULES][PWM_NUMBER_OF_GENERATORS];
+static PWM_CountModeType g_PwmMode[PWM_NUMBER_OF_MODULES][PWM_NUMBER_OF_GENERATORS];
+
+static void (*g_PwmCallBacks[PWM_NUMBER_OF_MODULES][PWM_NUMBER_OF_GENERATORS])(void);
+static PWM_FaultCallBackType g_PwmFaultCallBacks[PWM_NUMBER_OF_MODULES];
+
+/* Compare value giving a high time, clamped to the counter range */
+static uint32 PWM_Compare(uint32 Load, PWM_CountModeType Mode, uint32 HighTicks){
+
+    if(Mode == PWM_COUNT_UP_DOWN){
+
+        /* High below the compare, on both sides of the counter zero */
+        HighTicks >>= 1;
+        return (HighTicks > Load) ? Load : HighTicks;
+    }
+
+    /* High from the load down to the compare */
+    return (HighTicks > Load) ? 0 : (Load - HighTicks);
+}
+
+/* PWMENABLE bits of the generators of a mask */
+static uint32 PWM_OutputMask(uint8 Generators){
+
+    uint32 mask = 0;
+    uint8 gen;
+
+    for(gen = 0; gen < PWM_NUMBER_OF_GENERATORS; gen++){
+        if(Generators & PWM_GEN_MASK(gen)){
+            mask |= PWM_OUTPUTS(gen);
+        }
+    }
+
+    return mask;
+}
+
+/*********************************************************************
+* Service Name: PWM_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module / Divider - PWM clock divider
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clock the module and set the PWM clock divider, which is
+*              shared by both modules.
+**********************************************************************/
+void PWM_Init(PWM_ModuleType Module, PWM_DividerType Divider){
+
+    uint32 base = g_PwmBase[Module];
+    uint8 gen;
+
+    SYSCTL_RCGCPWM_REG |= (1u << Module);
+    SYSCTL_SCGCPWM_REG |= (1u << Module);
+    SYSCTL_DCGCPWM_REG |= (1u << Module);
+    while(!(SYSCTL_PRPWM_REG & (1u << Module))){}
+
+    if(Divider == PWM_DIV_1){
+        SYSCTL_RCC_REG &= ~PWM_RCC_USEPWMDIV;
+    }
+    else{
+        SYSCTL_RCC_REG = (SYSCTL_RCC_REG & ~PWM_RCC_PWMDIV_MASK) | PWM_RCC_USEPWMDIV |
+                         ((uint32)Divider << PWM_RCC_PWMDIV_POS);
+    }
+
+    PWM_ENABLE_REG(base) = 0;
+    PWM_INTEN_REG(base)  = 0;
+
+    for(gen = 0; gen < PWM_NUMBER_OF_GENERATORS; gen++){
+        PWM_GEN_CTL_REG(base, gen) = 0;
+    }
+}
+
+/*********************************************************************
+* Service Name: PWM_ConfigureGenerator
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Generator
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for a wrong period or dead-band
+* Description: Function to program and start the counter of a generator with its
+*              outputs disabled, the duties are set before PWM_Start. Later load and
+*              compare writes apply on PWM_Commit, the NVIC lines are enabled by the
+*              application.
+**********************************************************************/
+boolean PWM_ConfigureGenerator(const PWM_GeneratorConfigType *Config){
+
+    uint32 base = g_PwmBase[Config->module];
+    uint32 gen  = Config->generator;
+    uint32 outputs = PWM_OUTPUTS(gen);
+    uint32 load;
+    uint32 ctl;
+
+    /* Counting down takes load + 1 clocks, counting up and down 2 x load */
+    if(Config->mode == PWM_COUNT_UP_DOWN){
+        load = Config->period / 2;
+        if((Config->period & 1) != 0){
+            return FALSE;
+        }
+    }
+    else{
+        load = Config->period - 1;
+    }
+
+    if((Config->period < 2) || (load > PWM_MAX_LOAD) ||
+       (Config->complementary && ((Config->deadBandRise > PWM_DEAD_BAND_MAX) ||
+                                  (Config->deadBandFall > PWM_DEAD_BAND_MAX)))){
+        return FALSE;
+    }
+
+    g_PwmLoad[Config->module][gen] = (uint16)load;
+    g_PwmMode[Config->module][gen] = Config->mode;
+
+    ctl = ((uint32)Config->mode << PWM_GEN_CTL_MODE_POS) | PWM_GEN_CTL_GLOBAL_UPDATES;
+    if(Config->faultInputs != 0){
+        ctl |= PWM_GEN_CTL_FLTSRC;
+        if(Config->faultLatch){
+            ctl |= PWM_GEN_CTL_LATCH;
+        }
+    }
+
+    /* The generator is programmed stopped with its outputs off */
+    PWM_ENABLE_REG(base)      &= ~outputs;
+    PWM_GEN_CTL_REG(base, gen) = ctl;
+
+    PWM_GEN_LOAD_REG(base, gen) = load;
+    PWM_GEN_CMPA_REG(base, gen) = PWM_Compare(load, Config->mode, 0);
+    PWM_GEN_CMPB_REG(base, gen) = PWM_Compare(load, Config->mode, 0);
+    PWM_GEN_GENA_REG(base, gen) = (Config->mode == PWM_COUNT_UP_DOWN) ? PWM_GENA_UP_DOWN : PWM_GENA_DOWN;
+    PWM_GEN_GENB_REG(base, gen) = (Config->mode == PWM_COUNT_UP_DOWN) ? PWM_GENB_UP_DOWN : PWM_GENB_DOWN;
+
+    /* Complementary pair, B is A inverted and each rising edge waits its dead-band */
+    if(Config->complementary){
+        PWM_GEN_DBRISE_REG(base, gen) = Config->deadBandRise;
+        PWM_GEN_DBFALL_REG(base, gen) = Config->deadBandFall;
+        PWM_GEN_DBCTL_REG(base, gen)  = PWM_DBCTL_ENABLE;
+    }
+    else{
+        PWM_GEN_DBCTL_REG(base, gen)  = 0;
+    }
+
+    /* Fault inputs drive both outputs to their fault level, in hardware */
+    PWM_GEN_FLTSRC0_REG(base, gen) = Config->faultInputs;
+    PWM_GEN_FLTSEN_REG(base, gen)  = Config->faultActiveLow;
+    PWM_FAULTVAL_REG(base) = (PWM_FAULTVAL_REG(base) & ~outputs) | (((uint32)Config->faultLevel & 0x3) << (2 * gen));
+    if(Config->faultInputs != 0){
+        PWM_FAULT_REG(base) |= outputs;
+        PWM_GEN_FLTSTAT0_REG(base, gen) = PWM_FLTSTAT_ALL;
+        PWM_ISC_REG(base)    = PWM_INT_FAULT(gen);
+        PWM_INTEN_REG(base) |= PWM_INT_FAULT(gen);
+    }
+    else{
+        PWM_FAULT_REG(base) &= ~outputs;
+        PWM_INTEN_REG(base) &= ~PWM_INT_FAULT(gen);
+    }
+
+    PWM_GEN_ISC_REG(base, gen)   = PWM_GEN_INT_ALL;
+    PWM_GEN_INTEN_REG(base, gen) = (Config->interrupt ? PWM_GEN_INT_CNTZERO : 0) | (uint32)Config->adcTrigger;
+    if(Config->interrupt){
+        PWM_INTEN_REG(base) |= PWM_INT_GEN(gen);
+    }
+    else{
+        PWM_INTEN_REG(base) &= ~PWM_INT_GEN(gen);
+    }
+
+    /* Start counting and take the load and compare values at the first zero */
+    PWM_GEN_CTL_REG(base, gen) = ctl | PWM_GEN_CTL_ENABLE;
+    PWM_CTL_REG(base) = PWM_GEN_MASK(gen);
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: PWM_SetDuty
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Output - PWM_OUTPUT_A or PWM_OUTPUT_B of a
+*                  generator / HighTicks - High time in PWM clocks, 1 ... period - 1
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to queue the high time of an output, the generator keeps the
+*              old one until PWM_Commit. Output B follows A in complementary mode.
+**********************************************************************/
+void PWM_SetDuty(PWM_ModuleType Module, uint8 Output, uint32 HighTicks){
+
+    uint8 gen = Output >> 1;
+    uint32 compare = PWM_Compare(g_PwmLoad[Module][gen], g_PwmMode[Module][gen], HighTicks);
+
+    if(Output & 1){
+        PWM_GEN_CMPB_REG(g_PwmBase[Module], gen) = compare;
+    }
+    else{
+        PWM_GEN_CMPA_REG(g_PwmBase[Module], gen) = compare;
+    }
+}
+
+/*********************************************************************
+* Service Name: PWM_Commit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Generators - PWM_GEN_MASK of the generators
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to apply the queued duties of the generators together, each
+*              at its next counter zero, with one register write.
+**********************************************************************/
+void PWM_Commit(PWM_ModuleType Module, uint8 Generators){
+
+    /* GLOBALSYNCn are set by a one and cleared by the hardware, zeros have no effect */
+    PWM_CTL_REG(g_PwmBase[Module]) = Generators;
+}
+
+/*********************************************************************
+* Service Name: PWM_IsCommitPending
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Generators - PWM_GEN_MASK of the generators
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE while a generator has not reached its counter zero
+* Description: Function to check that the last commit has been applied.
+**********************************************************************/
+boolean PWM_IsCommitPending(PWM_ModuleType Module, uint8 Generators){
+
+    return (PWM_CTL_REG(g_PwmBase[Module]) & Generators) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+* Service Name: PWM_Start
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module / Generators - PWM_GEN_MASK of the generators
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to restart the counters of the generators in phase and
+*              enable their outputs.
+**********************************************************************/
+void PWM_Start(PWM_ModuleType Module, uint8 Generators){
+
+    uint32 base = g_PwmBase[Module];
+
+    PWM_SYNC_REG(base)    = Generators;
+    PWM_ENABLE_REG(base) |= PWM_OutputMask(Generators);
+}
+
+/*********************************************************************
+* Service Name: PWM_Stop
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module / Generators - PWM_GEN_MASK of the generators
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to disable the outputs of the generators, they are driven low
+*              and the counters keep running.
+**********************************************************************/
+void PWM_Stop(PWM_ModuleType Module, uint8 Generators){
+
+    PWM_ENABLE_REG(g_PwmBase[Module]) &= ~PWM_OutputMask(Generators);
+}
+
+/*********************************************************************
+* Service Name: PWM_GetFaults
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint8 - PWM_GEN_MASK of the generators in fault
+* Description: Function to read the fault state of the generators, a latched fault
+*              stays until PWM_ClearFault.
+**********************************************************************/
+uint8 PWM_GetFaults(PWM_ModuleType Module){
+
+    return (uint8)(PWM_STATUS_REG(g_PwmBase[Module]) & PWM_STATUS_FAULT_MASK);
+}
+
+/*********************************************************************
+* Service Name: PWM_ClearFault
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Generator - Generator
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to release the outputs of a latched fault, they stay at the
+*              fault level while the fault input is still active.
+**********************************************************************/
+void PWM_ClearFault(PWM_ModuleType Module, PWM_GeneratorType Generator){
+
+    uint32 base = g_PwmBase[Module];
+
+    PWM_GEN_FLTSTAT0_REG(base, Generator) = PWM_FLTSTAT_ALL;
+    PWM_ISC_REG(base) = PWM_INT_FAULT(Generator);
+}
+
+/*********************************************************************
+* Service Name: PWM_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Generator - Generator /
+*                  Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called at the counter zero of a generator,
+*              the control law runs there and ends with PWM_Commit.
+**********************************************************************/
+void PWM_SetCallBack(PWM_ModuleType Module, PWM_GeneratorType Generator, void (*Ptr2Func)(void)){
+
+    g_PwmCallBacks[Module][Generator] = Ptr2Func;
+}
+
+/*********************************************************************
+* Service Name: PWM_SetFaultCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called on a fault of any generator with a
+*              fault input. The outputs are already at their fault level by then.
+**********************************************************************/
+void PWM_SetFaultCallBack(PWM_ModuleType Module, PWM_FaultCallBackType Ptr2Func){
+
+    g_PwmFaultCallBacks[Module] = Ptr2Func;
+}
+
+/*********************************************************************
+* Service Name: PWM_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module / Generator - Generator
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the counter zero interrupt of a generator. The vector
+*              table entries PWM_Pwm0Gen0_Handler ... PWM_Pwm1Gen3_Handler call it.
+**********************************************************************/
+void PWM_Handler(PWM_ModuleType Module, PWM_GeneratorType Generator){
+
+    uint32 base   = g_PwmBase[Module];
+    uint32 status = PWM_GEN_RIS_REG(base, Generator) & PWM_GEN_INT_CNTZERO;
+
+    PWM_GEN_ISC_REG(base, Generator) = status;
+
+    if(status && (g_PwmCallBacks[Module][Generator] != NULL_PTR)){
+        g_PwmCallBacks[Module][Generator]();
+    }
+}
+
+/*********************************************************************
+* Service Name: PWM_FaultHandler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the fault interrupt of a module. The vector table
+*              entries PWM_Pwm0Fault_Handler and PWM_Pwm1Fault_Handler call it.
+**********************************************************************/
+void PWM_FaultHandler(PWM_ModuleType Module){
+
+    uint32 base   = g_PwmBase[Module];
+    uint32 status = PWM_ISC_REG(base) & PWM_INT_FAULT_ALL;
+
+    PWM_ISC_REG(base) = status;
+
+    if(status && (g_PwmFaultCallBacks[Module] != NULL_PTR)){
+        g_PwmFaultCallBacks[Module]((uint8)(status >> PWM_INT_FAULT_POS));
+    }
+}
+
+/* Vector table entries */
+#define PWM_DEFINE_HANDLER(Name, Module, Gen)       void PWM_##Name##_Handler(void){ PWM_Handler(Module, Gen); }
+
+PWM_DEFINE_HANDLER(Pwm0Gen0, PWM_MODULE0, PWM_GENERATOR0)
+PWM_DEFINE_HANDLER(Pwm0Gen1, PWM_MODULE0, PWM_GENERATOR1)
+PWM_DEFINE_HANDLER(Pwm0Gen2, PWM_MODULE0, PWM_GENERATOR2)
+PWM_DEFINE_HANDLER(Pwm0Gen3, PWM_MODULE0, PWM_GENERATOR3)
+PWM_DEFINE_HANDLER(Pwm1Gen0, PWM_MODULE1, PWM_GENERATOR0)
+PWM_DEFINE_HANDLER(Pwm1Gen1, PWM_MODULE1, PWM_GENERATOR1)
+PWM_DEFINE_HANDLER(Pwm1Gen2, PWM_MODULE1, PWM_GENERATOR2)
+PWM_DEFINE_HANDLER(Pwm1Gen3, PWM_MODULE1, PWM_GENERATOR3)
+
+void PWM_Pwm0Fault_Handler(void){ PWM_FaultHandler(PWM_MODULE0); }
+void PWM_Pwm1Fault_Handler(void){ PWM_FaultHandler(PWM_MODULE1); }
@@ -0,0 +1,306 @@
+/******************************************************************************
+ *
+ * Module: PWM
+ *
+ * File Name: PWM.h
+ *
+ * Description: Header file for the TM4C123GH6PM PWM generator driver with globally
+ *              synchronized duty updates, dead-band and fault inputs
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef PWM_H_
+#define PWM_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define PWM_NUMBER_OF_MODULES                2
+#define PWM_NUMBER_OF_GENERATORS             4
+#define PWM_NUMBER_OF_OUTPUTS                8
+
+/* Generator n drives the outputs MnPWM(2n) on its comparator A and MnPWM(2n+1) on B */
+#define PWM_OUTPUT_A(Gen)                    ((uint8)(2 * (Gen)))
+#define PWM_OUTPUT_B(Gen)                    ((uint8)((2 * (Gen)) + 1))
+
+/* Masks of generators for PWM_Commit, PWM_Start and PWM_Stop */
+#define PWM_GEN_MASK(Gen)                    (1u << (Gen))
+#define PWM_GEN_MASK_ALL                     0xFu
+
+/* Fault inputs of a generator, FAULT0 ... FAULT3 */
+#define PWM_FAULT_INPUT(Input)               (1u << (Input))
+
+/* High time of Permille / 1000 of a period */
+#define PWM_DUTY_TICKS(Period, Permille)     ((uint32)(((uint32)(Period) * (Permille)) / 1000u))
+
+/* Dead-band delays are 12-bit */
+#define PWM_DEAD_BAND_MAX                    0xFFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    PWM_MODULE0, PWM_MODULE1
+}PWM_ModuleType;
+
+typedef enum
+{
+    PWM_GENERATOR0, PWM_GENERATOR1, PWM_GENERATOR2, PWM_GENERATOR3
+}PWM_GeneratorType;
+
+/* RCC PWMDIV, the PWM clock is the system clock divided by 1 ... 64 */
+typedef enum
+{
+    PWM_DIV_1 = 0xFF, PWM_DIV_2 = 0, PWM_DIV_4, PWM_DIV_8, PWM_DIV_16, PWM_DIV_32, PWM_DIV_64
+}PWM_DividerType;
+
+typedef enum
+{
+    PWM_COUNT_DOWN,                     /* left aligned, outputs rise at the load      */
+    PWM_COUNT_UP_DOWN                   /* center aligned, for motor bridges           */
+}PWM_CountModeType;
+
+/* Counter event starting the ADC sequencers on ADC_TRIGGER_PWMn */
+typedef enum
+{
+    PWM_ADC_TRIGGER_NONE = 0x000,
+    PWM_ADC_TRIGGER_ZERO = 0x100,       /* TRCNTZERO, center of the on time up/down   */
+    PWM_ADC_TRIGGER_LOAD = 0x200        /* TRCNTLOAD                                  */
+}PWM_AdcTriggerType;
+
+typedef struct
+{
+    PWM_ModuleType module;
+    PWM_GeneratorType generator;
+    PWM_CountModeType mode;
+    uint32 period;                      /* PWM clocks, 2 ... 65536, even up to 131070 up/down */
+    boolean complementary;              /* B is A inverted with the dead-band delays    */
+    uint16 deadBandRise;                /* PWM clocks before A rises, complementary only */
+    uint16 deadBandFall;                /* PWM clocks before B rises, complementary only */
+    uint8 faultInputs;                  /* PWM_FAULT_INPUT mask, 0 for none              */
+    uint8 faultActiveLow;               /* PWM_FAULT_INPUT mask of the low active inputs */
+    boolean faultLatch;                 /* outputs stay at the fault level until cleared */
+    uint8 faultLevel;                   /* bit 0 level of A, bit 1 level of B on a fault */
+    boolean interrupt;                  /* counter zero interrupt, the commit point      */
+    PWM_AdcTriggerType adcTrigger;
+}PWM_GeneratorConfigType;
+
+/* Called from the fault handler with the mask of the faulted generators */
+typedef void (*PWM_FaultCallBackType)(uint8 Generators);
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: PWM_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module / Divider - PWM clock divider
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clock the module and set the PWM clock divider, which is
+*              shared by both modules.
+**********************************************************************/
+
+void PWM_Init(PWM_ModuleType Module, PWM_DividerType Divider);
+
+/*********************************************************************
+* Service Name: PWM_ConfigureGenerator
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Generator
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for a wrong period or dead-band
+* Description: Function to program and start the counter of a generator with its
+*              outputs disabled, the duties are set before PWM_Start. Later load and
+*              compare writes apply on PWM_Commit, the NVIC lines are enabled by the
+*              application.
+**********************************************************************/
+
+boolean PWM_ConfigureGenerator(const PWM_GeneratorConfigType *Config);
+
+/*********************************************************************
+* Service Name: PWM_SetDuty
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Output - PWM_OUTPUT_A or PWM_OUTPUT_B of a
+*                  generator / HighTicks - High time in PWM clocks, 1 ... period - 1
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to queue the high time of an output, the generator keeps the
+*              old one until PWM_Commit. Output B follows A in complementary mode.
+**********************************************************************/
+
+void PWM_SetDuty(PWM_ModuleType Module, uint8 Output, uint32 HighTicks);
+
+/*********************************************************************
+* Service Name: PWM_Commit
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Generators - PWM_GEN_MASK of the generators
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to apply the queued duties of the generators together, each
+*              at its next counter zero, with one register write.
+**********************************************************************/
+
+void PWM_Commit(PWM_ModuleType Module, uint8 Generators);
+
+/*********************************************************************
+* Service Name: PWM_IsCommitPending
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Generators - PWM_GEN_MASK of the generators
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE while a generator has not reached its counter zero
+* Description: Function to check that the last commit has been applied.
+**********************************************************************/
+
+boolean PWM_IsCommitPending(PWM_ModuleType Module, uint8 Generators);
+
+/*********************************************************************
+* Service Name: PWM_Start
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module / Generators - PWM_GEN_MASK of the generators
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to restart the counters of the generators in phase and
+*              enable their outputs.
+**********************************************************************/
+
+void PWM_Start(PWM_ModuleType Module, uint8 Generators);
+
+/*********************************************************************
+* Service Name: PWM_Stop
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module / Generators - PWM_GEN_MASK of the generators
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to disable the outputs of the generators, they are driven low
+*              and the counters keep running.
+**********************************************************************/
+
+void PWM_Stop(PWM_ModuleType Module, uint8 Generators);
+
+/*********************************************************************
+* Service Name: PWM_GetFaults
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint8 - PWM_GEN_MASK of the generators in fault
+* Description: Function to read the fault state of the generators, a latched fault
+*              stays until PWM_ClearFault.
+**********************************************************************/
+
+uint8 PWM_GetFaults(PWM_ModuleType Module);
+
+/*********************************************************************
+* Service Name: PWM_ClearFault
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Generator - Generator
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to release the outputs of a latched fault, they stay at the
+*              fault level while the fault input is still active.
+**********************************************************************/
+
+void PWM_ClearFault(PWM_ModuleType Module, PWM_GeneratorType Generator);
+
+/*********************************************************************
+* Service Name: PWM_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Generator - Generator /
+*                  Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called at the counter zero of a generator,
+*              the control law runs there and ends with PWM_Commit.
+**********************************************************************/
+
+void PWM_SetCallBack(PWM_ModuleType Module, PWM_GeneratorType Generator, void (*Ptr2Func)(void));
+
+/*********************************************************************
+* Service Name: PWM_SetFaultCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - PWM module / Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called on a fault of any generator with a
+*              fault input. The outputs are already at their fault level by then.
+**********************************************************************/
+
+void PWM_SetFaultCallBack(PWM_ModuleType Module, PWM_FaultCallBackType Ptr2Func);
+
+/*********************************************************************
+* Service Name: PWM_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module / Generator - Generator
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the counter zero interrupt of a generator. The vector
+*              table entries PWM_Pwm0Gen0_Handler ... PWM_Pwm1Gen3_Handler call it.
+**********************************************************************/
+
+void PWM_Handler(PWM_ModuleType Module, PWM_GeneratorType Generator);
+
+/*********************************************************************
+* Service Name: PWM_FaultHandler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - PWM module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the fault interrupt of a module. The vector table
+*              entries PWM_Pwm0Fault_Handler and PWM_Pwm1Fault_Handler call it.
+**********************************************************************/
+
+void PWM_FaultHandler(PWM_ModuleType Module);
+
+/* Vector table entries, one per NVIC_PWMn_GENERATORm_IRQ and NVIC_PWMn_FAULT_IRQ */
+void PWM_Pwm0Gen0_Handler(void);
+void PWM_Pwm0Gen1_Handler(void);
+void PWM_Pwm0Gen2_Handler(void);
+void PWM_Pwm0Gen3_Handler(void);
+void PWM_Pwm1Gen0_Handler(void);
+void PWM_Pwm1Gen1_Handler(void);
+void PWM_Pwm1Gen2_Handler(void);
+void PWM_Pwm1Gen3_Handler(void);
+void PWM_Pwm0Fault_Handler(void);
+void PWM_Pwm1Fault_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* PWM_H_ */
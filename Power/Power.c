@@ -0,0 +1,275 @@
+/******************************************************************************
+ *
+ * Module: Power
+ *
+ * File Name: Power.c
+ *
+ * Description: Source file for the sleep / deep-sleep power manager called from the
+ *              idle loop. Picks the deepest low power mode that the next SysTick or
+ *              timer deadline and the wake-up latency allow
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Power.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef HOST_SIMULATION
+#include "HostModel.h"
+#endif
+
+#ifdef __TI_ARM__
+/* WFI wakes on a pending interrupt with PRIMASK set, its handler runs on the restore */
+#define POWER_ENTER_CRITICAL()     uint32 savedPrimask = _disable_IRQ()
+#define POWER_EXIT_CRITICAL()      _restore_interrupts(savedPrimask)
+#else
+#define POWER_ENTER_CRITICAL()
+#define POWER_EXIT_CRITICAL()
+#endif
+
+/* SysTick CTRL bits, the deadline counts only when the tick interrupts */
+#define POWER_SYSTICK_ENABLE_INTEN           0x00000003
+#define POWER_SYSTICK_COUNT                  0x00010000
+
+/* VECTPENDING field of INTCTRL, an enabled exception waits for its handler */
+#define POWER_INTCTRL_VECTPENDING            0x001FF000
+
+static Power_ConfigType g_PowerConfig;
+static Power_StatsType g_PowerStats[POWER_NUMBER_OF_STATES];
+static volatile uint8 g_PowerBlock[POWER_NUMBER_OF_STATES];
+
+/* Cycles until the next SysTick interrupt or configured deadline */
+static uint32 Power_NextDeadline(void){
+
+    uint32 deadline = POWER_NO_DEADLINE;
+
+    /* Reading CTRL clears COUNT, nothing polls it while the idle loop runs */
+    if((SYSTICK_CTRL_REG & POWER_SYSTICK_ENABLE_INTEN) == POWER_SYSTICK_ENABLE_INTEN){
+
+        uint32 current = SYSTICK_CURRENT_REG;
+        deadline = (current != 0) ? current : (SYSTICK_RELOAD_REG + 1);
+    }
+
+    if(g_PowerConfig.deadline != NULL_PTR){
+
+        uint32 other = g_PowerConfig.deadline();
+        if(other < deadline){
+            deadline = other;
+        }
+    }
+
+    return deadline;
+}
+
+#ifndef HOST_SIMULATION
+/* SysTick clocks since Start, one wrap at most: with INTEN set the wrap itself wakes the core */
+static uint32 Power_SysTickElapsed(uint32 Start){
+
+    /* Read CTRL first, a wrap between the two reads leaves CURRENT above Start */
+    boolean wrapped = ((SYSTICK_CTRL_REG & POWER_SYSTICK_COUNT) != 0);
+    uint32 end = SYSTICK_CURRENT_REG;
+
+    if(end > Start){
+        wrapped = TRUE;
+    }
+
+    return wrapped ? (Start - end + SYSTICK_RELOAD_REG + 1) : (Start - end);
+}
+#endif
+
+/* Wait for an interrupt, returns the cycles spent waiting (the prediction on target without SysTick) */
+static uint64 Power_WaitForInterrupt(uint32 WakeCycles, uint32 Predicted, boolean Sleep){
+
+#ifdef HOST_SIMULATION
+    (void)Predicted;
+    return HostModel_WaitForInterrupt(WakeCycles, Sleep);
+#else
+    uint32 start;
+
+    (void)WakeCycles;
+
+    /* Without the tick nothing measures the wait, sleep counts the predicted time */
+    if((SYSTICK_CTRL_REG & POWER_SYSTICK_ENABLE_INTEN) != POWER_SYSTICK_ENABLE_INTEN){
+
+        if(!Sleep){
+            return 0;       /*the idle loop calls again, the time counts as run time there*/
+        }
+        __asm(" DSB");
+        __asm(" WFI");
+        return Predicted;
+    }
+
+    /* The CTRL read above cleared COUNT, a wrap from here on shows in it */
+    start = SYSTICK_CURRENT_REG;
+    if(SYSTICK_CTRL_REG & POWER_SYSTICK_COUNT){
+        start = SYSTICK_CURRENT_REG;
+    }
+
+    if(Sleep){
+        __asm(" DSB");
+        __asm(" WFI");
+    }
+    else{
+        /* Busy wait as WFI would, PRIMASK holds the handler back until the restore */
+        while((NVIC_SYSTEM_INTCTRL & POWER_INTCTRL_VECTPENDING) == 0){}
+    }
+
+    /* SysTick keeps counting in sleep and, on PIOSC / 1, in deep-sleep (Power.h) */
+    return Power_SysTickElapsed(start);
+#endif
+}
+
+/*********************************************************************
+* Service Name: Power_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Deep-sleep clock, wake-up latencies and deadline source
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to program the deep-sleep clock and clear the statistics
+*              and the state locks.
+**********************************************************************/
+void Power_Init(const Power_ConfigType *Config){
+
+    uint8 state;
+
+    g_PowerConfig = *Config;
+
+    for(state = 0; state < POWER_NUMBER_OF_STATES; state++){
+
+        g_PowerStats[state].entries = 0;
+        g_PowerStats[state].cycles  = 0;
+        g_PowerBlock[state] = 0;
+    }
+
+    SYSCTL_DSLPCLKCFG_REG = Config->dslpClkCfg;
+    NVIC_SYSTEM_SYSCTRL  &= ~POWER_SCR_SLEEPDEEP;
+}
+
+/*********************************************************************
+* Service Name: Power_Idle
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Power_StateType - State used
+* Description: Function to sleep until the next interrupt in the deepest allowed state:
+*              deep-sleep when the idle time covers its wake-up latency and break-even
+*              time, sleep when it covers the sleep wake-up latency, else busy-wait in
+*              run mode, interrupts masked, until one is pending (SysTick times the
+*              run state, without its interrupt the run state returns at once). Returns
+*              only after an interrupt otherwise, its handler runs on the way out, so a
+*              caller that polls between calls must not use it.
+*              Clears SLEEPDEEP and waits for the PLL on wake-up. Thread mode only.
+**********************************************************************/
+Power_StateType Power_Idle(void){
+
+    Power_StateType state = POWER_STATE_RUN;
+    uint32 idle;
+    uint64 cycles;
+
+    POWER_ENTER_CRITICAL();
+
+    idle = Power_NextDeadline();
+
+    if((g_PowerBlock[POWER_STATE_SLEEP] == 0) && (g_PowerBlock[POWER_STATE_DEEP_SLEEP] == 0) &&
+       (idle >= g_PowerConfig.deepSleepWakeCycles + g_PowerConfig.deepSleepMinCycles)){
+        state = POWER_STATE_DEEP_SLEEP;
+    }
+    else if((g_PowerBlock[POWER_STATE_SLEEP] == 0) && (idle > g_PowerConfig.sleepWakeCycles)){
+        state = POWER_STATE_SLEEP;
+    }
+
+    switch(state){
+
+    case POWER_STATE_DEEP_SLEEP:
+        NVIC_SYSTEM_SYSCTRL |= POWER_SCR_SLEEPDEEP;
+        cycles = Power_WaitForInterrupt(g_PowerConfig.deepSleepWakeCycles, idle, TRUE);
+        NVIC_SYSTEM_SYSCTRL &= ~POWER_SCR_SLEEPDEEP;
+
+        /* The run clock configuration comes back by itself, the PLL has to lock again */
+        if(g_PowerConfig.pllLock){
+            while(!(SYSCTL_PLLSTAT_REG & POWER_PLLSTAT_LOCK)){}
+        }
+        break;
+
+    case POWER_STATE_SLEEP:
+        cycles = Power_WaitForInterrupt(g_PowerConfig.sleepWakeCycles, idle, TRUE);
+        break;
+
+    default:
+        cycles = Power_WaitForInterrupt(0, 0, FALSE);
+        break;
+    }
+
+    g_PowerStats[state].entries++;
+    g_PowerStats[state].cycles += cycles;
+
+    POWER_EXIT_CRITICAL();
+
+    return state;
+}
+
+/*********************************************************************
+* Service Name: Power_Block
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): State - POWER_STATE_SLEEP or POWER_STATE_DEEP_SLEEP
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to forbid a state and the deeper ones, e.g. while a transfer
+*              needs a peripheral clock that the state gates. Calls nest.
+**********************************************************************/
+void Power_Block(Power_StateType State){
+
+    if((State != POWER_STATE_RUN) && (State < POWER_NUMBER_OF_STATES)){
+
+        POWER_ENTER_CRITICAL();
+        g_PowerBlock[State]++;
+        POWER_EXIT_CRITICAL();
+    }
+}
+
+/*********************************************************************
+* Service Name: Power_Unblock
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): State - State given to Power_Block
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to drop one Power_Block of the state.
+**********************************************************************/
+void Power_Unblock(Power_StateType State){
+
+    if((State != POWER_STATE_RUN) && (State < POWER_NUMBER_OF_STATES)){
+
+        POWER_ENTER_CRITICAL();
+        if(g_PowerBlock[State] > 0){
+            g_PowerBlock[State]--;
+        }
+        POWER_EXIT_CRITICAL();
+    }
+}
+
+/*********************************************************************
+* Service Name: Power_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): State - State
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the residency of the state, NULL_PTR for an invalid state
+* Description: Function to read how often and how long the state was used.
+**********************************************************************/
+const Power_StatsType *Power_GetStats(Power_StateType State){
+
+    if(State >= POWER_NUMBER_OF_STATES){
+        return NULL_PTR;
+    }
+
+    return &g_PowerStats[State];
+}
@@ -0,0 +1,167 @@
+/******************************************************************************
+ *
+ * Module: Power
+ *
+ * File Name: Power.h
+ *
+ * Description: Header file for the sleep / deep-sleep power manager called from the
+ *              idle loop. Picks the deepest low power mode that the next SysTick or
+ *              timer deadline and the wake-up latency allow
+ *
+ *              Idle loop with the scheduler (tasks run from PendSV):
+ *                  for(;;){ Power_Idle(); }
+ *              With the thread layer, from the idle thread body.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef POWER_H_
+#define POWER_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* System Control register (SCR) */
+#define POWER_SCR_SLEEPDEEP                  0x00000004
+
+/* SYSCTL_DSLPCLKCFG_REG values, clock source and divider of the deep-sleep clock */
+#define POWER_DSLPCLKCFG_MOSC                0x00000000
+#define POWER_DSLPCLKCFG_PIOSC               0x00000010
+#define POWER_DSLPCLKCFG_LFIOSC              0x00000030
+#define POWER_DSLPCLKCFG_DIV(Divisor)        ((uint32)((Divisor) - 1) << 23)
+
+/* PLL lock bit of SYSCTL_PLLSTAT_REG */
+#define POWER_PLLSTAT_LOCK                   0x00000001
+
+/*
+ * Default timings at 16 MHz, deep-sleep on PIOSC / 1. SysTick keeps counting at the
+ * same rate in deep-sleep then, so the tick deadline holds in both modes.
+ */
+#define POWER_SLEEP_WAKE_CYCLES              2       /* clock ungated at once            */
+#define POWER_DEEP_SLEEP_WAKE_CYCLES         400     /* run clock switch back, 25 us     */
+#define POWER_DEEP_SLEEP_MIN_CYCLES          1600    /* break-even idle time, 100 us     */
+
+/* No deadline besides SysTick */
+#define POWER_NO_DEADLINE                    0xFFFFFFFF
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    POWER_STATE_RUN,                /* deadline too close, returned without sleeping */
+    POWER_STATE_SLEEP,              /* WFI, core clock gated                         */
+    POWER_STATE_DEEP_SLEEP,         /* WFI with SLEEPDEEP, deep-sleep clock          */
+    POWER_NUMBER_OF_STATES
+}Power_StateType;
+
+/* Cycles until the next timed event other than SysTick (GPTM, RTC), POWER_NO_DEADLINE for none */
+typedef uint32 (*Power_DeadlineFuncType)(void);
+
+typedef struct
+{
+    uint32 dslpClkCfg;              /* SYSCTL_DSLPCLKCFG_REG value                            */
+    uint32 sleepWakeCycles;         /* wake-up event to first handler instruction, sleep       */
+    uint32 deepSleepWakeCycles;     /* same for deep-sleep, includes the oscillator restart    */
+    uint32 deepSleepMinCycles;      /* shorter idle periods cost more to enter than they save  */
+    boolean pllLock;                /* run clock from the PLL, wait for the lock after waking  */
+    Power_DeadlineFuncType deadline;/* may be NULL_PTR                                         */
+}Power_ConfigType;
+
+typedef struct
+{
+    uint32 entries;
+    uint64 cycles;                  /* time in the state, SysTick measured on target           */
+}Power_StatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Power_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Deep-sleep clock, wake-up latencies and deadline source
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to program the deep-sleep clock and clear the statistics
+*              and the state locks.
+**********************************************************************/
+
+void Power_Init(const Power_ConfigType *Config);
+
+/*********************************************************************
+* Service Name: Power_Idle
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Power_StateType - State used
+* Description: Function to sleep until the next interrupt in the deepest allowed state:
+*              deep-sleep when the idle time covers its wake-up latency and break-even
+*              time, sleep when it covers the sleep wake-up latency, else busy-wait in
+*              run mode, interrupts masked, until one is pending (SysTick times the
+*              run state, without its interrupt the run state returns at once). Returns
+*              only after an interrupt otherwise, its handler runs on the way out, so a
+*              caller that polls between calls must not use it.
+*              Clears SLEEPDEEP and waits for the PLL on wake-up. Thread mode only.
+**********************************************************************/
+
+Power_StateType Power_Idle(void);
+
+/*********************************************************************
+* Service Name: Power_Block
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): State - POWER_STATE_SLEEP or POWER_STATE_DEEP_SLEEP
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to forbid a state and the deeper ones, e.g. while a transfer
+*              needs a peripheral clock that the state gates. Calls nest.
+**********************************************************************/
+
+void Power_Block(Power_StateType State);
+
+/*********************************************************************
+* Service Name: Power_Unblock
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): State - State given to Power_Block
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to drop one Power_Block of the state.
+**********************************************************************/
+
+void Power_Unblock(Power_StateType State);
+
+/*********************************************************************
+* Service Name: Power_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): State - State
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the residency of the state, NULL_PTR for an invalid state
+* Description: Function to read how often and how long the state was used.
+**********************************************************************/
+
+const Power_StatsType *Power_GetStats(Power_StateType State);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* POWER_H_ */
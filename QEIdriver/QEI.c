@@ -0,0 +1,258 @@
+/******************************************************************************
+ *
+ * Module: QEI
+ *
+ * File Name: QEI.c
+ *
+ * Description: Source file for the TM4C123GH6PM quadrature encoder interface driver
+ *              with the hardware position counter, velocity capture, index pulse
+ *              handling and a lock-free snapshot of position and velocity
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "QEI.h"
+#include "tm4c123gh6pm_registers.h"
+
+/* QEICTL, both phases counted on both edges */
+#define QEI_CTL_ENABLE                0x00000001
+#define QEI_CTL_SWAP                  0x00000002
+#define QEI_CTL_CAPMODE               0x00000008
+#define QEI_CTL_RESMODE               0x00000010
+#define QEI_CTL_VELEN                 0x00000020
+#define QEI_CTL_VELDIV_POS            6
+
+#define QEI_STAT_DIRECTION            0x02
+
+/* QEIINTEN, QEIRIS and QEIISC */
+#define QEI_INT_INDEX                 0x01
+#define QEI_INT_TIMER                 0x02
+#define QEI_INT_ERROR                 0x08
+#define QEI_INT_ALL                   0x0F
+
+/*
+ * The handler fills the buffer after the published one and then bumps the sequence,
+ * whose low bit names the published buffer. A reader preempting the handler copies an
+ * untouched buffer, a reader preempted by it sees the sequence move and copies again.
+ */
+typedef struct
+{
+    uint32 position;
+    sint32 velocity;
+    sint32 revolutions;
+    uint32 indexPosition;
+    uint32 errors;
+    uint32 period;
+}QEI_BufferType;
+
+typedef struct
+{
+    volatile uint32 sequence;
+    volatile QEI_BufferType buffer[2];
+    sint32 revolutions;
+    uint32 indexPosition;
+    uint32 errors;
+    uint32 period;
+    uint32 rate;                        /* velocity periods per second                  */
+    uint8 divider;                      /* log2 of the velocity predivider              */
+    uint8 interrupts;
+}QEI_AxisType;
+
+static const uint32 g_QeiBase[QEI_NUMBER_OF_MODULES] = { QEI0_BASE, QEI1_BASE };
+
+static QEI_AxisType g_QeiAxis[QEI_NUMBER_OF_MODULES];
+
+/* End of a velocity period: SPEED holds the pulses of the period that just ended */
+static void QEI_Publish(QEI_AxisType *Axis, uint32 Base){
+
+    volatile QEI_BufferType *next = &Axis->buffer[(Axis->sequence + 1u) & 1u];
+    sint32 velocity = (sint32)((QEI_SPEED_REG(Base) << Axis->divider) * Axis->rate);
+
+    next->position      = QEI_POS_REG(Base);
+    next->velocity      = (QEI_STAT_REG(Base) & QEI_STAT_DIRECTION) ? -velocity : velocity;
+    next->revolutions   = Axis->revolutions;
+    next->indexPosition = Axis->indexPosition;
+    next->errors        = Axis->errors;
+    next->period        = ++Axis->period;
+
+    Axis->sequence++;
+}
+
+/*********************************************************************
+* Service Name: QEI_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Encoder
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for a velocity period of 0 or above the clock
+* Description: Function to clock the module and start the position counter at 0 and
+*              the velocity timer. The handler publishes a snapshot at the end of each
+*              velocity period. The QEI pins and the NVIC line are configured by the
+*              application.
+**********************************************************************/
+boolean QEI_Init(const QEI_ConfigType *Config){
+
+    QEI_AxisType *axis = &g_QeiAxis[Config->module];
+    uint32 base = g_QeiBase[Config->module];
+    uint32 bit = 1u << Config->module;
+    uint32 ctl;
+
+    if((Config->velocityPeriod == 0) || (Config->velocityPeriod > Config->clock)){
+        return FALSE;
+    }
+
+    SYSCTL_RCGCQEI_REG |= bit;
+    SYSCTL_SCGCQEI_REG |= bit;
+    SYSCTL_DCGCQEI_REG |= bit;
+    while(!(SYSCTL_PRQEI_REG & bit)){}
+
+    /* Only a reset clears the enable bit, so a second init starts from a reset module */
+    SYSCTL_SRQEI_REG |= bit;
+    SYSCTL_SRQEI_REG &= ~bit;
+    while(!(SYSCTL_PRQEI_REG & bit)){}
+
+    axis->sequence      = 0;
+    axis->revolutions   = 0;
+    axis->indexPosition = 0;
+    axis->errors        = 0;
+    axis->period        = 0;
+    axis->rate          = Config->clock / Config->velocityPeriod;
+    axis->divider       = (uint8)Config->divider;
+    axis->interrupts    = QEI_INT_TIMER | QEI_INT_ERROR | ((Config->indexMode != QEI_INDEX_NONE) ? QEI_INT_INDEX : 0);
+
+    axis->buffer[0].position      = 0;
+    axis->buffer[0].velocity      = 0;
+    axis->buffer[0].revolutions   = 0;
+    axis->buffer[0].indexPosition = 0;
+    axis->buffer[0].errors        = 0;
+    axis->buffer[0].period        = 0;
+
+    ctl = QEI_CTL_ENABLE | QEI_CTL_CAPMODE | QEI_CTL_VELEN | ((uint32)Config->divider << QEI_CTL_VELDIV_POS);
+    if(Config->swap){
+        ctl |= QEI_CTL_SWAP;
+    }
+    if(Config->indexMode == QEI_INDEX_RESET){
+        ctl |= QEI_CTL_RESMODE;
+    }
+
+    QEI_MAXPOS_REG(base) = Config->maxPosition;
+    QEI_POS_REG(base)    = 0;
+    QEI_LOAD_REG(base)   = Config->velocityPeriod - 1u;
+    QEI_ISC_REG(base)    = QEI_INT_ALL;
+    QEI_INTEN_REG(base)  = axis->interrupts;
+    QEI_CTL_REG(base)    = ctl;
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: QEI_GetSnapshot
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - QEI module
+* Parameters (inout): None
+* Parameters (out): Snapshot - Last published state of the axis
+* Return value: None
+* Description: Function to copy the last snapshot without masking interrupts. A copy
+*              overtaken by the handler is taken again, so the fields always come
+*              from one period.
+**********************************************************************/
+void QEI_GetSnapshot(QEI_ModuleType Module, QEI_SnapshotType *Snapshot){
+
+    QEI_AxisType *axis = &g_QeiAxis[Module];
+    uint32 sequence;
+
+    do{
+        volatile QEI_BufferType *published;
+
+        sequence  = axis->sequence;
+        published = &axis->buffer[sequence & 1u];
+
+        Snapshot->position      = published->position;
+        Snapshot->velocity      = published->velocity;
+        Snapshot->revolutions   = published->revolutions;
+        Snapshot->indexPosition = published->indexPosition;
+        Snapshot->errors        = published->errors;
+        Snapshot->period        = published->period;
+    }while(axis->sequence != sequence);
+}
+
+/*********************************************************************
+* Service Name: QEI_GetPosition
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - QEI module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Position counter now
+* Description: Function to read the live position, newer than the snapshot.
+**********************************************************************/
+uint32 QEI_GetPosition(QEI_ModuleType Module){
+
+    return QEI_POS_REG(g_QeiBase[Module]);
+}
+
+/*********************************************************************
+* Service Name: QEI_SetPosition
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - QEI module / Position - New position
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to load the position counter, for homing without an index.
+**********************************************************************/
+void QEI_SetPosition(QEI_ModuleType Module, uint32 Position){
+
+    QEI_POS_REG(g_QeiBase[Module]) = Position;
+}
+
+/*********************************************************************
+* Service Name: QEI_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - QEI module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the index, phase error and velocity timer interrupts
+*              of a module. The vector table entries QEI_Qei0_Handler and
+*              QEI_Qei1_Handler call it.
+**********************************************************************/
+void QEI_Handler(QEI_ModuleType Module){
+
+    QEI_AxisType *axis = &g_QeiAxis[Module];
+    uint32 base = g_QeiBase[Module];
+    uint32 status = QEI_RIS_REG(base) & axis->interrupts;
+
+    if(status == 0){
+        return;
+    }
+    QEI_ISC_REG(base) = status;
+
+    if(status & QEI_INT_INDEX){
+
+        if(QEI_STAT_REG(base) & QEI_STAT_DIRECTION){
+            axis->revolutions--;
+        }
+        else{
+            axis->revolutions++;
+        }
+        axis->indexPosition = QEI_POS_REG(base);
+    }
+
+    if(status & QEI_INT_ERROR){
+        axis->errors++;
+    }
+
+    if(status & QEI_INT_TIMER){
+        QEI_Publish(axis, base);
+    }
+}
+
+/* Vector table entries */
+#define QEI_DEFINE_HANDLER(Name, Module)            void QEI_##Name##_Handler(void){ QEI_Handler(Module); }
+
+QEI_DEFINE_HANDLER(Qei0, QEI_MODULE0)
+QEI_DEFINE_HANDLER(Qei1, QEI_MODULE1)
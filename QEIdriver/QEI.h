@@ -0,0 +1,165 @@
+/******************************************************************************
+ *
+ * Module: QEI
+ *
+ * File Name: QEI.h
+ *
+ * Description: Header file for the TM4C123GH6PM quadrature encoder interface driver
+ *              with the hardware position counter, velocity capture, index pulse
+ *              handling and a lock-free snapshot of position and velocity
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef QEI_H_
+#define QEI_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define QEI_NUMBER_OF_MODULES                2
+
+/* Counts of an encoder of Lines lines, both edges of both phases are counted */
+#define QEI_COUNTS_PER_REV(Lines)            ((uint32)(Lines) * 4u)
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    QEI_MODULE0, QEI_MODULE1
+}QEI_ModuleType;
+
+typedef enum
+{
+    QEI_INDEX_NONE,                     /* index pulse not wired                        */
+    QEI_INDEX_LATCH,                    /* position free running, latched at each index */
+    QEI_INDEX_RESET                     /* position reset to 0 at each index            */
+}QEI_IndexModeType;
+
+/* CTL VELDIV, pulses counted by the velocity accumulator are divided by 1 ... 128 */
+typedef enum
+{
+    QEI_VELOCITY_DIV_1, QEI_VELOCITY_DIV_2, QEI_VELOCITY_DIV_4, QEI_VELOCITY_DIV_8,
+    QEI_VELOCITY_DIV_16, QEI_VELOCITY_DIV_32, QEI_VELOCITY_DIV_64, QEI_VELOCITY_DIV_128
+}QEI_VelocityDividerType;
+
+typedef struct
+{
+    QEI_ModuleType module;
+    uint32 clock;                       /* system clock in Hz                           */
+    uint32 maxPosition;                 /* position wraps from it to 0, counts per
+                                           revolution - 1 for QEI_INDEX_RESET            */
+    QEI_IndexModeType indexMode;
+    boolean swap;                       /* exchange PhA and PhB to reverse the direction */
+    uint32 velocityPeriod;              /* system clocks per velocity and snapshot period */
+    QEI_VelocityDividerType divider;
+}QEI_ConfigType;
+
+/*
+ * State of an axis at the end of a velocity period, all fields from the same
+ * period. Revolutions count the index pulses, up when moving forward.
+ */
+typedef struct
+{
+    uint32 position;                    /* counts                                        */
+    sint32 velocity;                    /* counts per second, negative in reverse        */
+    sint32 revolutions;
+    uint32 indexPosition;               /* position at the last index, QEI_INDEX_LATCH  */
+    uint32 errors;                      /* phase errors since QEI_Init                   */
+    uint32 period;                      /* velocity periods since QEI_Init               */
+}QEI_SnapshotType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: QEI_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Encoder
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for a velocity period of 0 or above the clock
+* Description: Function to clock the module and start the position counter at 0 and
+*              the velocity timer. The handler publishes a snapshot at the end of each
+*              velocity period. The QEI pins and the NVIC line are configured by the
+*              application.
+**********************************************************************/
+
+boolean QEI_Init(const QEI_ConfigType *Config);
+
+/*********************************************************************
+* Service Name: QEI_GetSnapshot
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - QEI module
+* Parameters (inout): None
+* Parameters (out): Snapshot - Last published state of the axis
+* Return value: None
+* Description: Function to copy the last snapshot without masking interrupts. A copy
+*              overtaken by the handler is taken again, so the fields always come
+*              from one period.
+**********************************************************************/
+
+void QEI_GetSnapshot(QEI_ModuleType Module, QEI_SnapshotType *Snapshot);
+
+/*********************************************************************
+* Service Name: QEI_GetPosition
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - QEI module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Position counter now
+* Description: Function to read the live position, newer than the snapshot.
+**********************************************************************/
+
+uint32 QEI_GetPosition(QEI_ModuleType Module);
+
+/*********************************************************************
+* Service Name: QEI_SetPosition
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - QEI module / Position - New position
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to load the position counter, for homing without an index.
+**********************************************************************/
+
+void QEI_SetPosition(QEI_ModuleType Module, uint32 Position);
+
+/*********************************************************************
+* Service Name: QEI_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - QEI module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the index, phase error and velocity timer interrupts
+*              of a module. The vector table entries QEI_Qei0_Handler and
+*              QEI_Qei1_Handler call it.
+**********************************************************************/
+
+void QEI_Handler(QEI_ModuleType Module);
+
+/* Vector table entries, one per NVIC_QEIn_IRQ */
+void QEI_Qei0_Handler(void);
+void QEI_Qei1_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* QEI_H_ */
@@ -0,0 +1,252 @@
+/******************************************************************************
+ *
+ * Module: Queue
+ *
+ * File Name: Queue.h
+ *
+ * Description: Header only, statically sized lock-free queues to hand data from
+ *              interrupt handlers to threads without critical sections
+ *
+ *              QUEUE_SPSC_DEFINE  one producer, one consumer, wait-free
+ *              QUEUE_MPSC_DEFINE  many producers (any ISR priority), one consumer,
+ *                                 lock-free with LDREX/STREX
+ *
+ *              Queue_CompareAndSwap is the atomic of MemPool as well.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef QUEUE_H_
+#define QUEUE_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Memory barrier between writing an item and publishing its index. The core
+ * does not reorder stores to normal memory, the DMB keeps the queues correct
+ * when a DMA master or a bus matrix with write buffers reads them.
+ */
+#ifdef __TI_ARM__
+#define QUEUE_BARRIER()                      __asm(" DMB")
+#else
+#define QUEUE_BARRIER()                      do{ __atomic_thread_fence(__ATOMIC_SEQ_CST); QUEUE_PREEMPTION_POINT(); }while(0)
+#endif
+
+/*
+ * Host only: where an interrupt hurts most, between reading a counter and
+ * swapping it and between writing an item and publishing it. The host stress
+ * test (HostSim/QueueStress.c) switches threads there, empty otherwise.
+ */
+#ifndef QUEUE_PREEMPTION_POINT
+#define QUEUE_PREEMPTION_POINT()
+#endif
+
+/* Build fails when the queue size is not a power of two */
+#define QUEUE_CHECK_SIZE(Name, Size)         typedef char Name##_queue_size_check[(((Size) > 1) && (((Size) & ((Size) - 1)) == 0)) ? 1 : -1]
+
+/*******************************************************************************
+ *                            Functions Definitions                            *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Queue_CompareAndSwap
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Expected - Value Address must hold / Desired - New value
+* Parameters (inout): Address - Word to update
+* Parameters (out): None
+* Return value: boolean - TRUE when Address held Expected and was updated
+* Description: Atomic compare and swap. On target an exception between LDREX and
+*              STREX clears the exclusive monitor, the STREX fails and it retries.
+**********************************************************************/
+static inline boolean Queue_CompareAndSwap(volatile uint32 *Address, uint32 Expected, uint32 Desired){
+
+#ifdef __TI_ARM__
+    do{
+        if((uint32)__ldrex((void *)Address) != Expected){
+            __asm(" CLREX");
+            return FALSE;
+        }
+    }while(__strex(Desired, (void *)Address) != 0);
+
+    return TRUE;
+#else
+    QUEUE_PREEMPTION_POINT();
+    return __atomic_compare_exchange_n(Address, &Expected, Desired, FALSE,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+/*
+ * QUEUE_SPSC_DEFINE(Name, ElementType, Size)
+ *
+ * Defines Name_Type and its functions. head and tail are free running counters
+ * masked with Size - 1, each one is written by one side only, so neither side
+ * ever waits:
+ *   void    Name_Init(Name_Type *Queue)
+ *   boolean Name_Enqueue(Name_Type *Queue, const ElementType *Item)    producer
+ *   boolean Name_Dequeue(Name_Type *Queue, ElementType *Item)          consumer
+ *   uint32  Name_DequeueBatch(Name_Type *Queue, ElementType *Items, uint32 MaxItems)
+ *   uint32  Name_Count(const Name_Type *Queue)
+ */
+#define QUEUE_SPSC_DEFINE(Name, ElementType, Size)                                              \
+                                                                                                \
+QUEUE_CHECK_SIZE(Name, Size);                                                                   \
+                                                                                                \
+typedef struct                                                                                  \
+{                                                                                               \
+    volatile uint32 head;               /* next item to read, written by the consumer  */      \
+    volatile uint32 tail;               /* next slot to write, written by the producer */      \
+    ElementType items[Size];                                                                    \
+} Name##_Type;                                                                                  \
+                                                                                                \
+static inline void Name##_Init(Name##_Type *Queue){                                             \
+                                                                                                \
+    Queue->head = 0;                                                                            \
+    Queue->tail = 0;                                                                            \
+}                                                                                               \
+                                                                                                \
+static inline boolean Name##_Enqueue(Name##_Type *Queue, const ElementType *Item){              \
+                                                                                                \
+    uint32 tail = Queue->tail;                                                                  \
+                                                                                                \
+    if((tail - Queue->head) == (Size)){                                                         \
+        return FALSE;                                                                           \
+    }                                                                                           \
+    Queue->items[tail & ((Size) - 1)] = *Item;                                                  \
+    QUEUE_BARRIER();                    /*the item is visible before the new tail*/             \
+    Queue->tail = tail + 1;                                                                     \
+                                                                                                \
+    return TRUE;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline uint32 Name##_DequeueBatch(Name##_Type *Queue, ElementType *Items, uint32 MaxItems){ \
+                                                                                                \
+    uint32 head = Queue->head;                                                                  \
+    uint32 count = Queue->tail - head;                                                          \
+    uint32 i;                                                                                   \
+                                                                                                \
+    if(count > MaxItems){                                                                       \
+        count = MaxItems;                                                                       \
+    }                                                                                           \
+    QUEUE_BARRIER();                    /*the items are read after the tail*/                   \
+    for(i = 0; i < count; i++){                                                                 \
+        Items[i] = Queue->items[(head + i) & ((Size) - 1)];                                     \
+    }                                                                                           \
+    QUEUE_BARRIER();                    /*the slots are read before they are released*/         \
+    Queue->head = head + count;         /*one release for the whole batch*/                     \
+                                                                                                \
+    return count;                                                                               \
+}                                                                                               \
+                                                                                                \
+static inline boolean Name##_Dequeue(Name##_Type *Queue, ElementType *Item){                    \
+                                                                                                \
+    return Name##_DequeueBatch(Queue, Item, 1) == 1;                                            \
+}                                                                                               \
+                                                                                                \
+static inline uint32 Name##_Count(const Name##_Type *Queue){                                    \
+                                                                                                \
+    return Queue->tail - Queue->head;                                                           \
+}
+
+/*
+ * QUEUE_MPSC_DEFINE(Name, ElementType, Size)
+ *
+ * Defines Name_Type and its functions. A producer claims a slot by moving tail
+ * with a compare and swap, fills it, then publishes it through the slot sequence
+ * number, so a producer preempted between the claim and the publish only delays
+ * the consumer at that slot, it never blocks the other producers:
+ *   void    Name_Init(Name_Type *Queue)
+ *   boolean Name_Enqueue(Name_Type *Queue, const ElementType *Item)    any context
+ *   boolean Name_Dequeue(Name_Type *Queue, ElementType *Item)          one consumer
+ *   uint32  Name_DequeueBatch(Name_Type *Queue, ElementType *Items, uint32 MaxItems)
+ */
+#define QUEUE_MPSC_DEFINE(Name, ElementType, Size)                                              \
+                                                                                                \
+QUEUE_CHECK_SIZE(Name, Size);                                                                   \
+                                                                                                \
+typedef struct                                                                                  \
+{                                                                                               \
+    volatile uint32 sequence;           /* position + 1 when published, position when free */  \
+    ElementType item;                                                                           \
+} Name##_SlotType;                                                                              \
+                                                                                                \
+typedef struct                                                                                  \
+{                                                                                               \
+    volatile uint32 head;               /* next item to read, written by the consumer  */      \
+    volatile uint32 tail;               /* next slot to claim, moved by compare and swap */    \
+    Name##_SlotType slots[Size];                                                                \
+} Name##_Type;                                                                                  \
+                                                                                                \
+static inline void Name##_Init(Name##_Type *Queue){                                             \
+                                                                                                \
+    uint32 i;                                                                                   \
+                                                                                                \
+    Queue->head = 0;                                                                            \
+    Queue->tail = 0;                                                                            \
+    for(i = 0; i < (Size); i++){                                                                \
+        Queue->slots[i].sequence = i;                                                           \
+    }                                                                                           \
+}                                                                                               \
+                                                                                                \
+static inline boolean Name##_Enqueue(Name##_Type *Queue, const ElementType *Item){              \
+                                                                                                \
+    Name##_SlotType *slot;                                                                      \
+    uint32 tail;                                                                                \
+                                                                                                \
+    do{                                                                                         \
+        tail = Queue->tail;                                                                     \
+        slot = &Queue->slots[tail & ((Size) - 1)];                                              \
+        if((sint32)(slot->sequence - tail) < 0){                                                \
+            return FALSE;               /*slot of the previous lap not read yet: full*/         \
+        }                                                                                       \
+    }while((slot->sequence != tail) || !Queue_CompareAndSwap(&Queue->tail, tail, tail + 1));   \
+                                                                                                \
+    slot->item = *Item;                                                                         \
+    QUEUE_BARRIER();                    /*the item is visible before it is published*/          \
+    slot->sequence = tail + 1;                                                                  \
+                                                                                                \
+    return TRUE;                                                                                \
+}                                                                                               \
+                                                                                                \
+static inline uint32 Name##_DequeueBatch(Name##_Type *Queue, ElementType *Items, uint32 MaxItems){ \
+                                                                                                \
+    uint32 head = Queue->head;                                                                  \
+    uint32 count = 0;                                                                           \
+                                                                                                \
+    while(count < MaxItems){                                                                    \
+                                                                                                \
+        Name##_SlotType *slot = &Queue->slots[head & ((Size) - 1)];                             \
+                                                                                                \
+        if(slot->sequence != (head + 1)){                                                       \
+            break;                      /*empty, or the next producer is still writing*/        \
+        }                                                                                       \
+        QUEUE_BARRIER();                                                                        \
+        Items[count++] = slot->item;                                                            \
+        QUEUE_BARRIER();                                                                        \
+        slot->sequence = head + (Size); /*free for the next lap*/                               \
+        head++;                                                                                 \
+    }                                                                                           \
+    Queue->head = head;                                                                         \
+                                                                                                \
+    return count;                                                                               \
+}                                                                                               \
+                                                                                                \
+static inline boolean Name##_Dequeue(Name##_Type *Queue, ElementType *Item){                    \
+                                                                                                \
+    return Name##_DequeueBatch(Queue, Item, 1) == 1;                                            \
+}
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* QUEUE_H_ */
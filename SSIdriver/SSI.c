@@ -0,0 +1,462 @@
+/******************************************************************************
+ *
+ * Module: SSI
+ *
+ * File Name: SSI.c
+ *
+ * Description: Source file for the TM4C123GH6PM SSI (SPI master) driver with a
+ *              transaction queue, GPIO chip selects, FIFO burst transfers for short
+ *              transactions and uDMA transfers for long ones
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "SSI.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef __TI_ARM__
+#define SSI_ENTER_CRITICAL()       uint32 savedPrimask = _disable_IRQ()
+#define SSI_EXIT_CRITICAL()        _restore_interrupts(savedPrimask)
+#else
+#define SSI_ENTER_CRITICAL()
+#define SSI_EXIT_CRITICAL()
+#endif
+
+/* Bus address of a buffer, unsigned long has the pointer width on target and host */
+#define SSI_ADDRESS(Ptr)              ((uint32)(unsigned long)(Ptr))
+
+/* SSICR0 8-bit Freescale SPI frames, SSICR1 master enabled, TXRIS at end of transmission */
+#define SSI_CR0_DSS_8BIT              0x7
+#define SSI_CR0_SCR_POS               8
+#define SSI_CR1_SSE                   0x02
+#define SSI_CR1_EOT                   0x10
+
+#define SSI_SR_TNF                    0x02
+#define SSI_SR_RNE                    0x04
+
+#define SSI_IM_RXIM                   0x04
+#define SSI_IM_TXIM                   0x08
+#define SSI_DMACTL_RX_TX              0x03
+
+/*
+ * uDMA channels, receive then transmit: SSI0 10/11, SSI1 24/25, SSI2 12/13 and SSI3
+ * 14/15. SSI1 and SSI3 share their channels with ADC1 and ADC0 sequencers 0 and 1.
+ */
+#define SSI_DMA_RX_CHANNEL(Module)    (g_SsiRxChannel[Module])
+#define SSI_DMA_TX_CHANNEL(Module)    (g_SsiRxChannel[Module] + 1)
+#define SSI_DMA_ENCODING(Module)      (((Module) >= SSI_MODULE2) ? 2u : 0u)
+
+/* Channel control words: bytes, 4 frame arbitration for the half full FIFO, basic mode */
+#define SSI_DMA_CHCTL_DST_FIXED       0xC0000000
+#define SSI_DMA_CHCTL_SRC_FIXED       0x0C000000
+#define SSI_DMA_CHCTL_ARB4            0x00008000
+#define SSI_DMA_CHCTL_XFERSIZE_POS    4
+#define SSI_DMA_CHCTL_BASIC           0x1
+
+#define SSI_DMA_PRIMARY(Channel)      ((Channel) * 4)
+#define SSI_DMA_SRCENDP               0
+#define SSI_DMA_DSTENDP               1
+#define SSI_DMA_CHCTL                 2
+
+#define SSI_UDMA_CFG_MASTEN           0x1
+
+typedef struct
+{
+    SSI_TransactionType *head;          /* receiving, the oldest one                    */
+    SSI_TransactionType *tail;
+    SSI_TransactionType *txTrans;       /* writing, the head or a chained successor     */
+    uint16 txIndex;
+    uint16 rxIndex;
+    uint8 inFlight;                     /* frames written and not read back yet         */
+    boolean dma;
+    uint16 dmaDone;                     /* frames of the head moved by finished chunks  */
+    uint16 dmaChunk;
+    const SSI_DeviceType *device;       /* format and clock programmed in the module    */
+    const SSI_DeviceType *selected;     /* chip select low                              */
+    uint32 *dmaTable;
+}SSI_BusType;
+
+static const uint32 g_SsiBase[SSI_NUMBER_OF_MODULES] = { SSI0_BASE, SSI1_BASE, SSI2_BASE, SSI3_BASE };
+static const uint8 g_SsiRxChannel[SSI_NUMBER_OF_MODULES] = { 10, 24, 12, 14 };
+
+static SSI_BusType g_SsiBus[SSI_NUMBER_OF_MODULES];
+
+/* uDMA end points of the transactions without transmit or receive data */
+static const uint8 g_SsiFill = SSI_FILL_BYTE;
+static uint8 g_SsiDrop;
+
+static void SSI_Deselect(SSI_BusType *Bus){
+
+    if(Bus->selected != NULL_PTR){
+        GPIO_DATA_BITS_REG(Bus->selected->csPort, Bus->selected->csPin) = 0xFF;
+        Bus->selected = NULL_PTR;
+    }
+}
+
+static boolean SSI_UsesDma(const SSI_BusType *Bus, const SSI_TransactionType *Trans){
+
+    return ((Trans->length > SSI_DMA_THRESHOLD) && (Bus->dmaTable != NULL_PTR)) ? TRUE : FALSE;
+}
+
+/* A transaction the writer can start while the previous one of the device is still shifting */
+static boolean SSI_CanChain(const SSI_BusType *Bus, const SSI_TransactionType *Previous,
+                            const SSI_TransactionType *Next){
+
+    return (Previous->keepSelected && (Next->device == Previous->device) && !SSI_UsesDma(Bus, Next)) ? TRUE : FALSE;
+}
+
+/* Program the channels for the next chunk of the head */
+static void SSI_ArmDma(SSI_BusType *Bus, SSI_ModuleType Module){
+
+    SSI_TransactionType *trans = Bus->head;
+    uint32 base = g_SsiBase[Module];
+    uint32 rxEntry = SSI_DMA_PRIMARY(SSI_DMA_RX_CHANNEL(Module));
+    uint32 txEntry = SSI_DMA_PRIMARY(SSI_DMA_TX_CHANNEL(Module));
+    uint32 last;
+    uint32 ctl;
+
+    Bus->dmaChunk = trans->length - Bus->dmaDone;
+    if(Bus->dmaChunk > SSI_DMA_MAX_FRAMES){
+        Bus->dmaChunk = SSI_DMA_MAX_FRAMES;
+    }
+    last = Bus->dmaDone + Bus->dmaChunk - 1;
+    ctl  = SSI_DMA_CHCTL_ARB4 | ((uint32)(Bus->dmaChunk - 1) << SSI_DMA_CHCTL_XFERSIZE_POS) | SSI_DMA_CHCTL_BASIC;
+
+    Bus->dmaTable[rxEntry + SSI_DMA_SRCENDP] = SSI_DR_ADDRESS(base);
+    if(trans->rx != NULL_PTR){
+        Bus->dmaTable[rxEntry + SSI_DMA_DSTENDP] = SSI_ADDRESS(&trans->rx[last]);
+        Bus->dmaTable[rxEntry + SSI_DMA_CHCTL]   = SSI_DMA_CHCTL_SRC_FIXED | ctl;
+    }
+    else{
+        Bus->dmaTable[rxEntry + SSI_DMA_DSTENDP] = SSI_ADDRESS(&g_SsiDrop);
+        Bus->dmaTable[rxEntry + SSI_DMA_CHCTL]   = SSI_DMA_CHCTL_DST_FIXED | SSI_DMA_CHCTL_SRC_FIXED | ctl;
+    }
+
+    Bus->dmaTable[txEntry + SSI_DMA_DSTENDP] = SSI_DR_ADDRESS(base);
+    if(trans->tx != NULL_PTR){
+        Bus->dmaTable[txEntry + SSI_DMA_SRCENDP] = SSI_ADDRESS(&trans->tx[last]);
+        Bus->dmaTable[txEntry + SSI_DMA_CHCTL]   = SSI_DMA_CHCTL_DST_FIXED | ctl;
+    }
+    else{
+        Bus->dmaTable[txEntry + SSI_DMA_SRCENDP] = SSI_ADDRESS(&g_SsiFill);
+        Bus->dmaTable[txEntry + SSI_DMA_CHCTL]   = SSI_DMA_CHCTL_DST_FIXED | SSI_DMA_CHCTL_SRC_FIXED | ctl;
+    }
+
+    /* Receive first, so no received frame is missed once the transmit side starts */
+    UDMA_ENASET_REG = (1u << SSI_DMA_RX_CHANNEL(Module));
+    UDMA_ENASET_REG = (1u << SSI_DMA_TX_CHANNEL(Module));
+}
+
+/* Write frames while the receive FIFO can hold their answers, moving into chained transactions */
+static void SSI_Fill(SSI_BusType *Bus, uint32 Base){
+
+    while((Bus->txTrans != NULL_PTR) && (Bus->inFlight < SSI_FIFO_DEPTH) && (SSI_SR_REG(Base) & SSI_SR_TNF)){
+
+        SSI_TransactionType *trans = Bus->txTrans;
+
+        SSI_DR_REG(Base) = (trans->tx != NULL_PTR) ? trans->tx[Bus->txIndex] : SSI_FILL_BYTE;
+        Bus->inFlight++;
+
+        if(++Bus->txIndex == trans->length){
+
+            Bus->txIndex = 0;
+            if((trans->next != NULL_PTR) && SSI_CanChain(Bus, trans, trans->next)){
+                Bus->txTrans = trans->next;
+                Bus->txTrans->state = SSI_TRANSACTION_ACTIVE;
+            }
+            else{
+                Bus->txTrans = NULL_PTR;
+            }
+        }
+    }
+
+    /*
+     * TXRIS at half empty while there is more to write and at the end of the last frame
+     * then. With the receive FIFO spoken for, wait until it is half full instead.
+     */
+    if(Bus->txTrans == NULL_PTR){
+        SSI_CR1_REG(Base) = SSI_CR1_SSE | SSI_CR1_EOT;
+        SSI_IM_REG(Base)  = SSI_IM_TXIM;
+    }
+    else{
+        SSI_CR1_REG(Base) = SSI_CR1_SSE;
+        SSI_IM_REG(Base)  = (Bus->inFlight == SSI_FIFO_DEPTH) ? SSI_IM_RXIM : SSI_IM_TXIM;
+    }
+}
+
+/* Retire the head, its chip select goes high unless it keeps the device selected */
+static void SSI_Complete(SSI_BusType *Bus){
+
+    SSI_TransactionType *trans = Bus->head;
+
+    Bus->head    = trans->next;
+    Bus->rxIndex = 0;
+    if(Bus->head == NULL_PTR){
+        Bus->tail = NULL_PTR;
+    }
+
+    trans->state = SSI_TRANSACTION_DONE;
+    if(!trans->keepSelected){
+        SSI_Deselect(Bus);
+    }
+
+    if(trans->callBack != NULL_PTR){
+        trans->callBack(trans);
+    }
+}
+
+/* Read back the received frames of the active transactions */
+static void SSI_Drain(SSI_BusType *Bus, uint32 Base){
+
+    while((Bus->inFlight != 0) && (SSI_SR_REG(Base) & SSI_SR_RNE)){
+
+        SSI_TransactionType *trans = Bus->head;
+        uint8 frame = (uint8)SSI_DR_REG(Base);
+
+        if(trans->rx != NULL_PTR){
+            trans->rx[Bus->rxIndex] = frame;
+        }
+        Bus->inFlight--;
+
+        if(++Bus->rxIndex == trans->length){
+            SSI_Complete(Bus);
+        }
+    }
+}
+
+/* Start the head when the bus has finished the previous one */
+static void SSI_Start(SSI_BusType *Bus, SSI_ModuleType Module){
+
+    SSI_TransactionType *trans = Bus->head;
+    const SSI_DeviceType *device;
+    uint32 base = g_SsiBase[Module];
+
+    if(trans == NULL_PTR){
+        SSI_IM_REG(base) = 0;
+        return;
+    }
+    if(trans->state == SSI_TRANSACTION_ACTIVE){
+        return;
+    }
+
+    device = trans->device;
+    if(Bus->selected != device){
+        SSI_Deselect(Bus);
+    }
+
+    /* The frame format and clock are changed with the module disabled */
+    if(Bus->device != device){
+
+        SSI_CR1_REG(base)  = 0;
+        SSI_CR0_REG(base)  = ((uint32)device->scr << SSI_CR0_SCR_POS) | (uint32)device->mode | SSI_CR0_DSS_8BIT;
+        SSI_CPSR_REG(base) = device->cpsdvsr;
+        SSI_CR1_REG(base)  = SSI_CR1_SSE;
+        Bus->device = device;
+    }
+
+    if(Bus->selected == NULL_PTR){
+        GPIO_DATA_BITS_REG(device->csPort, device->csPin) = 0;
+        Bus->selected = device;
+    }
+
+    trans->state = SSI_TRANSACTION_ACTIVE;
+
+    if(SSI_UsesDma(Bus, trans)){
+
+        Bus->dma     = TRUE;
+        Bus->dmaDone = 0;
+        SSI_IM_REG(base) = 0;
+        SSI_ArmDma(Bus, Module);
+        SSI_DMACTL_REG(base) = SSI_DMACTL_RX_TX;
+    }
+    else{
+
+        Bus->txTrans = trans;
+        Bus->txIndex = 0;
+        SSI_Fill(Bus, base);
+    }
+}
+
+/*********************************************************************
+* Service Name: SSI_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - SSI module / DmaTable - uDMA control table shared with
+*                  the other uDMA users, 1024 byte aligned, NULL_PTR for FIFO only
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clock the module as an SPI master and empty its queue. The
+*              SSI pins and the chip select outputs are configured by the application.
+**********************************************************************/
+void SSI_Init(SSI_ModuleType Module, uint32 *DmaTable){
+
+    SSI_BusType *bus = &g_SsiBus[Module];
+    uint32 base = g_SsiBase[Module];
+
+    SYSCTL_RCGCSSI_REG |= (1u << Module);
+    SYSCTL_SCGCSSI_REG |= (1u << Module);
+    SYSCTL_DCGCSSI_REG |= (1u << Module);
+    while(!(SYSCTL_PRSSI_REG & (1u << Module))){}
+
+    SSI_CR1_REG(base)    = 0;
+    SSI_IM_REG(base)     = 0;
+    SSI_DMACTL_REG(base) = 0;
+    SSI_CC_REG(base)     = 0;
+
+    bus->head     = NULL_PTR;
+    bus->tail     = NULL_PTR;
+    bus->txTrans  = NULL_PTR;
+    bus->rxIndex  = 0;
+    bus->inFlight = 0;
+    bus->dma      = FALSE;
+    bus->device   = NULL_PTR;
+    bus->selected = NULL_PTR;
+    bus->dmaTable = DmaTable;
+
+    if(DmaTable != NULL_PTR){
+
+        uint32 rx = SSI_DMA_RX_CHANNEL(Module);
+        uint32 channels = (1u << rx) | (2u << rx);
+
+        SYSCTL_RCGCDMA_REG |= 0x1;
+        SYSCTL_SCGCDMA_REG |= 0x1;
+        SYSCTL_DCGCDMA_REG |= 0x1;
+        while(!(SYSCTL_PRDMA_REG & 0x1)){}
+
+        UDMA_CFG_REG     = SSI_UDMA_CFG_MASTEN;
+        UDMA_CTLBASE_REG = SSI_ADDRESS(DmaTable);
+
+        /* Both channels are in the same CHMAP register */
+        UDMA_ENACLR_REG = channels;
+        UDMA_CHMAP_REG(rx) = (UDMA_CHMAP_REG(rx) & ~(0xFFu << (4 * (rx % 8)))) |
+                             ((SSI_DMA_ENCODING(Module) * 0x11u) << (4 * (rx % 8)));
+        UDMA_USEBURSTCLR_REG = channels;
+        UDMA_PRIOCLR_REG     = channels;
+        UDMA_ALTCLR_REG      = channels;
+        UDMA_REQMASKCLR_REG  = channels;
+    }
+}
+
+/*********************************************************************
+* Service Name: SSI_Submit
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - SSI module
+* Parameters (inout): Transaction - Transaction, owned by the driver until done
+* Parameters (out): None
+* Return value: boolean - FALSE for an empty transaction or one already queued
+* Description: Function to queue a transaction, it starts at once on an idle bus. The
+*              handler starts the next one as soon as the previous one completes.
+**********************************************************************/
+boolean SSI_Submit(SSI_ModuleType Module, SSI_TransactionType *Transaction){
+
+    SSI_BusType *bus = &g_SsiBus[Module];
+    SSI_TransactionType *previous;
+
+    if((Transaction->length == 0) || (Transaction->state == SSI_TRANSACTION_QUEUED) ||
+       (Transaction->state == SSI_TRANSACTION_ACTIVE)){
+        return FALSE;
+    }
+
+    Transaction->next  = NULL_PTR;
+    Transaction->state = SSI_TRANSACTION_QUEUED;
+
+    {
+        SSI_ENTER_CRITICAL();
+
+        previous = bus->tail;
+        if(previous != NULL_PTR){
+            previous->next = Transaction;
+        }
+        else{
+            bus->head = Transaction;
+        }
+        bus->tail = Transaction;
+
+        if(previous == NULL_PTR){
+            SSI_Start(bus, Module);
+        }
+        /* The previous one is fully written and still shifting, continue right after it */
+        else if(!bus->dma && (bus->txTrans == NULL_PTR) && (previous->state == SSI_TRANSACTION_ACTIVE) &&
+                SSI_CanChain(bus, previous, Transaction)){
+            Transaction->state = SSI_TRANSACTION_ACTIVE;
+            bus->txTrans = Transaction;
+            bus->txIndex = 0;
+            SSI_Fill(bus, g_SsiBase[Module]);
+        }
+
+        SSI_EXIT_CRITICAL();
+    }
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: SSI_IsIdle
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - SSI module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when no transaction is queued or running
+* Description: Function to check that the queue of a module is empty.
+**********************************************************************/
+boolean SSI_IsIdle(SSI_ModuleType Module){
+
+    return (g_SsiBus[Module].head == NULL_PTR) ? TRUE : FALSE;
+}
+
+/*********************************************************************
+* Service Name: SSI_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - SSI module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the FIFO and uDMA done interrupts of a module. The
+*              vector table entries SSI_Ssi0_Handler ... SSI_Ssi3_Handler call it.
+**********************************************************************/
+void SSI_Handler(SSI_ModuleType Module){
+
+    SSI_BusType *bus = &g_SsiBus[Module];
+    uint32 base = g_SsiBase[Module];
+
+    if(bus->dma){
+
+        uint32 rxBit = 1u << SSI_DMA_RX_CHANNEL(Module);
+        uint32 txBit = 1u << SSI_DMA_TX_CHANNEL(Module);
+
+        /* Every frame is sent once the last one is received */
+        if(!(UDMA_CHIS_REG & rxBit)){
+            return;
+        }
+        UDMA_CHIS_REG = rxBit | txBit;
+
+        bus->dmaDone += bus->dmaChunk;
+        if(bus->dmaDone < bus->head->length){
+            SSI_ArmDma(bus, Module);
+            return;
+        }
+
+        SSI_DMACTL_REG(base) = 0;
+        bus->dma = FALSE;
+        SSI_Complete(bus);
+    }
+    else if(bus->head != NULL_PTR){
+
+        SSI_Drain(bus, base);
+        SSI_Fill(bus, base);
+    }
+
+    SSI_Start(bus, Module);
+}
+
+/* Vector table entries */
+#define SSI_DEFINE_HANDLER(Name, Module)            void SSI_##Name##_Handler(void){ SSI_Handler(Module); }
+
+SSI_DEFINE_HANDLER(Ssi0, SSI_MODULE0)
+SSI_DEFINE_HANDLER(Ssi1, SSI_MODULE1)
+SSI_DEFINE_HANDLER(Ssi2, SSI_MODULE2)
+SSI_DEFINE_HANDLER(Ssi3, SSI_MODULE3)
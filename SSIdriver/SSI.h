@@ -0,0 +1,172 @@
+/******************************************************************************
+ *
+ * Module: SSI
+ *
+ * File Name: SSI.h
+ *
+ * Description: Header file for the TM4C123GH6PM SSI (SPI master) driver with a
+ *              transaction queue, GPIO chip selects, FIFO burst transfers for short
+ *              transactions and uDMA transfers for long ones
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef SSI_H_
+#define SSI_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define SSI_NUMBER_OF_MODULES                4
+#define SSI_FIFO_DEPTH                       8
+
+/*
+ * Transactions longer than this use the uDMA when the module has a uDMA table, the
+ * shorter ones are cheaper to feed from the FIFO interrupt than to set up a channel
+ */
+#ifndef SSI_DMA_THRESHOLD
+#define SSI_DMA_THRESHOLD                    32
+#endif
+
+/* Most frames moved by one uDMA transfer, longer transactions take several */
+#define SSI_DMA_MAX_FRAMES                   1024
+
+/* Byte sent by transactions without transmit data */
+#define SSI_FILL_BYTE                        0xFF
+
+/* SysClk / (cpsdvsr * (1 + scr)), the SSI master runs at up to SysClk / 2 */
+#define SSI_BIT_RATE(SysClk, Cpsdvsr, Scr)   ((SysClk) / ((uint32)(Cpsdvsr) * (1u + (Scr))))
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    SSI_MODULE0, SSI_MODULE1, SSI_MODULE2, SSI_MODULE3
+}SSI_ModuleType;
+
+/* SPI clock polarity and phase, the SPO and SPH bits of SSICR0 */
+typedef enum
+{
+    SSI_MODE0 = 0x00,                   /* idle low, sample on the rising edge         */
+    SSI_MODE1 = 0x80,                   /* idle low, sample on the falling edge        */
+    SSI_MODE2 = 0x40,                   /* idle high, sample on the falling edge       */
+    SSI_MODE3 = 0xC0                    /* idle high, sample on the rising edge        */
+}SSI_ModeType;
+
+/* A device on the bus, selected by an active low GPIO output */
+typedef struct
+{
+    uint32 csPort;                      /* GPIO_PORTx_BASE                              */
+    uint8 csPin;                        /* pin mask                                     */
+    SSI_ModeType mode;
+    uint8 cpsdvsr;                      /* even, 2 ... 254                              */
+    uint8 scr;                          /* 0 ... 255                                    */
+}SSI_DeviceType;
+
+typedef enum
+{
+    SSI_TRANSACTION_IDLE,               /* never submitted                             */
+    SSI_TRANSACTION_QUEUED,
+    SSI_TRANSACTION_ACTIVE,
+    SSI_TRANSACTION_DONE
+}SSI_TransactionStateType;
+
+/*
+ * Full duplex transfer of 8-bit frames with one device. The transaction belongs to
+ * the driver from SSI_Submit until its state is SSI_TRANSACTION_DONE, the call back
+ * may submit it again.
+ */
+typedef struct SSI_Transaction
+{
+    const SSI_DeviceType *device;
+    const uint8 *tx;                    /* NULL_PTR sends SSI_FILL_BYTE                 */
+    uint8 *rx;                          /* NULL_PTR drops the received bytes            */
+    uint16 length;
+    boolean keepSelected;               /* chip select stays low for the next one, a
+                                           queued next one of the same device follows
+                                           without a gap on the bus                     */
+    void (*callBack)(struct SSI_Transaction *Transaction);
+    volatile SSI_TransactionStateType state;
+    struct SSI_Transaction *next;       /* queue link, driver owned                     */
+}SSI_TransactionType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: SSI_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - SSI module / DmaTable - uDMA control table shared with
+*                  the other uDMA users, 1024 byte aligned, NULL_PTR for FIFO only
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clock the module as an SPI master and empty its queue. The
+*              SSI pins and the chip select outputs are configured by the application.
+**********************************************************************/
+
+void SSI_Init(SSI_ModuleType Module, uint32 *DmaTable);
+
+/*********************************************************************
+* Service Name: SSI_Submit
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - SSI module
+* Parameters (inout): Transaction - Transaction, owned by the driver until done
+* Parameters (out): None
+* Return value: boolean - FALSE for an empty transaction or one already queued
+* Description: Function to queue a transaction, it starts at once on an idle bus. The
+*              handler starts the next one as soon as the previous one completes.
+**********************************************************************/
+
+boolean SSI_Submit(SSI_ModuleType Module, SSI_TransactionType *Transaction);
+
+/*********************************************************************
+* Service Name: SSI_IsIdle
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Module - SSI module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - TRUE when no transaction is queued or running
+* Description: Function to check that the queue of a module is empty.
+**********************************************************************/
+
+boolean SSI_IsIdle(SSI_ModuleType Module);
+
+/*********************************************************************
+* Service Name: SSI_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Module - SSI module
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the FIFO and uDMA done interrupts of a module. The
+*              vector table entries SSI_Ssi0_Handler ... SSI_Ssi3_Handler call it.
+**********************************************************************/
+
+void SSI_Handler(SSI_ModuleType Module);
+
+/* Vector table entries, one per NVIC_SSIn_IRQ */
+void SSI_Ssi0_Handler(void);
+void SSI_Ssi1_Handler(void);
+void SSI_Ssi2_Handler(void);
+void SSI_Ssi3_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* SSI_H_ */
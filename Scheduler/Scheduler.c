@@ -0,0 +1,311 @@
+/******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: Scheduler.c
+ *
+ * Description: Source file for the priority based run-to-completion task scheduler
+ *              dispatched from PendSV and ticked by SysTick
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Scheduler.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef HOST_SIMULATION
+#include "HostModel.h"
+#endif
+
+#ifdef __TI_ARM__
+/* Save PRIMASK and mask IRQs, so posting works with interrupts already masked */
+#define SCHED_ENTER_CRITICAL()     uint32 savedPrimask = _disable_IRQ()
+#define SCHED_EXIT_CRITICAL()      _restore_interrupts(savedPrimask)
+#define SCHED_CLZ(Value)           _norm(Value)
+#else
+#define SCHED_ENTER_CRITICAL()
+#define SCHED_EXIT_CRITICAL()
+#define SCHED_CLZ(Value)           __builtin_clz(Value)
+#endif
+
+/* The host simulation turns the PendSV request into a HostModel exception */
+#if defined(__TI_ARM__) || defined(HOST_SIMULATION)
+#define SCHED_PEND_DISPATCH()      (NVIC_SYSTEM_INTCTRL = SCHED_INTCTRL_PENDSV_SET)
+#define SCHED_SET_PENDSV_LOWEST()  (NVIC_SYSTEM_PRI3_REG |= SCHED_PENDSV_LOWEST_PRIORITY)
+#else
+#define SCHED_PEND_DISPATCH()
+#define SCHED_SET_PENDSV_LOWEST()
+#endif
+
+typedef struct
+{
+    Sched_TaskFuncType func;
+    uint8 head;                                 /* next event to dispatch */
+    uint8 tail;                                 /* next free slot         */
+    Sched_EventType events[SCHED_QUEUE_SIZE];
+    uint32 postTime[SCHED_QUEUE_SIZE];
+} Sched_TaskType;
+
+typedef struct
+{
+    Sched_TaskIdType task;
+    Sched_EventType event;
+    uint32 remaining;                           /* 0 when the timer is stopped */
+    uint32 period;
+} Sched_TimerType;
+
+static Sched_TaskType g_Tasks[SCHED_MAX_TASKS];
+static Sched_StatsType g_Stats[SCHED_MAX_TASKS];
+static Sched_TimerType g_Timers[SCHED_MAX_TIMERS];
+
+/* Bit n set when task n has at least one queued event */
+static volatile uint32 g_ReadySet = 0;
+
+/*********************************************************************
+* Service Name: Sched_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear every task, queue and timer.
+**********************************************************************/
+void Sched_Init(void){
+
+    uint8 i;
+
+    g_ReadySet = 0;
+
+    /* PendSV must not preempt any ISR, otherwise tasks would delay interrupts */
+    SCHED_SET_PENDSV_LOWEST();
+
+    for(i = 0; i < SCHED_MAX_TASKS; i++){
+
+        g_Tasks[i].func = NULL_PTR;
+        g_Tasks[i].head = 0;
+        g_Tasks[i].tail = 0;
+        g_Stats[i].dispatchCount = 0;
+        g_Stats[i].overflowCount = 0;
+        g_Stats[i].maxResponseTime = 0;
+        g_Stats[i].totalResponseTime = 0;
+    }
+
+    for(i = 0; i < SCHED_MAX_TIMERS; i++){
+
+        g_Timers[i].remaining = 0;
+    }
+}
+
+/*********************************************************************
+* Service Name: Sched_CreateTask
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): TaskId - Task priority (0 .. SCHED_MAX_TASKS-1) / TaskFunc - Task body
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Sched_StatusType
+* Description: Function to register a task at the given priority.
+**********************************************************************/
+Sched_StatusType Sched_CreateTask(Sched_TaskIdType TaskId, Sched_TaskFuncType TaskFunc){
+
+    if((TaskId >= SCHED_MAX_TASKS) || (TaskFunc == NULL_PTR)){
+        return SCHED_INVALID_TASK;
+    }
+
+    g_Tasks[TaskId].func = TaskFunc;
+
+    return SCHED_OK;
+}
+
+/*********************************************************************
+* Service Name: Sched_Post
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): TaskId - Destination task / Event - Event value
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Sched_StatusType
+* Description: Function to queue an event for a task and pend PendSV. Safe from any ISR.
+**********************************************************************/
+Sched_StatusType Sched_Post(Sched_TaskIdType TaskId, Sched_EventType Event){
+
+    Sched_TaskType *task;
+    uint8 slot;
+
+    if((TaskId >= SCHED_MAX_TASKS) || (g_Tasks[TaskId].func == NULL_PTR)){
+        return SCHED_INVALID_TASK;
+    }
+
+    task = &g_Tasks[TaskId];
+
+    {
+        SCHED_ENTER_CRITICAL();
+
+        if((uint8)(task->tail - task->head) >= SCHED_QUEUE_SIZE){
+
+            g_Stats[TaskId].overflowCount++;
+            SCHED_EXIT_CRITICAL();
+            return SCHED_QUEUE_FULL;
+        }
+
+        slot = task->tail & SCHED_QUEUE_MASK;
+        task->events[slot]   = Event;
+        task->postTime[slot] = SCHED_TIMESTAMP();
+        task->tail++;
+
+        g_ReadySet |= (1UL << TaskId);
+
+        SCHED_EXIT_CRITICAL();
+    }
+
+    SCHED_PEND_DISPATCH();      /*PendSV runs once every higher priority ISR returned*/
+
+    return SCHED_OK;
+}
+
+/*********************************************************************
+* Service Name: Sched_StartTimer
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): TimerId - Timer index / TaskId - Destination task / Event - Event value
+*                  Ticks - First expiry in SysTick ticks / Period - Reload, 0 for one shot
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Sched_StatusType
+* Description: Function to post Event to TaskId after Ticks, then every Period ticks.
+**********************************************************************/
+Sched_StatusType Sched_StartTimer(uint8 TimerId, Sched_TaskIdType TaskId, Sched_EventType Event,
+                                  uint32 Ticks, uint32 Period){
+
+    if((TimerId >= SCHED_MAX_TIMERS) || (TaskId >= SCHED_MAX_TASKS) || (Ticks == 0)){
+        return SCHED_INVALID_TASK;
+    }
+
+    g_Timers[TimerId].remaining = 0;        /*stop it while the fields are updated*/
+    g_Timers[TimerId].task   = TaskId;
+    g_Timers[TimerId].event  = Event;
+    g_Timers[TimerId].period = Period;
+    g_Timers[TimerId].remaining = Ticks;
+
+    return SCHED_OK;
+}
+
+/*********************************************************************
+* Service Name: Sched_StopTimer
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): TimerId - Timer index
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop a software timer.
+**********************************************************************/
+void Sched_StopTimer(uint8 TimerId){
+
+    if(TimerId < SCHED_MAX_TIMERS){
+        g_Timers[TimerId].remaining = 0;
+    }
+}
+
+/*********************************************************************
+* Service Name: Sched_Tick
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to advance the software timers, register it with SysTick_SetCallBack.
+**********************************************************************/
+void Sched_Tick(void){
+
+    uint8 i;
+
+    for(i = 0; i < SCHED_MAX_TIMERS; i++){
+
+        if((g_Timers[i].remaining != 0) && (--g_Timers[i].remaining == 0)){
+
+            g_Timers[i].remaining = g_Timers[i].period;     /*0 leaves one shot timers stopped*/
+            Sched_Post(g_Timers[i].task, g_Timers[i].event);
+        }
+    }
+}
+
+/*********************************************************************
+* Service Name: Sched_Dispatch
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to run ready tasks, highest priority first, until none is ready.
+**********************************************************************/
+void Sched_Dispatch(void){
+
+    while(g_ReadySet != 0){
+
+        Sched_TaskIdType taskId = (Sched_TaskIdType)(31 - SCHED_CLZ(g_ReadySet));
+        Sched_TaskType *task = &g_Tasks[taskId];
+        Sched_StatsType *stats = &g_Stats[taskId];
+        Sched_EventType event;
+        uint32 responseTime;
+
+        {
+            SCHED_ENTER_CRITICAL();
+
+            event = task->events[task->head & SCHED_QUEUE_MASK];
+            responseTime = SCHED_TIMESTAMP() - task->postTime[task->head & SCHED_QUEUE_MASK];
+            task->head++;
+
+            if(task->head == task->tail){
+                g_ReadySet &= ~(1UL << taskId);
+            }
+
+            SCHED_EXIT_CRITICAL();
+        }
+
+        stats->dispatchCount++;
+        stats->totalResponseTime += responseTime;
+        if(responseTime > stats->maxResponseTime){
+            stats->maxResponseTime = responseTime;
+        }
+
+        task->func(event);      /*run to completion with interrupts enabled*/
+    }
+}
+
+/*********************************************************************
+* Service Name: PendSV_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to handle ISR for PendSV, calls Sched_Dispatch.
+**********************************************************************/
+void PendSV_Handler(void){
+
+    Sched_Dispatch();
+}
+
+/*********************************************************************
+* Service Name: Sched_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): TaskId - Task priority
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the task statistics, NULL_PTR for an invalid task
+* Description: Function to read the dispatch and response time statistics of a task.
+**********************************************************************/
+const Sched_StatsType *Sched_GetStats(Sched_TaskIdType TaskId){
+
+    if(TaskId >= SCHED_MAX_TASKS){
+        return NULL_PTR;
+    }
+
+    return &g_Stats[TaskId];
+}
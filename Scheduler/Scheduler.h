@@ -0,0 +1,222 @@
+/******************************************************************************
+ *
+ * Module: Scheduler
+ *
+ * File Name: Scheduler.h
+ *
+ * Description: Header file for the priority based run-to-completion task scheduler
+ *              dispatched from PendSV and ticked by SysTick
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of tasks, one priority level each, 32 at most (one ready bit per task) */
+#ifndef SCHED_MAX_TASKS
+#define SCHED_MAX_TASKS                      8
+#endif
+
+/* Depth of each task event queue, must be a power of two */
+#ifndef SCHED_QUEUE_SIZE
+#define SCHED_QUEUE_SIZE                     8
+#endif
+
+/* Number of software timers driven by Sched_Tick */
+#ifndef SCHED_MAX_TIMERS
+#define SCHED_MAX_TIMERS                     4
+#endif
+
+/* Free running timestamp used for response time statistics, 0 disables them.
+ * The host simulation counts in HostModel core cycles */
+#ifndef SCHED_TIMESTAMP
+#ifdef HOST_SIMULATION
+#define SCHED_TIMESTAMP()                    ((uint32)HostModel_GetCycles())
+#else
+#define SCHED_TIMESTAMP()                    0
+#endif
+#endif
+
+#define SCHED_QUEUE_MASK                     (SCHED_QUEUE_SIZE - 1)
+
+/* PENDSTSET bit of the Interrupt Control and State register */
+#define SCHED_INTCTRL_PENDSV_SET             0x10000000
+
+/* PendSV priority 7 (lowest) in the SYSPRI3 register */
+#define SCHED_PENDSV_LOWEST_PRIORITY         0x00E00000
+
+#if (SCHED_MAX_TASKS > 32)
+#error "SCHED_MAX_TASKS must not exceed 32"
+#endif
+
+#if ((SCHED_QUEUE_SIZE & SCHED_QUEUE_MASK) != 0)
+#error "SCHED_QUEUE_SIZE must be a power of two"
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Task priority, also its identifier. Higher value runs first */
+typedef uint8 Sched_TaskIdType;
+
+typedef uint32 Sched_EventType;
+
+/* Task body, runs to completion for one event */
+typedef void (*Sched_TaskFuncType)(Sched_EventType Event);
+
+typedef enum
+{
+    SCHED_OK,
+    SCHED_QUEUE_FULL,
+    SCHED_INVALID_TASK
+}Sched_StatusType;
+
+/* Per task statistics in SCHED_TIMESTAMP units */
+typedef struct
+{
+    uint32 dispatchCount;
+    uint32 overflowCount;
+    uint32 maxResponseTime;     /* post to start of the task body        */
+    uint32 totalResponseTime;   /* sum, divide by dispatchCount for mean */
+} Sched_StatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Sched_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to clear every task, queue and timer.
+**********************************************************************/
+
+void Sched_Init(void);
+
+/*********************************************************************
+* Service Name: Sched_CreateTask
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): TaskId - Task priority (0 .. SCHED_MAX_TASKS-1) / TaskFunc - Task body
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Sched_StatusType
+* Description: Function to register a task at the given priority.
+**********************************************************************/
+
+Sched_StatusType Sched_CreateTask(Sched_TaskIdType TaskId, Sched_TaskFuncType TaskFunc);
+
+/*********************************************************************
+* Service Name: Sched_Post
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): TaskId - Destination task / Event - Event value
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Sched_StatusType
+* Description: Function to queue an event for a task and pend PendSV. Safe from any ISR.
+**********************************************************************/
+
+Sched_StatusType Sched_Post(Sched_TaskIdType TaskId, Sched_EventType Event);
+
+/*********************************************************************
+* Service Name: Sched_StartTimer
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): TimerId - Timer index / TaskId - Destination task / Event - Event value
+*                  Ticks - First expiry in SysTick ticks / Period - Reload, 0 for one shot
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Sched_StatusType
+* Description: Function to post Event to TaskId after Ticks, then every Period ticks.
+**********************************************************************/
+
+Sched_StatusType Sched_StartTimer(uint8 TimerId, Sched_TaskIdType TaskId, Sched_EventType Event,
+                                  uint32 Ticks, uint32 Period);
+
+/*********************************************************************
+* Service Name: Sched_StopTimer
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): TimerId - Timer index
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to stop a software timer.
+**********************************************************************/
+
+void Sched_StopTimer(uint8 TimerId);
+
+/*********************************************************************
+* Service Name: Sched_Tick
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to advance the software timers, register it with SysTick_SetCallBack.
+**********************************************************************/
+
+void Sched_Tick(void);
+
+/*********************************************************************
+* Service Name: Sched_Dispatch
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to run ready tasks, highest priority first, until none is ready.
+**********************************************************************/
+
+void Sched_Dispatch(void);
+
+/*********************************************************************
+* Service Name: PendSV_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to handle ISR for PendSV, calls Sched_Dispatch.
+**********************************************************************/
+
+void PendSV_Handler(void);
+
+/*********************************************************************
+* Service Name: Sched_GetStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): TaskId - Task priority
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the task statistics, NULL_PTR for an invalid task
+* Description: Function to read the dispatch and response time statistics of a task.
+**********************************************************************/
+
+const Sched_StatsType *Sched_GetStats(Sched_TaskIdType TaskId);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* SCHEDULER_H_ */
@@ -13,7 +13,7 @@
 #include "tm4c123gh6pm_registers.h"
 
 
-extern volatile void (*g_CallBackPtr)(void) = NULL_PTR;      /*Global Variable for Call Back Pointer = NULL*/
+static void (*volatile g_CallBackPtr)(void) = NULL_PTR;      /*Call Back Pointer, set by SysTick_SetCallBack, NULL = none*/
 
 /*********************************************************************
 * Service Name: SysTick_Init
@@ -70,7 +70,7 @@ void SysTick_StartBusyWait(uint16 a_TimeInMilliSeconds){
 * Return value: None
 * Description: Function to handle ISR for SysTick
 **********************************************************************/
-void SysTick_Handler(void){
+RAMFUNC void SysTick_Handler(void){
 
     if(g_CallBackPtr != NULL_PTR){
 
@@ -88,7 +88,7 @@ void SysTick_Handler(void){
 * Return value: None
 * Description: Function to set the call back function
 **********************************************************************/
-void SysTick_SetCallBack(volatile void (*Ptr2Func) (void)){
+void SysTick_SetCallBack(void (*Ptr2Func) (void)){
 
     g_CallBackPtr = Ptr2Func;
 
@@ -75,7 +75,7 @@ void SysTick_Handler(void);
 * Description: Function to set the call back function
 **********************************************************************/
 
-void SysTick_SetCallBack(volatile void (*Ptr2Func) (void));
+void SysTick_SetCallBack(void (*Ptr2Func) (void));
 
 /*********************************************************************
 * Service Name: SysTick_Stop
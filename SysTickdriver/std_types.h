@@ -30,8 +30,14 @@ typedef unsigned char         uint8;          /*           0 .. 255
 typedef signed char           sint8;          /*        -128 .. +127             */
 typedef unsigned short        uint16;         /*           0 .. 65535            */
 typedef signed short          sint16;         /*      -32768 .. +32767           */
+#if defined(__LP64__) || defined(_LP64)
+/* 64-bit host (HOST_SIMULATION builds), long is 64 bits wide */
+typedef unsigned int          uint32;         /*           0 .. 4294967295       */
+typedef signed int            sint32;         /* -2147483648 .. +2147483647      */
+#else
 typedef unsigned long         uint32;         /*           0 .. 4294967295       */
 typedef signed long           sint32;         /* -2147483648 .. +2147483647      */
+#endif
 typedef unsigned long long    uint64;         /*       0 .. 18446744073709551615  */
 typedef signed long long      sint64;         /* -9223372036854775808 .. 9223372036854775807 */
 typedef float                 float32;
@@ -40,4 +46,12 @@ typedef double                float64;
 /* Boolean Data Type */
 typedef uint8 boolean;
 
+/* Place a function in the .ramfunc section, which the linker command file loads
+ * from FLASH and runs from zero-wait-state SRAM. Use it for ISRs and hot helpers. */
+#if defined(__TI_ARM__) || (defined(__GNUC__) && defined(__arm__))
+#define RAMFUNC     __attribute__((section(".ramfunc")))
+#else
+#define RAMFUNC
+#endif
+
 #endif /* STD_TYPE_H_ */
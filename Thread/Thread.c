@@ -0,0 +1,381 @@
+/******************************************************************************
+ *
+ * Module: Thread
+ *
+ * File Name: Thread.c
+ *
+ * Description: Source file for the preemptive thread layer with PendSV context
+ *              switching and lazy FPU state preservation
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Thread.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef __TI_ARM__
+#define THREAD_ENTER_CRITICAL()    uint32 savedPrimask = _disable_IRQ()
+#define THREAD_EXIT_CRITICAL()     _restore_interrupts(savedPrimask)
+#define THREAD_CLZ(Value)          _norm(Value)
+#define THREAD_PEND_SWITCH()       (NVIC_SYSTEM_INTCTRL = THREAD_INTCTRL_PENDSV_SET)
+#else
+/* Host build: no PendSV, the switch is simulated by updating the current thread */
+#define THREAD_ENTER_CRITICAL()
+#define THREAD_EXIT_CRITICAL()
+#define THREAD_CLZ(Value)          __builtin_clz(Value)
+#define THREAD_PEND_SWITCH()       Thread_SimulateSwitch()
+#endif
+
+/* Address as the 32-bit value the target stacks (the host pointers are wider) */
+#define THREAD_ADDRESS(Ptr)        ((uint32)(unsigned long)(Ptr))
+
+/* Running thread and the one selected by Thread_Schedule, used by Thread_Switch.asm */
+Thread_ControlBlockType *g_ThreadCurrent = NULL_PTR;
+Thread_ControlBlockType *g_ThreadNext = NULL_PTR;
+Thread_SwitchStatsType g_ThreadSwitchStats;
+
+static Thread_ControlBlockType g_ThreadTable[THREAD_MAX_THREADS];
+
+/* Bit n set when thread n is ready, the idle thread is always ready */
+static volatile uint32 g_ThreadReadySet = 0;
+
+/* Static stack pool, 8 byte aligned as required for exception frames */
+#ifdef __TI_ARM__
+#pragma DATA_ALIGN(g_ThreadStacks, 8)
+#endif
+static uint32 g_ThreadStacks[THREAD_MAX_THREADS][THREAD_STACK_WORDS];
+
+static void Thread_IdleLoop(void *Arg){
+
+    (void)Arg;
+    while(1){}
+}
+
+#ifndef __TI_ARM__
+static void Thread_SimulateSwitch(void){
+
+    g_ThreadCurrent = g_ThreadNext;
+    g_ThreadCurrent->switchCount++;
+    g_ThreadSwitchStats.switchCount++;
+}
+#endif
+
+/* Select the highest priority ready thread and request a switch if it changed. The
+ * switch counts are kept by the switch itself, a request can still be overtaken */
+static void Thread_Schedule(void){
+
+    Thread_IdType next = (Thread_IdType)(31 - THREAD_CLZ(g_ThreadReadySet));
+
+    g_ThreadNext = &g_ThreadTable[next];
+
+    if(g_ThreadNext != g_ThreadCurrent){
+        THREAD_PEND_SWITCH();
+    }
+}
+
+/* Return address of every thread, a thread function that returns stops for good */
+static void Thread_Exit(void){
+
+    {
+        THREAD_ENTER_CRITICAL();
+
+        g_ThreadReadySet &= ~(1UL << Thread_GetCurrent());
+        Thread_Schedule();
+
+        THREAD_EXIT_CRITICAL();
+    }
+
+    while(1){}
+}
+
+/* Build the initial exception and software frames so the first switch "returns" into Func */
+static void Thread_InitStack(Thread_IdType ThreadId, Thread_FuncType Func, void *Arg){
+
+    uint32 *sp = &g_ThreadStacks[ThreadId][THREAD_STACK_WORDS];
+    uint8 i;
+
+    sp -= THREAD_HW_FRAME_WORDS;
+    sp[0] = THREAD_ADDRESS(Arg);            /* R0   */
+    sp[1] = 0;                              /* R1   */
+    sp[2] = 0;                              /* R2   */
+    sp[3] = 0;                              /* R3   */
+    sp[4] = 0;                              /* R12  */
+    sp[5] = THREAD_ADDRESS(Thread_Exit);    /* LR   */
+    sp[6] = THREAD_ADDRESS(Func);           /* PC   */
+    sp[7] = THREAD_INITIAL_XPSR;            /* xPSR */
+
+    sp -= THREAD_SW_FRAME_WORDS;
+    for(i = 0; i < (THREAD_SW_FRAME_WORDS - 1); i++){
+        sp[i] = 0;                          /* R4 - R11 */
+    }
+    sp[THREAD_SW_FRAME_WORDS - 1] = THREAD_EXC_RETURN_PSP_BASIC;
+
+    g_ThreadTable[ThreadId].sp = sp;
+}
+
+/*********************************************************************
+* Service Name: Thread_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): IdleFunc - Body of the idle thread, NULL_PTR for an empty loop
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to reset the thread table and create the idle thread.
+**********************************************************************/
+void Thread_Init(Thread_FuncType IdleFunc){
+
+    uint8 i;
+
+    for(i = 0; i < THREAD_MAX_THREADS; i++){
+
+        g_ThreadTable[i].sp = NULL_PTR;
+        g_ThreadTable[i].sleepTicks = 0;
+        g_ThreadTable[i].switchCount = 0;
+    }
+
+    g_ThreadCurrent = NULL_PTR;
+    g_ThreadNext = NULL_PTR;
+    g_ThreadSwitchStats.lastCycles = 0;
+    g_ThreadSwitchStats.maxCycles = 0;
+    g_ThreadSwitchStats.switchCount = 0;
+
+    Thread_InitStack(THREAD_IDLE_ID, (IdleFunc != NULL_PTR) ? IdleFunc : Thread_IdleLoop, NULL_PTR);
+    g_ThreadReadySet = (1UL << THREAD_IDLE_ID);
+}
+
+/*********************************************************************
+* Service Name: Thread_Create
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): ThreadId - Priority (1 .. THREAD_MAX_THREADS-1) / Func - Thread body / Arg - Argument
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Thread_StatusType
+* Description: Function to create a ready thread on its static stack.
+**********************************************************************/
+Thread_StatusType Thread_Create(Thread_IdType ThreadId, Thread_FuncType Func, void *Arg){
+
+    if((ThreadId == THREAD_IDLE_ID) || (ThreadId >= THREAD_MAX_THREADS) || (Func == NULL_PTR)){
+        return THREAD_INVALID_ID;
+    }
+    if(g_ThreadTable[ThreadId].sp != NULL_PTR){
+        return THREAD_ALREADY_CREATED;
+    }
+
+    Thread_InitStack(ThreadId, Func, Arg);
+
+    {
+        THREAD_ENTER_CRITICAL();
+
+        g_ThreadReadySet |= (1UL << ThreadId);
+        if(g_ThreadCurrent != NULL_PTR){
+            Thread_Schedule();      /*created from a running thread, may preempt it*/
+        }
+
+        THREAD_EXIT_CRITICAL();
+    }
+
+    return THREAD_OK;
+}
+
+/*********************************************************************
+* Service Name: Thread_Start
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable lazy FP stacking and the cycle counter, then switch
+*              to the highest priority ready thread. Never returns on target.
+**********************************************************************/
+void Thread_Start(void){
+
+#ifdef __TI_ARM__
+    /* FP context is reserved on exception entry but only stacked if the handler uses the FPU */
+    FPU_CPAC_REG |= THREAD_CPAC_CP10_CP11_FULL;
+    FPU_FPCC_REG |= (THREAD_FPCC_ASPEN | THREAD_FPCC_LSPEN);
+
+    /* Free running cycle counter used to time the context switch */
+    DEBUG_DEMCR_REG |= THREAD_DEMCR_TRCENA;
+    DWT_CYCCNT_REG = 0;
+    DWT_CTRL_REG |= THREAD_DWT_CYCCNTENA;
+
+    /* PendSV must not preempt any ISR */
+    NVIC_SYSTEM_PRI3_REG |= THREAD_PENDSV_LOWEST_PRIORITY;
+#endif
+
+    Thread_Schedule();
+
+#ifdef __TI_ARM__
+    __asm(" CPSIE I ");     /*the pending PendSV switches to the first thread here*/
+
+    while(1){}
+#endif
+}
+
+/*********************************************************************
+* Service Name: Thread_Yield
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to re-run the scheduler and switch if a higher priority thread is ready.
+**********************************************************************/
+void Thread_Yield(void){
+
+    THREAD_ENTER_CRITICAL();
+
+    Thread_Schedule();
+
+    THREAD_EXIT_CRITICAL();
+}
+
+/*********************************************************************
+* Service Name: Thread_Sleep
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ticks - Number of Thread_Tick calls to block for
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to block the calling thread for a number of ticks.
+**********************************************************************/
+void Thread_Sleep(uint32 Ticks){
+
+    Thread_IdType self = Thread_GetCurrent();
+
+    if((Ticks == 0) || (self == THREAD_IDLE_ID)){
+        return;
+    }
+
+    {
+        THREAD_ENTER_CRITICAL();
+
+        g_ThreadTable[self].sleepTicks = Ticks;
+        g_ThreadReadySet &= ~(1UL << self);
+        Thread_Schedule();
+
+        THREAD_EXIT_CRITICAL();     /*PendSV is taken here and this thread blocks*/
+    }
+}
+
+/*********************************************************************
+* Service Name: Thread_Suspend
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to block the calling thread until Thread_Resume is called for it.
+**********************************************************************/
+void Thread_Suspend(void){
+
+    Thread_IdType self = Thread_GetCurrent();
+
+    if(self == THREAD_IDLE_ID){
+        return;
+    }
+
+    {
+        THREAD_ENTER_CRITICAL();
+
+        g_ThreadReadySet &= ~(1UL << self);
+        Thread_Schedule();
+
+        THREAD_EXIT_CRITICAL();
+    }
+}
+
+/*********************************************************************
+* Service Name: Thread_Resume
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): ThreadId - Thread to make ready
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to make a thread ready, safe from any ISR below PendSV priority mask.
+**********************************************************************/
+void Thread_Resume(Thread_IdType ThreadId){
+
+    if((ThreadId >= THREAD_MAX_THREADS) || (g_ThreadTable[ThreadId].sp == NULL_PTR)){
+        return;
+    }
+
+    {
+        THREAD_ENTER_CRITICAL();
+
+        g_ThreadTable[ThreadId].sleepTicks = 0;
+        g_ThreadReadySet |= (1UL << ThreadId);
+        Thread_Schedule();
+
+        THREAD_EXIT_CRITICAL();
+    }
+}
+
+/*********************************************************************
+* Service Name: Thread_Tick
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to wake sleeping threads, register it with SysTick_SetCallBack.
+**********************************************************************/
+void Thread_Tick(void){
+
+    uint8 i;
+
+    THREAD_ENTER_CRITICAL();
+
+    for(i = 1; i < THREAD_MAX_THREADS; i++){
+
+        if((g_ThreadTable[i].sleepTicks != 0) && (--g_ThreadTable[i].sleepTicks == 0)){
+            g_ThreadReadySet |= (1UL << i);
+        }
+    }
+
+    Thread_Schedule();
+
+    THREAD_EXIT_CRITICAL();
+}
+
+/*********************************************************************
+* Service Name: Thread_GetCurrent
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Thread_IdType - Identifier of the running thread
+* Description: Function to get the running thread.
+**********************************************************************/
+Thread_IdType Thread_GetCurrent(void){
+
+    if(g_ThreadCurrent == NULL_PTR){
+        return THREAD_IDLE_ID;
+    }
+
+    return (Thread_IdType)(g_ThreadCurrent - g_ThreadTable);
+}
+
+/*********************************************************************
+* Service Name: Thread_GetSwitchStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the context switch cycle statistics
+* Description: Function to read the measured context switch cost.
+**********************************************************************/
+const Thread_SwitchStatsType *Thread_GetSwitchStats(void){
+
+    return &g_ThreadSwitchStats;
+}
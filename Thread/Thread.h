@@ -0,0 +1,254 @@
+/******************************************************************************
+ *
+ * Module: Thread
+ *
+ * File Name: Thread.h
+ *
+ * Description: Header file for the preemptive thread layer with PendSV context
+ *              switching and lazy FPU state preservation
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef THREAD_H_
+#define THREAD_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+/* Number of threads including the idle thread (priority 0), 32 at most */
+#ifndef THREAD_MAX_THREADS
+#define THREAD_MAX_THREADS                   8
+#endif
+
+/* Stack size of every thread in words, must be even (8 byte aligned frames) */
+#ifndef THREAD_STACK_WORDS
+#define THREAD_STACK_WORDS                   256
+#endif
+
+#define THREAD_IDLE_ID                       0
+
+/* Initial context: R4-R11 and EXC_RETURN pushed by software, R0-xPSR by hardware */
+#define THREAD_SW_FRAME_WORDS                9
+#define THREAD_HW_FRAME_WORDS                8
+#define THREAD_INITIAL_XPSR                  0x01000000   /* Thumb bit */
+#define THREAD_EXC_RETURN_PSP_BASIC          0xFFFFFFFD   /* thread mode, PSP, no FP frame */
+
+/* FPCC register: automatic and lazy FP state preservation */
+#define THREAD_FPCC_ASPEN                    0x80000000
+#define THREAD_FPCC_LSPEN                    0x40000000
+
+/* CPAC register: full access to CP10 and CP11 */
+#define THREAD_CPAC_CP10_CP11_FULL           0x00F00000
+
+/* DWT cycle counter enable */
+#define THREAD_DEMCR_TRCENA                  0x01000000
+#define THREAD_DWT_CYCCNTENA                 0x00000001
+
+/* PendSV priority 7 (lowest) in the SYSPRI3 register */
+#define THREAD_PENDSV_LOWEST_PRIORITY        0x00E00000
+
+/* PENDSTSET bit of the Interrupt Control and State register */
+#define THREAD_INTCTRL_PENDSV_SET            0x10000000
+
+#if (THREAD_MAX_THREADS > 32)
+#error "THREAD_MAX_THREADS must not exceed 32"
+#endif
+
+#if ((THREAD_STACK_WORDS % 2) != 0)
+#error "THREAD_STACK_WORDS must be even"
+#endif
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+/* Thread priority, also its identifier. Higher value runs first */
+typedef uint8 Thread_IdType;
+
+typedef void (*Thread_FuncType)(void *Arg);
+
+typedef enum
+{
+    THREAD_OK,
+    THREAD_INVALID_ID,
+    THREAD_ALREADY_CREATED
+}Thread_StatusType;
+
+/* Thread control block, Thread_Switch.asm uses sp at offset 0 and switchCount at 8 */
+typedef struct
+{
+    uint32 *sp;
+    uint32 sleepTicks;
+    uint32 switchCount;         /* switches into the thread */
+} Thread_ControlBlockType;
+
+/* Context switch cost in CPU cycles, measured inside PendSV with DWT CYCCNT */
+typedef struct
+{
+    uint32 lastCycles;
+    uint32 maxCycles;
+    uint32 switchCount;
+} Thread_SwitchStatsType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Thread_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): IdleFunc - Body of the idle thread, NULL_PTR for an empty loop
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to reset the thread table and create the idle thread.
+**********************************************************************/
+
+void Thread_Init(Thread_FuncType IdleFunc);
+
+/*********************************************************************
+* Service Name: Thread_Create
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): ThreadId - Priority (1 .. THREAD_MAX_THREADS-1) / Func - Thread body / Arg - Argument
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Thread_StatusType
+* Description: Function to create a ready thread on its static stack.
+**********************************************************************/
+
+Thread_StatusType Thread_Create(Thread_IdType ThreadId, Thread_FuncType Func, void *Arg);
+
+/*********************************************************************
+* Service Name: Thread_Start
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to enable lazy FP stacking and the cycle counter, then switch
+*              to the highest priority ready thread. Never returns on target.
+**********************************************************************/
+
+void Thread_Start(void);
+
+/*********************************************************************
+* Service Name: Thread_Yield
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to re-run the scheduler and switch if a higher priority thread is ready.
+**********************************************************************/
+
+void Thread_Yield(void);
+
+/*********************************************************************
+* Service Name: Thread_Sleep
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ticks - Number of Thread_Tick calls to block for
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to block the calling thread for a number of ticks.
+**********************************************************************/
+
+void Thread_Sleep(uint32 Ticks);
+
+/*********************************************************************
+* Service Name: Thread_Suspend
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to block the calling thread until Thread_Resume is called for it.
+**********************************************************************/
+
+void Thread_Suspend(void);
+
+/*********************************************************************
+* Service Name: Thread_Resume
+* Sync/Async: Asynchronous
+* Reentrancy: reentrant
+* Parameters (in): ThreadId - Thread to make ready
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to make a thread ready, safe from any ISR below PendSV priority mask.
+**********************************************************************/
+
+void Thread_Resume(Thread_IdType ThreadId);
+
+/*********************************************************************
+* Service Name: Thread_Tick
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to wake sleeping threads, register it with SysTick_SetCallBack.
+**********************************************************************/
+
+void Thread_Tick(void);
+
+/*********************************************************************
+* Service Name: Thread_GetCurrent
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Thread_IdType - Identifier of the running thread
+* Description: Function to get the running thread.
+**********************************************************************/
+
+Thread_IdType Thread_GetCurrent(void);
+
+/*********************************************************************
+* Service Name: Thread_GetSwitchStats
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: Pointer to the context switch cycle statistics
+* Description: Function to read the measured context switch cost.
+**********************************************************************/
+
+const Thread_SwitchStatsType *Thread_GetSwitchStats(void);
+
+/*********************************************************************
+* Service Name: PendSV_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Context switch, implemented in Thread_Switch.asm. Saves S16-S31 only
+*              for threads that used the FPU, S0-S15/FPSCR are stacked lazily by hardware.
+**********************************************************************/
+
+void PendSV_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* THREAD_H_ */
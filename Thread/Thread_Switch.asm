@@ -0,0 +1,83 @@
+;******************************************************************************
+;
+; Module: Thread
+;
+; File Name: Thread_Switch.asm
+;
+; Description: PendSV context switch of the preemptive thread layer
+;
+; Author: Abdelrahman Hussien
+;
+;******************************************************************************
+
+        .thumb
+        .text
+
+        .global PendSV_Handler
+        .ref    g_ThreadCurrent
+        .ref    g_ThreadNext
+        .ref    g_ThreadSwitchStats
+
+;******************************************************************************
+; PendSV_Handler
+; The hardware already stacked R0-R3, R12, LR, PC, xPSR on the PSP, and for a
+; thread that used the FPU it reserved S0-S15/FPSCR, which are written lazily
+; only if this handler touches the FPU. Software saves R4-R11, EXC_RETURN and,
+; when EXC_RETURN bit 4 is clear (FP frame), S16-S31. Threads that never used
+; the FPU pay for neither FP block.
+; The DWT cycle counter is sampled on entry and exit to time the switch.
+;******************************************************************************
+PendSV_Handler: .asmfunc
+        LDR     R3, DWT_CYCCNT_ADDR
+        LDR     R12, [R3]               ; entry timestamp
+
+        CPSID   I
+        LDR     R1, CURRENT_ADDR
+        LDR     R2, [R1]
+        CBZ     R2, RESTORE             ; first switch, no context to save
+
+        MRS     R0, PSP
+        TST     LR, #0x10
+        IT      EQ
+        VSTMDBEQ R0!, {S16-S31}
+        STMDB   R0!, {R4-R11, LR}
+        STR     R0, [R2]                ; g_ThreadCurrent->sp
+
+RESTORE:
+        LDR     R3, NEXT_ADDR
+        LDR     R2, [R3]
+        STR     R2, [R1]                ; g_ThreadCurrent = g_ThreadNext
+        LDR     R0, [R2, #8]
+        ADD     R0, R0, #1
+        STR     R0, [R2, #8]            ; g_ThreadNext->switchCount
+        LDR     R0, [R2]
+        LDMIA   R0!, {R4-R11, LR}
+        TST     LR, #0x10
+        IT      EQ
+        VLDMIAEQ R0!, {S16-S31}
+        MSR     PSP, R0
+
+        LDR     R3, DWT_CYCCNT_ADDR
+        LDR     R0, [R3]
+        SUB     R0, R0, R12             ; cycles spent in the switch
+        LDR     R3, STATS_ADDR
+        STR     R0, [R3]                ; lastCycles
+        LDR     R1, [R3, #4]
+        CMP     R0, R1
+        IT      HI
+        STRHI   R0, [R3, #4]            ; maxCycles
+        LDR     R1, [R3, #8]
+        ADD     R1, R1, #1
+        STR     R1, [R3, #8]            ; switchCount
+        CPSIE   I
+
+        BX      LR
+        .endasmfunc
+
+        .align  4
+CURRENT_ADDR:       .word   g_ThreadCurrent
+NEXT_ADDR:          .word   g_ThreadNext
+STATS_ADDR:         .word   g_ThreadSwitchStats
+DWT_CYCCNT_ADDR:    .word   0xE0001004
+
+        .end
@@ -0,0 +1,306 @@
+/******************************************************************************
+ *
+ * Module: Watchdog
+ *
+ * File Name: Watchdog.c
+ *
+ * Description: Source file for the watchdog supervisor. Every registered task checks
+ *              in once per supervision window, the SysTick call back kicks the
+ *              hardware watchdog at the end of a window only when all of them did.
+ *              The first watchdog timeout saves a diagnostic record kept across the
+ *              reset that follows the second one
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+#include "Watchdog.h"
+#include "tm4c123gh6pm_registers.h"
+
+#ifdef __TI_ARM__
+#define WATCHDOG_ENTER_CRITICAL()  uint32 savedPrimask = _disable_IRQ()
+#define WATCHDOG_EXIT_CRITICAL()   _restore_interrupts(savedPrimask)
+#else
+#define WATCHDOG_ENTER_CRITICAL()
+#define WATCHDOG_EXIT_CRITICAL()
+#endif
+
+/* WDTCTL */
+#define WATCHDOG_CTL_INTEN            0x00000001
+#define WATCHDOG_CTL_RESEN            0x00000002
+#define WATCHDOG_CTL_INTTYPE          0x00000004
+#define WATCHDOG_CTL_WRC              0x80000000
+
+#define WATCHDOG_TEST_STALL           0x00000100
+#define WATCHDOG_RIS_TIMEOUT          0x00000001
+
+/* SYSCTL_RESC_REG watchdog reset causes */
+#define WATCHDOG_RESC_WDT0            0x00000008
+#define WATCHDOG_RESC_WDT1            0x00000020
+
+#define WATCHDOG_RECORD_MAGIC         0x57444F47u     /* "WDOG" */
+
+/* NVIC_DIS0_REG bit of NVIC_WATCHDOG_TIMERS_0_AND_1, IRQ 18 */
+#define WATCHDOG_NVIC_IRQ_BIT         0x00040000
+
+static const uint32 g_WatchdogBase[] = { WDT0_BASE, WDT1_BASE };
+
+static uint32 g_WatchdogBaseAddress = WDT0_BASE;
+static Watchdog_ModuleType g_WatchdogModule = WATCHDOG_MODULE0;
+static uint16 g_WatchdogWindowTicks;
+static uint16 g_WatchdogTicksLeft;
+static uint32 g_WatchdogTicksSinceKick;
+static uint32 g_WatchdogWindow;
+static uint32 g_WatchdogRegistered;
+static uint32 g_WatchdogJoining;            /* registered during the current window      */
+static uint32 g_WatchdogAllocated;
+static volatile uint32 g_WatchdogAlive;
+static uint32 g_WatchdogMissed;
+static boolean g_WatchdogFailed;
+static boolean g_WatchdogSaved;
+static void (*g_WatchdogCallBack)(const Watchdog_RecordType *Record) = NULL_PTR;
+
+/* Left alone by the C start-up, so a watchdog reset does not wipe them */
+#ifdef __TI_ARM__
+#pragma NOINIT(g_WatchdogRecord)
+#pragma NOINIT(g_WatchdogRecordMagic)
+#endif
+static Watchdog_RecordType g_WatchdogRecord;
+static uint32 g_WatchdogRecordMagic;
+
+/* WDT1 runs on its own clock, a write must wait for the previous one to cross over */
+static void Watchdog_WaitWrite(void){
+
+    if(g_WatchdogModule == WATCHDOG_MODULE1){
+        while(!(WDT_CTL_REG(g_WatchdogBaseAddress) & WATCHDOG_CTL_WRC)){}
+    }
+}
+
+/*********************************************************************
+* Service Name: Watchdog_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Watchdog
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for a timeout or window of 0
+* Description: Function to start the watchdog with its interrupt and reset, with no
+*              task registered. The counter stops while the debugger halts the core.
+*              The record of the previous reset is kept for Watchdog_GetRecord.
+**********************************************************************/
+boolean Watchdog_Init(const Watchdog_ConfigType *Config){
+
+    uint32 bit = 1u << Config->module;
+
+    if((Config->timeout == 0) || (Config->windowTicks == 0)){
+        return FALSE;
+    }
+
+    g_WatchdogModule         = Config->module;
+    g_WatchdogBaseAddress    = g_WatchdogBase[Config->module];
+    g_WatchdogWindowTicks    = Config->windowTicks;
+    g_WatchdogTicksLeft      = Config->windowTicks;
+    g_WatchdogTicksSinceKick = 0;
+    g_WatchdogWindow         = 0;
+    g_WatchdogRegistered     = 0;
+    g_WatchdogJoining        = 0;
+    g_WatchdogAllocated      = 0;
+    g_WatchdogAlive          = 0;
+    g_WatchdogMissed         = 0;
+    g_WatchdogFailed         = FALSE;
+    g_WatchdogSaved          = FALSE;
+
+    SYSCTL_RCGCWD_REG |= bit;
+    SYSCTL_SCGCWD_REG |= bit;
+    SYSCTL_DCGCWD_REG |= bit;
+    while(!(SYSCTL_PRWD_REG & bit)){}
+
+    Watchdog_WaitWrite();
+    WDT_LOAD_REG(g_WatchdogBaseAddress) = Config->timeout;
+    Watchdog_WaitWrite();
+    WDT_TEST_REG(g_WatchdogBaseAddress) = WATCHDOG_TEST_STALL;
+
+    /* Once set, the interrupt and the reset stay on until the next reset */
+    Watchdog_WaitWrite();
+    WDT_CTL_REG(g_WatchdogBaseAddress) = WATCHDOG_CTL_INTEN | WATCHDOG_CTL_RESEN |
+                                         (Config->nmi ? WATCHDOG_CTL_INTTYPE : 0);
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: Watchdog_Register
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Check-in bit of the new task, 0 when WATCHDOG_MAX_TASKS are
+*                        registered
+* Description: Function to add a task to the supervision. Its first window is the next
+*              one, so it is not blamed for the window it registered in.
+**********************************************************************/
+uint32 Watchdog_Register(void){
+
+    uint32 task = 0;
+    uint8 i;
+
+    WATCHDOG_ENTER_CRITICAL();
+
+    for(i = 0; i < WATCHDOG_MAX_TASKS; i++){
+        if(!(g_WatchdogAllocated & (1u << i))){
+            task = 1u << i;
+            g_WatchdogAllocated |= task;
+            g_WatchdogJoining   |= task;
+            break;
+        }
+    }
+
+    WATCHDOG_EXIT_CRITICAL();
+
+    return task;
+}
+
+/*********************************************************************
+* Service Name: Watchdog_CheckIn
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Task - Check-in bit from Watchdog_Register
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to report a task alive for the current window.
+**********************************************************************/
+void Watchdog_CheckIn(uint32 Task){
+
+    WATCHDOG_ENTER_CRITICAL();
+    g_WatchdogAlive |= Task;
+    WATCHDOG_EXIT_CRITICAL();
+}
+
+/*********************************************************************
+* Service Name: Watchdog_Tick
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to close a window every windowTicks calls. The watchdog is
+*              kicked when every task checked in, a window with a missing task stops
+*              the kicks for good. Called from the SysTick call back.
+**********************************************************************/
+void Watchdog_Tick(void){
+
+    uint32 alive;
+
+    g_WatchdogTicksSinceKick++;
+    if(--g_WatchdogTicksLeft != 0){
+        return;
+    }
+    g_WatchdogTicksLeft = g_WatchdogWindowTicks;
+    g_WatchdogWindow++;
+
+    {
+        WATCHDOG_ENTER_CRITICAL();
+
+        alive = g_WatchdogAlive;
+        g_WatchdogAlive = 0;
+
+        WATCHDOG_EXIT_CRITICAL();
+    }
+
+    if(g_WatchdogFailed){
+        return;
+    }
+
+    if((alive & g_WatchdogRegistered) == g_WatchdogRegistered){
+
+        /* Any write of WDTICR reloads the counter */
+        Watchdog_WaitWrite();
+        WDT_ICR_REG(g_WatchdogBaseAddress) = 0;
+        g_WatchdogTicksSinceKick = 0;
+    }
+    else{
+        g_WatchdogMissed = g_WatchdogRegistered & ~alive;
+        g_WatchdogFailed = TRUE;
+    }
+
+    g_WatchdogRegistered |= g_WatchdogJoining;
+    g_WatchdogJoining = 0;
+}
+
+/*********************************************************************
+* Service Name: Watchdog_GetRecord
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): Record - Diagnostic record of the last watchdog reset
+* Return value: boolean - TRUE once after a watchdog reset with a saved record
+* Description: Function to read the record saved before the reset that started this
+*              run, it is consumed by the read.
+**********************************************************************/
+boolean Watchdog_GetRecord(Watchdog_RecordType *Record){
+
+    if((g_WatchdogRecordMagic != WATCHDOG_RECORD_MAGIC) ||
+       !(SYSCTL_RESC_REG & (WATCHDOG_RESC_WDT0 | WATCHDOG_RESC_WDT1))){
+        return FALSE;
+    }
+
+    *Record = g_WatchdogRecord;
+    g_WatchdogRecordMagic = 0;
+
+    return TRUE;
+}
+
+/*********************************************************************
+* Service Name: Watchdog_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called by the pre-reset interrupt after
+*              the record is saved, to flush logs or park outputs. The reset follows
+*              one timeout later whatever it does.
+**********************************************************************/
+void Watchdog_SetCallBack(void (*Ptr2Func)(const Watchdog_RecordType *Record)){
+
+    g_WatchdogCallBack = Ptr2Func;
+}
+
+/*********************************************************************
+* Service Name: Watchdog_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the first timeout: save the record, disable the NVIC
+*              line and leave the interrupt pending, so the next timeout resets the
+*              device while the handler no longer enters again.
+**********************************************************************/
+void Watchdog_Handler(void){
+
+    /* The pending interrupt enters again until the reset, the record is saved once */
+    if(g_WatchdogSaved || !(WDT_RIS_REG(g_WatchdogBaseAddress) & WATCHDOG_RIS_TIMEOUT)){
+        return;
+    }
+    g_WatchdogSaved = TRUE;
+
+    g_WatchdogRecord.missed         = g_WatchdogFailed ? g_WatchdogMissed : (g_WatchdogRegistered & ~g_WatchdogAlive);
+    g_WatchdogRecord.registered     = g_WatchdogRegistered;
+    g_WatchdogRecord.window         = g_WatchdogWindow;
+    g_WatchdogRecord.ticksSinceKick = g_WatchdogTicksSinceKick;
+    g_WatchdogRecordMagic           = WATCHDOG_RECORD_MAGIC;
+
+    /* WDTRIS stays set for the reset, the line is disabled so it stops tail-chaining
+       back in. The NMI form cannot be disabled, the saved flag returns it at once */
+    NVIC_DIS0_REG = WATCHDOG_NVIC_IRQ_BIT;
+
+    if(g_WatchdogCallBack != NULL_PTR){
+        g_WatchdogCallBack(&g_WatchdogRecord);
+    }
+}
@@ -0,0 +1,176 @@
+/******************************************************************************
+ *
+ * Module: Watchdog
+ *
+ * File Name: Watchdog.h
+ *
+ * Description: Header file for the watchdog supervisor. Every registered task checks
+ *              in once per supervision window, the SysTick call back kicks the
+ *              hardware watchdog at the end of a window only when all of them did.
+ *              The first watchdog timeout saves a diagnostic record kept across the
+ *              reset that follows the second one
+ *
+ *              Wiring, the kick stays one register write inside the SysTick tick:
+ *                  SysTick_SetCallBack(Watchdog_Tick);
+ *              and Watchdog_Handler in the vector of NVIC_WATCHDOG_TIMERS_0_AND_1,
+ *              or in the NMI vector with nmi set.
+ *
+ * Author: Abdelrahman Hussien
+ *
+ *******************************************************************************/
+
+#ifndef WATCHDOG_H_
+#define WATCHDOG_H_
+
+/*******************************************************************************
+ *                                Inclusions                                   *
+ *******************************************************************************/
+#include "std_types.h"
+
+/*******************************************************************************
+ *                           Preprocessor Definitions                          *
+ *******************************************************************************/
+
+#define WATCHDOG_MAX_TASKS                   32
+
+/*******************************************************************************
+ *                           Data Types Declarations                           *
+ *******************************************************************************/
+
+typedef enum
+{
+    WATCHDOG_MODULE0,                   /* system clock                                 */
+    WATCHDOG_MODULE1                    /* PIOSC, 16 MHz, runs on a failed main clock   */
+}Watchdog_ModuleType;
+
+typedef struct
+{
+    Watchdog_ModuleType module;
+    uint32 timeout;                     /* watchdog clocks to the pre-reset interrupt,
+                                           longer than a window; the reset follows one
+                                           more timeout later                            */
+    uint16 windowTicks;                 /* Watchdog_Tick calls per supervision window    */
+    boolean nmi;                        /* pre-reset interrupt as an NMI, it still runs
+                                           with the interrupts masked                    */
+}Watchdog_ConfigType;
+
+/* Saved by the pre-reset interrupt */
+typedef struct
+{
+    uint32 missed;                      /* tasks that did not check in                  */
+    uint32 registered;
+    uint32 window;                      /* supervision windows completed                */
+    uint32 ticksSinceKick;              /* below windowTicks when the ticks stopped     */
+}Watchdog_RecordType;
+
+/*******************************************************************************
+ *                            Functions Prototypes                             *
+ *******************************************************************************/
+
+/*********************************************************************
+* Service Name: Watchdog_Init
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): Config - Watchdog
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: boolean - FALSE for a timeout or window of 0
+* Description: Function to start the watchdog with its interrupt and reset, with no
+*              task registered. The counter stops while the debugger halts the core.
+*              The record of the previous reset is kept for Watchdog_GetRecord.
+**********************************************************************/
+
+boolean Watchdog_Init(const Watchdog_ConfigType *Config);
+
+/*********************************************************************
+* Service Name: Watchdog_Register
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: uint32 - Check-in bit of the new task, 0 when WATCHDOG_MAX_TASKS are
+*                        registered
+* Description: Function to add a task to the supervision. Its first window is the next
+*              one, so it is not blamed for the window it registered in.
+**********************************************************************/
+
+uint32 Watchdog_Register(void);
+
+/*********************************************************************
+* Service Name: Watchdog_CheckIn
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Task - Check-in bit from Watchdog_Register
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to report a task alive for the current window.
+**********************************************************************/
+
+void Watchdog_CheckIn(uint32 Task);
+
+/*********************************************************************
+* Service Name: Watchdog_Tick
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to close a window every windowTicks calls. The watchdog is
+*              kicked when every task checked in, a window with a missing task stops
+*              the kicks for good. Called from the SysTick call back.
+**********************************************************************/
+
+void Watchdog_Tick(void);
+
+/*********************************************************************
+* Service Name: Watchdog_GetRecord
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): Record - Diagnostic record of the last watchdog reset
+* Return value: boolean - TRUE once after a watchdog reset with a saved record
+* Description: Function to read the record saved before the reset that started this
+*              run, it is consumed by the read.
+**********************************************************************/
+
+boolean Watchdog_GetRecord(Watchdog_RecordType *Record);
+
+/*********************************************************************
+* Service Name: Watchdog_SetCallBack
+* Sync/Async: Synchronous
+* Reentrancy: reentrant
+* Parameters (in): Ptr2Func - Function, NULL_PTR to remove
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to set the function called by the pre-reset interrupt after
+*              the record is saved, to flush logs or park outputs. The reset follows
+*              one timeout later whatever it does.
+**********************************************************************/
+
+void Watchdog_SetCallBack(void (*Ptr2Func)(const Watchdog_RecordType *Record));
+
+/*********************************************************************
+* Service Name: Watchdog_Handler
+* Sync/Async: Synchronous
+* Reentrancy: non reentrant
+* Parameters (in): None
+* Parameters (inout): None
+* Parameters (out): None
+* Return value: None
+* Description: Function to serve the first timeout: save the record, disable the NVIC
+*              line and leave the interrupt pending, so the next timeout resets the
+*              device while the handler no longer enters again.
+**********************************************************************/
+
+void Watchdog_Handler(void);
+
+/************************************************************************************
+ *                                 End of File                                      *
+ ************************************************************************************/
+
+#endif /* WATCHDOG_H_ */
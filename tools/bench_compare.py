@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""
+Module: Build Tools
+
+File Name: bench_compare.py
+
+Description: Compares two JSON reports of the driver micro-benchmark (Benchmark/,
+             "make bench" in HostSim/) and fails when a call got slower than the
+             baseline by more than the tolerance, or when a case disappeared.
+
+Usage: python bench_compare.py <baseline>.json <current>.json [--tolerance PERCENT]
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as report:
+        data = json.load(report)
+    return data, {case['name']: case for case in data['results']}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('baseline')
+    parser.add_argument('current')
+    parser.add_argument('--tolerance', type=float, default=0.0,
+                        help='allowed slowdown of the minimum in percent (default 0)')
+    args = parser.parse_args()
+
+    base_report, baseline = load(args.baseline)
+    cur_report, current = load(args.current)
+
+    if (base_report['target'], base_report['unit']) != (cur_report['target'], cur_report['unit']):
+        print('reports are from different targets: %s/%s vs %s/%s' % (
+            base_report['target'], base_report['unit'], cur_report['target'], cur_report['unit']))
+        return 2
+
+    regressions = 0
+    print('%-32s %10s %10s %8s' % ('case', 'baseline', 'current', 'delta'))
+    for name, base in baseline.items():
+        if name not in current:
+            print('%-32s %10d %10s %8s  MISSING' % (name, base['min'], '-', '-'))
+            regressions += 1
+            continue
+        old, new = base['min'], current[name]['min']
+        limit = old * (1.0 + args.tolerance / 100.0)
+        flag = ''
+        if new > limit:
+            flag = '  SLOWER'
+            regressions += 1
+        elif new < old:
+            flag = '  faster'
+        print('%-32s %10d %10d %+8d%s' % (name, old, new, new - old, flag))
+
+    for name in current:
+        if name not in baseline:
+            print('%-32s %10s %10d %8s  new' % (name, '-', current[name]['min'], '-'))
+
+    print('%d regression(s) in %s' % (regressions, cur_report['unit']))
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,300 @@
+#!/usr/bin/env python3
+"""
+Module: Build Tools
+
+File Name: footprint_report.py
+
+Description: Post-build step that reports the code size, static RAM and stack usage
+             of every function and fails when a budget of footprint_budget.json is
+             exceeded.
+
+             Code size and static RAM come from the TI linker map. Stack usage per
+             function and the call graph come from one of:
+               --ofd  XML dump of the DWARF information of the linked image,
+                      armofd -g -x <project>.out (DW_AT_TI_max_frame_size and
+                      DW_TAG_TI_branch of every subprogram)
+               --ci   GCC -fcallgraph-info=su files (.ci)
+               --su   GCC -fstack-usage files (.su), no call graph
+
+             The worst case stack is the deepest path from the entry function plus,
+             for every configured exception priority level, the deepest handler of
+             that level and its exception frame, since one handler per level can be
+             active at the same time. It is checked against __STACK_SIZE of the map
+             (the 512 bytes between __stack and __STACK_TOP in tm4c123gh6pm.cmd).
+
+Usage: python footprint_report.py <project>.map [--ofd FILE | --ci FILE... | --su FILE...]
+                                  [--budget footprint_budget.json]
+"""
+import argparse
+import json
+import os
+import re
+import sys
+import xml.etree.ElementTree as ElementTree
+
+from ramfunc_report import parse_sections
+
+MEMORY_LINE = re.compile(r'^\s+(\w+)\s+([0-9a-fA-F]{8})\s+([0-9a-fA-F]{8})\s+([0-9a-fA-F]{8})\s+[0-9a-fA-F]{8}')
+SYMBOL_LINE = re.compile(r'^([0-9a-fA-F]{8})\s+(\S+)\s*$')
+INPUT_NAME = re.compile(r'^(?:(\S*)\s*:\s*)?(\S+)\s+\(([^)]*)\)$')
+
+CODE_SECTIONS = ('.text', '.ramfunc')
+RAM_SECTIONS = ('.bss', '.data', '.noinit', '.sysmem', '.vtable')
+
+DEFAULT_BUDGET = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'footprint_budget.json')
+
+
+def parse_memory(map_text):
+    """Return {region: (length, used)} from the MEMORY CONFIGURATION block."""
+    memory = {}
+    for line in map_text.splitlines():
+        if line.startswith('SEGMENT ALLOCATION MAP'):
+            break
+        match = MEMORY_LINE.match(line)
+        if match:
+            memory[match.group(1)] = (int(match.group(3), 16), int(match.group(4), 16))
+    return memory
+
+
+def parse_symbols(map_text):
+    """Return {symbol: address} from the GLOBAL SYMBOLS tables."""
+    symbols = {}
+    in_table = False
+    for line in map_text.splitlines():
+        if line.startswith('GLOBAL SYMBOLS'):
+            in_table = True
+            continue
+        match = SYMBOL_LINE.match(line) if in_table else None
+        if match:
+            symbols[match.group(2)] = int(match.group(1), 16)
+    return symbols
+
+
+def split_input(description):
+    """'lib : obj (.text:name:name)' -> (object, '.text', 'name' or None)."""
+    match = INPUT_NAME.match(description)
+    if not match:
+        return description, description, None
+    parts = match.group(3).split(':')
+    return match.group(2), parts[0], parts[1] if len(parts) > 1 else None
+
+
+def code_and_ram(sections):
+    """Return ({function or 'object (section)': [object, code bytes]}, {object: static RAM})."""
+    code = {}
+    ram = {}
+    for name, allocations in sections.items():
+        base = name.split(':')[0]
+        for origin, length, inputs in allocations:
+            # A load/run pair lists the same code twice, count the run copy only
+            if base == '.ramfunc' and origin < 0x20000000 and len(allocations) > 1:
+                continue
+            for size, description in inputs:
+                if '--HOLE--' in description:
+                    continue
+                obj, section, function = split_input(description)
+                if base in CODE_SECTIONS:
+                    key = function or '%s (%s)' % (obj, section)
+                    entry = code.setdefault(key, [obj, 0])
+                    entry[1] += size
+                elif base in RAM_SECTIONS:
+                    ram[obj] = ram.get(obj, 0) + size
+    return code, ram
+
+
+def dwarf_value(attribute):
+    value = attribute.find('value')
+    if value is None or len(value) == 0:
+        return None
+    return value[0].text
+
+
+def parse_ofd(path):
+    """Return ({function: frame bytes}, {function: set(callees)}) from armofd -g -x."""
+    frames = {}
+    calls = {}
+
+    def walk(die, function):
+        tag = die.findtext('tag')
+        attributes = {}
+        for attribute in die.findall('attribute'):
+            attributes[attribute.findtext('type')] = dwarf_value(attribute)
+        if tag == 'DW_TAG_subprogram' and attributes.get('DW_AT_name'):
+            function = attributes['DW_AT_name']
+            if attributes.get('DW_AT_TI_max_frame_size') is not None:
+                frames[function] = int(attributes['DW_AT_TI_max_frame_size'], 0)
+            calls.setdefault(function, set())
+        elif tag == 'DW_TAG_TI_branch' and function and attributes.get('DW_AT_name') \
+                and 'DW_AT_TI_call' in attributes:
+            calls[function].add(attributes['DW_AT_name'])
+        for child in die.findall('die'):
+            walk(child, function)
+
+    root = ElementTree.parse(path).getroot()
+    for die in root.iter('die'):
+        if die.findtext('tag') == 'DW_TAG_compile_unit':
+            walk(die, None)
+    return frames, calls
+
+
+def parse_ci(paths):
+    """Return ({function: frame bytes}, {function: set(callees)}) from GCC .ci files."""
+    node = re.compile(r'node:\s*\{\s*title:\s*"([^"]+)"\s*label:\s*"([^"]*)"')
+    edge = re.compile(r'edge:\s*\{\s*sourcename:\s*"([^"]+)"\s*targetname:\s*"([^"]+)"')
+    frame = re.compile(r'(\d+) bytes \((static|dynamic|bounded)')
+    frames = {}
+    calls = {}
+    for path in paths:
+        with open(path) as ci_file:
+            text = ci_file.read()
+        for title, label in node.findall(text):
+            size = frame.search(label)
+            if size:
+                frames[title] = int(size.group(1))
+            calls.setdefault(title, set())
+        for source, target in edge.findall(text):
+            calls.setdefault(source, set()).add(target)
+    return frames, calls
+
+
+def parse_su(paths):
+    """Return ({function: frame bytes}, {}) from GCC .su files."""
+    frames = {}
+    for path in paths:
+        with open(path) as su_file:
+            for line in su_file:
+                fields = line.rstrip('\n').split('\t')
+                if len(fields) >= 2:
+                    frames[fields[0].split(':')[-1]] = int(fields[1])
+    return frames, {}
+
+
+class StackGraph(object):
+    def __init__(self, frames, calls):
+        self.frames = frames
+        self.calls = calls
+        self.depths = {}
+        self.incomplete = set()
+        self.recursive = set()
+
+    def depth(self, function, path=()):
+        """Deepest stack from function down, None for a recursive path."""
+        if function in path:
+            self.recursive.update(path[path.index(function):])
+            return None
+        if function in self.depths:
+            return self.depths[function]
+        if function not in self.frames:
+            self.incomplete.add(function)
+        deepest = 0
+        for callee in sorted(self.calls.get(function, ())):
+            below = self.depth(callee, path + (function,))
+            if below is None:
+                return None
+            deepest = max(deepest, below)
+        self.depths[function] = self.frames.get(function, 0) + deepest
+        return self.depths[function]
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Code size, static RAM and stack usage report.')
+    parser.add_argument('map')
+    source = parser.add_mutually_exclusive_group()
+    source.add_argument('--ofd', help='armofd -g -x XML dump of the linked image')
+    source.add_argument('--ci', nargs='+', help='GCC -fcallgraph-info=su files')
+    source.add_argument('--su', nargs='+', help='GCC -fstack-usage files')
+    parser.add_argument('--budget', default=DEFAULT_BUDGET)
+    args = parser.parse_args()
+
+    with open(args.map) as map_file:
+        map_text = map_file.read()
+    with open(args.budget) as budget_file:
+        budget = json.load(budget_file)
+
+    memory = parse_memory(map_text)
+    symbols = parse_symbols(map_text)
+    code, ram = code_and_ram(parse_sections(map_text))
+
+    if args.ofd:
+        frames, calls = parse_ofd(args.ofd)
+    elif args.ci:
+        frames, calls = parse_ci(args.ci)
+    elif args.su:
+        frames, calls = parse_su(args.su)
+    else:
+        frames, calls = {}, {}
+
+    # Calls through function pointers (call-backs) are not in the debug information
+    for caller, callees in budget.get('indirect_calls', {}).items():
+        calls.setdefault(caller, set()).update(callees)
+    graph = StackGraph(frames, calls)
+
+    failures = []
+    limits = budget.get('functions', {})
+
+    print('%-40s %-28s %6s %6s %6s' % ('function', 'object', 'code', 'frame', 'depth'))
+    for function in sorted(set(code) | set(frames), key=lambda f: -code.get(f, ['', 0])[1]):
+        obj, size = code.get(function, ['-', 0])
+        depth = graph.depth(function) if function in frames else None
+        print('%-40s %-28s %6d %6s %6s' % (function, obj, size,
+                                             frames.get(function, '-'),
+                                             '-' if depth is None or not frames else depth))
+        limit = limits.get(function, {})
+        if 'code' in limit and size > limit['code']:
+            failures.append('%s code %d > %d' % (function, size, limit['code']))
+        if 'stack' in limit and depth is not None and frames and depth > limit['stack']:
+            failures.append('%s stack %d > %d' % (function, depth, limit['stack']))
+
+    print('')
+    print('static RAM per object')
+    for obj in sorted(ram, key=lambda o: -ram[o]):
+        print('  %6d bytes  %s' % (ram[obj], obj))
+    static_ram = sum(ram.values())
+
+    print('')
+    for region, (length, used) in sorted(memory.items()):
+        print('%-6s %7d / %7d bytes used' % (region, used, length))
+        region_budget = budget.get('regions', {}).get(region)
+        if region_budget is not None and used > region_budget:
+            failures.append('%s used %d > %d' % (region, used, region_budget))
+    print('static RAM %7d bytes (stack excluded)' % static_ram)
+    if 'static_ram' in budget and static_ram > budget['static_ram']:
+        failures.append('static RAM %d > %d' % (static_ram, budget['static_ram']))
+
+    stack_size = symbols.get('__STACK_SIZE')
+    if stack_size is None and '__STACK_TOP' in symbols and '__stack' in symbols:
+        stack_size = symbols['__STACK_TOP'] - symbols['__stack']
+    if frames:
+        entry = budget.get('entry', 'main')
+        worst = graph.depth(entry) or 0
+        print('')
+        print('worst case stack')
+        print('  %-34s %6d bytes' % (entry, worst))
+        levels = {}
+        for handler, priority in budget.get('handlers', {}).items():
+            if handler in frames:
+                depth = graph.depth(handler)
+                if depth is not None:
+                    levels[priority] = max(levels.get(priority, (0, '')), (depth, handler))
+        frame_bytes = budget.get('exception_frame', 32)
+        for priority in sorted(levels):
+            depth, handler = levels[priority]
+            print('  + priority %-3s %-23s %6d bytes (+%d frame)' % (priority, handler, depth, frame_bytes))
+            worst += depth + frame_bytes
+        print('  = %d bytes of %s' % (worst, stack_size if stack_size is not None else 'unknown'))
+        if stack_size is not None and worst > stack_size:
+            failures.append('worst case stack %d > __STACK_SIZE %d' % (worst, stack_size))
+        if graph.recursive:
+            failures.append('recursion, stack unbounded: ' + ', '.join(sorted(graph.recursive)))
+        if graph.incomplete:
+            print('  no stack information for: ' + ', '.join(sorted(graph.incomplete)))
+
+    print('')
+    for failure in failures:
+        print('BUDGET EXCEEDED: ' + failure)
+    print('footprint: %s' % ('FAIL' if failures else 'ok'))
+    return 1 if failures else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""
+Module: Build Tools
+
+File Name: ramfunc_report.py
+
+Description: Post-build step that reads the TI linker map file and reports the
+             FLASH and SRAM footprint of the code relocated to SRAM through the
+             .ramfunc section (see RAMFUNC in std_types.h and tm4c123gh6pm.cmd).
+
+Usage: python ramfunc_report.py <project>.map
+"""
+import re
+import sys
+
+SRAM_BASE = 0x20000000
+SRAM_SIZE = 0x00008000
+
+OUTPUT_SECTION = re.compile(r'^(\.\S+)\s+\d+\s+([0-9a-fA-F]{8})\s+([0-9a-fA-F]{8})')
+INPUT_SECTION = re.compile(r'^\s+([0-9a-fA-F]{8})\s+([0-9a-fA-F]{8})\s+(.*)$')
+
+
+def parse_sections(map_text):
+    """Return {section name: [(origin, length, [(length, input description)])]}."""
+    sections = {}
+    current = None
+    in_alloc_map = False
+    for line in map_text.splitlines():
+        if line.startswith('SECTION ALLOCATION MAP'):
+            in_alloc_map = True
+            continue
+        if line.startswith('MODULE SUMMARY'):
+            break
+        if not in_alloc_map:
+            continue
+        match = OUTPUT_SECTION.match(line)
+        if match:
+            current = (int(match.group(2), 16), int(match.group(3), 16), [])
+            sections.setdefault(match.group(1), []).append(current)
+            continue
+        match = INPUT_SECTION.match(line)
+        if match and current is not None:
+            current[2].append((int(match.group(2), 16), match.group(3).strip()))
+        elif not line.strip():
+            current = None
+    return sections
+
+
+def main(argv):
+    if len(argv) != 2:
+        sys.stderr.write('usage: ramfunc_report.py <map file>\n')
+        return 2
+
+    with open(argv[1]) as map_file:
+        sections = parse_sections(map_file.read())
+
+    ramfunc = sections.get('.ramfunc', [])
+    binit = sections.get('.binit', [])
+
+    run = [s for s in ramfunc if SRAM_BASE <= s[0] < SRAM_BASE + SRAM_SIZE]
+    load = [s for s in ramfunc if s not in run]
+    code_size = max([s[1] for s in ramfunc] or [0])
+    table_size = sum(s[1] for s in binit)
+
+    print('.ramfunc relocation report')
+    print('--------------------------')
+    for origin, length, inputs in (load or run):
+        for input_length, description in inputs:
+            if '--HOLE--' not in description:
+                print('  %6d bytes  %s' % (input_length, description))
+    if run:
+        print('  run address   0x%08X' % run[0][0])
+    if load:
+        print('  load address  0x%08X' % load[0][0])
+    print('  SRAM  footprint: %6d bytes' % code_size)
+    print('  FLASH footprint: %6d bytes (%d code + %d BINIT copy table)'
+          % (code_size + table_size, code_size, table_size))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))